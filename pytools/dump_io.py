@@ -52,6 +52,8 @@ class DumpField(object):
             mysize = BOOL_SIZE
             stringchar = "?"
             dtype = bool
+        elif self.type == 4:
+            mysize = None
         else:
             raise RuntimeError(
                 "Found unknown data type %d for field %s" % (self.type, self.name)
@@ -62,10 +64,81 @@ class DumpField(object):
         for dim in range(self.ndims):
             dims.append(int.from_bytes(fh.read(INT_SIZE), byteorder))
             ntot = ntot * dims[-1]
+        if mysize is None:
+            self.array = _read_compressed(fh, dims, byteorder)
+            return
         raw = struct.unpack(str(ntot) + stringchar, fh.read(mysize * ntot))
         self.array = np.asarray(raw, dtype=dtype).reshape(dims[::-1]).T
 
 
+def _lz_decompress(src, outsize):
+    # Decoder of the built-in "lz" codec of Idefix (see src/output/codec.cpp)
+    dst = bytearray(outsize)
+    ip = 0
+    op = 0
+    while ip < len(src):
+        token = src[ip]
+        ip += 1
+        nlit = token >> 4
+        if nlit == 15:
+            while True:
+                b = src[ip]
+                ip += 1
+                nlit += b
+                if b != 255:
+                    break
+        dst[op : op + nlit] = src[ip : ip + nlit]
+        ip += nlit
+        op += nlit
+        if ip >= len(src):
+            break
+        offset = src[ip] | (src[ip + 1] << 8)
+        ip += 2
+        length = token & 15
+        if length == 15:
+            while True:
+                b = src[ip]
+                ip += 1
+                length += b
+                if b != 255:
+                    break
+        length += 4
+        for _ in range(length):
+            dst[op] = dst[op - offset]
+            op += 1
+    if op != outsize:
+        raise RuntimeError("Corrupted compressed data")
+    return bytes(dst)
+
+
+def _read_compressed(fh, dims, byteorder):
+    endian = "<" if byteorder == "little" else ">"
+    fh.read(8)  # size of the compressed data
+    real_type, codec, nchunks = struct.unpack(endian + "3i", fh.read(3 * INT_SIZE))
+    dtype = np.dtype("float64" if real_type == 0 else "float32").newbyteorder(endian)
+    index = struct.unpack(endian + str(7 * nchunks) + "q", fh.read(8 * 7 * nchunks))
+    array = np.zeros(dims[::-1], dtype=dtype)
+    for c in range(nchunks):
+        start = index[7 * c : 7 * c + 3]
+        size = index[7 * c + 3 : 7 * c + 6]
+        raw = fh.read(index[7 * c + 6])
+        n = size[0] * size[1] * size[2]
+        if codec == 0:
+            data = np.frombuffer(raw, dtype=dtype)
+        elif codec == 1:
+            # bytes of the reals are shuffled before compression
+            shuffled = np.frombuffer(_lz_decompress(raw, n * dtype.itemsize), dtype=np.uint8)
+            data = shuffled.reshape(dtype.itemsize, n).T.copy().view(dtype).ravel()
+        else:
+            raise RuntimeError("Unknown compression codec %d" % codec)
+        array[
+            start[2] : start[2] + size[2],
+            start[1] : start[1] + size[1],
+            start[0] : start[0] + size[0],
+        ] = data.reshape(size[::-1])
+    return array.T
+
+
 class DumpDataset(object):
     def __init__(self, filename):
         self.filename = os.path.abspath(filename)
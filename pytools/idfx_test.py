@@ -66,6 +66,10 @@ class idfxTest:
                         help="Enable single precision",
                         action="store_true")
 
+    parser.add_argument("-mixed",
+                        help="Enable mixed precision (single precision with the evolved state in double precision)",
+                        action="store_true")
+
     parser.add_argument("-vectPot",
                         help="Enable vector potential formulation",
                         action="store_true")
@@ -73,7 +77,7 @@ class idfxTest:
     parser.add_argument("-reconstruction",
                         type=int,
                         default=2,
-                        help="set reconstruction scheme (2=PLM, 3=LimO3, 4=PPM)")
+                        help="set reconstruction scheme (2=PLM, 3=LimO3, 4=PPM, 5=WENO-Z)")
 
     parser.add_argument("-idefixDir",
                         default=idefix_dir_env,
@@ -124,8 +128,10 @@ class idfxTest:
       # disable fmad operations on HIP to make it compatible with CPU arithmetics
       comm.append("-DIdefix_CXX_FLAGS=-ffp-contract=off")
 
-    #if we use single precision
-    if(self.single):
+    #if we use single or mixed precision
+    if(self.mixed):
+      comm.append("-DIdefix_PRECISION=Mixed")
+    elif(self.single):
       comm.append("-DIdefix_PRECISION=Single")
     else:
       comm.append("-DIdefix_PRECISION=Double")
@@ -158,6 +164,8 @@ class idfxTest:
       comm.append("-DIdefix_RECONSTRUCTION=LimO3")
     elif(self.reconstruction==4):
       comm.append("-DIdefix_RECONSTRUCTION=Parabolic")
+    elif(self.reconstruction==5):
+      comm.append("-DIdefix_RECONSTRUCTION=WenoZ")
 
 
     try:
@@ -179,7 +187,7 @@ class idfxTest:
         print("***************************************************"+bcolors.ENDC)
         raise e
 
-  def run(self, inputFile="", np=2, nowrite=False, restart=-1):
+  def run(self, inputFile="", np=2, nowrite=False, restart=-1, args=[]):
       comm=["./idefix"]
       if inputFile:
           comm.append("-i")
@@ -208,6 +216,9 @@ class idfxTest:
         comm.append("-restart")
         comm.append(str(restart))
 
+      # additional command line options
+      comm.extend(args)
+
       try:
           make=subprocess.run(comm)
           make.check_returncode()
@@ -232,6 +243,11 @@ class idfxTest:
     else:
       self.single = False
 
+    if "MIXED PRECISION" in log:
+      self.mixed = True
+    else:
+      self.mixed = False
+
     if "Kokkos CUDA target ENABLED" in log:
       self.cuda = True
     else:
@@ -250,6 +266,9 @@ class idfxTest:
     if "4th order (PPM)" in log:
       self.reconstruction = 4
 
+    if "5th order (WENO-Z)" in log:
+      self.reconstruction = 5
+
     self.mpi=False
     if "MPI ENABLED" in log:
       self.mpi=True
@@ -362,7 +381,9 @@ class idfxTest:
     print("CMake Opts: " +" ".join(self.cmake))
     print("Definitions file:"+self.definitions)
     print("Input File: "+self.inifile)
-    if(self.single):
+    if(self.mixed):
+      print("Precision: Mixed")
+    elif(self.single):
       print("Precision: Single")
     else:
       print("Precision: Double")
@@ -372,6 +393,8 @@ class idfxTest:
       print("Reconstruction: LimO3")
     elif(self.reconstruction==4):
       print("Reconstruction: PPM")
+    elif(self.reconstruction==5):
+      print("Reconstruction: WENO-Z")
     if(self.vectPot):
       print("Vector Potential: ON")
     else:
@@ -389,10 +412,14 @@ class idfxTest:
       strReconstruction = "limo3"
     if self.reconstruction == 4:
       strReconstruction= "ppm"
+    if self.reconstruction == 5:
+      strReconstruction= "wenoz"
 
     strPrecision="double"
     if self.single:
       strPrecision="single"
+    if self.mixed:
+      strPrecision="mixed"
 
     fileref='dump.ref.'+strPrecision+"."+strReconstruction+"."+self.inifile
     if self.vectPot:
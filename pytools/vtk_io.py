@@ -20,6 +20,12 @@ __all__ = [
 # datatype we read
 dt = np.dtype(">f")  # Big endian single precision floats
 dint = np.dtype(">i4")  # Big endian integer
+# Types of the scalar fields (integers are used by quantized fields)
+SCALAR_TYPES = {
+    "float": dt,
+    "unsigned_short": np.dtype(">u2"),
+    "unsigned_char": np.dtype("u1"),
+}
 
 KNOWN_GEOMETRIES = {
     0: "cartesian",
@@ -33,6 +39,7 @@ class VTKDataset(object):
     def __init__(self, filename, geometry=None):
         self.filename = os.path.abspath(filename)
         self.data = {}
+        self._quantization = {}
         with open(filename, "rb") as fh:
             self._load_header(fh, geometry=geometry)
             self._load(fh)
@@ -88,6 +95,10 @@ class VTKDataset(object):
                     self.t = np.fromfile(fh, dt, 1)
                 elif d.startswith("PERIODICITY"):
                     self.periodicity = np.fromfile(fh, dtype=dint, count=3).astype(bool)
+                elif d.split()[0].endswith("_QUANTIZATION"):
+                    # offset and scale of a quantized field
+                    varname = d.split()[0][: -len("_QUANTIZATION")]
+                    self._quantization[varname] = np.fromfile(fh, dtype=">f8", count=2)
                 else:
                     warnings.warn("Found unknown field %s" % d)
                 fh.readline()  # skip extra linefeed (empty line)
@@ -315,11 +326,14 @@ class VTKDataset(object):
             varname = str(slist[1].decode("utf-8"))
             if datatype == "SCALARS":
                 fh.readline()  # LOOKUP TABLE
-                self.data[varname] = np.transpose(
-                    np.fromfile(fh, dt, self.nx * self.ny * self.nz).reshape(
-                        self.nz, self.ny, self.nx
-                    )
+                scalartype = slist[2].decode("utf-8")
+                Q = np.fromfile(
+                    fh, SCALAR_TYPES[scalartype], self.nx * self.ny * self.nz
                 )
+                if varname in self._quantization:
+                    offset, scale = self._quantization[varname]
+                    Q = (offset + scale * Q).astype(dt)
+                self.data[varname] = np.transpose(Q.reshape(self.nz, self.ny, self.nx))
             elif datatype == "VECTORS":
                 Q = np.fromfile(fh, dt, 3 * self.nx * self.ny * self.nz)
 
@@ -17,6 +17,8 @@ template <typename T> using IdefixArray3D =
                             Kokkos::View<T***, Layout, Device>;
 template <typename T> using IdefixArray4D =
                             Kokkos::View<T****, Layout, Device>;
+template <typename T> using IdefixArray5D =
+                            Kokkos::View<T*****, Layout, Device>;
 
 template <typename T> using IdefixHostArray1D =
                             Kokkos::View<T*, Kokkos::LayoutRight, Kokkos::HostSpace>;
@@ -11,6 +11,7 @@
 #include "idefix.hpp"
 #include "dataBlock.hpp"
 #include "fluid.hpp"
+#include "localTimeStepping.hpp"
 #include "gravity.hpp"
 #include "planetarySystem.hpp"
 #include "vtk.hpp"
@@ -34,7 +35,7 @@ DataBlock::DataBlock(Grid &grid, Input &input) {
     nghost[dir] = grid.nghost[dir];
     // Domain decomposition: decompose the full domain size in grid by the number of processes
     // in that direction
-    np_int[dir] = grid.np_int[dir]/grid.nproc[dir];
+    np_int[dir] = grid.np_proc[dir][grid.xproc[dir]];
     np_tot[dir] = np_int[dir]+2*nghost[dir];
 
     // Boundary conditions
@@ -57,8 +58,8 @@ DataBlock::DataBlock(Grid &grid, Input &input) {
 
     // Where does this datablock starts and end in the grid?
     // This assumes even distribution of points between procs
-    gbeg[dir] = grid.nghost[dir] + grid.xproc[dir]*np_int[dir];
-    gend[dir] = grid.nghost[dir] + (grid.xproc[dir]+1)*np_int[dir];
+    gbeg[dir] = grid.nghost[dir] + grid.GetProcOffset(dir, grid.xproc[dir]);
+    gend[dir] = gbeg[dir] + np_int[dir];
 
     // Local start and end of current datablock
     xbeg[dir] = gridHost.xl[dir](gbeg[dir]);
@@ -147,10 +148,19 @@ DataBlock::DataBlock(Grid &grid, Input &input) {
   // Initialise dust grains if needed
   if(input.CheckBlock("Dust")) {
     haveDust = true;
-    int nSpecies = input.Get<int>("Dust","nSpecies",0);
+    // The dust fluids are views of the arrays of dustSpecies, which should exist beforehand
+    dustSpecies = std::make_unique<DustSpecies>(input, this);
+    int nSpecies = dustSpecies->nSpecies;
     for(int i = 0 ; i < nSpecies ; i++) {
       dust.emplace_back(std::make_unique<Fluid<DustPhysics>>(grid, input, this, i));
     }
+    dustSpecies->Init();
+  }
+
+  // Initialise local time stepping if needed (once all of the modules are known)
+  if(input.CheckEntry("TimeIntegrator","lts_levels")>0) {
+    this->lts = std::make_unique<LocalTimeStepping>(input, this);
+    this->haveLocalTimeStepping = true;
   }
   // Register variables that need to be saved in case of restart dump
   dump->RegisterVariable(&t, "time");
@@ -179,7 +189,7 @@ DataBlock::DataBlock(SubGrid *subgrid) {
     nghost[dir] = grid->nghost[dir];
     // Domain decomposition: decompose the full domain size in grid by the number of processes
     // in that direction
-    np_int[dir] = grid->np_int[dir]/grid->nproc[dir];
+    np_int[dir] = grid->np_proc[dir][grid->xproc[dir]];
     np_tot[dir] = np_int[dir]+2*nghost[dir];
 
     // Boundary conditions
@@ -202,8 +212,8 @@ DataBlock::DataBlock(SubGrid *subgrid) {
 
     // Where does this datablock starts and end in the grid?
     // This assumes even distribution of points between procs
-    gbeg[dir] = grid->nghost[dir] + grid->xproc[dir]*np_int[dir];
-    gend[dir] = grid->nghost[dir] + (grid->xproc[dir]+1)*np_int[dir];
+    gbeg[dir] = grid->nghost[dir] + grid->GetProcOffset(dir, grid->xproc[dir]);
+    gend[dir] = gbeg[dir] + np_int[dir];
 
     // Local start and end of current datablock
     xbeg[dir] = gridHost.xl[dir](gbeg[dir]);
@@ -253,32 +263,35 @@ DataBlock::DataBlock(SubGrid *subgrid) {
 void DataBlock::ResetStage() {
   this->hydro->ResetStage();
   if(haveDust) {
-    for(int i = 0 ; i < dust.size() ; i++) {
-      dust[i]->ResetStage();
-    }
+    dustSpecies->ResetStage();
   }
 }
 
 void DataBlock::ConsToPrim() {
   this->hydro->ConvertConsToPrim();
   if(haveDust) {
-    for(int i = 0 ; i < dust.size() ; i++) {
-      dust[i]->ConvertConsToPrim();
-    }
+    dustSpecies->ConvertConsToPrim();
   }
 }
 
 void DataBlock::PrimToCons() {
   this->hydro->ConvertPrimToCons();
   if(haveDust) {
-    for(int i = 0 ; i < dust.size() ; i++) {
-      dust[i]->ConvertPrimToCons();
-    }
+    dustSpecies->ConvertPrimToCons();
   }
 }
 
 // Set the boundaries of the data structures in this datablock
 void DataBlock::SetBoundaries() {
+  SetBoundariesBegin();
+  if(hydro->haveMpiOverlap) {
+    hydro->boundary->SetBoundariesEnd(t);
+  }
+}
+
+// Set the boundaries of the data structures in this datablock. When mpiOverlap is enabled,
+// the hydro boundaries are left incomplete, and must be completed by EvolveStage.
+void DataBlock::SetBoundariesBegin() {
   if(haveGridCoarsening) {
     ComputeGridCoarseningLevels();
     hydro->CoarsenFlow(hydro->Vc);
@@ -296,7 +309,12 @@ void DataBlock::SetBoundaries() {
       dust[i]->boundary->SetBoundaries(t);
     }
   }
-  hydro->boundary->SetBoundaries(t);
+  if(hydro->haveMpiOverlap) {
+    // Completed while the hydro is evolved (see Fluid::OverlapSweeps)
+    hydro->boundary->SetBoundariesBegin(t);
+  } else {
+    hydro->boundary->SetBoundaries(t);
+  }
 }
 
 
@@ -312,6 +330,7 @@ void DataBlock::ShowConfig() {
   }
   hydro->ShowConfig();
   if(haveFargo) fargo->ShowConfig();
+  if(haveLocalTimeStepping) lts->ShowConfig();
   if(haveplanetarySystem) planetarySystem->ShowConfig();
   if(haveGravity) gravity->ShowConfig();
   if(haveUserStepFirst) idfx::cout << "DataBlock: User's first step has been enrolled."
@@ -322,6 +341,7 @@ void DataBlock::ShowConfig() {
     idfx::cout << "DataBlock: evolving " << dust.size() << " dust species." << std::endl;
     // Only show the config the first dust specie
     dust[0]->ShowConfig();
+    dustSpecies->ShowConfig();
     /*
     for(int i = 0 ; i < dust.size() ; i++) {
       dust[i]->ShowConfig();
@@ -345,19 +365,7 @@ real DataBlock::ComputeTimestep() {
               },
           Kokkos::Min<real>(dt));
   if(haveDust) {
-    for(int n = 0 ; n < dust.size() ; n++) {
-      real dtDust;
-      auto InvDt = dust[n]->InvDt;
-      idefix_reduce("Timestep_reduction_dust",
-          beg[KDIR], end[KDIR],
-          beg[JDIR], end[JDIR],
-          beg[IDIR], end[IDIR],
-          KOKKOS_LAMBDA (int k, int j, int i, real &dtmin) {
-                  dtmin=FMIN(ONE_F/InvDt(k,j,i),dtmin);
-              },
-          Kokkos::Min<real>(dtDust));
-      dt = std::min(dt,dtDust);
-    }
+    dt = std::min(dt,dustSpecies->ComputeTimestep());
   }
   Kokkos::fence();
   return(dt);
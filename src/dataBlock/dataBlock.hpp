@@ -36,6 +36,8 @@ class Vtk;
 class Dump;
 class Xdmf;
 class Fargo;
+class LocalTimeStepping;
+class DustSpecies;
 class Gravity;
 class PlanetarySystem;
 template<typename Phys>
@@ -115,6 +117,7 @@ class DataBlock {
   std::unique_ptr<Fluid<DefaultPhysics>> hydro;   ///< The Hydro object attached to this datablock
   bool haveDust{false};
   std::vector<std::unique_ptr<Fluid<DustPhysics>>> dust; ///< Holder for zero pressure dust fluid
+  std::unique_ptr<DustSpecies> dustSpecies;  ///< Storage of all of the dust species
 
   std::unique_ptr<Vtk> vtk;
   std::unique_ptr<Dump> dump;
@@ -139,9 +142,10 @@ class DataBlock {
 
   bool rklCycle{false};           ///<  // Set to true when we're inside a RKL call
 
-  void EvolveStage();             ///< Evolve this DataBlock by dt
+  void EvolveStage(real);         ///< Evolve this DataBlock by a (sub)step of given length
   void EvolveRKLStage();          ///< Evolve this DataBlock by dt for terms impacted by RKL
   void SetBoundaries();       ///< Enforce boundary conditions to this datablock
+  void SetBoundariesBegin();  ///< Same, but hydro MPI exchanges may be completed by EvolveStage
   void ConsToPrim();       ///< Convert conservative to primitive variables
   void PrimToCons();       ///< Convert primitive to conservative variables
   void DeriveVectorPotential(); ///< Compute magnetic fields from vector potential where applicable
@@ -159,6 +163,10 @@ class DataBlock {
   bool haveFargo{false};
   std::unique_ptr<Fargo> fargo;
 
+  // Do we use local time stepping along X1?
+  bool haveLocalTimeStepping{false};
+  std::unique_ptr<LocalTimeStepping> lts;
+
   // Do we have Gravity ?
   bool haveGravity{false};
   std::unique_ptr<Gravity> gravity;
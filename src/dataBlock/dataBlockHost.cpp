@@ -172,7 +172,8 @@ void DataBlockHost::SyncFromDevice() {
   idfx::popRegion();
 }
 
-void DataBlockHost::MakeVsFromAmag(IdefixHostArray4D<real> &Ain) {
+template <typename T>
+void DataBlockHost::MakeVsFromAmag(IdefixHostArray4D<T> &Ain) {
   IdefixHostArray1D<real> dx1 = this->dx[IDIR];
   IdefixHostArray1D<real> dx2 = this->dx[JDIR];
   IdefixHostArray1D<real> dx3 = this->dx[KDIR];
@@ -247,3 +248,8 @@ void DataBlockHost::MakeVsFromAmag(IdefixHostArray4D<real> &Ain) {
   IDEFIX_ERROR("This function cannot be used without MHD enabled");
 #endif
 }
+
+template void DataBlockHost::MakeVsFromAmag(IdefixHostArray4D<real> &);
+#ifdef MIXED_PRECISION
+template void DataBlockHost::MakeVsFromAmag(IdefixHostArray4D<accum> &);
+#endif
@@ -39,8 +39,8 @@ class DataBlockHost {
   std::vector<IdefixHostArray4D<real>> dustVc; ///< Cell-centered primitive variables index for dust
 
   #if MHD == YES
-  IdefixArray4D<real>::HostMirror Vs;     ///< Main face-centered primitive variables index
-  IdefixArray4D<real>::HostMirror Ve;     ///< Main edge-centered primitive variables index
+  IdefixArray4D<accum>::HostMirror Vs;    ///< Main face-centered primitive variables index
+  IdefixArray4D<accum>::HostMirror Ve;    ///< Main edge-centered primitive variables index
   IdefixArray4D<real>::HostMirror J;      ///< Current (only when haveCurrent is enabled)
 
   IdefixArray3D<real>::HostMirror Ex1;    ///< x1 electric field
@@ -48,7 +48,7 @@ class DataBlockHost {
   IdefixArray3D<real>::HostMirror Ex3;    ///< x3 electric field
 
   #endif
-  IdefixArray4D<real>::HostMirror Uc;     ///< Main cell-centered conservative variables
+  IdefixArray4D<accum>::HostMirror Uc;    ///< Main cell-centered conservative variables
   IdefixArray3D<real>::HostMirror InvDt;  ///< Inverse of maximum timestep in each cell
 
   std::array<IdefixArray2D<int>::HostMirror,3> coarseningLevel; ///< Grid coarsening level
@@ -85,8 +85,10 @@ class DataBlockHost {
   PlanetarySystem* planetarySystem;
 
 
-  void MakeVsFromAmag(IdefixHostArray4D<real> &); ///< Compute a face-centered mag. field in Vs from
-                                                  ///< potential vector in argument
+  template <typename T>
+  void MakeVsFromAmag(IdefixHostArray4D<T> &);    ///< Compute a face-centered mag. field in Vs from
+                                                  ///< potential vector in argument (either real
+                                                  ///< or the accum type of Ve)
 
   void SyncToDevice();                            ///< Synchronize this to the device datablock
   void SyncFromDevice();                          ///< Synchronize this from the device datablock
@@ -110,8 +110,12 @@ void DataBlock::DumpToFile(std::string filebase)  {
   // Write Vs
 #if MHD == YES
   // Write Vs
-  IdefixArray4D<real>::HostMirror locVs = Kokkos::create_mirror_view(this->hydro->Vs);
-  Kokkos::deep_copy(locVs,this->hydro->Vs);
+  // Vs is written in real precision, as the other fields
+  IdefixArray4D<accum>::HostMirror VsHost = Kokkos::create_mirror_view(this->hydro->Vs);
+  Kokkos::deep_copy(VsHost,this->hydro->Vs);
+  IdefixHostArray4D<real> locVs("locVs", VsHost.extent(0), VsHost.extent(1), VsHost.extent(2),
+                                         VsHost.extent(3));
+  for(size_t n = 0 ; n < VsHost.size() ; n++) locVs.data()[n] = VsHost.data()[n];
   dims[0] = this->np_tot[IDIR]+IOFFSET;
   dims[1] = this->np_tot[JDIR]+JOFFSET;
   dims[2] = this->np_tot[KDIR]+KOFFSET;
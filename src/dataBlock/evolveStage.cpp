@@ -8,17 +8,21 @@
 #include "../idefix.hpp"
 #include "dataBlock.hpp"
 #include "fluid.hpp"
+#include "dustSpecies.hpp"
 
 // Evolve one step forward in time of hydro
-void DataBlock::EvolveStage() {
+void DataBlock::EvolveStage(real stageDt) {
   idfx::pushRegion("DataBlock::EvolveStage");
 
-  hydro->EvolveStage(this->t,this->dt);
+  hydro->EvolveStage(this->t,stageDt);
 
   if(haveDust) {
+    // The fluxes, right hand sides and boundaries are computed species by species, only the
+    // drag being applied to all of the species at once
     for(int i = 0 ; i < dust.size() ; i++) {
-      dust[i]->EvolveStage(this->t,this->dt);
+      dust[i]->EvolveStage(this->t,stageDt);
     }
+    if(dustSpecies->haveBatchedDrag) dustSpecies->AddDragForce(stageDt);
   }
 
   idfx::popRegion();
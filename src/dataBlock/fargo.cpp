@@ -13,6 +13,7 @@
 #include "fluid.hpp"
 #include "dataBlock.hpp"
 #include "fargo.hpp"
+#include "gridHost.hpp"
 
 
 
@@ -43,6 +44,15 @@ Fargo::Fargo(Input &input, int nmax, DataBlock *data) {
       "Only userdef and shearingbox are allowed");
     }
     this->maxShift = input.GetOrSet<int>("Fargo", "maxShift",0, 10);
+    std::string remapType = input.GetOrSet<std::string>("Fargo", "remap", 0, "flux");
+    if(remapType.compare("flux")==0) {
+      this->remap = flux;
+    } else if(remapType.compare("spectral")==0) {
+      this->remap = spectral;
+    } else {
+      IDEFIX_ERROR("Unknown fargo remap in the input file. "
+      "Only flux and spectral are allowed");
+    }
   } else {
     // DEPRECATED: initialisation from the [Hydro] block
     if(input.CheckEntry("Hydro","fargo")>=0) {
@@ -103,6 +113,31 @@ Fargo::Fargo(Input &input, int nmax, DataBlock *data) {
     IDEFIX_ERROR("Fargo is not compatible with the GEOMETRY you intend to use");
   #endif
 
+  #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR || GEOMETRY == SPHERICAL
+  if(remap == spectral) {
+    #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
+      const int dir = JDIR;
+    #else
+      const int dir = KDIR;
+    #endif
+    if(haveDomainDecomposition) {
+      IDEFIX_ERROR("Fargo:remap spectral is not compatible with a domain decomposition "
+                   "along the azimuthal direction");
+    }
+    // The spectral shift requires a uniform azimuthal grid
+    GridHost gh(*data->mygrid);
+    gh.SyncFromDevice();
+    this->dphi = (gh.xend[dir] - gh.xbeg[dir]) / gh.np_int[dir];
+    for(int s = gh.nghost[dir] ; s < gh.nghost[dir] + gh.np_int[dir] ; s++) {
+      if(std::fabs(gh.dx[dir](s) - dphi) > 1e-6*dphi) {
+        IDEFIX_ERROR("Fargo:remap spectral requires a uniform azimuthal grid");
+      }
+    }
+    this->radix = FftFactorise(data->np_int[dir]);
+    this->twiddle = FftTwiddle("FargoTwiddle", data->np_int[dir]);
+  }
+  #endif
+
 
   // Initialise our scratch space
   // Maximum number of variables
@@ -113,17 +148,20 @@ Fargo::Fargo(Input &input, int nmax, DataBlock *data) {
     }
   }
 
-  this->scrhUc = IdefixArray4D<real>("FargoVcScratchSpace",nvar
-                                      ,end[KDIR]-beg[KDIR] + 2*nghost[KDIR]
-                                      ,end[JDIR]-beg[JDIR] + 2*nghost[JDIR]
-                                      ,end[IDIR]-beg[IDIR] + 2*nghost[IDIR]);
+  // Without domain decomposition, the fields are remapped in place, pencil after pencil
+  if(haveDomainDecomposition) {
+    this->scrhUc = IdefixArray4D<accum>("FargoVcScratchSpace",nvar
+                                         ,end[KDIR]-beg[KDIR] + 2*nghost[KDIR]
+                                         ,end[JDIR]-beg[JDIR] + 2*nghost[JDIR]
+                                         ,end[IDIR]-beg[IDIR] + 2*nghost[IDIR]);
+  }
 
   #if MHD == YES
     if(haveDomainDecomposition) {
-      this->scrhVs = IdefixArray4D<real>("FargoVsScratchSpace",DIMENSIONS
-                                          ,end[KDIR]-beg[KDIR] + 2*nghost[KDIR]+KOFFSET
-                                          ,end[JDIR]-beg[JDIR] + 2*nghost[JDIR]+JOFFSET
-                                          ,end[IDIR]-beg[IDIR] + 2*nghost[IDIR]+IOFFSET);
+      this->scrhVs = IdefixArray4D<accum>("FargoVsScratchSpace",DIMENSIONS
+                                           ,end[KDIR]-beg[KDIR] + 2*nghost[KDIR]+KOFFSET
+                                           ,end[JDIR]-beg[JDIR] + 2*nghost[JDIR]+JOFFSET
+                                           ,end[IDIR]-beg[IDIR] + 2*nghost[IDIR]+IOFFSET);
 
 
     } else {
@@ -170,6 +208,11 @@ void Fargo::ShowConfig() {
   if(haveDomainDecomposition) {
     idfx::cout << "Fargo: using domain decomposition along the azimuthal direction"
                << " with maxShift=" << this->maxShift << std::endl;
+  } else if(remap == spectral) {
+    idfx::cout << "Fargo: cell-centered fields remapped in place by exact spectral shifts."
+               << std::endl;
+  } else {
+    idfx::cout << "Fargo: cell-centered fields remapped in place." << std::endl;
   }
   idfx::popRegion();
 }
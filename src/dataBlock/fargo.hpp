@@ -16,6 +16,7 @@
 
 #include "physics.hpp"
 #include "slopeLimiter.hpp"
+#include "fft.hpp"
 
 // Forward class hydro declaration
 template <typename Phys> class Fluid;
@@ -29,6 +30,7 @@ using FargoVelocityFunc = void (*) (DataBlock &, IdefixArray2D<real> &);
 class Fargo {
  public:
   enum FargoType {none, userdef, shearingbox};
+  enum FargoRemap {flux, spectral};
   Fargo(Input &, int, DataBlock*);  // Initialisation
   void ShiftSolution(const real t, const real dt);  // Effectively shift the solution
   void SubstractVelocity(const real);
@@ -50,17 +52,21 @@ class Fargo {
   template <typename Phys>
   void StoreToScratch(Fluid<Phys>*);
 
+  template <typename Phys>
+  void ShiftPencils(const real dt, Fluid<Phys>* );
+
   void GetFargoVelocity(real);
 
   IdefixArray2D<real> meanVelocity;
   FargoType type{none};                 // By default, Fargo is disabled
+  FargoRemap remap{flux};               // Remap of the cell-centered fields
 
  private:
   friend Hydro;
   DataBlock *data;
 
-  IdefixArray4D<real> scrhUc;
-  IdefixArray4D<real> scrhVs;
+  IdefixArray4D<accum> scrhUc;
+  IdefixArray4D<accum> scrhVs;
 
 #ifdef WITH_MPI
   Mpi mpi;                      // Fargo-specific MPI layer
@@ -75,6 +81,10 @@ class Fargo {
   bool velocityHasBeenComputed{false};
   bool haveDomainDecomposition{false};
 
+  real dphi{0};                         //< uniform azimuthal spacing (spectral remap)
+  FftRadices radix;                     //< FFT factorisation of the azimuthal lines
+  IdefixArray1D<FftComplex> twiddle;    //< FFT twiddle factors of the azimuthal lines
+
   FargoVelocityFunc fargoVelocityFunc{NULL};  // The user-defined fargo velocity function
 };
 
@@ -86,8 +96,40 @@ class Fargo {
   #endif
 #endif
 
+// Azimuthal lines of a pencil held in team scratch, line after line for each transverse cell.
+// They hold the conservative state, hence in accum precision
+using FargoScratch = Kokkos::View<accum**, Kokkos::LayoutRight,
+                                  Kokkos::DefaultExecutionSpace::scratch_memory_space,
+                                  Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+using FargoScratchComplex = Kokkos::View<FftComplex**, Kokkos::LayoutRight,
+                                  Kokkos::DefaultExecutionSpace::scratch_memory_space,
+                                  Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+
 #ifdef HIGH_ORDER_FARGO
-KOKKOS_INLINE_FUNCTION real FargoFlux(const IdefixArray4D<real> &Vin, int n, int k, int j, int i,
+// Flux across the right interface of the cell q0 for a shift eps
+KOKKOS_INLINE_FUNCTION real FargoFlux(real qm2, real qm1, real q0, real qp1, real qp2,
+                                      real eps) {
+  real qp, qm;
+  SlopeLimiter<>::getPPMStates(qm2,qm1,q0,qp1,qp2, qm, qp);
+
+  real dqp = qp-q0;
+  real dqm = qm-q0;
+
+  real dqc = dqp - dqm;
+  real d2q = dqp + dqm;
+
+  real F;
+  if(eps > 0.0) {
+    F = eps*(qp - 0.5*eps*(dqc + d2q*(3.0 - 2.0*eps)));
+  } else {
+    F = eps*(qm - 0.5*eps*(dqc - d2q*(3.0 + 2.0*eps)));
+  }
+
+  return(F);
+}
+
+template <typename T>
+KOKKOS_INLINE_FUNCTION real FargoFlux(const IdefixArray4D<T> &Vin, int n, int k, int j, int i,
                                       int so, int ds, int sbeg, real eps,
                                       bool haveDomainDecomposition) {
   // compute shifted indices, taking into account the fact that we're periodic
@@ -116,27 +158,38 @@ KOKKOS_INLINE_FUNCTION real FargoFlux(const IdefixArray4D<real> &Vin, int n, int
     qp2 = Vin(n,sop2,j,i);
   #endif
 
-  real qp, qm;
-  SlopeLimiter<>::getPPMStates(qm2,qm1,q0,qp1,qp2, qm, qp);
+  return(FargoFlux(qm2, qm1, q0, qp1, qp2, eps));
+}
 
-  real dqp = qp-q0;
-  real dqm = qm-q0;
+// Same, for the periodic line l of a pencil held in scratch
+KOKKOS_INLINE_FUNCTION real FargoFlux(const FargoScratch &Q, int l, int so, int ds, real eps) {
+  int sop1 = so+1;
+  if(sop1 >= ds) sop1 = sop1-ds;
+  int sop2 = sop1+1;
+  if(sop2 >= ds) sop2 = sop2-ds;
 
-  real dqc = dqp - dqm;
-  real d2q = dqp + dqm;
+  int som1 = so-1;
+  if(som1 < 0) som1 = som1+ds;
+  int som2 = som1-1;
+  if(som2 < 0) som2 = som2+ds;
 
-  real F;
-  if(eps > 0.0) {
-    F = eps*(qp - 0.5*eps*(dqc + d2q*(3.0 - 2.0*eps)));
-  } else {
-    F = eps*(qm - 0.5*eps*(dqc - d2q*(3.0 + 2.0*eps)));
-  }
+  return(FargoFlux(Q(som2,l), Q(som1,l), Q(so,l), Q(sop1,l), Q(sop2,l), eps));
+}
 
+#else// HIGH_ORDER_FARGO
+// Flux across the right interface of the cell V0 for a shift eps
+KOKKOS_INLINE_FUNCTION real FargoFlux(real Vm1, real V0, real Vp1, real eps) {
+  int sign = (eps>=0) ? 1 : -1;
+  real F, dqm, dqp, dq;
+  dqm = V0 - Vm1;
+  dqp = Vp1 - V0;
+  dq = (dqp*dqm > ZERO_F ? TWO_F*dqp*dqm/(dqp + dqm) : ZERO_F);
+  F = eps*(V0 + sign*0.5*dq*(1.0-sign*eps));
   return(F);
 }
 
-#else// HIGH_ORDER_FARGO
-KOKKOS_INLINE_FUNCTION real FargoFlux(const IdefixArray4D<real> &Vin, int n, int k, int j, int i,
+template <typename T>
+KOKKOS_INLINE_FUNCTION real FargoFlux(const IdefixArray4D<T> &Vin, int n, int k, int j, int i,
                                       int so, int ds, int sbeg, real eps,
                                       bool haveDomainDecomposition) {
   // compute shifted indices, taking into account the fact that we're periodic
@@ -144,20 +197,22 @@ KOKKOS_INLINE_FUNCTION real FargoFlux(const IdefixArray4D<real> &Vin, int n, int
   if(!haveDomainDecomposition && (sop1-sbeg >= ds)) sop1 = sop1-ds;
   int som1 = so-1;
   if(!haveDomainDecomposition && (som1-sbeg< 0 )) som1 = som1+ds;
-  int sign = (eps>=0) ? 1 : -1;
-  real F, dqm, dqp, dq, V0;
   #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
-    V0 = Vin(n,k,so,i);
-    dqm = V0 - Vin(n,k,som1,i);
-    dqp = Vin(n,k,sop1,i) - V0;
+    return(FargoFlux(Vin(n,k,som1,i), Vin(n,k,so,i), Vin(n,k,sop1,i), eps));
   #elif GEOMETRY == SPHERICAL
-    V0 = Vin(n,so,j,i);
-    dqm = V0 - Vin(n,som1,j,i);
-    dqp = Vin(n,sop1,j,i) - V0;
+    return(FargoFlux(Vin(n,som1,j,i), Vin(n,so,j,i), Vin(n,sop1,j,i), eps));
+  #else
+    return(ZERO_F);
   #endif
-    dq = (dqp*dqm > ZERO_F ? TWO_F*dqp*dqm/(dqp + dqm) : ZERO_F);
-    F = eps*(V0 + sign*0.5*dq*(1.0-sign*eps));
-  return(F);
+}
+
+// Same, for the periodic line l of a pencil held in scratch
+KOKKOS_INLINE_FUNCTION real FargoFlux(const FargoScratch &Q, int l, int so, int ds, real eps) {
+  int sop1 = so+1;
+  if(sop1 >= ds) sop1 = sop1-ds;
+  int som1 = so-1;
+  if(som1 < 0) som1 = som1+ds;
+  return(FargoFlux(Q(som1,l), Q(so,l), Q(sop1,l), eps));
 }
 
 #endif // HIGH_ORDER_FARGO
@@ -242,27 +297,26 @@ void Fargo::SubstractVelocityFluid(const real t, Fluid<Phys>* hydro) {
 
 template<typename Phys>
 void Fargo::StoreToScratch(Fluid<Phys>* hydro) {
-  IdefixArray4D<real> Uc = hydro->Uc;
-  IdefixArray4D<real> scrhUc = this->scrhUc;
+  IdefixArray4D<accum> Uc = hydro->Uc;
+  IdefixArray4D<accum> scrhUc = this->scrhUc;
   bool haveDomainDecomposition = this->haveDomainDecomposition;
   int maxShift = this->maxShift;
 
-  idefix_for("Fargo:StoreUc",
-            0,Phys::nvar+hydro->nTracer,
-            data->beg[KDIR],data->end[KDIR],
-            data->beg[JDIR],data->end[JDIR],
-            data->beg[IDIR],data->end[IDIR],
-            KOKKOS_LAMBDA(int n, int k, int j, int i) {
-              if(!haveDomainDecomposition) {
-                scrhUc(n,k,j,i) = Uc(n,k,j,i);
-              } else {
+  // Without domain decomposition, Uc is remapped in place by ShiftPencils
+  if(haveDomainDecomposition) {
+    idefix_for("Fargo:StoreUc",
+              0,Phys::nvar+hydro->nTracer,
+              data->beg[KDIR],data->end[KDIR],
+              data->beg[JDIR],data->end[JDIR],
+              data->beg[IDIR],data->end[IDIR],
+              KOKKOS_LAMBDA(int n, int k, int j, int i) {
                 #if GEOMETRY==POLAR || GEOMETRY==CARTESIAN
                   scrhUc(n,k,j+maxShift,i) = Uc(n,k,j,i);
                 #elif GEOMETRY == SPHERICAL
                   scrhUc(n,k+maxShift,j,i) = Uc(n,k,j,i);
                 #endif
-              }
-            });
+              });
+  }
 
   if constexpr(Phys::mhd) {
     #ifdef EVOLVE_VECTOR_POTENTIAL
@@ -272,8 +326,8 @@ void Fargo::StoreToScratch(Fluid<Phys>* hydro) {
     // in MHD mode, we need to copy Vs only when there is domain decomposition, otherwise,
     // we just make a reference (this is already done by init)
     if(haveDomainDecomposition) {
-      IdefixArray4D<real> Vs = hydro->Vs;
-      IdefixArray4D<real> scrhVs = this->scrhVs;
+      IdefixArray4D<accum> Vs = hydro->Vs;
+      IdefixArray4D<accum> scrhVs = this->scrhVs;
       idefix_for("Fargo:StoreVs",
               0,DIMENSIONS,
               data->beg[KDIR],data->end[KDIR]+KOFFSET,
@@ -299,6 +353,194 @@ void Fargo::StoreToScratch(Fluid<Phys>* hydro) {
   #endif
 }
 
+// Remap of the cell-centered fields when the azimuthal direction is not decomposed: each team
+// loads a pencil of complete azimuthal lines in scratch memory, and writes the shifted lines
+// back in place, so that no copy of the full arrays is needed.
+template<typename Phys>
+void Fargo::ShiftPencils(const real dt, Fluid<Phys>* hydro) {
+  idfx::pushRegion("Fargo::ShiftPencils");
+  IdefixArray4D<accum> Uc = hydro->Uc;
+  IdefixArray2D<real> meanV = this->meanVelocity;
+  IdefixArray1D<real> x1 = data->x[IDIR];
+  IdefixArray1D<real> dx2 = data->dx[JDIR];
+  IdefixArray1D<real> dx3 = data->dx[KDIR];
+  IdefixArray1D<real> sinx2 = data->sinx2;
+  [[maybe_unused]] FargoType fargoType = type;
+  [[maybe_unused]] real sbS = hydro->sbS;
+
+  // s is the azimuthal index, t the other transverse index
+  real Lphi;
+  int sbeg, send, tbeg, tend;
+  #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
+    Lphi = data->mygrid->xend[JDIR] - data->mygrid->xbeg[JDIR];
+    sbeg = data->beg[JDIR];
+    send = data->end[JDIR];
+    tbeg = data->beg[KDIR];
+    tend = data->end[KDIR];
+  #elif GEOMETRY == SPHERICAL
+    Lphi = data->mygrid->xend[KDIR] - data->mygrid->xbeg[KDIR];
+    sbeg = data->beg[KDIR];
+    send = data->end[KDIR];
+    tbeg = data->beg[JDIR];
+    tend = data->end[JDIR];
+  #else
+    Lphi = 1.0;   // Do nothing, but initialize this.
+    sbeg = send = tbeg = tend = 0;
+  #endif
+
+  const int ds = send-sbeg;
+  const int nt = tend-tbeg;
+  const int ibeg = data->beg[IDIR];
+  const int iend = data->end[IDIR];
+  // Each pencil holds nl consecutive lines along X1
+  constexpr int nl = KOKKOS_VECTOR_LENGTH;
+  const int nPencils = (iend-ibeg+nl-1)/nl;
+  const int league = (Phys::nvar+hydro->nTracer)*nt*nPencils;
+
+  if(remap == flux) {
+    const size_t scratchSize = FargoScratch::shmem_size(ds, nl);
+    const int scratchLevel = (scratchSize <= team_policy::scratch_size_max(0)) ? 0 : 1;
+
+    Kokkos::parallel_for("Fargo:ShiftPencils",
+      team_policy(league, Kokkos::AUTO, KOKKOS_VECTOR_LENGTH)
+        .set_scratch_size(scratchLevel, Kokkos::PerTeam(scratchSize)),
+      KOKKOS_LAMBDA (member_type team) {
+        FargoScratch Q(team.team_scratch(scratchLevel), ds, nl);
+        const int n = team.league_rank() / (nt*nPencils);
+        const int t = tbeg + (team.league_rank() / nPencils) % nt;
+        const int i0 = ibeg + (team.league_rank() % nPencils) * nl;
+        const int nc = (iend-i0 < nl) ? iend-i0 : nl;
+
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(team, ds*nc), [&] (const int c) {
+          #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
+            Q(c/nc,c%nc) = Uc(n,t,sbeg+c/nc,i0+c%nc);
+          #elif GEOMETRY == SPHERICAL
+            Q(c/nc,c%nc) = Uc(n,sbeg+c/nc,t,i0+c%nc);
+          #endif
+        });
+        team.team_barrier();
+
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(team, ds*nc), [&] (const int c) {
+          const int s = c/nc;
+          const int l = c%nc;
+          const int i = i0+l;
+          real w,dphi;
+          #if GEOMETRY == CARTESIAN
+            if(fargoType==userdef) {
+              w = meanV(t,i);
+            } else if(fargoType==shearingbox) {
+              w = sbS*x1(i);
+            }
+            dphi = dx2(sbeg+s);
+          #elif GEOMETRY == POLAR
+            w = meanV(t,i)/x1(i);
+            dphi = dx2(sbeg+s);
+          #elif GEOMETRY == SPHERICAL
+            w = meanV(t,i)/(x1(i)*sinx2(t));
+            dphi = dx3(sbeg+s);
+          #else
+            w = ZERO_F;
+            dphi = ONE_F;
+          #endif
+
+          // Compute the offset in phi, modulo the full domain size
+          real dL = std::fmod(w*dt, Lphi);
+
+          // Translate this into # of cells
+          int m = static_cast<int> (std::floor(dL/dphi+HALF_F));
+
+          // get the remainding shift
+          real eps = dL/dphi - m;
+
+          // so is the "origin" index in the periodic line
+          int so = modPositive(s-m, ds);
+
+          real Fl,Fr;
+          if(eps>=ZERO_F) {
+            Fl = FargoFlux(Q, l, (so > 0) ? so-1 : ds-1, ds, eps);
+            Fr = FargoFlux(Q, l, so, ds, eps);
+          } else {
+            Fl = FargoFlux(Q, l, so, ds, eps);
+            Fr = FargoFlux(Q, l, (so < ds-1) ? so+1 : 0, ds, eps);
+          }
+
+          #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
+            Uc(n,t,sbeg+s,i) = Q(so,l) - (Fr - Fl);
+          #elif GEOMETRY == SPHERICAL
+            Uc(n,sbeg+s,t,i) = Q(so,l) - (Fr - Fl);
+          #endif
+        });
+      });
+  } else {
+    // Exact shift of the band-limited interpolant of each line: the Fourier modes are
+    // multiplied by exp(-2 i pi k delta/ds), delta being the (fractional) shift in cells.
+    IdefixArray1D<FftComplex> twiddle = this->twiddle;
+    const FftRadices radix = this->radix;
+    const real dphi = this->dphi;
+    const size_t scratchSize = 2*FargoScratchComplex::shmem_size(ds, nl);
+    const int scratchLevel = (scratchSize <= team_policy::scratch_size_max(0)) ? 0 : 1;
+
+    Kokkos::parallel_for("Fargo:ShiftPencilsSpectral",
+      team_policy(league, Kokkos::AUTO, KOKKOS_VECTOR_LENGTH)
+        .set_scratch_size(scratchLevel, Kokkos::PerTeam(scratchSize)),
+      KOKKOS_LAMBDA (member_type team) {
+        FargoScratchComplex X(team.team_scratch(scratchLevel), ds, nl);
+        FargoScratchComplex Y(team.team_scratch(scratchLevel), ds, nl);
+        const int n = team.league_rank() / (nt*nPencils);
+        const int t = tbeg + (team.league_rank() / nPencils) % nt;
+        const int i0 = ibeg + (team.league_rank() % nPencils) * nl;
+        const int nc = (iend-i0 < nl) ? iend-i0 : nl;
+
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(team, ds*nc), [&] (const int c) {
+          #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
+            X(c/nc,c%nc) = FftComplex(Uc(n,t,sbeg+c/nc,i0+c%nc), ZERO_F);
+          #elif GEOMETRY == SPHERICAL
+            X(c/nc,c%nc) = FftComplex(Uc(n,sbeg+c/nc,t,i0+c%nc), ZERO_F);
+          #endif
+        });
+        team.team_barrier();
+
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(team, nc), [&] (const int l) {
+          const int i = i0+l;
+          real w;
+          #if GEOMETRY == CARTESIAN
+            if(fargoType==userdef) {
+              w = meanV(t,i);
+            } else if(fargoType==shearingbox) {
+              w = sbS*x1(i);
+            }
+          #elif GEOMETRY == POLAR
+            w = meanV(t,i)/x1(i);
+          #elif GEOMETRY == SPHERICAL
+            w = meanV(t,i)/(x1(i)*sinx2(t));
+          #else
+            w = ZERO_F;
+          #endif
+          const real delta = std::fmod(w*dt, Lphi)/dphi;
+
+          FftTransform(X.data()+l, Y.data()+l, nl, ds, radix, twiddle, -1);
+          for(int k = 0 ; k < ds ; k++) {
+            // signed wavenumber. The Nyquist mode is made symmetric by taking the real part
+            const int kk = (2*k <= ds) ? k : k-ds;
+            const real phi = -2.0*M_PI*kk*delta/ds;
+            X(k,l) *= FftComplex(cos(phi), sin(phi));
+          }
+          FftTransform(X.data()+l, Y.data()+l, nl, ds, radix, twiddle, 1);
+        });
+        team.team_barrier();
+
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(team, ds*nc), [&] (const int c) {
+          #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
+            Uc(n,t,sbeg+c/nc,i0+c%nc) = X(c/nc,c%nc).real()/ds;
+          #elif GEOMETRY == SPHERICAL
+            Uc(n,sbeg+c/nc,t,i0+c%nc) = X(c/nc,c%nc).real()/ds;
+          #endif
+        });
+      });
+  }
+  idfx::popRegion();
+}
+
 template<typename Phys>
 void Fargo::ShiftFluid(const real t, const real dt, Fluid<Phys>* hydro) {
   idfx::pushRegion("Fargo::ShiftFluid");
@@ -321,8 +563,8 @@ void Fargo::ShiftFluid(const real t, const real dt, Fluid<Phys>* hydro) {
     IDEFIX_ERROR(message);
   }
 
-  IdefixArray4D<real> Uc = hydro->Uc;
-  IdefixArray4D<real> scrh = this->scrhUc;
+  IdefixArray4D<accum> Uc = hydro->Uc;
+  IdefixArray4D<accum> scrh = this->scrhUc;
   IdefixArray2D<real> meanV = this->meanVelocity;
   IdefixArray1D<real> x1 = data->x[IDIR];
   IdefixArray1D<real> x2 = data->x[JDIR];
@@ -352,80 +594,84 @@ void Fargo::ShiftFluid(const real t, const real dt, Fluid<Phys>* hydro) {
   // move Uc to scratch, and fill the ghost zones if required.
   StoreToScratch(hydro);
 
-  idefix_for("Fargo:ShiftVc",
-              0,Phys::nvar+hydro->nTracer,
-              data->beg[KDIR],data->end[KDIR],
-              data->beg[JDIR],data->end[JDIR],
-              data->beg[IDIR],data->end[IDIR],
-              KOKKOS_LAMBDA(int n, int k, int j, int i) {
-                real w,dphi;
-                int s;
-                #if GEOMETRY == CARTESIAN
-                 if(fargoType==userdef) {
-                  w = meanV(k,i);
-                 } else if(fargoType==shearingbox) {
-                  w = sbS*x1(i);
-                 }
-                 dphi = dx2(j);
-                 s = j;
-                #elif GEOMETRY == POLAR
-                 w = meanV(k,i)/x1(i);
-                 dphi = dx2(j);
-                 s = j;
-                #elif GEOMETRY == SPHERICAL
-                 w = meanV(j,i)/(x1(i)*sinx2(j));
-                 dphi = dx3(k);
-                 s = k;
-                #endif
+  if(!haveDomainDecomposition) {
+    ShiftPencils(dt, hydro);
+  } else {
+    idefix_for("Fargo:ShiftVc",
+                0,Phys::nvar+hydro->nTracer,
+                data->beg[KDIR],data->end[KDIR],
+                data->beg[JDIR],data->end[JDIR],
+                data->beg[IDIR],data->end[IDIR],
+                KOKKOS_LAMBDA(int n, int k, int j, int i) {
+                  real w,dphi;
+                  int s;
+                  #if GEOMETRY == CARTESIAN
+                   if(fargoType==userdef) {
+                    w = meanV(k,i);
+                   } else if(fargoType==shearingbox) {
+                    w = sbS*x1(i);
+                   }
+                   dphi = dx2(j);
+                   s = j;
+                  #elif GEOMETRY == POLAR
+                   w = meanV(k,i)/x1(i);
+                   dphi = dx2(j);
+                   s = j;
+                  #elif GEOMETRY == SPHERICAL
+                   w = meanV(j,i)/(x1(i)*sinx2(j));
+                   dphi = dx3(k);
+                   s = k;
+                  #endif
 
-                // Compute the offset in phi, modulo the full domain size
-                real dL = std::fmod(w*dt, Lphi);
-
-                // Translate this into # of cells
-                int m = static_cast<int> (std::floor(dL/dphi+HALF_F));
-
-                // get the remainding shift
-                real eps = dL/dphi - m;
-
-                // origin index before the shift
-                // Note the trick to get a positive module i%%n = (i%n + n)%n;
-                int ds = send-sbeg;
-
-                // so is the "origin" index
-                int so;
-                if(haveDomainDecomposition) {
-                  so = s-m + maxShift;    // maxshift corresponds to the offset between
-                                          // the indices in scrh and in Uc
-                } else {
-                  so = sbeg + modPositive(s-m-sbeg, ds);
-                }
-
-                // Define Left and right fluxes
-                // Fluxes are defined from slope-limited interpolation
-                // Using Van-leer slope limiter (consistently with the main advection scheme)
-                real Fl,Fr;
-
-                if(eps>=ZERO_F) {
-                  int som1 = so-1;
-                  if(!haveDomainDecomposition && som1-sbeg< 0 ) som1 = som1+ds;
-                  Fl = FargoFlux(scrh, n, k, j, i, som1, ds, sbeg, eps, haveDomainDecomposition);
-                  Fr = FargoFlux(scrh, n, k, j, i, so, ds, sbeg, eps, haveDomainDecomposition);
-                } else {
-                  int sop1 = so+1;
-                  if(!haveDomainDecomposition && sop1-sbeg >= ds) sop1 = sop1-ds;
-                  Fl = FargoFlux(scrh, n, k, j, i, so, ds, sbeg, eps, haveDomainDecomposition);
-                  Fr = FargoFlux(scrh, n, k, j, i, sop1, ds, sbeg, eps, haveDomainDecomposition);
-                }
+                  // Compute the offset in phi, modulo the full domain size
+                  real dL = std::fmod(w*dt, Lphi);
 
-                #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
-                  Uc(n,k,s,i) = scrh(n,k,so,i) - (Fr - Fl);
-                #elif GEOMETRY == SPHERICAL
-                  Uc(n,s,j,i) = scrh(n,so,j,i) - (Fr - Fl);
-                #endif
-              });
+                  // Translate this into # of cells
+                  int m = static_cast<int> (std::floor(dL/dphi+HALF_F));
+
+                  // get the remainding shift
+                  real eps = dL/dphi - m;
+
+                  // origin index before the shift
+                  // Note the trick to get a positive module i%%n = (i%n + n)%n;
+                  int ds = send-sbeg;
+
+                  // so is the "origin" index
+                  int so;
+                  if(haveDomainDecomposition) {
+                    so = s-m + maxShift;    // maxshift corresponds to the offset between
+                                            // the indices in scrh and in Uc
+                  } else {
+                    so = sbeg + modPositive(s-m-sbeg, ds);
+                  }
+
+                  // Define Left and right fluxes
+                  // Fluxes are defined from slope-limited interpolation
+                  // Using Van-leer slope limiter (consistently with the main advection scheme)
+                  real Fl,Fr;
+
+                  if(eps>=ZERO_F) {
+                    int som1 = so-1;
+                    if(!haveDomainDecomposition && som1-sbeg< 0 ) som1 = som1+ds;
+                    Fl = FargoFlux(scrh, n, k, j, i, som1, ds, sbeg, eps, haveDomainDecomposition);
+                    Fr = FargoFlux(scrh, n, k, j, i, so, ds, sbeg, eps, haveDomainDecomposition);
+                  } else {
+                    int sop1 = so+1;
+                    if(!haveDomainDecomposition && sop1-sbeg >= ds) sop1 = sop1-ds;
+                    Fl = FargoFlux(scrh, n, k, j, i, so, ds, sbeg, eps, haveDomainDecomposition);
+                    Fr = FargoFlux(scrh, n, k, j, i, sop1, ds, sbeg, eps, haveDomainDecomposition);
+                  }
+
+                  #if GEOMETRY == CARTESIAN || GEOMETRY == POLAR
+                    Uc(n,k,s,i) = scrh(n,k,so,i) - (Fr - Fl);
+                  #elif GEOMETRY == SPHERICAL
+                    Uc(n,s,j,i) = scrh(n,so,j,i) - (Fr - Fl);
+                  #endif
+                });
+  }
 
   if constexpr(Phys::mhd) {
-    IdefixArray4D<real> scrhVs = this->scrhVs;
+    IdefixArray4D<accum> scrhVs = this->scrhVs;
     IdefixArray3D<real> ex = hydro->emf->Ex1;
     IdefixArray3D<real> ey = hydro->emf->Ex2;
     IdefixArray3D<real> ez = hydro->emf->Ex3;
@@ -698,7 +944,7 @@ void Fargo::ShiftFluid(const real t, const real dt, Fluid<Phys>* hydro) {
 
     // Update field components according to the computed EMFS
     #ifndef EVOLVE_VECTOR_POTENTIAL
-      IdefixArray4D<real> Vs = hydro->Vs;
+      IdefixArray4D<accum> Vs = hydro->Vs;
       idefix_for("Fargo::EvolvMagField",
                 data->beg[KDIR],data->end[KDIR]+KOFFSET,
                 data->beg[JDIR],data->end[JDIR]+JOFFSET,
@@ -741,7 +987,7 @@ void Fargo::ShiftFluid(const real t, const real dt, Fluid<Phys>* hydro) {
 
     #else // EVOLVE_VECTOR_POTENTIAL
       // evolve field using vector potential
-      IdefixArray4D<real> Ve = hydro->Ve;
+      IdefixArray4D<accum> Ve = hydro->Ve;
       idefix_for("Fargo::EvolvMagField",
                 data->beg[KDIR],data->end[KDIR]+KOFFSET,
                 data->beg[JDIR],data->end[JDIR]+JOFFSET,
@@ -0,0 +1,425 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "idefix.hpp"
+#include "localTimeStepping.hpp"
+#include "dataBlock.hpp"
+#include "fluid.hpp"
+
+LocalTimeStepping::LocalTimeStepping(Input &input, DataBlock *data) {
+  idfx::pushRegion("LocalTimeStepping::LocalTimeStepping");
+  this->data = data;
+
+  nlevels = input.Get<int>("TimeIntegrator","lts_levels",0);
+  if(nlevels < 1 || nlevels > 16) {
+    IDEFIX_ERROR("[TimeIntegrator]:lts_levels should be between 1 and 16");
+  }
+  nsub = 1 << (nlevels-1);
+
+  const int nx = data->mygrid->np_int[IDIR];
+  nbands = input.GetOrSet<int>("TimeIntegrator","lts_bands",0, std::min(nx, 8));
+  if(nbands < 1 || nbands > nx) {
+    IDEFIX_ERROR("[TimeIntegrator]:lts_bands should be between 1 and the number of cells in X1");
+  }
+  // The ghost cells of a band should only belong to its neighbours
+  if(nx/nbands < data->nghost[IDIR]) {
+    IDEFIX_ERROR("[TimeIntegrator]:lts_bands is too large, the bands should be at least as wide "
+                 "as the ghost zones");
+  }
+
+  // Check that all of the modules integrated by EvolveStage are compatible with a restriction
+  // of the active domain along X1
+  if constexpr(DefaultPhysics::mhd) {
+    IDEFIX_ERROR("Local time stepping is not compatible with MHD");
+  }
+  if(data->haveDust) {
+    IDEFIX_ERROR("Local time stepping is not compatible with dust fluids");
+  }
+  if(data->haveFargo) {
+    IDEFIX_ERROR("Local time stepping is not compatible with Fargo");
+  }
+  if(data->haveGridCoarsening) {
+    IDEFIX_ERROR("Local time stepping is not compatible with grid coarsening");
+  }
+  if(data->hydro->haveRKLParabolicTerms) {
+    IDEFIX_ERROR("Local time stepping is not compatible with RKL parabolic terms");
+  }
+  if(data->hydro->haveFusedSweep) {
+    IDEFIX_ERROR("Local time stepping is not compatible with fusedSweep and mpiOverlap");
+  }
+
+  // Bands of (nearly) equal number of cells
+  bandBeg.resize(nbands+1);
+  for(int b = 0 ; b <= nbands ; b++) {
+    bandBeg[b] = data->nghost[IDIR] + (b*nx)/nbands;
+  }
+
+  // The levels are unknown until the first cycle has been integrated, and are all set to the
+  // finest one. Each band is then advanced with dt/2^(nlevels-1), which is stable for the
+  // time step of the previous cycle, as for a restart.
+  level.assign(nbands, nlevels-1);
+  nextLevel = level;
+  dtBand.assign(nbands, std::numeric_limits<real>::max());
+
+  range = {data->beg[IDIR], data->end[IDIR]};
+  bound = {data->lbound[IDIR], data->rbound[IDIR]};
+  offset = data->beg[IDIR] - data->gbeg[IDIR];
+
+  const int nvar = data->hydro->FluxRiemann.extent(0);
+  const int ng = data->nghost[IDIR];
+  for(int b = 0 ; b < nbands-1 ; b++) {
+    registers.push_back(IdefixArray3D<accum>("LTS_Register", nvar,
+                                             data->np_tot[KDIR], data->np_tot[JDIR]));
+    coarseVc.push_back(IdefixArray4D<real>("LTS_CoarseVc", data->hydro->Vc.extent(0),
+                                           data->np_tot[KDIR], data->np_tot[JDIR], ng));
+  }
+  coarseT.assign(nbands-1, 0);
+  coarseDt.assign(nbands-1, 0);
+  for(int side = 0 ; side < 2 ; side++) {
+    ghostSave[side] = IdefixArray4D<real>("LTS_GhostSave", data->hydro->Vc.extent(0),
+                                          data->np_tot[KDIR], data->np_tot[JDIR], ng);
+  }
+  ghostBeg = {-1, -1};
+
+  #ifdef WITH_MPI
+  int remainDims[3] = {true, false, false};
+  MPI_SAFE_CALL(MPI_Cart_sub(data->mygrid->CartComm, remainDims, &comm));
+  #endif
+
+  idfx::popRegion();
+}
+
+void LocalTimeStepping::ShowConfig() {
+  idfx::cout << "LocalTimeStepping: ENABLED with " << nlevels << " levels and " << nbands
+             << " bands along X1." << std::endl;
+}
+
+void LocalTimeStepping::SetScheme(const std::vector<real> &dtFactor,
+                                  const std::vector<real> &stageTime,
+                                  const std::vector<real> &stageWeight) {
+  this->dtFactor = dtFactor;
+  this->stageTime = stageTime;
+  this->stageWeight = stageWeight;
+}
+
+void LocalTimeStepping::BeginCycle(real t) {
+  tCycle = t;
+  dtCycle = data->dt;
+  level = nextLevel;
+  dtBand.assign(nbands, std::numeric_limits<real>::max());
+
+  // A level begins a step every nsub/2^level substeps. The coarse levels are advanced first, so
+  // that the fine ones can interpolate their ghost cells at the end of the coarse step.
+  passes.clear();
+  for(int s = 0 ; s < nsub ; s++) {
+    for(int l = 0 ; l < nlevels ; l++) {
+      if(s % (nsub >> l) != 0) continue;
+      if(std::find(level.begin(), level.end(), l) == level.end()) continue;
+      passes.push_back({s, l});
+    }
+  }
+}
+
+real LocalTimeStepping::BeginPass(int p) {
+  pass = p;
+  const Pass &ps = passes[p];
+  tPass = tCycle + ps.substep*(dtCycle/nsub);
+  dtPass = dtCycle / (1 << ps.level);
+
+  segments.clear();
+  for(int b = 0 ; b < nbands ; b++) {
+    if(level[b] != ps.level) continue;
+    if(b > 0 && level[b-1] == ps.level) {
+      segments.back().iend = LocalIndex(bandBeg[b+1]);
+    } else {
+      segments.push_back({LocalIndex(bandBeg[b]), LocalIndex(bandBeg[b+1])});
+    }
+  }
+
+  // Only keep the part of the segments which belongs to this process
+  std::vector<Segment> local;
+  for(auto seg : segments) {
+    seg.ibeg = std::max(seg.ibeg, range[0]);
+    seg.iend = std::min(seg.iend, range[1]);
+    if(seg.ibeg < seg.iend) local.push_back(seg);
+  }
+  segments = local;
+  return(tPass);
+}
+
+void LocalTimeStepping::EvolveStage(int stage) {
+  idfx::pushRegion("LocalTimeStepping::EvolveStage");
+  if(stage == 0) StoreCoarseSides();
+  const real t = data->t;
+  data->t = tPass + stageTime[stage]*dtPass;
+  fluxWeight = stageWeight[stage]*dtPass;
+  for(const auto &seg : segments) {
+    current = &seg;
+    InterpolateGhosts(seg, data->t);
+    Restrict(seg);
+    data->EvolveStage(dtFactor[stage]*dtPass);
+    Release();
+    RestoreGhosts();
+  }
+  current = nullptr;
+  data->t = t;
+  idfx::popRegion();
+}
+
+void LocalTimeStepping::EndPass() {
+  // The interfaces are synchronised once all of the levels of the substep have been advanced
+  const int s = passes[pass].substep;
+  if(pass+1 == GetNPasses() || passes[pass+1].substep != s) Synchronise(s+1);
+}
+
+void LocalTimeStepping::StoreCoarseSides() {
+  IdefixArray4D<real> Vc = data->hydro->Vc;
+  const int nvar = Vc.extent(0);
+  const int ng = data->nghost[IDIR];
+  const int passLevel = passes[pass].level;
+
+  for(int n = 0 ; n < nbands-1 ; n++) {
+    if(level[n] == level[n+1]) continue;
+    if(std::min(level[n], level[n+1]) != passLevel) continue;
+    // Only needed when the first cell of the fine side belongs to this process
+    const int f = LocalIndex(bandBeg[n+1]);
+    const int ifine = (level[n] < level[n+1]) ? f : f-1;
+    if(ifine < range[0] || ifine >= range[1]) continue;
+
+    const int ibeg = (level[n] < level[n+1]) ? f-ng : f;
+    IdefixArray4D<real> store = coarseVc[n];
+    idefix_for("LTS_StoreCoarseSides",
+               0, nvar,
+               0, data->np_tot[KDIR],
+               0, data->np_tot[JDIR],
+               0, ng,
+      KOKKOS_LAMBDA (int nv, int k, int j, int i) {
+        store(nv,k,j,i) = Vc(nv,k,j,ibeg+i);
+      });
+    coarseT[n] = tPass;
+    coarseDt[n] = dtPass;
+  }
+}
+
+void LocalTimeStepping::InterpolateGhosts(const Segment &seg, real t) {
+  IdefixArray4D<real> Vc = data->hydro->Vc;
+  const int nvar = Vc.extent(0);
+  const int ng = data->nghost[IDIR];
+  const int passLevel = passes[pass].level;
+
+  for(int n = 0 ; n < nbands-1 ; n++) {
+    if(level[n] == level[n+1]) continue;
+    if(std::min(level[n], level[n+1]) >= passLevel) continue;
+    // The coarser neighbour has already completed its step, and its cells are brought back to
+    // the time of the stage
+    const int f = LocalIndex(bandBeg[n+1]);
+    int side;
+    if(level[n] < level[n+1] && seg.ibeg == f) {
+      side = 0;
+    } else if(level[n] > level[n+1] && seg.iend == f) {
+      side = 1;
+    } else {
+      continue;
+    }
+    const int ibeg = (side == 0) ? f-ng : f;
+    const real theta = (t - coarseT[n]) / coarseDt[n];
+    IdefixArray4D<real> store = coarseVc[n];
+    IdefixArray4D<real> save = ghostSave[side];
+    idefix_for("LTS_InterpolateGhosts",
+               0, nvar,
+               0, data->np_tot[KDIR],
+               0, data->np_tot[JDIR],
+               0, ng,
+      KOKKOS_LAMBDA (int nv, int k, int j, int i) {
+        const real q = Vc(nv,k,j,ibeg+i);
+        save(nv,k,j,i) = q;
+        Vc(nv,k,j,ibeg+i) = store(nv,k,j,i) + theta*(q - store(nv,k,j,i));
+      });
+    ghostBeg[side] = ibeg;
+  }
+}
+
+void LocalTimeStepping::RestoreGhosts() {
+  IdefixArray4D<real> Vc = data->hydro->Vc;
+  const int nvar = Vc.extent(0);
+  const int ng = data->nghost[IDIR];
+  for(int side = 0 ; side < 2 ; side++) {
+    if(ghostBeg[side] < 0) continue;
+    const int ibeg = ghostBeg[side];
+    IdefixArray4D<real> save = ghostSave[side];
+    idefix_for("LTS_RestoreGhosts",
+               0, nvar,
+               0, data->np_tot[KDIR],
+               0, data->np_tot[JDIR],
+               0, ng,
+      KOKKOS_LAMBDA (int nv, int k, int j, int i) {
+        Vc(nv,k,j,ibeg+i) = save(nv,k,j,i);
+      });
+    ghostBeg[side] = -1;
+  }
+}
+
+void LocalTimeStepping::Restrict(const Segment &seg) {
+  // The cells of the neighbouring bands act as ghost cells, which are not updated
+  data->beg[IDIR] = seg.ibeg;
+  data->end[IDIR] = seg.iend;
+  data->lbound[IDIR] = (seg.ibeg == range[0]) ? bound[0] : internal;
+  data->rbound[IDIR] = (seg.iend == range[1]) ? bound[1] : internal;
+}
+
+void LocalTimeStepping::Release() {
+  data->beg[IDIR] = range[0];
+  data->end[IDIR] = range[1];
+  data->lbound[IDIR] = bound[0];
+  data->rbound[IDIR] = bound[1];
+}
+
+void LocalTimeStepping::AccumulateFlux(const IdefixArray4D<real> &flux) {
+  if(current == nullptr) return;
+  idfx::pushRegion("LocalTimeStepping::AccumulateFlux");
+  const int nvar = flux.extent(0);
+  for(int n = 0 ; n < nbands-1 ; n++) {
+    if(level[n] == level[n+1]) continue;
+    const int f = LocalIndex(bandBeg[n+1]);
+    if(f < current->ibeg || f > current->iend) continue;
+    // Interfaces between levels are always at the edge of a segment
+    real w = 0;
+    if(f-1 >= current->ibeg) w += fluxWeight;    // flux applied to the left band
+    if(f < current->iend) w -= fluxWeight;       // flux applied to the right band
+    if(w == 0) continue;
+
+    IdefixArray3D<accum> reg = registers[n];
+    IdefixArray4D<real> Flux = flux;
+    idefix_for("LTS_AccumulateFlux",
+               0, nvar,
+               data->beg[KDIR], data->end[KDIR],
+               data->beg[JDIR], data->end[JDIR],
+      KOKKOS_LAMBDA (int nv, int k, int j) {
+        reg(nv,k,j) += w*Flux(nv,k,j,f);
+      });
+  }
+  idfx::popRegion();
+}
+
+void LocalTimeStepping::Synchronise(int s) {
+  idfx::pushRegion("LocalTimeStepping::Synchronise");
+  IdefixArray4D<accum> Uc = data->hydro->Uc;
+  IdefixArray3D<real> dV = data->dV;
+  [[maybe_unused]] IdefixArray1D<real> x1 = data->x[IDIR];
+  const int nvar = data->hydro->FluxRiemann.extent(0);
+
+  for(int n = 0 ; n < nbands-1 ; n++) {
+    if(level[n] == level[n+1]) continue;
+    // Both sides are synchronised once the coarsest one has completed its step
+    const int coarse = std::min(level[n], level[n+1]);
+    if(s % (nsub >> coarse) != 0) continue;
+
+    IdefixArray3D<accum> reg = registers[n];
+    #ifdef WITH_MPI
+    if(data->mygrid->nproc[IDIR] > 1) {
+      // The fluxes of each side may have been accumulated by different processes
+      Kokkos::fence();
+      MPI_SAFE_CALL(MPI_Allreduce(MPI_IN_PLACE, reg.data(), reg.size(), accumMPI, MPI_SUM,
+                                 comm));
+    }
+    #endif
+
+    // The coarse cell receives the fluxes of the fine side instead of its own ones
+    const int f = LocalIndex(bandBeg[n+1]);
+    const int ic = (level[n] < level[n+1]) ? f-1 : f;
+    if(ic >= range[0] && ic < range[1]) {
+      idefix_for("LTS_Synchronise",
+                 0, nvar,
+                 data->beg[KDIR], data->end[KDIR],
+                 data->beg[JDIR], data->end[JDIR],
+        KOKKOS_LAMBDA (int nv, int k, int j) {
+          accum dU = reg(nv,k,j) / dV(k,j,ic);
+          #if GEOMETRY != CARTESIAN
+            #ifdef iMPHI
+              // The angular momentum flux is multiplied by the radius
+              if(nv == iMPHI) dU = dU / x1(ic);
+            #endif
+          #endif
+          Uc(nv,k,j,ic) += dU;
+        });
+    }
+    Kokkos::deep_copy(reg, ZERO_F);
+  }
+  idfx::popRegion();
+}
+
+void LocalTimeStepping::MeasureTimestep() {
+  // Every level is advanced during the first substep, InvDt holding the signal speeds of the
+  // first stage of each band
+  if(passes[pass].substep != 0) return;
+  idfx::pushRegion("LocalTimeStepping::MeasureTimestep");
+  IdefixArray3D<real> InvDt = data->hydro->InvDt;
+
+  for(int b = 0 ; b < nbands ; b++) {
+    if(level[b] != passes[pass].level) continue;
+    const int ibeg = std::max(range[0], LocalIndex(bandBeg[b]));
+    const int iend = std::min(range[1], LocalIndex(bandBeg[b+1]));
+    if(ibeg >= iend) continue;
+    idefix_reduce("LTS_Timestep",
+                  data->beg[KDIR], data->end[KDIR],
+                  data->beg[JDIR], data->end[JDIR],
+                  ibeg, iend,
+                  KOKKOS_LAMBDA (int k, int j, int i, real &dtmin) {
+                    dtmin = FMIN(ONE_F/InvDt(k,j,i),dtmin);
+                  },
+                  Kokkos::Min<real>(dtBand[b]));
+  }
+  idfx::popRegion();
+}
+
+real LocalTimeStepping::ComputeTimestep(real cfl) {
+  idfx::pushRegion("LocalTimeStepping::ComputeTimestep");
+  #ifdef WITH_MPI
+  MPI_SAFE_CALL(MPI_Allreduce(MPI_IN_PLACE, dtBand.data(), nbands, realMPI, MPI_MIN,
+                              MPI_COMM_WORLD));
+  #endif
+
+  // Each band is subcycled by the power of two that brings its time step closest to (but not
+  // above) the largest one
+  const real dtMax = *std::max_element(dtBand.begin(), dtBand.end());
+  for(int b = 0 ; b < nbands ; b++) {
+    int l = 0;
+    while(l < nlevels-1 && dtBand[b]*(2 << l) <= dtMax) l++;
+    nextLevel[b] = l;
+  }
+  // Neighbouring bands differ by one level at most. The first and last bands are neighbours
+  // in a periodic domain, and are kept at the same level since their interface has no register.
+  const bool periodicX1 = data->mygrid->lbound[IDIR] == periodic
+                          || data->mygrid->lbound[IDIR] == shearingbox;
+  bool changed = true;
+  while(changed) {
+    changed = false;
+    for(int b = 0 ; b < nbands ; b++) {
+      int l = nextLevel[b];
+      if(b > 0) l = std::max(l, nextLevel[b-1]-1);
+      if(b < nbands-1) l = std::max(l, nextLevel[b+1]-1);
+      if(periodicX1 && (b == 0 || b == nbands-1)) {
+        l = std::max(l, nextLevel[nbands-1-b]);
+      }
+      if(l != nextLevel[b]) {
+        nextLevel[b] = l;
+        changed = true;
+      }
+    }
+  }
+
+  real dt = std::numeric_limits<real>::max();
+  for(int b = 0 ; b < nbands ; b++) {
+    dt = std::min(dt, cfl*dtBand[b]*(1 << nextLevel[b]));
+  }
+  idfx::popRegion();
+  return(dt);
+}
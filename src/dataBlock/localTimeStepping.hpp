@@ -0,0 +1,128 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef DATABLOCK_LOCALTIMESTEPPING_HPP_
+#define DATABLOCK_LOCALTIMESTEPPING_HPP_
+
+#include <array>
+#include <vector>
+#include "idefix.hpp"
+#include "input.hpp"
+#ifdef WITH_MPI
+  #include "mpi.hpp"
+#endif
+
+class DataBlock;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+/// Local time stepping along the first direction (radius in spherical geometry). The domain is
+/// split into radial bands, and each band is advanced with its own time step dt/2^level, where
+/// dt is the time step of a cycle and level is chosen from the signal speeds stored in InvDt.
+/// A cycle is made of 2^(nlevels-1) substeps of the finest level. At each substep, the levels
+/// which begin a step are advanced one after the other, from the coarsest to the finest one,
+/// each pass integrating all of the stages of the scheme over the step of its level. A fine band
+/// therefore sees its coarser neighbour at the end of the neighbour's step, and its ghost cells
+/// are interpolated in time between the values stored at the beginning of that step and these
+/// ones. A coarse band sees its finer neighbour frozen at the beginning of its own step. The
+/// fluxes through the interfaces between bands of different levels are accumulated in registers,
+/// and the coarse side of each interface is corrected with the fluxes of the fine side once both
+/// are synchronised, so that the scheme remains conservative.
+//////////////////////////////////////////////////////////////////////////////////////////////////
+class LocalTimeStepping {
+ public:
+  LocalTimeStepping(Input &, DataBlock *);
+  void ShowConfig();
+
+  // Set the time integration scheme: time step factor of each stage, time of each stage and
+  // weight of each stage in the complete step (both in units of the step)
+  void SetScheme(const std::vector<real> &, const std::vector<real> &, const std::vector<real> &);
+
+  int GetNPasses() const { return(static_cast<int>(passes.size())); }
+  real GetPassDt() const { return(dtPass); }
+  void BeginCycle(real);                   // Start a cycle at a given time
+  real BeginPass(int);                     // Start a pass, return its time
+  void EvolveStage(int);                   // Evolve the bands of the pass by one stage
+  void MeasureTimestep();                  // Find the time step of the bands of the pass
+  void EndPass();                          // Correct the interfaces which are synchronised
+
+  // Add the fluxes of the first direction to the registers (called by the hydro)
+  void AccumulateFlux(const IdefixArray4D<real> &);
+
+  // Compute the levels and the time step of the next cycle from the time steps measured during
+  // the first substep, given the CFL factor
+  real ComputeTimestep(real);
+
+ private:
+  // Levels which begin a step at a given substep
+  struct Pass {
+    int substep;
+    int level;
+  };
+
+  // A contiguous range of bands of the level of the pass
+  struct Segment {
+    int ibeg;    // local indices of the first cell and last cell+1
+    int iend;
+  };
+
+  DataBlock *data;
+
+  int nlevels;
+  int nbands;
+  int nsub;                              // number of substeps per cycle (2^(nlevels-1))
+  std::vector<int> bandBeg;              // global index of the first cell of each band (+end)
+  std::vector<int> level;                // current level of each band
+  std::vector<int> nextLevel;            // level of each band in the next cycle
+  std::vector<real> dtBand;              // largest time step allowed in each band
+
+  std::vector<real> dtFactor;            // scheme description
+  std::vector<real> stageTime;
+  std::vector<real> stageWeight;
+
+  real tCycle;                           // time and time step of the cycle
+  real dtCycle;
+  std::vector<Pass> passes;              // passes of the current cycle
+  int pass{0};
+  real tPass{0};                         // time and time step of the current pass
+  real dtPass{0};
+  std::vector<Segment> segments;         // segments of the current pass
+  const Segment *current{nullptr};       // segment being integrated
+  real fluxWeight{0};                    // weight of the current fluxes in the registers
+
+  // Primitive variables of the coarse side of each interface at the beginning of its step, with
+  // the time and time step of that step
+  std::vector<IdefixArray4D<real>> coarseVc;
+  std::vector<real> coarseT;
+  std::vector<real> coarseDt;
+  // Ghost cells of the current segment replaced by interpolated values, on each side (first
+  // cell, or -1 if none)
+  std::array<IdefixArray4D<real>,2> ghostSave;
+  std::array<int,2> ghostBeg;
+
+  // Registers of the interfaces between band b and b+1: sum of the weighted fluxes applied by
+  // the left band minus those applied by the right band
+  std::vector<IdefixArray3D<accum>> registers;
+
+  // Active domain and boundaries of the datablock along the first direction
+  std::array<int,2> range;
+  std::array<BoundaryType,2> bound;
+  int offset;                            // local index - global index
+
+  void Restrict(const Segment &);        // Restrict the active domain of the datablock
+  void Release();                        // Restore the active domain of the datablock
+  void StoreCoarseSides();               // Store the coarse sides which begin a step
+  void InterpolateGhosts(const Segment &, real);  // Interpolate the coarser ghost cells
+  void RestoreGhosts();
+  void Synchronise(int);                 // Correct the interfaces synchronised before a substep
+  int LocalIndex(int g) const { return(g + offset); }
+
+  #ifdef WITH_MPI
+  MPI_Comm comm;                         // processes along the first direction
+  #endif
+};
+
+#endif // DATABLOCK_LOCALTIMESTEPPING_HPP_
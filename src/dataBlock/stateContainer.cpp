@@ -45,10 +45,10 @@ void StateContainer::AllocateAs(StateContainer &in) {
 
     if(stateIn.type == State::idefixArray4D) {
       // But then reinit the array
-      stateOut.array = IdefixArray4D<real>(stateIn.name, stateIn.array.extent(0),
-                                                              stateIn.array.extent(1),
-                                                              stateIn.array.extent(2),
-                                                              stateIn.array.extent(3));
+      stateOut.array = IdefixArray4D<accum>(stateIn.name, stateIn.array.extent(0),
+                                                               stateIn.array.extent(1),
+                                                               stateIn.array.extent(2),
+                                                               stateIn.array.extent(3));
     } else {
       IDEFIX_ERROR("Cannot allocate a state with type none");
     }
@@ -58,7 +58,7 @@ void StateContainer::AllocateAs(StateContainer &in) {
   idfx::popRegion();
 }
 
-void StateContainer::PushArray(IdefixArray4D<real>& in,
+void StateContainer::PushArray(IdefixArray4D<accum>& in,
                                State::TypeLocation loc,
                                std::string name) {
   idfx::pushRegion("StateContainer::PushArray");
@@ -72,7 +72,7 @@ void StateContainer::PushArray(IdefixArray4D<real>& in,
 }
 
 
-void StateContainer::AddAndStore(const real wl, const real wr, StateContainer & in) {
+void StateContainer::AddAndStore(const accum wl, const accum wr, StateContainer & in) {
   idfx::pushRegion("StateContainer::AddAndStore");
 
   if(in.stateVector.size() != this->stateVector.size()) {
@@ -18,7 +18,7 @@ class State{
   enum TypeState{none, idefixArray4D};
 
   TypeState type{none};           ///< type of data contained by this state
-  IdefixArray4D<real> array;      ///< only defined if type==IdefixArray4D
+  IdefixArray4D<accum> array;     ///< only defined if type==IdefixArray4D
   TypeLocation location{undefined};    ///< location of array when type==IdefixArray4D
                                        ///< (otherwise undefined)
   std::string name;               ///< Name of the full state (always applicable)
@@ -29,8 +29,8 @@ class StateContainer {
   StateContainer();
   void CopyFrom(StateContainer &);    // Return a deepcopy of the current state container
   void AllocateAs(StateContainer &);    // Return a deepcopy of the current state container
-  void PushArray(IdefixArray4D<real> &, State::TypeLocation, std::string);
-  void AddAndStore(const real, const real, StateContainer&);
+  void PushArray(IdefixArray4D<accum> &, State::TypeLocation, std::string);
+  void AddAndStore(const accum, const accum, StateContainer&);
 
 
  private:
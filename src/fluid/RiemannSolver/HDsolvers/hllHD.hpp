@@ -14,104 +14,117 @@
 #include "flux.hpp"
 #include "convertConsToPrim.hpp"
 
+// Compute the Riemann flux at the left interface of cell (k,j,i) using HLL solver
+template <typename Phys, int DIR>
+struct RiemannSolver_HllHDFunctor {
+  //*****************************************************************
+  // Functor constructor
+  //*****************************************************************
+  explicit RiemannSolver_HllHDFunctor(RiemannSolver<Phys> *rSolver):
+      eos{*(rSolver->hydro->eos.get())},
+      extrapol{*rSolver->template GetExtrapolator<DIR>()} {}
+
+  //*****************************************************************
+  // Functor Variables
+  //*****************************************************************
+  EquationOfState eos;
+  ExtrapolateToFaces<Phys,DIR> extrapol;
+
+  //*****************************************************************
+  // Functor Operator
+  //*****************************************************************
+  KOKKOS_INLINE_FUNCTION void operator() (const int k, const int j, const int i,
+                                          real Flux[Phys::nvar], real &cmax) const {
+    // Primitive variables
+    real vL[Phys::nvar];
+    real vR[Phys::nvar];
+
+    // 1-- Store the primitive variables on the left, right, and averaged states
+    extrapol.ExtrapolatePrimVar(i, j, k, vL, vR);
+
+    Solve(k, j, i, vL, vR, Flux, cmax);
+  }
+
+  // Riemann flux from the left and right states of the interface, extrapolated by extrapol
+  KOKKOS_INLINE_FUNCTION void Solve(const int k, const int j, const int i,
+                                    real vL[Phys::nvar], real vR[Phys::nvar],
+                                    real Flux[Phys::nvar], real &cmax) const {
+    constexpr int ioffset = (DIR==IDIR) ? 1 : 0;
+    constexpr int joffset = (DIR==JDIR) ? 1 : 0;
+    constexpr int koffset = (DIR==KDIR) ? 1 : 0;
+
+    // Init the directions (should be in the kernel for proper optimisation by the compilers)
+    constexpr int Xn = DIR+MX1;
+
+    // Conservative variables
+    real uL[Phys::nvar];
+    real uR[Phys::nvar];
+
+    // Flux (left and right)
+    real fluxL[Phys::nvar];
+    real fluxR[Phys::nvar];
+
+    // Signal speeds
+    real cL, cR;
+
+    // 2-- Get the wave speed
+    #if HAVE_ENERGY
+      cL = std::sqrt(eos.GetGamma(vL[PRS],vL[RHO])*(vL[PRS]/vL[RHO]));
+      cR = std::sqrt(eos.GetGamma(vR[PRS],vR[RHO])*(vR[PRS]/vR[RHO]));
+    #else
+      cL = HALF_F*(eos.GetWaveSpeed(k,j,i)
+                  +eos.GetWaveSpeed(k-koffset,j-joffset,i-ioffset));
+      cR = cL;
+    #endif
+
+    // 4.1
+    real cminL = vL[Xn] - cL;
+    real cmaxL = vL[Xn] + cL;
+
+    real cminR = vR[Xn] - cR;
+    real cmaxR = vR[Xn] + cR;
+
+    real SL = FMIN(cminL, cminR);
+    real SR = FMAX(cmaxL, cmaxR);
+
+    cmax  = FMAX(FABS(SL), FABS(SR));
+
+    // 2-- Compute the conservative variables: do this by extrapolation
+    K_PrimToCons<Phys>(uL, vL, &eos);
+    K_PrimToCons<Phys>(uR, vR, &eos);
+
+    // 3-- Compute the left and right fluxes
+    K_Flux<Phys,DIR>(fluxL, vL, uL, cL*cL);
+    K_Flux<Phys,DIR>(fluxR, vR, uR, cR*cR);
+
+    // 5-- Compute the flux from the left and right states
+    if (SL > 0) {
+#pragma unroll
+      for (int nv = 0 ; nv < Phys::nvar; nv++) {
+        Flux[nv] = fluxL[nv];
+      }
+    } else if (SR < 0) {
+#pragma unroll
+      for (int nv = 0 ; nv < Phys::nvar; nv++) {
+        Flux[nv] = fluxR[nv];
+      }
+    } else {
+#pragma unroll
+      for(int nv = 0 ; nv < Phys::nvar; nv++) {
+        Flux[nv] = SL*SR*uR[nv] - SL*SR*uL[nv] + SR*fluxL[nv] - SL*fluxR[nv];
+        Flux[nv] /= (SR - SL);
+      }
+    }
+  }
+};
+
 // Compute Riemann fluxes from states using HLL solver
 template <typename Phys>
 template<const int DIR>
 void RiemannSolver<Phys>::HllHD(IdefixArray4D<real> &Flux) {
   idfx::pushRegion("RiemannSolver::HLL_Solver");
 
-  constexpr int ioffset = (DIR==IDIR) ? 1 : 0;
-  constexpr int joffset = (DIR==JDIR) ? 1 : 0;
-  constexpr int koffset = (DIR==KDIR) ? 1 : 0;
-
-  IdefixArray4D<real> Vc = this->Vc;
-  IdefixArray4D<real> Vs = this->Vs;
-  IdefixArray3D<real> cMax = this->cMax;
-  EquationOfState eos = *(hydro->eos.get());
-
-  // Required for high order interpolations
-  IdefixArray1D<real> dx = this->data->dx[DIR];
-
-  ExtrapolateToFaces<Phys,DIR> extrapol = *this->GetExtrapolator<DIR>();
-  idefix_for("HLL_Kernel",
-             data->beg[KDIR],data->end[KDIR]+koffset,
-             data->beg[JDIR],data->end[JDIR]+joffset,
-             data->beg[IDIR],data->end[IDIR]+ioffset,
-    KOKKOS_LAMBDA (int k, int j, int i) {
-      // Init the directions (should be in the kernel for proper optimisation by the compilers)
-      constexpr int Xn = DIR+MX1;
-
-      // Primitive variables
-      real vL[Phys::nvar];
-      real vR[Phys::nvar];
-
-      // Conservative variables
-      real uL[Phys::nvar];
-      real uR[Phys::nvar];
-
-      // Flux (left and right)
-      real fluxL[Phys::nvar];
-      real fluxR[Phys::nvar];
-
-      // Signal speeds
-      real cL, cR, cmax;
-
-      // 1-- Store the primitive variables on the left, right, and averaged states
-      extrapol.ExtrapolatePrimVar(i, j, k, vL, vR);
-
-      // 2-- Get the wave speed
-      #if HAVE_ENERGY
-        cL = std::sqrt(eos.GetGamma(vL[PRS],vL[RHO])*(vL[PRS]/vL[RHO]));
-        cR = std::sqrt(eos.GetGamma(vR[PRS],vR[RHO])*(vR[PRS]/vR[RHO]));
-      #else
-        cL = HALF_F*(eos.GetWaveSpeed(k,j,i)
-                    +eos.GetWaveSpeed(k-koffset,j-joffset,i-ioffset));
-        cR = cL;
-      #endif
-
-      // 4.1
-      real cminL = vL[Xn] - cL;
-      real cmaxL = vL[Xn] + cL;
-
-      real cminR = vR[Xn] - cR;
-      real cmaxR = vR[Xn] + cR;
-
-      real SL = FMIN(cminL, cminR);
-      real SR = FMAX(cmaxL, cmaxR);
-
-      cmax  = FMAX(FABS(SL), FABS(SR));
-
-      // 2-- Compute the conservative variables: do this by extrapolation
-      K_PrimToCons<Phys>(uL, vL, &eos);
-      K_PrimToCons<Phys>(uR, vR, &eos);
-
-      // 3-- Compute the left and right fluxes
-      K_Flux<Phys,DIR>(fluxL, vL, uL, cL*cL);
-      K_Flux<Phys,DIR>(fluxR, vR, uR, cR*cR);
-
-      // 5-- Compute the flux from the left and right states
-      if (SL > 0) {
-#pragma unroll
-        for (int nv = 0 ; nv < Phys::nvar; nv++) {
-          Flux(nv,k,j,i) = fluxL[nv];
-        }
-      } else if (SR < 0) {
-#pragma unroll
-        for (int nv = 0 ; nv < Phys::nvar; nv++) {
-          Flux(nv,k,j,i) = fluxR[nv];
-        }
-      } else {
-#pragma unroll
-        for(int nv = 0 ; nv < Phys::nvar; nv++) {
-          Flux(nv,k,j,i) = SL*SR*uR[nv] - SL*SR*uL[nv] + SR*fluxL[nv] - SL*fluxR[nv];
-          Flux(nv,k,j,i) /= (SR - SL);
-        }
-      }
-
-      //6-- Compute maximum wave speed for this sweep
-      cMax(k,j,i) = cmax;
-    }
-  );
+  CalcFluxPencil<DIR>("HLL_Kernel", RiemannSolver_HllHDFunctor<Phys,DIR>(this), Flux);
 
   idfx::popRegion();
 }
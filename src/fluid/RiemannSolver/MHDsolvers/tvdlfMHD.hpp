@@ -41,7 +41,7 @@ void RiemannSolver<Phys>::TvdlfMHD(IdefixArray4D<real> &Flux) {
   #endif
 
   IdefixArray4D<real> Vc = this->Vc;
-  IdefixArray4D<real> Vs = this->Vs;
+  IdefixArray4D<accum> Vs = this->Vs;
   IdefixArray3D<real> cMax = this->cMax;
 
   // Required for high order interpolations
@@ -15,6 +15,7 @@
 #include "tvdlfMHD.hpp"
 #endif
 
+#include "calcFluxPencil.hpp"
 #include "hllcHD.hpp"
 #include "hllHD.hpp"
 #include "tvdlfHD.hpp"
@@ -0,0 +1,149 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef FLUID_RIEMANNSOLVER_CALCFLUXPENCIL_HPP_
+#define FLUID_RIEMANNSOLVER_CALCFLUXPENCIL_HPP_
+
+#include <algorithm>
+#include <string>
+#include "fluid.hpp"
+#include "dataBlock.hpp"
+
+// Number of interfaces along the sweep direction handled by a single team for the JDIR and KDIR
+// sweeps, and number of cells along IDIR of the lines of these tiles.
+constexpr int calcFluxTile = 8;
+constexpr int calcFluxTileI = 64;
+
+// Compute the intercell fluxes along dir with the Riemann solver functor solver.
+// The reconstruction and the Riemann problem are instantiated together for each solver, limiter
+// and order. Each team first copies the part of Vc it needs (a pencil of cells along dir, with
+// the ghost cells of the reconstruction stencil) in scratch memory, so that each value of Vc is
+// read once instead of once per interface using it.
+// When keepFlux is set, the solver starts from the flux already stored in Flux.
+template <typename Phys>
+template <int dir, typename Solver>
+void RiemannSolver<Phys>::CalcFluxPencil(const std::string &name, Solver solver,
+                                         IdefixArray4D<real> &Flux, bool keepFlux) {
+  using ScratchArray = Kokkos::View<real**, Kokkos::LayoutRight,
+                                    Kokkos::DefaultExecutionSpace::scratch_memory_space,
+                                    Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+
+  constexpr int h = decltype(Solver::extrapol)::stencilHalfWidth;
+
+  IdefixArray4D<real> Vc = this->Vc;
+  IdefixArray3D<real> cMax = this->cMax;
+
+  const int ibeg = data->beg[IDIR];
+  const int jbeg = data->beg[JDIR];
+  const int kbeg = data->beg[KDIR];
+  const int ni = data->end[IDIR] - ibeg;
+  const int nj = data->end[JDIR] - jbeg;
+  const int nk = data->end[KDIR] - kbeg;
+  const int sbeg = data->beg[dir];
+
+  // A team treats the interfaces of one line along IDIR, or a tile of ntile rows of interfaces
+  // along dir made of nl cells along IDIR.
+  const int nFacesDir = data->end[dir] - sbeg + 1;
+  const int ntile = (dir == IDIR) ? nFacesDir : std::min(calcFluxTile, nFacesDir);
+  const int nTilesDir = (nFacesDir + ntile - 1) / ntile;
+  const int nl = (dir == IDIR) ? 1 : std::min(calcFluxTileI, ni);
+  const int nTilesI = (ni + nl - 1) / nl;
+
+  const int league = (dir == IDIR) ? nk*nj : ((dir == JDIR) ? nk : nj)*nTilesDir*nTilesI;
+
+  // The interfaces s0..s0+ntile-1 use the cells s0-h..s0+ntile+h-2
+  const size_t scratchSize = ScratchArray::shmem_size(Phys::nvar, (ntile+2*h-1)*nl);
+  const int scratchLevel = (scratchSize <= team_policy::scratch_size_max(0)) ? 0 : 1;
+
+  Kokkos::parallel_for(name,
+    team_policy(league, Kokkos::AUTO, KOKKOS_VECTOR_LENGTH)
+      .set_scratch_size(scratchLevel, Kokkos::PerTeam(scratchSize)),
+    KOKKOS_LAMBDA (member_type team) {
+      // Locate the tile of this team. s0 is the first interface of the tile along dir, nf its
+      // number of interfaces along dir, i0 and nli the first cell and number of cells along IDIR
+      int k = kbeg;
+      int j = jbeg;
+      int i0 = ibeg;
+      int s0 = sbeg;
+      int nf = ntile;
+      int nli = 1;
+      if constexpr(dir == IDIR) {
+        k += team.league_rank() / nj;
+        j += team.league_rank() % nj;
+      } else {
+        int r = team.league_rank();
+        const int ti = r % nTilesI;
+        r /= nTilesI;
+        s0 += (r % nTilesDir) * ntile;
+        r /= nTilesDir;
+        if constexpr(dir == JDIR) k += r;
+        if constexpr(dir == KDIR) j += r;
+        i0 += ti*nl;
+        nli = (i0 + nl <= ibeg + ni) ? nl : ibeg + ni - i0;
+        nf = (s0 + ntile <= sbeg + nFacesDir) ? ntile : sbeg + nFacesDir - s0;
+      }
+
+      // Step 1: copy the pencil of cells to scratch memory. W(nv,c*nli+l) is the cell s0-h+c
+      // along dir of line l.
+      ScratchArray W(team.team_scratch(scratchLevel), Phys::nvar, (nf+2*h-1)*nli);
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(team, (nf+2*h-1)*nli), [&] (const int e) {
+        const int c = e / nli;
+        int kc = k;
+        int jc = j;
+        int ic = s0 - h + c;
+        if constexpr(dir != IDIR) {
+          ic = i0 + e - c*nli;
+          if constexpr(dir == JDIR) jc = s0 - h + c;
+          if constexpr(dir == KDIR) kc = s0 - h + c;
+        }
+        for(int nv = 0 ; nv < Phys::nvar ; nv++) {
+          W(nv,e) = Vc(nv,kc,jc,ic);
+        }
+      });
+
+      team.team_barrier();
+
+      // Step 2: reconstruction from the scratch copy and Riemann problem of each interface
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(team, nf*nli), [&] (const int e) {
+        const int f = e / nli;
+        const int l = e - f*nli;
+        int kf = k;
+        int jf = j;
+        int i = s0 + f;
+        if constexpr(dir != IDIR) {
+          i = i0 + l;
+          if constexpr(dir == JDIR) jf = s0 + f;
+          if constexpr(dir == KDIR) kf = s0 + f;
+        }
+        // The interface f lies between the cells f+h-1 and f+h of the pencil
+        auto V = [&] (const int nv, const int o) {
+          return(W(nv,(f+h+o)*nli+l));
+        };
+
+        real vL[Phys::nvar];
+        real vR[Phys::nvar];
+        solver.extrapol.ExtrapolateStencil(V, i, jf, kf, vL, vR);
+
+        real F[Phys::nvar];
+        real cmax;
+        if(keepFlux) {
+          for(int nv = 0 ; nv < Phys::nvar; nv++) {
+            F[nv] = Flux(nv,kf,jf,i);
+          }
+        }
+        solver.Solve(kf, jf, i, vL, vR, F, cmax);
+
+#pragma unroll
+        for(int nv = 0 ; nv < Phys::nvar; nv++) {
+          Flux(nv,kf,jf,i) = F[nv];
+        }
+        cMax(kf,jf,i) = cmax;
+      });
+    });
+}
+
+#endif // FLUID_RIEMANNSOLVER_CALCFLUXPENCIL_HPP_
@@ -27,6 +27,9 @@ class ExtrapolateToFaces {
   using SL = SlopeLimiter<limiter>;
 
  public:
+  // Number of cells on each side of an interface used by the reconstruction
+  static constexpr int stencilHalfWidth = (order == 1) ? 1 : ((order >= 4) ? 3 : 2);
+
   explicit ExtrapolateToFaces(RiemannSolver<Phys> *rSolver):
           Vc(rSolver->hydro->Vc),
           dx(rSolver->hydro->data->dx[dir]),
@@ -38,6 +41,10 @@ class ExtrapolateToFaces {
             if(!isRegularGrid) {
               ComputePLMweights(rSolver->hydro->data);
             }
+            characteristic = rSolver->haveCharacteristic;
+            if(characteristic) {
+              eos = *(rSolver->hydro->eos.get());
+            }
   }
 
   void ComputePLMweights(DataBlock *data) {
@@ -76,23 +83,49 @@ class ExtrapolateToFaces {
                                                     const int j,
                                                     const int k,
                                                     real vL[], real vR[]) const {
+    constexpr int ioffset = (dir==IDIR ? 1 : 0);
+    constexpr int joffset = (dir==JDIR ? 1 : 0);
+    constexpr int koffset = (dir==KDIR ? 1 : 0);
+
+    auto V = [&] (const int nv, const int o) {
+      return(Vc(nv,k+o*koffset,j+o*joffset,i+o*ioffset));
+    };
+    ExtrapolateStencil(V, i, j, k, vL, vR);
+  }
+
+  // Same as ExtrapolatePrimVar, the stencil being read from V(nv,o), the value of the variable
+  // nv in the cell at offset o from cell (k,j,i) along dir, with -stencilHalfWidth <= o
+  // < stencilHalfWidth. This allows the caller to keep the stencil in scratch memory.
+  template<typename Stencil>
+  KOKKOS_FORCEINLINE_FUNCTION void ExtrapolateStencil(const Stencil &V,
+                                                    const int i,
+                                                    const int j,
+                                                    const int k,
+                                                    real vL[], real vR[]) const {
     // 1-- Store the primitive variables on the left, right, and averaged states
     constexpr int ioffset = (dir==IDIR ? 1 : 0);
     constexpr int joffset = (dir==JDIR ? 1 : 0);
     constexpr int koffset = (dir==KDIR ? 1 : 0);
 
+    if constexpr(order == 5) {
+      // vL is reconstructed at the right interface of cell i-1, vR at the left interface of cell i
+      ExtrapolateWenoZ<false>(V, -1, i-ioffset, j-joffset, k-koffset, vL);
+      ExtrapolateWenoZ<true>(V, 0, i, j, k, vR);
+      return;
+    }
+
     for(int nv = 0 ; nv < Phys::nvar ; nv++) {
       if constexpr(order == 1) {
-        vL[nv] = Vc(nv,k-koffset,j-joffset,i-ioffset);
-        vR[nv] = Vc(nv,k,j,i);
+        vL[nv] = V(nv,-1);
+        vR[nv] = V(nv,0);
       } else if constexpr(order == 2) {
         if(isRegularGrid) {
           /////////////////////////////////////
           // Regular Grid, PLM reconstruction
           /////////////////////////////////////
-          real dvm = Vc(nv,k-koffset,j-joffset,i-ioffset)
-                    -Vc(nv,k-2*koffset,j-2*joffset,i-2*ioffset);
-          real dvp = Vc(nv,k,j,i)-Vc(nv,k-koffset,j-joffset,i-ioffset);
+          real dvm = V(nv,-1)
+                    -V(nv,-2);
+          real dvp = V(nv,0)-V(nv,-1);
 
           real dv;
           if(shockFlattening) {
@@ -106,10 +139,10 @@ class ExtrapolateToFaces {
             dv = SL::PLMLim(dvp,dvm);
           }
 
-          vL[nv] = Vc(nv,k-koffset,j-joffset,i-ioffset) + HALF_F*dv;
+          vL[nv] = V(nv,-1) + HALF_F*dv;
 
           dvm = dvp;
-          dvp = Vc(nv,k+koffset,j+joffset,i+ioffset) - Vc(nv,k,j,i);
+          dvp = V(nv,1) - V(nv,0);
 
           if(shockFlattening) {
             if(flags(k,j,i) == FlagShock::Shock) {
@@ -121,16 +154,16 @@ class ExtrapolateToFaces {
             dv = SL::PLMLim(dvp,dvm);
           }
 
-          vR[nv] = Vc(nv,k,j,i) - HALF_F*dv;
+          vR[nv] = V(nv,0) - HALF_F*dv;
         } else {
           /////////////////////////////////////
           // Irregular Grid, PLM reconstruction
           /////////////////////////////////////
           const int index = ioffset*i + joffset*j + koffset*k;
 
-          real dvm = Vc(nv,k-koffset,j-joffset,i-ioffset)
-                    -Vc(nv,k-2*koffset,j-2*joffset,i-2*ioffset);
-          real dvp = Vc(nv,k,j,i)-Vc(nv,k-koffset,j-joffset,i-ioffset);
+          real dvm = V(nv,-1)
+                    -V(nv,-2);
+          real dvp = V(nv,0)-V(nv,-1);
 
           dvm *= wmArray(index-1);
           dvp *= wpArray(index-1);
@@ -149,10 +182,10 @@ class ExtrapolateToFaces {
             dv = SL::PLMLim(dvp,dvm,cp,cm);
           }
 
-          vL[nv] = Vc(nv,k-koffset,j-joffset,i-ioffset) + dpArray(index-1)*dv;
+          vL[nv] = V(nv,-1) + dpArray(index-1)*dv;
 
-          dvm = Vc(nv,k,j,i)-Vc(nv,k-koffset,j-joffset,i-ioffset);
-          dvp = Vc(nv,k+koffset,j+joffset,i+ioffset) - Vc(nv,k,j,i);
+          dvm = V(nv,0)-V(nv,-1);
+          dvp = V(nv,1) - V(nv,0);
           dvm *= wmArray(index);
           dvp *= wpArray(index);
           cp = cpArray(index);
@@ -167,15 +200,15 @@ class ExtrapolateToFaces {
           } else { // No shock flattening
             dv = SL::PLMLim(dvp,dvm,cp,cm);
           }
-          vR[nv] = Vc(nv,k,j,i) - dmArray(index)*dv;
+          vR[nv] = V(nv,0) - dmArray(index)*dv;
         } // Regular grid
 
       } else if constexpr(order == 3) {
           // 1D index along the chosen direction
           const int index = ioffset*i + joffset*j + koffset*k;
-          real dvm = Vc(nv,k-koffset,j-joffset,i-ioffset)
-                    -Vc(nv,k-2*koffset,j-2*joffset,i-2*ioffset);
-          real dvp = Vc(nv,k,j,i)-Vc(nv,k-koffset,j-joffset,i-ioffset);
+          real dvm = V(nv,-1)
+                    -V(nv,-2);
+          real dvp = V(nv,0)-V(nv,-1);
 
           // Limo3 limiter
           real dv;
@@ -190,14 +223,14 @@ class ExtrapolateToFaces {
               dv = dvp * SL::LimO3Lim(dvp, dvm, dx(index-1));
           }
 
-          vL[nv] = Vc(nv,k-koffset,j-joffset,i-ioffset) + HALF_F*dv;
+          vL[nv] = V(nv,-1) + HALF_F*dv;
 
           // Check positivity
           if(nv==RHO) {
             // If face element is negative, revert to minmod
             if(vL[nv] <= 0.0) {
               dv = SL::MinModLim(dvp,dvm);
-              vL[nv] = Vc(nv,k-koffset,j-joffset,i-ioffset) + HALF_F*dv;
+              vL[nv] = V(nv,-1) + HALF_F*dv;
             }
           }
           if constexpr(Phys::pressure) {
@@ -205,13 +238,13 @@ class ExtrapolateToFaces {
               // If face element is negative, revert to minmod
               if(vL[nv] <= 0.0) {
                 dv = SL::MinModLim(dvp,dvm);
-                vL[nv] = Vc(nv,k-koffset,j-joffset,i-ioffset) + HALF_F*dv;
+                vL[nv] = V(nv,-1) + HALF_F*dv;
               }
             }
           }
 
           dvm = dvp;
-          dvp = Vc(nv,k+koffset,j+joffset,i+ioffset) - Vc(nv,k,j,i);
+          dvp = V(nv,1) - V(nv,0);
 
           // Limo3 limiter
           if(shockFlattening) {
@@ -225,14 +258,14 @@ class ExtrapolateToFaces {
             dv = dvm * SL::LimO3Lim(dvm, dvp, dx(index));
           }
 
-          vR[nv] = Vc(nv,k,j,i) - HALF_F*dv;
+          vR[nv] = V(nv,0) - HALF_F*dv;
 
           // Check positivity
           if(nv==RHO) {
             // If face element is negative, revert to vanleer
             if(vR[nv] <= 0.0) {
               dv = SL::MinModLim(dvp,dvm);
-              vR[nv] = Vc(nv,k,j,i) - HALF_F*dv;
+              vR[nv] = V(nv,0) - HALF_F*dv;
             }
           }
           if constexpr(Phys::pressure) {
@@ -240,17 +273,17 @@ class ExtrapolateToFaces {
               // If face element is negative, revert to vanleer
               if(vR[nv] <= 0.0) {
                 dv = SL::MinModLim(dvp,dvm);
-                vR[nv] = Vc(nv,k,j,i) - HALF_F*dv;
+                vR[nv] = V(nv,0) - HALF_F*dv;
               }
             }
           }
       } else if constexpr(order == 4) {
           // Reconstruction in cell i-1
-          real vm2 = Vc(nv,k-3*koffset,j-3*joffset,i-3*ioffset);;
-          real vm1 = Vc(nv,k-2*koffset,j-2*joffset,i-2*ioffset);
-          real v0 = Vc(nv,k-koffset,j-joffset,i-ioffset);
-          real vp1 = Vc(nv,k,j,i);
-          real vp2 = Vc(nv,k+koffset,j+joffset,i+ioffset);
+          real vm2 = V(nv,-3);;
+          real vm1 = V(nv,-2);
+          real v0 = V(nv,-1);
+          real vp1 = V(nv,0);
+          real vp2 = V(nv,1);
 
           real vr,vl;
           SL::getPPMStates(vm2, vm1, v0, vp1, vp2, vl, vr);
@@ -281,7 +314,7 @@ class ExtrapolateToFaces {
           vm1 = v0;
           v0 = vp1;
           vp1 = vp2;
-          vp2 = Vc(nv,k+2*koffset,j+2*joffset,i+2*ioffset);
+          vp2 = V(nv,2);
 
           SL::getPPMStates(vm2, vm1, v0, vp1, vp2, vl, vr);
 
@@ -308,6 +341,103 @@ class ExtrapolateToFaces {
     }
   }
 
+  // WENO-Z reconstruction at the left (left=true) or right interface of the cell at offset c
+  // from the interface, of coordinates (kc,jc,ic). When characteristic is set, the stencil is
+  // projected on the characteristic variables of the HD equations in this cell before the
+  // reconstruction.
+  template<bool left, typename Stencil>
+  KOKKOS_FORCEINLINE_FUNCTION void ExtrapolateWenoZ(const Stencil &V, const int c,
+                                                  const int ic, const int jc, const int kc,
+                                                  real v[]) const {
+    real q[5][Phys::nvar];
+    for(int m = 0 ; m < 5 ; m++) {
+      for(int nv = 0 ; nv < Phys::nvar ; nv++) {
+        q[m][nv] = V(nv, c-2+m);
+      }
+    }
+
+    // Reference state of the characteristic decomposition
+    [[maybe_unused]] real rho, cs;
+    if constexpr(!Phys::mhd && !Phys::dust) {
+      if(characteristic) {
+        rho = q[2][RHO];
+        if constexpr(Phys::pressure) {
+          cs = std::sqrt(eos.GetGamma(q[2][PRS],rho)*(q[2][PRS]/rho));
+        } else {
+          cs = eos.GetWaveSpeed(kc,jc,ic);
+        }
+        for(int m = 0 ; m < 5 ; m++) {
+          ToCharacteristic(rho, cs, q[m]);
+        }
+      }
+    }
+
+    for(int nv = 0 ; nv < Phys::nvar ; nv++) {
+      if constexpr(left) {
+        v[nv] = SL::getWenoZFaceValue(q[4][nv], q[3][nv], q[2][nv], q[1][nv], q[0][nv]);
+      } else {
+        v[nv] = SL::getWenoZFaceValue(q[0][nv], q[1][nv], q[2][nv], q[3][nv], q[4][nv]);
+      }
+    }
+
+    if constexpr(!Phys::mhd && !Phys::dust) {
+      if(characteristic) FromCharacteristic(rho, cs, v);
+    }
+
+    // Revert to minmod in shocks, and to vanleer when the face density or pressure is negative
+    const bool shock = shockFlattening && (flags(kc,jc,ic) == FlagShock::Shock);
+    for(int nv = 0 ; nv < Phys::nvar ; nv++) {
+      bool revert = shock || (nv==RHO && v[nv] <= 0.0);
+      if constexpr(Phys::pressure) {
+        revert = revert || (nv==PRS && v[nv] <= 0.0);
+      }
+      if(revert) {
+        const real dvp = V(nv,c+1) - V(nv,c);
+        const real dvm = V(nv,c) - V(nv,c-1);
+        const real dv = shock ? SL::MinModLim(dvp,dvm) : SL::PLMLim(dvp,dvm);
+        v[nv] = V(nv,c) + (left ? -HALF_F : HALF_F)*dv;
+      }
+    }
+  }
+
+  // Projection of the primitive variables v on the characteristic variables of the HD equations
+  // along dir, linearised around the state of density rho and sound speed cs. The acoustic
+  // waves u-cs and u+cs are stored in place of the normal velocity and of the pressure
+  // (density in the isothermal case), the entropy wave in place of the density.
+  KOKKOS_FORCEINLINE_FUNCTION void ToCharacteristic(const real rho, const real cs,
+                                                  real v[]) const {
+    constexpr int Xn = VX1+dir;
+    if constexpr(Phys::pressure) {
+      const real p = v[PRS]/(cs*cs);
+      const real u = rho/cs*v[Xn];
+      v[RHO] = v[RHO] - p;
+      v[Xn] = HALF_F*(p - u);
+      v[PRS] = HALF_F*(p + u);
+    } else {
+      const real u = rho/cs*v[Xn];
+      v[Xn] = HALF_F*(v[RHO] + u);
+      v[RHO] = HALF_F*(v[RHO] - u);
+    }
+  }
+
+  // Inverse of ToCharacteristic
+  KOKKOS_FORCEINLINE_FUNCTION void FromCharacteristic(const real rho, const real cs,
+                                                    real v[]) const {
+    constexpr int Xn = VX1+dir;
+    if constexpr(Phys::pressure) {
+      const real wm = v[Xn];
+      const real wp = v[PRS];
+      v[RHO] = v[RHO] + wm + wp;
+      v[Xn] = cs/rho*(wp - wm);
+      v[PRS] = cs*cs*(wm + wp);
+    } else {
+      const real wm = v[RHO];
+      const real wp = v[Xn];
+      v[RHO] = wm + wp;
+      v[Xn] = cs/rho*(wp - wm);
+    }
+  }
+
   IdefixArray4D<real> Vc;
   IdefixArray1D<real> dx;
   IdefixArray3D<FlagShock> flags;
@@ -321,6 +451,10 @@ class ExtrapolateToFaces {
 
   bool isRegularGrid{true};
   bool shockFlattening{false};
+
+  // Characteristic WENO-Z reconstruction, using the equation of state of the fluid
+  bool characteristic{false};
+  EquationOfState eos;
 };
 
 
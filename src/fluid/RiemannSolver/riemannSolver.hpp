@@ -58,6 +58,11 @@ class RiemannSolver {
 
   template<const int>
     void HllDust(IdefixArray4D<real> &);
+
+  // Fluxes of a HD Riemann solver functor, reconstructed from a copy of Vc in scratch memory
+  template<int dir, typename Solver>
+    void CalcFluxPencil(const std::string &, Solver, IdefixArray4D<real> &, bool keepFlux = false);
+
   // Get the right slope limiter
   template<int dir>
   ExtrapolateToFaces<Phys, dir>* GetExtrapolator();
@@ -68,8 +73,17 @@ class RiemannSolver {
   template <typename P, int dir, PLMLimiter L, int O>
   friend class ExtrapolateToFaces;
 
+  template <typename P, int dir>
+  friend struct RiemannSolver_HllHDFunctor;
+  template <typename P, int dir>
+  friend struct RiemannSolver_HllcHDFunctor;
+  template <typename P, int dir>
+  friend struct RiemannSolver_RoeHDFunctor;
+  template <typename P, int dir>
+  friend struct RiemannSolver_TvdlfHDFunctor;
+
   IdefixArray4D<real> Vc;
-  IdefixArray4D<real> Vs;
+  IdefixArray4D<accum> Vs;
   IdefixArray4D<real> Flux;
   IdefixArray3D<real> cMax;
   Fluid<Phys>* hydro;
@@ -83,6 +97,7 @@ class RiemannSolver {
   std::unique_ptr<ExtrapolateToFaces<Phys,KDIR>> slopeLimKDIR;
 
   bool haveShockFlattening;
+  bool haveCharacteristic{false};
 };
 
 #include "shockFlattening.hpp"
@@ -158,6 +173,18 @@ RiemannSolver<Phys>::RiemannSolver(Input &input, Fluid<Phys>* hydro) : Vc{hydro-
                               hydro,input.Get<real>(std::string(Phys::prefix),"shockFlattening",0));
   }
 
+  // Characteristic reconstruction
+  if constexpr(!Phys::mhd && !Phys::dust) {
+    haveCharacteristic = input.GetOrSet<bool>(std::string(Phys::prefix),"characteristic",0,false);
+    if(haveCharacteristic && ORDER != 5) {
+      IDEFIX_ERROR("Characteristic reconstruction requires Idefix_RECONSTRUCTION=WenoZ");
+    }
+  } else if constexpr(Phys::mhd) {
+    if(input.CheckEntry(std::string(Phys::prefix),"characteristic")>=0) {
+      IDEFIX_ERROR("Characteristic reconstruction is only implemented for HD fluids");
+    }
+  }
+
   // init slope limiters
   slopeLimIDIR = std::make_unique<ExtrapolateToFaces<Phys,IDIR>>(this);
   #if DIMENSIONS >= 2
@@ -206,6 +233,9 @@ void RiemannSolver<Phys>::ShowConfig() {
   if(haveShockFlattening) {
     idfx::cout << Phys::prefix << ": Shock Flattening ENABLED." << std::endl;
   }
+  if(haveCharacteristic) {
+    idfx::cout << Phys::prefix << ": reconstruction in characteristic variables." << std::endl;
+  }
 }
 
 template <typename Phys>
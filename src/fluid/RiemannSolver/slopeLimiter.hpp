@@ -189,6 +189,37 @@ class SlopeLimiter {
       }
     }
   }
+
+  // Fifth order WENO-Z interpolation of the value at the right interface of cell 0. The value at
+  // the left interface is obtained by reversing the stencil.
+  // BCCD08: Borges, R., Carmona, M., Costa, B. & Don, W. S. An improved weighted essentially
+  //         non-oscillatory scheme for hyperbolic conservation laws. Journal of Computational
+  //         Physics 227, 3191–3211 (2008).
+  KOKKOS_FORCEINLINE_FUNCTION static real getWenoZFaceValue(const real vm2, const real vm1,
+                                                      const real v0, const real vp1,
+                                                      const real vp2) {
+    // Smoothness indicators of the three sub-stencils (BCCD08 eq. 2.9)
+    const real b0 = 13.0/12.0*(vm2-2.0*vm1+v0)*(vm2-2.0*vm1+v0)
+                   + 0.25*(vm2-4.0*vm1+3.0*v0)*(vm2-4.0*vm1+3.0*v0);
+    const real b1 = 13.0/12.0*(vm1-2.0*v0+vp1)*(vm1-2.0*v0+vp1)
+                   + 0.25*(vm1-vp1)*(vm1-vp1);
+    const real b2 = 13.0/12.0*(v0-2.0*vp1+vp2)*(v0-2.0*vp1+vp2)
+                   + 0.25*(3.0*v0-4.0*vp1+vp2)*(3.0*v0-4.0*vp1+vp2);
+
+    // Z weights (BCCD08 eq. 3.4), built on the optimal weights 1/10, 6/10 and 3/10
+    const real tau5 = FABS(b0-b2);
+    const real eps = 1e-30;
+    const real a0 = 0.1*(1.0 + tau5/(b0+eps));
+    const real a1 = 0.6*(1.0 + tau5/(b1+eps));
+    const real a2 = 0.3*(1.0 + tau5/(b2+eps));
+
+    // Third order interpolants of the sub-stencils
+    const real q0 = (2.0*vm2 - 7.0*vm1 + 11.0*v0)/6.0;
+    const real q1 = (-vm1 + 5.0*v0 + 2.0*vp1)/6.0;
+    const real q2 = (2.0*v0 + 5.0*vp1 - vp2)/6.0;
+
+    return((a0*q0 + a1*q1 + a2*q2)/(a0 + a1 + a2));
+  }
 };
 
 #endif // FLUID_RIEMANNSOLVER_SLOPELIMITER_HPP_
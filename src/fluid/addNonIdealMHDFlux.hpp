@@ -22,7 +22,7 @@ void Fluid<Phys>::AddNonIdealMHDFlux(const real t) {
 
     IdefixArray4D<real> Flux = this->FluxRiemann;
     IdefixArray4D<real> Vc   = this->Vc;
-    IdefixArray4D<real> Vs   = this->Vs;
+    IdefixArray4D<accum> Vs   = this->Vs;
     IdefixArray3D<real> dMax = this->dMax;
     IdefixArray4D<real> J    = this->J;
     IdefixArray3D<real> etaArr = this->etaOhmic;
@@ -47,7 +47,7 @@ struct Fluid_AddSourceTermsFunctor {
   //*****************************************************************
   // Functor Variables
   //*****************************************************************
-  IdefixArray4D<real> Uc;
+  IdefixArray4D<accum> Uc;
   IdefixArray4D<real> Vc;
   IdefixArray1D<real> x1;
   IdefixArray1D<real> x2;
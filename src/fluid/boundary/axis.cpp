@@ -85,7 +85,7 @@ void Axis::RegularizeCurrentSide(int side) {
   // Compute the values of Jx, Jy and Jz that are consistent for all cells touching the axis
   #if DIMENSIONS == 3
     IdefixArray4D<real> J = this->J;
-    IdefixArray4D<real> Vs = this->Vs;
+    IdefixArray4D<accum> Vs = this->Vs;
     int js = 0;
     int jc = 0;
     int sign = 0;
@@ -178,7 +178,7 @@ void Axis::RegularizeCurrent() {
 void Axis::FixBx2sAxis(int side) {
   // Compute the values of Bx and By that are consistent with BX2 along the axis
   #if DIMENSIONS == 3
-    IdefixArray4D<real> Vs = this->Vs;
+    IdefixArray4D<accum> Vs = this->Vs;
     IdefixArray2D<real> BAvg = this->BAvg;
     IdefixArray1D<real> phi = data->x[KDIR];
 
@@ -243,7 +243,7 @@ void Axis::FixBx2sAxisGhostAverage(int side) {
   // right-side boundary)
 
   #if DIMENSIONS == 3
-    IdefixArray4D<real> Vs = this->Vs;
+    IdefixArray4D<accum> Vs = this->Vs;
 
     int jaxis = 0;
 
@@ -314,7 +314,7 @@ void Axis::EnforceAxisBoundary(int side) {
   }
 
   if(haveMHD) {
-    IdefixArray4D<real> Vs = this->Vs;
+    IdefixArray4D<accum> Vs = this->Vs;
     IdefixArray1D<int> sVs = this->symmetryVs;
 
     for(int component=0; component<DIMENSIONS; component++) {
@@ -361,7 +361,7 @@ void Axis::EnforceAxisBoundary(int side) {
 void Axis::ReconstructBx2s() {
   idfx::pushRegion("Axis::ReconstructBx2s");
 #if DIMENSIONS >= 2 && MHD == YES
-  IdefixArray4D<real> Vs = this->Vs;
+  IdefixArray4D<accum> Vs = this->Vs;
   IdefixArray3D<real> Ax1=data->A[IDIR];
   IdefixArray3D<real> Ax2=data->A[JDIR];
   IdefixArray3D<real> Ax3=data->A[KDIR];
@@ -444,7 +444,7 @@ void Axis::ExchangeMPI(int side) {
   auto bufferSend = this->bufferSend;
   IdefixArray1D<int> map = this->mapVars;
   IdefixArray4D<real> Vc = this->Vc;
-  IdefixArray4D<real> Vs = this->Vs;
+  IdefixArray4D<accum> Vs = this->Vs;
 
 // If MPI Persistent, start receiving even before the buffers are filled
 
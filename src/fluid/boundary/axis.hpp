@@ -80,7 +80,7 @@ class Axis {
   IdefixArray4D<real> J;
 
   IdefixArray4D<real> Vc;
-  IdefixArray4D<real> Vs;
+  IdefixArray4D<accum> Vs;
 
   DataBlock *data;
 };
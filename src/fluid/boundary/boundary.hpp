@@ -39,8 +39,12 @@ class Boundary {
  public:
   explicit Boundary(Fluid<Phys>*);
   void SetBoundaries(real);                         ///< Set the ghost zones in all directions
+  void SetBoundariesBegin(real);    ///< Set the ghost zones up to the first MPI exchange
+  void SetBoundariesEnd(real);      ///< Complete the ghost zones started by SetBoundariesBegin
+  void EnableMpiExchangeAll();      ///< Exchange with all the MPI neighbours in a single phase
   void EnforceBoundaryDir(real, int);             ///< write in the ghost zone in specific direction
-  void ReconstructVcField(IdefixArray4D<real> &);  ///< reconstruct cell-centered magnetic field
+  template <typename T>
+  void ReconstructVcField(IdefixArray4D<T> &);     ///< reconstruct cell-centered magnetic field
   void ReconstructNormalField(int dir);           ///< reconstruct normal field using divB=0
 
   void EnforceFluxBoundaries(int,real);      ///< Apply boundary condition conditions to the fluxes
@@ -109,9 +113,11 @@ class Boundary {
   IdefixArray4D<real> sBArray;    ///< Array use by shearingbox boundary conditions
 
   IdefixArray4D<real> Vc; ///< reference to cell-centered array that we should sync
-  IdefixArray4D<real> Vs; ///< reference to face-centered array that we should sync
+  IdefixArray4D<accum> Vs; ///< reference to face-centered array that we should sync
   std::unique_ptr<Axis> axis; ///< Axis object, initialised if needed.
   bool haveAxis{false};
+  int pendingDir{DIMENSIONS};  ///< 1st direction left to SetBoundariesEnd by SetBoundariesBegin
+  bool haveMpiExchangeAll{false}; ///< MPI ghost zones are exchanged in a single phase
 
  private:
   friend class Axis;
@@ -235,6 +241,17 @@ void Boundary<Phys>::EnforceFluxBoundaries(int dir,const real t) {
 template<typename Phys>
 void Boundary<Phys>::SetBoundaries(real t) {
   idfx::pushRegion("Boundary::SetBoundaries");
+  SetBoundariesBegin(t);
+  SetBoundariesEnd(t);
+  idfx::popRegion();
+}
+
+// Set the internal boundaries and the ghost zones in all directions up to the first
+// direction requiring an MPI exchange. This exchange is started, but it is completed
+// by SetBoundariesEnd, so that the active cells can be used in the meantime.
+template<typename Phys>
+void Boundary<Phys>::SetBoundariesBegin(real t) {
+  idfx::pushRegion("Boundary::SetBoundariesBegin");
   // set internal boundary conditions
   if(haveInternalBoundary) {
     idfx::pushRegion("Boundary::UserDefInternalBoundary");
@@ -245,21 +262,29 @@ void Boundary<Phys>::SetBoundaries(real t) {
     }
     idfx::popRegion();
   }
+  pendingDir = DIMENSIONS;
   for(int dir=0 ; dir < DIMENSIONS ; dir++ ) {
       // MPI Exchange data when needed
     #ifdef WITH_MPI
     if(data->mygrid->nproc[dir]>1) {
-      switch(dir) {
-        case 0:
-          mpi.ExchangeX1(this->Vc, this->Vs);
-          break;
-        case 1:
-          mpi.ExchangeX2(this->Vc, this->Vs);
-          break;
-        case 2:
-          mpi.ExchangeX3(this->Vc, this->Vs);
-          break;
+      if(haveMpiExchangeAll) {
+        // Exchange the remaining directions at once, including the corners
+        mpi.ExchangeAllBegin(this->Vc, this->Vs);
+      } else {
+        switch(dir) {
+          case 0:
+            mpi.ExchangeX1Begin(this->Vc, this->Vs);
+            break;
+          case 1:
+            mpi.ExchangeX2Begin(this->Vc, this->Vs);
+            break;
+          case 2:
+            mpi.ExchangeX3Begin(this->Vc, this->Vs);
+            break;
+        }
       }
+      pendingDir = dir;
+      break;
     }
     #endif
     EnforceBoundaryDir(t, dir);
@@ -268,6 +293,46 @@ void Boundary<Phys>::SetBoundaries(real t) {
       ReconstructNormalField(dir);
     }
   } // Loop on dimension ends
+  idfx::popRegion();
+}
+
+// Complete the ghost zones, starting from the exchange left pending by SetBoundariesBegin
+template<typename Phys>
+void Boundary<Phys>::SetBoundariesEnd(real t) {
+  idfx::pushRegion("Boundary::SetBoundariesEnd");
+  for(int dir=pendingDir ; dir < DIMENSIONS ; dir++ ) {
+      // MPI Exchange data when needed
+    #ifdef WITH_MPI
+    if(data->mygrid->nproc[dir]>1) {
+      const bool pending = (dir == pendingDir);
+      if(haveMpiExchangeAll) {
+        // The following directions have been exchanged with the pending one
+        if(pending) mpi.ExchangeAllEnd(this->Vc, this->Vs);
+      } else {
+        switch(dir) {
+          case 0:
+            if(pending) mpi.ExchangeX1End(this->Vc, this->Vs);
+            else        mpi.ExchangeX1(this->Vc, this->Vs);
+            break;
+          case 1:
+            if(pending) mpi.ExchangeX2End(this->Vc, this->Vs);
+            else        mpi.ExchangeX2(this->Vc, this->Vs);
+            break;
+          case 2:
+            if(pending) mpi.ExchangeX3End(this->Vc, this->Vs);
+            else        mpi.ExchangeX3(this->Vc, this->Vs);
+            break;
+        }
+      }
+    }
+    #endif
+    EnforceBoundaryDir(t, dir);
+    if constexpr(Phys::mhd) {
+      // Reconstruct the normal field component when using CT
+      ReconstructNormalField(dir);
+    }
+  } // Loop on dimension ends
+  pendingDir = DIMENSIONS;
 
   if constexpr(Phys::mhd) {
     // Remake the cell-centered field.
@@ -278,6 +343,25 @@ void Boundary<Phys>::SetBoundaries(real t) {
 }
 
 
+// Exchange the ghost zones with all of the MPI neighbours (including the diagonal ones) in a
+// single phase. The physical boundary conditions of the decomposed directions are enforced
+// once the exchange is completed, hence over the ghost zones received from the neighbours.
+template<typename Phys>
+void Boundary<Phys>::EnableMpiExchangeAll() {
+  #ifdef WITH_MPI
+  if(haveAxis) {
+    IDEFIX_ERROR("mpiExchangeAll is not compatible with axis boundaries");
+  }
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    if(data->lbound[dir] == shearingbox || data->rbound[dir] == shearingbox) {
+      IDEFIX_ERROR("mpiExchangeAll is not compatible with shearing box boundaries");
+    }
+  }
+  mpi.InitExchangeAll();
+  haveMpiExchangeAll = true;
+  #endif
+}
+
 // Enforce boundary conditions by writing into ghost zones
 template<typename Phys>
 void Boundary<Phys>::EnforceBoundaryDir(real t, int dir) {
@@ -382,10 +466,11 @@ void Boundary<Phys>::EnforceBoundaryDir(real t, int dir) {
 
 
 template<typename Phys>
-void Boundary<Phys>::ReconstructVcField(IdefixArray4D<real> &Vc) {
+template<typename T>
+void Boundary<Phys>::ReconstructVcField(IdefixArray4D<T> &Vc) {
   idfx::pushRegion("Boundary::ReconstructVcField");
 
-  IdefixArray4D<real> Vs=this->Vs;
+  IdefixArray4D<accum> Vs=this->Vs;
 
   // Reconstruct cell average field when using CT
   idefix_for("ReconstructVcMagField",0,data->np_tot[KDIR],0,data->np_tot[JDIR],0,data->np_tot[IDIR],
@@ -414,7 +499,7 @@ void Boundary<Phys>::ReconstructNormalField(int dir) {
   }
 
   // Reconstruct the field
-  IdefixArray4D<real> Vs = this->Vs;
+  IdefixArray4D<accum> Vs = this->Vs;
   // Coordinates
   IdefixArray1D<real> x1=data->x[IDIR];
   IdefixArray1D<real> x2=data->x[JDIR];
@@ -598,7 +683,7 @@ void Boundary<Phys>::EnforcePeriodic(int dir, BoundarySide side ) {
         });
 
   if constexpr(Phys::mhd) {
-    IdefixArray4D<real> Vs = this->Vs;
+    IdefixArray4D<accum> Vs = this->Vs;
     BoundaryForX1s("BoundaryPeriodicX1s",dir,side,
     KOKKOS_LAMBDA (int k, int j, int i) {
       int iref, jref, kref;
@@ -692,7 +777,7 @@ void Boundary<Phys>::EnforceReflective(int dir, BoundarySide side ) {
         });
 
   if constexpr(Phys::mhd) {
-    IdefixArray4D<real> Vs = this->Vs;
+    IdefixArray4D<accum> Vs = this->Vs;
     if(dir==JDIR || dir==KDIR) {
       BoundaryForX1s("BoundaryReflectiveX1s",dir,side,
         KOKKOS_LAMBDA (int k, int j, int i) {
@@ -760,7 +845,7 @@ void Boundary<Phys>::EnforceOutflow(int dir, BoundarySide side ) {
         });
 
   if constexpr(Phys::mhd) {
-    IdefixArray4D<real> Vs = this->Vs;
+    IdefixArray4D<accum> Vs = this->Vs;
     if(dir==JDIR || dir==KDIR) {
       BoundaryForX1s("BoundaryOutflowX1s",dir,side,
         KOKKOS_LAMBDA (int k, int j, int i) {
@@ -900,7 +985,7 @@ void Boundary<Phys>::EnforceShearingBox(real t, int dir, BoundarySide side) {
 
   // Magnetised version of the same thing
   if constexpr(Phys::mhd) {
-    IdefixArray4D<real> Vs = this->Vs;
+    IdefixArray4D<accum> Vs = this->Vs;
     #if DIMENSIONS >= 2
       for(int component = BX2s ; component < DIMENSIONS ; component++) {
         BoundaryFor("BoundaryShearingBoxBXs", dir, side,
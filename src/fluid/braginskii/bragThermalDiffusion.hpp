@@ -56,7 +56,7 @@ class BragThermalDiffusion {
 
   // helper array
   IdefixArray4D<real> &Vc;
-  IdefixArray4D<real> &Vs;
+  IdefixArray4D<accum> &Vs;
   IdefixArray3D<real> &dMax;
 
   // constant diffusion coefficient (when needed)
@@ -204,7 +204,7 @@ void BragThermalDiffusion::AddBragDiffusiveFluxLim(int dir, const real t,
   idfx::pushRegion("BragThermalDiffusion::AddBragDiffusiveFluxLim");
 
   IdefixArray4D<real> Vc = this->Vc;
-  IdefixArray4D<real> Vs = this->Vs;
+  IdefixArray4D<accum> Vs = this->Vs;
   IdefixArray3D<real> dMax = this->dMax;
   EquationOfState eos = *(this->eos);
 
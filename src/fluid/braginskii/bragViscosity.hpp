@@ -54,7 +54,7 @@ class BragViscosity {
   bool haveSlopeLimiter{false};
 
   IdefixArray4D<real> &Vc;
-  IdefixArray4D<real> &Vs;
+  IdefixArray4D<accum> &Vs;
   IdefixArray3D<real> &dMax;
 
   // constant diffusion coefficient (when needed)
@@ -168,7 +168,7 @@ template <PLMLimiter limTemplate>
 void BragViscosity::AddBragViscousFluxLim(int dir, const real t, const IdefixArray4D<real> &Flux) {
   idfx::pushRegion("BragViscosity::AddBragViscousFlux");
   IdefixArray4D<real> Vc = this->Vc;
-  IdefixArray4D<real> Vs = this->Vs;
+  IdefixArray4D<accum> Vs = this->Vs;
   IdefixArray4D<real> bragViscSrc = this->bragViscSrc;
   IdefixArray3D<real> dMax = this->dMax;
   IdefixArray3D<real> etaBragArr = this->etaBragArr;
@@ -52,7 +52,7 @@ struct Fluid_CorrectFluxFunctor {
   //*****************************************************************
   // Functor Variables
   //*****************************************************************
-  IdefixArray4D<real> Uc;
+  IdefixArray4D<accum> Uc;
   IdefixArray4D<real> Vc;
   IdefixArray4D<real> Flux;
   IdefixArray3D<real> A;
@@ -82,6 +82,23 @@ struct Fluid_CorrectFluxFunctor {
   // Functor Operator
   //*****************************************************************
   KOKKOS_INLINE_FUNCTION void operator() (const int k, const int j,  const int i) const {
+    real F[Phys::nvar];
+    #pragma unroll
+    for(int nv = 0 ; nv < Phys::nvar ; nv++) {
+      F[nv] = Flux(nv,k,j,i);
+    }
+
+    CorrectFlux(k, j, i, F);
+
+    #pragma unroll
+    for(int nv = 0 ; nv < Phys::nvar ; nv++) {
+      Flux(nv,k,j,i) = F[nv];
+    }
+  }
+
+  // Apply the corrections to the flux F of the left interface of cell (k,j,i)
+  KOKKOS_INLINE_FUNCTION void CorrectFlux(const int k, const int j,  const int i,
+                                          real F[Phys::nvar]) const {
       // Add Fargo velocity to the fluxes
       if(haveFargo || haveRotation) {
         // Set mean advection direction
@@ -143,16 +160,16 @@ struct Fluid_CorrectFluxFunctor {
         // since in that case meanV=0
         if constexpr(Phys::pressure) {
           // Mignone (2012): second and third term of rhs of (25)
-          Flux(ENG,k,j,i) += meanV * (HALF_F*meanV*Flux(RHO,k,j,i) + Flux(MX1+meanDir,k,j,i));
+          F[ENG] += meanV * (HALF_F*meanV*F[RHO] + F[MX1+meanDir]);
         }
         // Mignone+2012: second term of rhs of (24)
-        Flux(MX1+meanDir,k,j,i) += meanV * Flux(RHO,k,j,i);
+        F[MX1+meanDir] += meanV * F[RHO];
       } // Fargo & Rotation corrections
 
       real Ax = A(k,j,i);
 
       for(int nv = 0 ; nv < Phys::nvar ; nv++) {
-        Flux(nv,k,j,i) = Flux(nv,k,j,i) * Ax;
+        F[nv] = F[nv] * Ax;
       }
 
       // Curvature terms
@@ -160,11 +177,11 @@ struct Fluid_CorrectFluxFunctor {
     || (GEOMETRY == CYLINDRICAL && COMPONENTS == 3)
       if constexpr (dir==IDIR) {
         // Conserve angular momentum, hence flux is R*Bphi
-        Flux(iMPHI,k,j,i) = Flux(iMPHI,k,j,i) * FABS(x1m(i));
+        F[iMPHI] = F[iMPHI] * FABS(x1m(i));
         if constexpr(Phys::mhd) {
           if(Ax<SMALL_NUMBER) Ax=SMALL_NUMBER;    //avoid singularity around poles
           // No area for this one
-          Flux(iBPHI,k,j,i) = Flux(iBPHI,k,j,i) / Ax;
+          F[iBPHI] = F[iBPHI] / Ax;
         }
       }
 #endif // GEOMETRY==POLAR OR CYLINDRICAL
@@ -172,20 +189,20 @@ struct Fluid_CorrectFluxFunctor {
 #if GEOMETRY == SPHERICAL
       if constexpr(dir==IDIR) {
   #if COMPONENTS == 3
-        Flux(iMPHI,k,j,i) = Flux(iMPHI,k,j,i) * FABS(x1m(i));
+        F[iMPHI] = F[iMPHI] * FABS(x1m(i));
   #endif // COMPONENTS == 3
         if constexpr(Phys::mhd) {
           if(Ax<SMALL_NUMBER) Ax=SMALL_NUMBER;    // avoid singularity around poles
           EXPAND(                                            ,
-              Flux(iBTH,k,j,i)  = Flux(iBTH,k,j,i) * x1m(i) / Ax;  ,
-              Flux(iBPHI,k,j,i) = Flux(iBPHI,k,j,i) * x1m(i) / Ax; )
+              F[iBTH]  = F[iBTH] * x1m(i) / Ax;  ,
+              F[iBPHI] = F[iBPHI] * x1m(i) / Ax; )
         }
       } else if constexpr (dir==JDIR) {
   #if COMPONENTS == 3
-        Flux(iMPHI,k,j,i) = Flux(iMPHI,k,j,i) * FABS(sinx2m(j));
+        F[iMPHI] = F[iMPHI] * FABS(sinx2m(j));
         if constexpr(Phys::mhd) {
           if(Ax<SMALL_NUMBER) Ax=SMALL_NUMBER;    // avoid singularity around poles
-          Flux(iBPHI,k,j,i) = Flux(iBPHI,k,j,i)  / Ax;
+          F[iBPHI] = F[iBPHI]  / Ax;
         }
   #endif // COMPONENTS = 3
       }
@@ -268,7 +285,7 @@ struct Fluid_CalcRHSFunctor {
   //*****************************************************************
   // Functor Variables
   //*****************************************************************
-  IdefixArray4D<real> Uc;
+  IdefixArray4D<accum> Uc;
   IdefixArray4D<real> Vc;
   IdefixArray4D<real> Flux;
   IdefixArray3D<real> A;
@@ -322,8 +339,8 @@ struct Fluid_CalcRHSFunctor {
   // shearingBox
   real sbS;
 
-  // timestep
-  real dt;
+  // timestep, in the accumulation precision
+  accum dt;
 
   //*****************************************************************
   // Functor Operator
@@ -333,12 +350,34 @@ struct Fluid_CalcRHSFunctor {
     const int joffset = (dir==JDIR) ? 1 : 0;
     const int koffset = (dir==KDIR) ? 1 : 0;
 
-    real dtdV=dt / dV(k,j,i);
-    real rhs[Phys::nvar];
+    real FL[Phys::nvar];
+    real FR[Phys::nvar];
+    #pragma unroll
+    for(int nv = 0 ; nv < Phys::nvar ; nv++) {
+      FL[nv] = Flux(nv, k, j, i);
+      FR[nv] = Flux(nv, k+koffset, j+joffset, i+ioffset);
+    }
+
+    Apply(k, j, i, FL, FR, cMax(k,j,i), cMax(k+koffset,j+joffset,i+ioffset));
+  }
+
+  // Update Uc in cell (k,j,i) from the fluxes FL, FR and the signal speeds cmaxL, cmaxR of its
+  // left and right interfaces
+  KOKKOS_INLINE_FUNCTION void Apply(const int k, const int j,  const int i,
+                                    const real FL[Phys::nvar], const real FR[Phys::nvar],
+                                    const real cmaxL, const real cmaxR) const {
+    const int ioffset = (dir==IDIR) ? 1 : 0;
+    const int joffset = (dir==JDIR) ? 1 : 0;
+    const int koffset = (dir==KDIR) ? 1 : 0;
+
+    // The update is accumulated in accum, which is double precision even when the
+    // arrays are stored in single precision (MIXED_PRECISION)
+    accum dtdV=dt / dV(k,j,i);
+    accum rhs[Phys::nvar];
 
     #pragma unroll
     for(int nv = 0 ; nv < Phys::nvar ; nv++) {
-      rhs[nv] = -  dtdV*(Flux(nv, k+koffset, j+joffset, i+ioffset) - Flux(nv, k, j, i));
+      rhs[nv] = -  dtdV*(static_cast<accum>(FR[nv]) - FL[nv]);
     }
 
     #if GEOMETRY != CARTESIAN
@@ -348,20 +387,20 @@ struct Fluid_CalcRHSFunctor {
         #endif
         if constexpr(Phys::mhd) {
           #if (GEOMETRY == POLAR || GEOMETRY == CYLINDRICAL) &&  (defined iBPHI)
-            rhs[iBPHI] = - dt / dx(i) * (Flux(iBPHI, k, j, i+1) - Flux(iBPHI, k, j, i) );
+            rhs[iBPHI] = - dt / dx(i) * (FR[iBPHI] - FL[iBPHI] );
 
           #elif (GEOMETRY == SPHERICAL)
-            real q = dt / (x1(i)*dx(i));
+            accum q = dt / (x1(i)*dx(i));
             EXPAND(                                                                       ,
-                  rhs[iBTH]  = -q * ((Flux(iBTH, k, j, i+1)  - Flux(iBTH, k, j, i) ));  ,
-                  rhs[iBPHI] = -q * ((Flux(iBPHI, k, j, i+1) - Flux(iBPHI, k, j, i) )); )
+                  rhs[iBTH]  = -q * ((FR[iBTH]  - FL[iBTH] ));  ,
+                  rhs[iBPHI] = -q * ((FR[iBPHI] - FL[iBPHI] )); )
           #endif
         } // MHD
       } else if constexpr(dir==JDIR) {
         #if (GEOMETRY == SPHERICAL) && (COMPONENTS == 3)
           rhs[iMPHI] /= FABS(sinx2(j));
           if constexpr(Phys::mhd) {
-            rhs[iBPHI] = -dt / (rt(i)*dx(j)) * (Flux(iBPHI, k, j+1, i) - Flux(iBPHI, k, j, i));
+            rhs[iBPHI] = -dt / (rt(i)*dx(j)) * (FR[iBPHI] - FL[iBPHI]);
           } // MHD
         #endif // GEOMETRY
       }
@@ -464,7 +503,7 @@ struct Fluid_CalcRHSFunctor {
         // This is equivalent to rho * v . nabla(phi)
         // (note that Flux has already been multiplied by A)
         rhs[ENG] += HALF_F * dtdV  *
-                  (Flux(RHO,k,j,i) + Flux(RHO, k+koffset, j+joffset, i+ioffset)) * dphi;
+                  (FL[RHO] + FR[RHO]) * dphi;
       }
     }
 
@@ -474,7 +513,7 @@ struct Fluid_CalcRHSFunctor {
       if constexpr(Phys::pressure) {
         //  rho * v . f, where rhov is taken as a  volume average of Flux(RHO)
         rhs[ENG] += HALF_F * dtdV * dl *
-                      (Flux(RHO,k,j,i) + Flux(RHO, k+koffset, j+joffset, i+ioffset)) *
+                      (FL[RHO] + FR[RHO]) *
                         bodyForce(dir,k,j,i);
       } // Pressure
 
@@ -519,8 +558,7 @@ struct Fluid_CalcRHSFunctor {
     }
 
     // Compute dt from max signal speed
-    invDt(k,j,i) = invDt(k,j,i) + HALF_F*(cMax(k+koffset,j+joffset,i+ioffset)
-                  + cMax(k,j,i)) / (dl);
+    invDt(k,j,i) = invDt(k,j,i) + HALF_F*(cmaxR + cmaxL) / (dl);
 
     if(haveParabolicTerms) {
       invDt(k,j,i) = invDt(k,j,i) + TWO_F* FMAX(dMax(k+koffset,j+joffset,i+ioffset),
@@ -14,7 +14,7 @@
 template<typename Phys>
 real Fluid<Phys>::CheckDivB() {
   real divB;
-  IdefixArray4D<real> Vs = this->Vs;
+  IdefixArray4D<accum> Vs = this->Vs;
   IdefixArray1D<real> dx1 = data->dx[IDIR];
   IdefixArray1D<real> dx2 = data->dx[JDIR];
   IdefixArray1D<real> dx3 = data->dx[KDIR];
@@ -29,7 +29,7 @@ real Fluid<Phys>::CheckDivB() {
     data->beg[JDIR], data->end[JDIR],
     data->beg[IDIR], data->end[IDIR],
     KOKKOS_LAMBDA (int k, int j, int i, real &divBmax) {
-      [[maybe_unused]] real dB1,dB2,dB3;
+      [[maybe_unused]] accum dB1,dB2,dB3;
 
       dB1=dB2=dB3=ZERO_F;
 
@@ -55,7 +55,7 @@ real Fluid<Phys>::CheckDivB() {
 /*
 real Fluid::CheckDivB(DataBlock &data) {
   real divB=0;
-  IdefixArray4D<real> Vs = this->Vs;
+  IdefixArray4D<accum> Vs = this->Vs;
   IdefixArray3D<real> Ax1 = data->A[IDIR];
   IdefixArray3D<real> Ax2 = data->A[JDIR];
   IdefixArray3D<real> Ax3 = data->A[KDIR];
@@ -33,7 +33,7 @@ int Fluid<Phys>::CheckNan()  {
   );
 
   if constexpr(Phys::mhd) {
-    IdefixArray4D<real> Vs=this->Vs;
+    IdefixArray4D<accum> Vs=this->Vs;
     idefix_reduce("checkNanVs",
       0, DIMENSIONS,
       data->beg[KDIR], data->end[KDIR]+KOFFSET,
@@ -95,7 +95,7 @@ int Fluid<Phys>::CheckNan()  {
       }
 
       if constexpr(Phys::mhd) {
-        IdefixHostArray4D<real> VsHost = Kokkos::create_mirror_view(this->Vs);
+        IdefixHostArray4D<accum> VsHost = Kokkos::create_mirror_view(this->Vs);
         Kokkos::deep_copy(VsHost,Vs);
         for(int k = data->beg[KDIR] ; k < data->end[KDIR]+KOFFSET ; k++) {
           for(int j = data->beg[JDIR] ; j < data->end[JDIR]+JOFFSET ; j++) {
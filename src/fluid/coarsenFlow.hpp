@@ -17,7 +17,8 @@ KOKKOS_INLINE_FUNCTION int Kmax(int n, int m) {
 // This function coarsen the flow according to the grid coarsening array
 
 template<typename Phys>
-void Fluid<Phys>::CoarsenFlow(IdefixArray4D<real> &Vi) {
+template<typename T>
+void Fluid<Phys>::CoarsenFlow(IdefixArray4D<T> &Vi) {
   idfx::pushRegion("Fluid::CoarsenFlow");
 
   IdefixArray3D<real> dV   = data->dV;
@@ -59,8 +60,8 @@ void Fluid<Phys>::CoarsenFlow(IdefixArray4D<real> &Vi) {
           // We average the cells by groups of "factor" in direction "dir",
           // so only the first element of each group will do the job.
           if( (index-begDir)%factor == 0) {
-            real q = 0.0;
-            real V = 0.0;
+            T q = 0.0;
+            T V = 0.0;
             for(int shift = 0 ; shift < factor ; shift++) {
               q = q + Vi(n, k + shift*koffset, j + shift*joffset, i+shift*ioffset)
                     * dV(k + shift*koffset, j + shift*joffset, i+shift*ioffset);
@@ -80,7 +81,7 @@ void Fluid<Phys>::CoarsenFlow(IdefixArray4D<real> &Vi) {
 }
 
 template<typename Phys>
-void Fluid<Phys>::CoarsenMagField(IdefixArray4D<real> &Vsin) {
+void Fluid<Phys>::CoarsenMagField(IdefixArray4D<accum> &Vsin) {
   if constexpr(Phys::mhd) {
     idfx::pushRegion("Fluid::CoarsenMagField");
     #if DIMENSIONS >= 2
@@ -181,8 +182,8 @@ void Fluid<Phys>::CoarsenMagField(IdefixArray4D<real> &Vsin) {
           // We average the cells by groups of "factor" in direction "dir",
           // so only the first element of each group will do the job.
           if( (index-begDir)%factor_t == 0) {
-            real q = 0.0;
-            real A = 0.0;
+            accum q = 0.0;
+            accum A = 0.0;
             for(int shift = 0 ; shift < factor_t ; shift++) {
               q = q + Vsin(BXt, k + shift*koffset, j + shift*joffset, i+shift*ioffset)
                     * At(k + shift*koffset, j + shift*joffset, i+shift*ioffset);
@@ -213,8 +214,8 @@ void Fluid<Phys>::CoarsenMagField(IdefixArray4D<real> &Vsin) {
           // We average the cells by groups of "factor" in direction "dir",
           // so only the first element of each group will do the job.
           if( (index-begDir)%factor_b == 0) {
-            real q = 0.0;
-            real A = 0.0;
+            accum q = 0.0;
+            accum A = 0.0;
             for(int shift = 0 ; shift < factor_b ; shift++) {
               q = q + Vsin(BXb, k + shift*koffset, j + shift*joffset, i+shift*ioffset)
                     * Ab(k + shift*koffset, j + shift*joffset, i+shift*ioffset);
@@ -293,8 +294,8 @@ void Fluid<Phys>::CoarsenMagField(IdefixArray4D<real> &Vsin) {
 
 
           if( (index-begDir)%factor == 0) {
-            real qt = 0;
-            real qb = 0;
+            accum qt = 0;
+            accum qb = 0;
 
             // Loop forward
             for(int shift = 0 ; shift < factor-1 ; shift++) {
@@ -10,6 +10,98 @@
 #include "fluid.hpp"
 #include "dataBlock.hpp"
 
+// Corner EMFs computed from the face-centered EMFs, either as a simple arithmetic average
+// (arithmetic and uct0 schemes), or upwinding the contact wave (uct_contact scheme)
+struct EmfCornerAverage {
+  bool contact{false};
+
+  // Face-centered EMFs
+  IdefixArray3D<real> exj, exk, eyi, eyk, ezi, ezj;
+
+  // cell-centered EMFs and sign of the contact discontinuity (uct_contact only)
+  IdefixArray3D<real> Ex1, Ex2, Ex3;
+  IdefixArray3D<real> wsx, wsy, wsz;
+
+  KOKKOS_INLINE_FUNCTION real Ex(int k, int j, int i) const {
+    if(contact) {
+      real ex_l3 = (1-wsy(k-1,j,i)) * (exk(k,j,i)   - Ex1(k-1,j,i)) +
+                   (  wsy(k-1,j,i)) * (exk(k,j-1,i) - Ex1(k-1,j-1,i));
+
+      real ex_r3 = (1-wsy(k,j,i)) * (exk(k,j,i)   - Ex1(k,j,i)) +
+                   (  wsy(k,j,i)) * (exk(k,j-1,i) - Ex1(k,j-1,i));
+
+      real ex_l2 = (1-wsz(k,j-1,i)) * (exj(k,j,i)   - Ex1(k,j-1,i)) +
+                   (  wsz(k,j-1,i)) * (exj(k-1,j,i) - Ex1(k-1,j-1,i));
+
+      real ex_r2 = (1-wsz(k,j,i)) * (exj(k,j,i)   - Ex1(k,j,i)) +
+                   (  wsz(k,j,i)) * (exj(k-1,j,i) - Ex1(k-1,j,i));
+
+      return(ONE_FOURTH_F * (ex_l3 + ex_r3 + ex_l2 + ex_r2 +
+                             exj(k,j,i) + exj(k-1,j,i) + exk(k,j,i) + exk(k,j-1,i)));
+    }
+    return(ONE_FOURTH_F * (exj(k,j,i) + exj(k-1,j,i) + exk(k,j,i) + exk(k,j-1,i)));
+  }
+
+  KOKKOS_INLINE_FUNCTION real Ey(int k, int j, int i) const {
+    if(contact) {
+      real ey_l3 = (1-wsx(k-1,j,i)) * (eyk(k,j,i)   - Ex2(k-1,j,i)) +
+                   (  wsx(k-1,j,i)) * (eyk(k,j,i-1) - Ex2(k-1,j,i-1));
+
+      real ey_r3 = (1-wsx(k,j,i)) * (eyk(k,j,i)   - Ex2(k,j,i)) +
+                   (  wsx(k,j,i)) * (eyk(k,j,i-1) - Ex2(k,j,i-1));
+
+      real ey_l1 = (1-wsz(k,j,i-1)) * (eyi(k,j,i)   - Ex2(k,j,i-1)) +
+                   (  wsz(k,j,i-1)) * (eyi(k-1,j,i) - Ex2(k-1,j,i-1));
+
+      real ey_r1 = (1-wsz(k,j,i)) * (eyi(k,j,i)   - Ex2(k,j,i)) +
+                   (  wsz(k,j,i)) * (eyi(k-1,j,i) - Ex2(k-1,j,i));
+
+      return(ONE_FOURTH_F * (ey_l3 + ey_r3 + ey_l1 + ey_r1 +
+                             eyi(k,j,i) + eyi(k-1,j,i) + eyk(k,j,i) + eyk(k,j,i-1)));
+    }
+    return(ONE_FOURTH_F * (eyi(k,j,i) + eyi(k-1,j,i) + eyk(k,j,i) + eyk(k,j,i-1)));
+  }
+
+  KOKKOS_INLINE_FUNCTION real Ez(int k, int j, int i) const {
+    if(contact) {
+      real ez_l2 = (1-wsx(k,j-1,i)) * (ezj(k,j,i)   - Ex3(k,j-1,i)) +
+                   (  wsx(k,j-1,i)) * (ezj(k,j,i-1) - Ex3(k,j-1,i-1));
+
+      real ez_r2 = (1-wsx(k,j,i)) * (ezj(k,j,i)   - Ex3(k,j,i)) +
+                   (  wsx(k,j,i)) * (ezj(k,j,i-1) - Ex3(k,j,i-1));
+
+      real ez_l1 = (1-wsy(k,j,i-1)) * (ezi(k,j,i)   - Ex3(k,j,i-1)) +
+                   (  wsy(k,j,i-1)) * (ezi(k,j-1,i) - Ex3(k,j-1,i-1));
+
+      real ez_r1 = (1-wsy(k,j,i)) * (ezi(k,j,i)   - Ex3(k,j,i)) +
+                   (  wsy(k,j,i)) * (ezi(k,j-1,i) - Ex3(k,j-1,i));
+
+      return(ONE_FOURTH_F * (ez_l2 + ez_r2 + ez_l1 + ez_r1 +
+                             ezi(k,j,i) + ezi(k,j-1,i) + ezj(k,j,i) + ezj(k,j,i-1)));
+    }
+    return(ONE_FOURTH_F * (ezi(k,j,i) + ezi(k,j-1,i) + ezj(k,j,i) + ezj(k,j,i-1)));
+  }
+};
+
+template<typename Phys>
+EmfCornerAverage ConstrainedTransport<Phys>::GetCornerAverage() {
+  EmfCornerAverage corner;
+  corner.contact = (averaging == uct_contact);
+  corner.exj = exj;
+  corner.exk = exk;
+  corner.eyi = eyi;
+  corner.eyk = eyk;
+  corner.ezi = ezi;
+  corner.ezj = ezj;
+  corner.Ex1 = Ex1;
+  corner.Ex2 = Ex2;
+  corner.Ex3 = Ex3;
+  corner.wsx = svx;
+  corner.wsy = svy;
+  corner.wsz = svz;
+  return(corner);
+}
+
 // Compute Corner EMFs from the one stored in the Riemann step
 template<typename Phys>
 void ConstrainedTransport<Phys>::CalcCornerEMF(real t) {
@@ -49,32 +141,19 @@ void ConstrainedTransport<Phys>::CalcArithmeticAverage() {
   IdefixArray3D<real> ey = this->ey;
   IdefixArray3D<real> ez = this->ez;
 
-  // Face-centered EMFs
-  IdefixArray3D<real> exj = this->exj;
-  IdefixArray3D<real> exk = this->exk;
-  IdefixArray3D<real> eyi = this->eyi;
-  IdefixArray3D<real> eyk = this->eyk;
-  IdefixArray3D<real> ezi = this->ezi;
-  IdefixArray3D<real> ezj = this->ezj;
-
   #if MHD == YES && DIMENSIONS >= 2
+  EmfCornerAverage corner = GetCornerAverage();
 
   idefix_for("CalcArithmeticAverage",
             data->beg[KDIR],data->end[KDIR]+KOFFSET,
             data->beg[JDIR],data->end[JDIR]+JOFFSET,
             data->beg[IDIR],data->end[IDIR]+IOFFSET,
     KOKKOS_LAMBDA (int k, int j, int i) {
-                  // CT_EMF_ArithmeticAverage (emf, 0.25);
-      real w = ONE_FOURTH_F;
     #if DIMENSIONS == 3
-      ex(k,j,i) = w * (exj(k,j,i) + exj(k-1,j,i) + exk(k,j,i) + exk(k,j-1,i));
-      ey(k,j,i) = w * (eyi(k,j,i) + eyi(k-1,j,i) + eyk(k,j,i) + eyk(k,j,i-1));
-    #endif
-    #if DIMENSIONS >= 2
-      ez(k,j,i) = w * (ezi(k,j,i) + ezi(k,j-1,i) + ezj(k,j,i) + ezj(k,j,i-1));
-    #else
-      ez(k,j,i) = w * (TWO_F*ezi(k,j,i) + ezj(k,j,i) + ezj(k,j,i-1));
+      ex(k,j,i) = corner.Ex(k,j,i);
+      ey(k,j,i) = corner.Ey(k,j,i);
     #endif
+      ez(k,j,i) = corner.Ez(k,j,i);
     });
 #endif // MHD
 
@@ -128,11 +207,36 @@ void ConstrainedTransport<Phys>::CalcCellCenteredEMF() {
 template<typename Phys>
 void ConstrainedTransport<Phys>::CalcUCT0Average() {
   idfx::pushRegion("ConstrainedTransport::CalcUCT0Average");
-    // Corned EMFs
+  // Corned EMFs
   IdefixArray3D<real> ex = this->ex;
   IdefixArray3D<real> ey = this->ey;
   IdefixArray3D<real> ez = this->ez;
 
+#if MHD == YES && DIMENSIONS >= 2
+  CalcUCT0FaceCentered();
+
+  EmfCornerAverage corner = GetCornerAverage();
+
+  idefix_for("CalcUCT0CornerEMF",
+            data->beg[KDIR],data->end[KDIR]+KOFFSET,
+            data->beg[JDIR],data->end[JDIR]+JOFFSET,
+            data->beg[IDIR],data->end[IDIR]+IOFFSET,
+    KOKKOS_LAMBDA (int k, int j, int i) {
+    #if DIMENSIONS == 3
+      ex(k,j,i) = corner.Ex(k,j,i);
+      ey(k,j,i) = corner.Ey(k,j,i);
+    #endif
+      ez(k,j,i) = corner.Ez(k,j,i);
+    }
+  );
+#endif
+  idfx::popRegion();
+}
+
+// Face-centered EMFs of the UCT0 scheme, corrected by the cell-centered EMFs
+template<typename Phys>
+void ConstrainedTransport<Phys>::CalcUCT0FaceCentered() {
+  idfx::pushRegion("ConstrainedTransport::CalcUCT0FaceCentered");
   // Face-centered EMFs
   IdefixArray3D<real> exj = this->exj;
   IdefixArray3D<real> exk = this->exk;
@@ -170,25 +274,6 @@ void ConstrainedTransport<Phys>::CalcUCT0Average() {
         ezj(k,j,i) -= HALF_F*(Ex3(k,j-1,i) + Ex3(k,j,i));
       }
     );
-
-  idefix_for("CalcUCT0CornerEMF",
-            data->beg[KDIR],data->end[KDIR]+KOFFSET,
-            data->beg[JDIR],data->end[JDIR]+JOFFSET,
-            data->beg[IDIR],data->end[IDIR]+IOFFSET,
-    KOKKOS_LAMBDA (int k, int j, int i) {
-      // CT_EMF_ArithmeticAverage (emf, 0.25);
-      const real w = ONE_FOURTH_F;
-    #if DIMENSIONS == 3
-      ex(k,j,i) = w * (exj(k,j,i) + exj(k-1,j,i) + exk(k,j,i) + exk(k,j-1,i));
-      ey(k,j,i) = w * (eyi(k,j,i) + eyi(k-1,j,i) + eyk(k,j,i) + eyk(k,j,i-1));
-    #endif
-    #if DIMENSIONS >= 2
-      ez(k,j,i) = w * (ezi(k,j,i) + ezi(k,j-1,i) + ezj(k,j,i) + ezj(k,j,i-1));
-    #else
-      ez(k,j,i) = w * (TWO_F*ezi(k,j,i) + ezj(k,j,i) + ezj(k,j,i-1));
-    #endif
-    }
-  );
 #endif
   idfx::popRegion();
 }
@@ -221,63 +306,17 @@ void ConstrainedTransport<Phys>::CalcContactAverage() {
 
 #if MHD == YES && DIMENSIONS >= 2
 
+  EmfCornerAverage corner = GetCornerAverage();
+
   idefix_for("EMF_Integrate_to_Corner",
             data->beg[KDIR],data->end[KDIR]+KOFFSET,
             data->beg[JDIR],data->end[JDIR]+JOFFSET,
             data->beg[IDIR],data->end[IDIR]+IOFFSET,
     KOKKOS_LAMBDA (int k, int j, int i) {
-      real ez_l2 = (1-wsx(k,j-1,i)) * (ezj(k,j,i)   - Ex3(k,j-1,i)) +
-                   (  wsx(k,j-1,i)) * (ezj(k,j,i-1) - Ex3(k,j-1,i-1));
-
-      real ez_r2 = (1-wsx(k,j,i)) * (ezj(k,j,i)   - Ex3(k,j,i)) +
-                   (  wsx(k,j,i)) * (ezj(k,j,i-1) - Ex3(k,j,i-1));
-
-      real ez_l1 = (1-wsy(k,j,i-1)) * (ezi(k,j,i)   - Ex3(k,j,i-1)) +
-                   (  wsy(k,j,i-1)) * (ezi(k,j-1,i) - Ex3(k,j-1,i-1));
-
-      real ez_r1 = (1-wsy(k,j,i)) * (ezi(k,j,i)   - Ex3(k,j,i)) +
-                   (  wsy(k,j,i)) * (ezi(k,j-1,i) - Ex3(k,j-1,i));
-
-      ez(k,j,i) = ONE_FOURTH_F * (ez_l2 + ez_r2 + ez_l1 + ez_r1 +
-                        #if DIMENSIONS >= 2
-                          ezi(k,j,i) + ezi(k,j-1,i) + ezj(k,j,i) + ezj(k,j,i-1)
-                        #else
-                          TWO_F*ezi(k,j,i) + ezj(k,j,i) + ezj(k,j,i-1)
-                        #endif
-                        );
-
+      ez(k,j,i) = corner.Ez(k,j,i);
       #if DIMENSIONS == 3
-        real ex_l3 = (1-wsy(k-1,j,i)) * (exk(k,j,i)   - Ex1(k-1,j,i)) +
-                     (  wsy(k-1,j,i)) * (exk(k,j-1,i) - Ex1(k-1,j-1,i));
-
-        real ex_r3 = (1-wsy(k,j,i)) * (exk(k,j,i)   - Ex1(k,j,i)) +
-                     (  wsy(k,j,i)) * (exk(k,j-1,i) - Ex1(k,j-1,i));
-
-        real ex_l2 = (1-wsz(k,j-1,i)) * (exj(k,j,i)   - Ex1(k,j-1,i)) +
-                     (  wsz(k,j-1,i)) * (exj(k-1,j,i) - Ex1(k-1,j-1,i));
-
-        real ex_r2 = (1-wsz(k,j,i)) * (exj(k,j,i)   - Ex1(k,j,i)) +
-                     (  wsz(k,j,i)) * (exj(k-1,j,i) - Ex1(k-1,j,i));
-
-        ex(k,j,i) = ONE_FOURTH_F * (ex_l3 + ex_r3 + ex_l2 + ex_r2 +
-                            exj(k,j,i) + exj(k-1,j,i) + exk(k,j,i) + exk(k,j-1,i) );
-
-        real ey_l3 = (1-wsx(k-1,j,i)) * (eyk(k,j,i)   - Ex2(k-1,j,i)) +
-                     (  wsx(k-1,j,i)) * (eyk(k,j,i-1) - Ex2(k-1,j,i-1));
-
-        real ey_r3 = (1-wsx(k,j,i)) * (eyk(k,j,i)   - Ex2(k,j,i)) +
-                     (  wsx(k,j,i)) * (eyk(k,j,i-1) - Ex2(k,j,i-1));
-
-        real ey_l1 = (1-wsz(k,j,i-1)) * (eyi(k,j,i)   - Ex2(k,j,i-1)) +
-                     (  wsz(k,j,i-1)) * (eyi(k-1,j,i) - Ex2(k-1,j,i-1));
-
-        real ey_r1 = (1-wsz(k,j,i)) * (eyi(k,j,i)   - Ex2(k,j,i)) +
-                     (  wsz(k,j,i)) * (eyi(k-1,j,i) - Ex2(k-1,j,i));
-
-        ey(k,j,i) = ONE_FOURTH_F * (ey_l3 + ey_r3 + ey_l1 + ey_r1 +
-                            eyi(k,j,i) + eyi(k-1,j,i) + eyk(k,j,i) + eyk(k,j,i-1));
-
-
+        ex(k,j,i) = corner.Ex(k,j,i);
+        ey(k,j,i) = corner.Ey(k,j,i);
       #endif
     });
 
@@ -22,7 +22,7 @@ void ConstrainedTransport<Phys>::CalcNonidealEMF(real t) {
   IdefixArray3D<real> ey = this->ey;
   IdefixArray3D<real> ez = this->ez;
   IdefixArray4D<real> J = hydro->J;
-  IdefixArray4D<real> Vs = hydro->Vs;
+  IdefixArray4D<accum> Vs = hydro->Vs;
   IdefixArray4D<real> Vc = hydro->Vc;
 
   // These arrays have been previously computed in calcParabolicFlux
@@ -15,6 +15,7 @@
 // Forward declarations
 #include "physics.hpp"
 template <typename Phys> class Fluid;
+struct EmfCornerAverage;
 
 class DataBlock;
 
@@ -26,6 +27,9 @@ class ConstrainedTransport {
   // Type of averaging
   AveragingType averaging{none};
 
+  // Whether the corner EMFs are computed within the field update
+  bool haveFusedUpdate{false};
+
   // Face centered emf components
   IdefixArray3D<real>     exj;
   IdefixArray3D<real>     exk;
@@ -77,7 +81,11 @@ class ConstrainedTransport {
   ConstrainedTransport(Input &, Fluid<Phys> *);
   ~ConstrainedTransport();
 
-  void EvolveMagField(real, real, IdefixArray4D<real>&);
+  void EvolveMagField(real, real, IdefixArray4D<accum>&);
+  // Field update computing the corner EMFs on the fly (see EvolveMagFieldFused)
+  void EvolveMagFieldFused(real, real, IdefixArray4D<accum>&);
+  template <typename EdgeEmf>
+  void UpdateMagField(real, IdefixArray4D<accum>&, const EdgeEmf &);
   void CalcCornerEMF(real );
   void ShowConfig();
 
@@ -86,7 +94,9 @@ class ConstrainedTransport {
   void CalcArithmeticAverage();
   void CalcCellCenteredEMF();
   void CalcUCT0Average();
+  void CalcUCT0FaceCentered();
   void CalcContactAverage();
+  EmfCornerAverage GetCornerAverage();
 
   // Enforce boundary conditions on the EMFs.
   void EnforceEMFBoundary();
@@ -99,8 +109,8 @@ class ConstrainedTransport {
                             IdefixArray2D<real>);
 
   // Routines for evolving the magnetic potential (only available when EVOLVE_VECTOR_POTENTIAL)
-  void EvolveVectorPotential(real, IdefixArray4D<real> &);
-  void ComputeMagFieldFromA(IdefixArray4D<real> &Vein, IdefixArray4D<real> &Vsout);
+  void EvolveVectorPotential(real, IdefixArray4D<accum> &);
+  void ComputeMagFieldFromA(IdefixArray4D<accum> &Vein, IdefixArray4D<accum> &Vsout);
 
 #ifdef WITH_MPI
   // Exchange surface EMFs to remove interprocess round off errors
@@ -181,6 +191,25 @@ ConstrainedTransport<Phys>::ConstrainedTransport(Input &input, Fluid<Phys> *hydr
   this->data = hydro->data;
   this->hydro = hydro;
 
+  if(input.CheckEntry("Hydro","fusedCT")>=0) {
+    this->haveFusedUpdate = input.Get<bool>("Hydro","fusedCT",0);
+  }
+  if(haveFusedUpdate) {
+    #if DIMENSIONS < 2
+      IDEFIX_ERROR("fusedCT requires DIMENSIONS >= 2");
+    #endif
+    #ifdef EVOLVE_VECTOR_POTENTIAL
+      IDEFIX_ERROR("fusedCT is not compatible with EVOLVE_VECTOR_POTENTIAL");
+    #endif
+    if(averaging == uct_hll || averaging == uct_hlld) {
+      IDEFIX_ERROR("fusedCT is only compatible with the arithmetic, uct0 and uct_contact emf");
+    }
+    if(hydro->resistivityStatus.isExplicit || hydro->ambipolarStatus.isExplicit) {
+      IDEFIX_ERROR("fusedCT is not compatible with explicit resistivity or ambipolar diffusion. "
+                   "Use rkl integration for these terms instead.");
+    }
+  }
+
   // Allocate shearing box arrays
   if(hydro->haveShearingBox == true) {
     sbEyL = IdefixArray2D<real>("EMF_sbEyL", data->np_tot[KDIR], data->np_tot[JDIR]);
@@ -442,6 +471,10 @@ void ConstrainedTransport<Phys>::ShowConfig() {
     default:
       IDEFIX_ERROR("Unknown averaging scheme");
   }
+  if(haveFusedUpdate) {
+    idfx::cout << "ConstrainedTransport: corner EMFs computed within the field update."
+               << std::endl;
+  }
 }
 
 #include "calcCornerEmf.hpp"
@@ -7,21 +7,118 @@
 #ifndef FLUID_CONSTRAINEDTRANSPORT_EVOLVEMAGFIELD_HPP_
 #define FLUID_CONSTRAINEDTRANSPORT_EVOLVEMAGFIELD_HPP_
 
+#include <array>
 #include "fluid.hpp"
 #include "dataBlock.hpp"
 
+// Edge EMFs stored in arrays
+struct EmfStored {
+  IdefixArray3D<real> ex, ey, ez;
+
+  KOKKOS_INLINE_FUNCTION real Ex(int k, int j, int i) const { return(ex(k,j,i)); }
+  KOKKOS_INLINE_FUNCTION real Ey(int k, int j, int i) const { return(ey(k,j,i)); }
+  KOKKOS_INLINE_FUNCTION real Ez(int k, int j, int i) const { return(ez(k,j,i)); }
+};
+
+// Edge EMFs computed on the fly from the face-centered EMFs, except on the boundary planes
+// of the domain (the shell), where they are stored to be modified by the boundary conditions
+struct EmfFused {
+  EmfCornerAverage corner;
+  EmfStored shell;
+  int ibeg, iend, jbeg, jend, kbeg, kend;
+
+  KOKKOS_INLINE_FUNCTION bool OnShell(int k, int j, int i) const {
+    return(D_EXPAND( i == ibeg || i == iend  ,
+                  || j == jbeg || j == jend  ,
+                  || k == kbeg || k == kend  ));
+  }
+  KOKKOS_INLINE_FUNCTION real Ex(int k, int j, int i) const {
+    return(OnShell(k,j,i) ? shell.Ex(k,j,i) : corner.Ex(k,j,i));
+  }
+  KOKKOS_INLINE_FUNCTION real Ey(int k, int j, int i) const {
+    return(OnShell(k,j,i) ? shell.Ey(k,j,i) : corner.Ey(k,j,i));
+  }
+  KOKKOS_INLINE_FUNCTION real Ez(int k, int j, int i) const {
+    return(OnShell(k,j,i) ? shell.Ez(k,j,i) : corner.Ez(k,j,i));
+  }
+};
+
 // Evolve the magnetic field in Vs according to Constranied transport
 template<typename Phys>
-void ConstrainedTransport<Phys>::EvolveMagField(real t, real dt, IdefixArray4D<real> &Vsin) {
+void ConstrainedTransport<Phys>::EvolveMagField(real t, real dtin, IdefixArray4D<accum> &Vsin) {
   idfx::pushRegion("ConstrainedTransport::EvolveMagField");
+  UpdateMagField(dtin, Vsin, EmfStored{ex, ey, ez});
+  idfx::popRegion();
+}
+
+// Evolve the magnetic field in Vs, computing the corner EMFs within the update, so that the
+// edge EMF arrays are only written and read on the boundary planes of the domain. This is
+// equivalent to CalcCornerEMF+EnforceEMFBoundary+EvolveMagField, provided that the user-defined
+// EMF boundary conditions only modify the EMFs on the boundary planes.
+template<typename Phys>
+void ConstrainedTransport<Phys>::EvolveMagFieldFused(real t, real dt, IdefixArray4D<accum> &Vs) {
+  idfx::pushRegion("ConstrainedTransport::EvolveMagFieldFused");
+#if MHD == YES && DIMENSIONS >= 2
+  if(averaging==uct_contact||averaging==uct0) {
+    CalcCellCenteredEMF();
+    if(averaging==uct0) CalcUCT0FaceCentered();
+  }
+  EmfCornerAverage corner = GetCornerAverage();
+
+  // Store the corner EMFs of the boundary planes
+  IdefixArray3D<real> ex = this->ex;
+  IdefixArray3D<real> ey = this->ey;
+  IdefixArray3D<real> ez = this->ez;
+  const std::array<int,3> offset = {IOFFSET, JOFFSET, KOFFSET};
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    for(int side = 0 ; side < 2 ; side++) {
+      std::array<int,3> lo, hi;
+      for(int d = 0 ; d < 3 ; d++) {
+        lo[d] = data->beg[d];
+        hi[d] = data->end[d] + offset[d];
+      }
+      lo[dir] = (side == 0) ? data->beg[dir] : data->end[dir];
+      hi[dir] = lo[dir] + 1;
+      idefix_for("CalcShellEMF", lo[KDIR], hi[KDIR], lo[JDIR], hi[JDIR], lo[IDIR], hi[IDIR],
+        KOKKOS_LAMBDA (int k, int j, int i) {
+        #if DIMENSIONS == 3
+          ex(k,j,i) = corner.Ex(k,j,i);
+          ey(k,j,i) = corner.Ey(k,j,i);
+        #endif
+          ez(k,j,i) = corner.Ez(k,j,i);
+        });
+    }
+  }
+
+  // The boundary conditions only act on the boundary planes (and the MPI exchange of
+  // ENFORCE_EMF_CONSISTENCY only involves them)
+  EnforceEMFBoundary();
+
+  EmfFused emf;
+  emf.corner = corner;
+  emf.shell = EmfStored{ex, ey, ez};
+  emf.ibeg = data->beg[IDIR];
+  emf.iend = data->end[IDIR];
+  emf.jbeg = data->beg[JDIR];
+  emf.jend = data->end[JDIR];
+  emf.kbeg = data->beg[KDIR];
+  emf.kend = data->end[KDIR];
+  UpdateMagField(dt, Vs, emf);
+#endif
+  idfx::popRegion();
+}
+
+// Update of the field from the edge EMFs provided by E
+template<typename Phys>
+template<typename EdgeEmf>
+void ConstrainedTransport<Phys>::UpdateMagField(real dtin, IdefixArray4D<accum> &Vsin,
+                                                const EdgeEmf &E) {
 #if MHD == YES
-  // Corned EMFs
-  IdefixArray3D<real> Ex1 = this->ex;
-  IdefixArray3D<real> Ex2 = this->ey;
-  IdefixArray3D<real> Ex3 = this->ez;
+  // The increments are computed in double precision with MIXED_PRECISION
+  const accum dt = dtin;
 
   // Field
-  IdefixArray4D<real> Vs = Vsin;
+  IdefixArray4D<accum> Vs = Vsin;
 
   // Coordinates
   IdefixArray1D<real> x1=data->x[IDIR];
@@ -55,44 +152,44 @@ void ConstrainedTransport<Phys>::EvolveMagField(real t, real dt, IdefixArray4D<r
              data->beg[JDIR],data->end[JDIR]+JOFFSET,
              data->beg[IDIR],data->end[IDIR]+IOFFSET,
     KOKKOS_LAMBDA (int k, int j, int i) {
-      real rhsx1;
-      [[maybe_unused]] real rhsx2, rhsx3;
+      accum rhsx1;
+      [[maybe_unused]] accum rhsx2, rhsx3;
 
 #if GEOMETRY == CARTESIAN
       rhsx1 = D_EXPAND( ZERO_F                                     ,
-                       - dt/dx2(j) * (Ex3(k,j+1,i) - Ex3(k,j,i) )  ,
-                       + dt/dx3(k) * (Ex2(k+1,j,i) - Ex2(k,j,i) )  );
+                       - dt/dx2(j) * (E.Ez(k,j+1,i) - E.Ez(k,j,i) )  ,
+                       + dt/dx3(k) * (E.Ey(k+1,j,i) - E.Ey(k,j,i) )  );
 
   #if DIMENSIONS >= 2
-      rhsx2 =  D_EXPAND( dt/dx1(i) * (Ex3(k,j,i+1) - Ex3(k,j,i) )  ,
+      rhsx2 =  D_EXPAND( dt/dx1(i) * (E.Ez(k,j,i+1) - E.Ez(k,j,i) )  ,
                                                                    ,
-                        - dt/dx3(k) * (Ex1(k+1,j,i) - Ex1(k,j,i) ) );
+                        - dt/dx3(k) * (E.Ex(k+1,j,i) - E.Ex(k,j,i) ) );
   #endif
   #if DIMENSIONS == 3
-      rhsx3 = - dt/dx1(i) * (Ex2(k,j,i+1) - Ex2(k,j,i) )
-              + dt/dx2(j) * (Ex1(k,j+1,i) - Ex1(k,j,i) );
+      rhsx3 = - dt/dx1(i) * (E.Ey(k,j,i+1) - E.Ey(k,j,i) )
+              + dt/dx2(j) * (E.Ex(k,j+1,i) - E.Ex(k,j,i) );
   #endif
 
 #elif GEOMETRY == CYLINDRICAL
-      rhsx1 = - dt/dx2(j) * (Ex3(k,j+1,i) - Ex3(k,j,i) );
+      rhsx1 = - dt/dx2(j) * (E.Ez(k,j+1,i) - E.Ez(k,j,i) );
   #if DIMENSIONS >= 2
-      rhsx2 = dt * (FABS(x1p(i)) * Ex3(k,j,i+1) - FABS(x1m(i)) * Ex3(k,j,i)) / FABS(x1(i)*dx1(i));
+      rhsx2 = dt * (FABS(x1p(i)) * E.Ez(k,j,i+1) - FABS(x1m(i)) * E.Ez(k,j,i)) / FABS(x1(i)*dx1(i));
   #endif
 
 #elif GEOMETRY == POLAR
       rhsx1 = D_EXPAND( ZERO_F                                                      ,
-                       - dt/(FABS(x1m(i)) * dx2(j)) * (Ex3(k,j+1,i) - Ex3(k,j,i) )  ,
-                       + dt/dx3(k) * (Ex2(k+1,j,i) - Ex2(k,j,i) )                   );
+                       - dt/(FABS(x1m(i)) * dx2(j)) * (E.Ez(k,j+1,i) - E.Ez(k,j,i) )  ,
+                       + dt/dx3(k) * (E.Ey(k+1,j,i) - E.Ey(k,j,i) )                   );
 
   #if DIMENSIONS >= 2
-      rhsx2 =  D_EXPAND( dt/dx1(i) * (Ex3(k,j,i+1) - Ex3(k,j,i) )  ,
+      rhsx2 =  D_EXPAND( dt/dx1(i) * (E.Ez(k,j,i+1) - E.Ez(k,j,i) )  ,
                                                                    ,
-                        - dt/dx3(k) * (Ex1(k+1,j,i) - Ex1(k,j,i) ) );
+                        - dt/dx3(k) * (E.Ex(k+1,j,i) - E.Ex(k,j,i) ) );
   #endif
   #if DIMENSIONS == 3
       rhsx3 = dt/(FABS(x1(i))) * (
-                  -  (x1m(i+1)*Ex2(k,j,i+1) - x1m(i)*Ex2(k,j,i) ) / dx1(i)
-                  +  (Ex1(k,j+1,i) - Ex1(k,j,i) ) / dx2(j) );
+                  -  (x1m(i+1)*E.Ey(k,j,i+1) - x1m(i)*E.Ey(k,j,i) ) / dx1(i)
+                  +  (E.Ex(k,j+1,i) - E.Ex(k,j,i) ) / dx2(j) );
   #endif
 
 #elif GEOMETRY == SPHERICAL
@@ -101,8 +198,8 @@ void ConstrainedTransport<Phys>::EvolveMagField(real t, real dt, IdefixArray4D<r
       real Ax2m = FABS(sinx2m(j));
 
       rhsx1 = D_EXPAND( ZERO_F                                                        ,
-                       - dt/(x1m(i)*dV2) * ( Ax2p*Ex3(k,j+1,i) - Ax2m*Ex3(k,j,i) )    ,
-                       + dt*dx2(j)/(x1m(i)*dV2*dx3(k)) * (Ex2(k+1,j,i) - Ex2(k,j,i) ) );
+                       - dt/(x1m(i)*dV2) * ( Ax2p*E.Ez(k,j+1,i) - Ax2m*E.Ez(k,j,i) )    ,
+                       + dt*dx2(j)/(x1m(i)*dV2*dx3(k)) * (E.Ey(k+1,j,i) - E.Ey(k,j,i) ) );
 
   #if DIMENSIONS >= 2
       // If we include the axis, we symmetrize Ex on the axis. However, Ax2=0 on the axis
@@ -111,13 +208,13 @@ void ConstrainedTransport<Phys>::EvolveMagField(real t, real dt, IdefixArray4D<r
       if(haveAxis) {
         if(FABS(Ax2m)<1e-12) Ax2m = ONE_F;
       }
-      rhsx2 =  D_EXPAND( dt/(x1(i)*dx1(i)) * (x1m(i+1)*Ex3(k,j,i+1) - x1m(i)*Ex3(k,j,i) )  ,
+      rhsx2 =  D_EXPAND( dt/(x1(i)*dx1(i)) * (x1m(i+1)*E.Ez(k,j,i+1) - x1m(i)*E.Ez(k,j,i) )  ,
                                                                                            ,
-                        - dt/(x1(i)*Ax2m*dx3(k)) * (Ex1(k+1,j,i) - Ex1(k,j,i) )            );
+                        - dt/(x1(i)*Ax2m*dx3(k)) * (E.Ex(k+1,j,i) - E.Ex(k,j,i) )            );
   #endif
   #if DIMENSIONS == 3
-      rhsx3 = - dt/(x1(i)*dx1(i)) * (x1m(i+1)*Ex2(k,j,i+1) - x1m(i)*Ex2(k,j,i) )
-              + dt/(x1(i)*dx2(j)) * (Ex1(k,j+1,i) - Ex1(k,j,i) );
+      rhsx3 = - dt/(x1(i)*dx1(i)) * (x1m(i+1)*E.Ey(k,j,i+1) - x1m(i)*E.Ey(k,j,i) )
+              + dt/(x1(i)*dx2(j)) * (E.Ex(k,j+1,i) - E.Ex(k,j,i) );
   #endif
 #endif // GEOMETRY
 
@@ -131,7 +228,6 @@ void ConstrainedTransport<Phys>::EvolveMagField(real t, real dt, IdefixArray4D<r
 #endif
   });
 #endif
-  idfx::popRegion();
 }
 
 #endif //FLUID_CONSTRAINEDTRANSPORT_EVOLVEMAGFIELD_HPP_
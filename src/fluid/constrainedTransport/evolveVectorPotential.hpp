@@ -15,10 +15,12 @@
 #include "dataBlock.hpp"
 
 template<typename Phys>
-void ConstrainedTransport<Phys>::EvolveVectorPotential(real dt, IdefixArray4D<real> &Vein) {
+void ConstrainedTransport<Phys>::EvolveVectorPotential(real dtin, IdefixArray4D<accum> &Vein) {
   #ifdef EVOLVE_VECTOR_POTENTIAL
     idfx::pushRegion("ConstrainedTransport::EvolveVectorPotential");
-    IdefixArray4D<real> Ve = Vein;
+    // The increments are computed in double precision with MIXED_PRECISION
+    const accum dt = dtin;
+    IdefixArray4D<accum> Ve = Vein;
         // Corned EMFs
     IdefixArray3D<real> Ex1 = this->ex;
     IdefixArray3D<real> Ex2 = this->ey;
@@ -44,8 +46,8 @@ void ConstrainedTransport<Phys>::EvolveVectorPotential(real dt, IdefixArray4D<re
 
 
 template<typename Phys>
-void ConstrainedTransport<Phys>::ComputeMagFieldFromA(IdefixArray4D<real> &Vein,
-                                              IdefixArray4D<real> &Vsout) {
+void ConstrainedTransport<Phys>::ComputeMagFieldFromA(IdefixArray4D<accum> &Vein,
+                                              IdefixArray4D<accum> &Vsout) {
   #ifdef EVOLVE_VECTOR_POTENTIAL
     idfx::pushRegion("ConstrainedTransport::ComputeMagFieldfromA");
 
@@ -55,8 +57,8 @@ void ConstrainedTransport<Phys>::ComputeMagFieldFromA(IdefixArray4D<real> &Vein,
     IdefixArray3D<real> Ex3 = this->ez;
 
     // Field
-    IdefixArray4D<real> Vs = Vsout;
-    IdefixArray4D<real> Ve = Vein;
+    IdefixArray4D<accum> Vs = Vsout;
+    IdefixArray4D<accum> Ve = Vein;
 
     // Coordinates
     IdefixArray1D<real> x1=data->x[IDIR];
@@ -107,7 +107,7 @@ void Fluid<Phys>::ConvertConsToPrim() {
   idfx::pushRegion("Fluid::ConvertConsToPrim");
 
   IdefixArray4D<real> Vc = this->Vc;
-  IdefixArray4D<real> Uc = this->Uc;
+  IdefixArray4D<accum> Uc = this->Uc;
   EquationOfState eos;
   if constexpr(Phys::eos) {
     eos = *(this->eos.get());
@@ -154,7 +154,7 @@ void Fluid<Phys>::ConvertPrimToCons() {
   idfx::pushRegion("Fluid::ConvertPrimToCons");
 
   IdefixArray4D<real> Vc = this->Vc;
-  IdefixArray4D<real> Uc = this->Uc;
+  IdefixArray4D<accum> Uc = this->Uc;
   EquationOfState eos;
   if constexpr(Phys::eos) {
     eos = *(this->eos.get());
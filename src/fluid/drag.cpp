@@ -98,9 +98,14 @@ void Drag::ShowConfig() {
 
   idfx::cout << " drag law";
   if(feedback) {
-    idfx::cout << " with feedback." << std::endl;
+    idfx::cout << " with feedback";
   } else {
-    idfx::cout << " without feedback." << std::endl;
+    idfx::cout << " without feedback";
+  }
+  if(implicit) {
+    idfx::cout << ", integrated implicitly." << std::endl;
+  } else {
+    idfx::cout << "." << std::endl;
   }
 }
 
@@ -26,15 +26,18 @@ class Drag {
   void AddDragForce(const real);
   void EnrollUserDrag(UserDefDragFunc);   // User defined drag function enrollment
 
-  IdefixArray4D<real> UcDust;  // Dust conservative quantities
-  IdefixArray4D<real> UcGas;  // Gas conservative quantities
+  IdefixArray4D<accum> UcDust;  // Dust conservative quantities
+  IdefixArray4D<accum> UcGas;  // Gas conservative quantities
   IdefixArray4D<real> VcDust;  // Gas primitive quantities
   IdefixArray4D<real> VcGas;  // Gas primitive quantities
   IdefixArray3D<real> InvDt;  // The InvDt of current dust specie
   IdefixArray3D<real> gammai; // the drag coefficient (only used for user-defined dust grains)
   Type type;
+  bool isBatched{false};      // drag applied to all of the species by DustSpecies
+  bool implicit{false};       // implicit integration of the drag of all of the species
 
  private:
+  friend class DustSpecies;
   DataBlock* data;
   real dragCoeff;
   bool feedback{false};
@@ -97,6 +100,9 @@ Drag::Drag(Input &input, Fluid<Phys> *hydroin):
 
     // Feedback is true by default, but can be switched off.
     this->feedback = input.GetOrSet<bool>(BlockName,"drag_feedback",0,true);
+
+    // Implicit drag, applied to the gas and all of the dust species at once
+    this->implicit = input.GetOrSet<bool>(BlockName,"drag_implicit",0,false);
   } else {
     IDEFIX_ERROR("A [Drag] block is required in your input file to define the drag force.");
   }
@@ -0,0 +1,370 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <string>
+#include <vector>
+#include "dustSpecies.hpp"
+#include "dataBlock.hpp"
+#include "fluid.hpp"
+#include "drag.hpp"
+
+DustSpecies::DustSpecies(Input &input, DataBlock *datain) {
+  idfx::pushRegion("DustSpecies::DustSpecies");
+  this->data = datain;
+  this->nSpecies = input.Get<int>("Dust","nSpecies",0);
+  if(nSpecies < 1) {
+    IDEFIX_ERROR("The number of dust species should be >= 1");
+  }
+
+  // Same number of variables as in each dust fluid
+  this->nvar = DustPhysics::nvar;
+  if(input.CheckEntry("Dust","tracer")>=0) {
+    this->haveTracer = true;
+    this->nvar += input.Get<int>("Dust","tracer",0);
+  }
+
+  Vc = IdefixArray5D<real>("Dust_Vc", nSpecies, nvar,
+                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+  Uc = IdefixArray5D<accum>("Dust_Uc", nSpecies, nvar,
+                            data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+  InvDt = IdefixArray4D<real>("Dust_InvDt", nSpecies,
+                              data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+  idfx::popRegion();
+}
+
+void DustSpecies::Init() {
+  idfx::pushRegion("DustSpecies::Init");
+  // User-defined drag laws are computed species by species by the user, so they are left
+  // to each dust fluid, unless the drag is implicit.
+  Fluid<DustPhysics> *dust0 = data->dust[0].get();
+  if(dust0->haveDrag && (dust0->drag->implicit || dust0->drag->type != Drag::Type::Userdef)) {
+    haveBatchedDrag = true;
+    haveImplicitDrag = dust0->drag->implicit;
+    std::vector<real> coeffs;
+    for(int n = 0 ; n < nSpecies ; n++) {
+      coeffs.push_back(data->dust[n]->drag->dragCoeff);
+      data->dust[n]->drag->isBatched = true;
+    }
+    dragCoeff = idfx::ConvertVectorToIdefixArray(coeffs);
+    if(haveImplicitDrag && dust0->drag->type == Drag::Type::Userdef) {
+      gammai = IdefixArray4D<real>("Dust_UserDrag", nSpecies,
+                                   data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+    }
+  }
+  idfx::popRegion();
+}
+
+void DustSpecies::ShowConfig() {
+  idfx::cout << "DustSpecies: " << nSpecies << " species stored in a single array";
+  if(haveImplicitDrag) {
+    idfx::cout << ", drag integrated implicitly for all of the species at once." << std::endl;
+  } else if(haveBatchedDrag) {
+    idfx::cout << ", drag applied to all of the species at once." << std::endl;
+  } else {
+    idfx::cout << "." << std::endl;
+  }
+}
+
+void DustSpecies::ResetStage() {
+  idfx::pushRegion("DustSpecies::ResetStage");
+  IdefixArray4D<real> InvDt = this->InvDt;
+  idefix_for("DustResetStage",
+             0, nSpecies,
+             0, data->np_tot[KDIR],
+             0, data->np_tot[JDIR],
+             0, data->np_tot[IDIR],
+    KOKKOS_LAMBDA (int s, int k, int j, int i) {
+      InvDt(s,k,j,i) = ZERO_F;
+    });
+  idfx::popRegion();
+}
+
+void DustSpecies::ConvertConsToPrim() {
+  // Tracers are converted by the tracer object of each species
+  if(haveTracer) {
+    for(int n = 0 ; n < nSpecies ; n++) {
+      data->dust[n]->ConvertConsToPrim();
+    }
+    return;
+  }
+  idfx::pushRegion("DustSpecies::ConvertConsToPrim");
+  IdefixArray5D<real> Vc = this->Vc;
+  IdefixArray5D<accum> Uc = this->Uc;
+  EquationOfState eos;
+
+  idefix_for("DustConsToPrim",
+             0, nSpecies,
+             0, data->np_tot[KDIR],
+             0, data->np_tot[JDIR],
+             0, data->np_tot[IDIR],
+    KOKKOS_LAMBDA (int s, int k, int j, int i) {
+      real U[DustPhysics::nvar];
+      real V[DustPhysics::nvar];
+
+#pragma unroll
+      for(int nv = 0 ; nv < DustPhysics::nvar; nv++) {
+        U[nv] = Uc(s,nv,k,j,i);
+      }
+
+      K_ConsToPrim<DustPhysics>(V,U,&eos);
+
+#pragma unroll
+      for(int nv = 0 ; nv < DustPhysics::nvar; nv++) {
+        Vc(s,nv,k,j,i) = V[nv];
+      }
+    });
+  idfx::popRegion();
+}
+
+void DustSpecies::ConvertPrimToCons() {
+  if(haveTracer) {
+    for(int n = 0 ; n < nSpecies ; n++) {
+      data->dust[n]->ConvertPrimToCons();
+    }
+    return;
+  }
+  idfx::pushRegion("DustSpecies::ConvertPrimToCons");
+  IdefixArray5D<real> Vc = this->Vc;
+  IdefixArray5D<accum> Uc = this->Uc;
+  EquationOfState eos;
+
+  idefix_for("DustPrimToCons",
+             0, nSpecies,
+             0, data->np_tot[KDIR],
+             0, data->np_tot[JDIR],
+             0, data->np_tot[IDIR],
+    KOKKOS_LAMBDA (int s, int k, int j, int i) {
+      real U[DustPhysics::nvar];
+      real V[DustPhysics::nvar];
+
+#pragma unroll
+      for(int nv = 0 ; nv < DustPhysics::nvar; nv++) {
+        V[nv] = Vc(s,nv,k,j,i);
+      }
+
+      K_PrimToCons<DustPhysics>(U,V,&eos);
+
+#pragma unroll
+      for(int nv = 0 ; nv < DustPhysics::nvar; nv++) {
+        Uc(s,nv,k,j,i) = U[nv];
+      }
+    });
+  idfx::popRegion();
+}
+
+real DustSpecies::ComputeTimestep() {
+  auto InvDt = this->InvDt;
+  real dt;
+  idefix_reduce("Timestep_reduction_dust",
+          0, nSpecies,
+          data->beg[KDIR], data->end[KDIR],
+          data->beg[JDIR], data->end[JDIR],
+          data->beg[IDIR], data->end[IDIR],
+          KOKKOS_LAMBDA (int s, int k, int j, int i, real &dtmin) {
+                  dtmin=FMIN(ONE_F/InvDt(s,k,j,i),dtmin);
+              },
+          Kokkos::Min<real>(dt));
+  return(dt);
+}
+
+// Same drag force as Drag::AddDragForce, the gas quantities being loaded once for all of the
+// species. The species are accumulated in the same order as when they are applied one by one.
+void DustSpecies::AddDragForce(const real dt) {
+  if(haveImplicitDrag) {
+    AddImplicitDrag(dt);
+    return;
+  }
+  idfx::pushRegion("DustSpecies::AddDragForce");
+
+  auto UcGas = data->hydro->Uc;
+  auto VcGas = data->hydro->Vc;
+  auto UcDust = this->Uc;
+  auto VcDust = this->Vc;
+  auto InvDt = this->InvDt;
+  auto dragCoeff = this->dragCoeff;
+  const int nSpecies = this->nSpecies;
+
+  Drag *drag = data->dust[0]->drag.get();
+  const Drag::Type type = drag->type;
+  const bool feedback = drag->feedback;
+  EquationOfState eos = *(drag->eos);
+
+  idefix_for("DragForceAllSpecies",0,data->np_tot[KDIR],0,data->np_tot[JDIR],0,data->np_tot[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const real rhoGas = VcGas(RHO,k,j,i);
+      real cs = ZERO_F;
+      if(type == Drag::Type::Size) {
+        #if HAVE_ENERGY == 1
+          cs = std::sqrt(eos.GetGamma(VcGas(PRS,k,j,i),VcGas(RHO,k,j,i)
+                         *VcGas(PRS,k,j,i)/VcGas(RHO,k,j,i)));
+        #else
+          cs = eos.GetWaveSpeed(k,j,i);
+        #endif
+      }
+
+      accum gasMomentum[COMPONENTS];
+      for(int n = 0 ; n < COMPONENTS ; n++) {
+        gasMomentum[n] = UcGas(MX1+n,k,j,i);
+      }
+      #if HAVE_ENERGY == 1
+        accum gasEnergy = UcGas(ENG,k,j,i);
+      #endif
+
+      for(int s = 0 ; s < nSpecies ; s++) {
+        real gamma;  // The drag coefficient
+        if(type == Drag::Type::Gamma) {
+          gamma = dragCoeff(s);
+        } else if(type == Drag::Type::Tau) {
+          gamma = 1/(dragCoeff(s)*rhoGas);
+        } else {
+          gamma = cs/dragCoeff(s);
+        }
+
+        real dp = dt * gamma * VcDust(s,RHO,k,j,i) * rhoGas;
+        for(int n = 0 ; n < COMPONENTS ; n++) {
+          real dv = VcDust(s,MX1+n,k,j,i) - VcGas(MX1+n,k,j,i);
+          UcDust(s,MX1+n,k,j,i) -= dp*dv;
+          if(feedback) gasMomentum[n] += dp*dv;
+          #if HAVE_ENERGY == 1
+            gasEnergy += dp*dv*VcDust(s,MX1+n,k,j,i);
+          #endif
+        }
+        // Cfl constraint
+        real idt = gamma*rhoGas;
+        if(feedback) idt += gamma*VcDust(s,RHO,k,j,i);
+        InvDt(s,k,j,i) += idt;
+      }
+
+      if(feedback) {
+        for(int n = 0 ; n < COMPONENTS ; n++) {
+          UcGas(MX1+n,k,j,i) = gasMomentum[n];
+        }
+      }
+      #if HAVE_ENERGY == 1
+        UcGas(ENG,k,j,i) = gasEnergy;
+      #endif
+    });
+  idfx::popRegion();
+}
+
+// Backward Euler integration of the drag between the gas and all of the dust species, from the
+// state updated by the fluxes. With a_s = dt*gamma_s*rho_g, the velocities are the solution of
+//   v_s' = (v_s + a_s v_g')/(1+a_s)
+//   (rho_g + sum_s w_s) v_g' = rho_g v_g + sum_s w_s v_s,     w_s = rho_s a_s/(1+a_s)
+// which conserves the total momentum. The kinetic energy lost by the dust is given to the gas,
+// as for the explicit drag. The drag no longer contributes to InvDt.
+void DustSpecies::AddImplicitDrag(const real dt) {
+  idfx::pushRegion("DustSpecies::AddImplicitDrag");
+
+  auto UcGas = data->hydro->Uc;
+  auto VcGas = data->hydro->Vc;
+  auto UcDust = this->Uc;
+  auto dragCoeff = this->dragCoeff;
+  auto gammai = this->gammai;
+  const int nSpecies = this->nSpecies;
+
+  Drag *drag = data->dust[0]->drag.get();
+  const Drag::Type type = drag->type;
+  const bool feedback = drag->feedback;
+  EquationOfState eos = *(drag->eos);
+
+  if(type == Drag::Type::Userdef) {
+    idfx::pushRegion("Drag::UserDrag");
+    for(int s = 0 ; s < nSpecies ; s++) {
+      Drag *dragS = data->dust[s]->drag.get();
+      if(dragS->userDrag == NULL) {
+        IDEFIX_ERROR("No User-defined drag function has been enrolled");
+      }
+      IdefixArray3D<real> gammaS = Kokkos::subview(gammai, s,
+                                            Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL());
+      dragS->userDrag(data, dragS->dragCoeff, gammaS);
+    }
+    idfx::popRegion();
+  }
+
+  idefix_for("ImplicitDrag",
+             data->beg[KDIR],data->end[KDIR],
+             data->beg[JDIR],data->end[JDIR],
+             data->beg[IDIR],data->end[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const real rhoGas = UcGas(RHO,k,j,i);
+      real cs = ZERO_F;
+      if(type == Drag::Type::Size) {
+        #if HAVE_ENERGY == 1
+          cs = std::sqrt(eos.GetGamma(VcGas(PRS,k,j,i),VcGas(RHO,k,j,i)
+                         *VcGas(PRS,k,j,i)/VcGas(RHO,k,j,i)));
+        #else
+          cs = eos.GetWaveSpeed(k,j,i);
+        #endif
+      }
+
+      // Gas velocity at the end of the step
+      real rhoTot = rhoGas;
+      real vGas[COMPONENTS];
+      for(int n = 0 ; n < COMPONENTS ; n++) {
+        vGas[n] = UcGas(MX1+n,k,j,i);
+      }
+      if(feedback) {
+        for(int s = 0 ; s < nSpecies ; s++) {
+          real gamma;
+          if(type == Drag::Type::Gamma) {
+            gamma = dragCoeff(s);
+          } else if(type == Drag::Type::Tau) {
+            gamma = 1/(dragCoeff(s)*rhoGas);
+          } else if(type == Drag::Type::Size) {
+            gamma = cs/dragCoeff(s);
+          } else {
+            gamma = gammai(s,k,j,i);
+          }
+          const real a = dt*gamma*rhoGas;
+          const real rhoDust = UcDust(s,RHO,k,j,i);
+          const real w = a/(ONE_F+a);
+          rhoTot += w*rhoDust;
+          for(int n = 0 ; n < COMPONENTS ; n++) {
+            vGas[n] += w*UcDust(s,MX1+n,k,j,i);
+          }
+        }
+      }
+      for(int n = 0 ; n < COMPONENTS ; n++) {
+        vGas[n] /= rhoTot;
+      }
+
+      // Dust velocities
+      real dKin = ZERO_F;
+      for(int s = 0 ; s < nSpecies ; s++) {
+        real gamma;
+        if(type == Drag::Type::Gamma) {
+          gamma = dragCoeff(s);
+        } else if(type == Drag::Type::Tau) {
+          gamma = 1/(dragCoeff(s)*rhoGas);
+        } else if(type == Drag::Type::Size) {
+          gamma = cs/dragCoeff(s);
+        } else {
+          gamma = gammai(s,k,j,i);
+        }
+        const real a = dt*gamma*rhoGas;
+        const real rhoDust = UcDust(s,RHO,k,j,i);
+        for(int n = 0 ; n < COMPONENTS ; n++) {
+          const real v = UcDust(s,MX1+n,k,j,i)/rhoDust;
+          const real vNew = (v + a*vGas[n])/(ONE_F+a);
+          dKin += HALF_F*rhoDust*(vNew*vNew - v*v);
+          UcDust(s,MX1+n,k,j,i) = rhoDust*vNew;
+        }
+      }
+
+      if(feedback) {
+        for(int n = 0 ; n < COMPONENTS ; n++) {
+          UcGas(MX1+n,k,j,i) = rhoGas*vGas[n];
+        }
+      }
+      #if HAVE_ENERGY == 1
+        // Total energy conservation: the gas gets the kinetic energy lost by the dust
+        UcGas(ENG,k,j,i) -= dKin;
+      #endif
+    });
+  idfx::popRegion();
+}
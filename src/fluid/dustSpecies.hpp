@@ -0,0 +1,52 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef FLUID_DUSTSPECIES_HPP_
+#define FLUID_DUSTSPECIES_HPP_
+
+#include "idefix.hpp"
+#include "input.hpp"
+
+class DataBlock;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+/// Storage of all of the dust species in single (species, var, k, j, i) arrays. The Vc, Uc and
+/// InvDt arrays of each dust fluid are views of its species in these arrays, so that the
+/// kernels which do not depend on the Riemann solver (variable conversions, time step and drag)
+/// are applied to all of the species in a single launch. The drag can also be integrated
+/// implicitly, coupling the gas and all of the species in each cell.
+//////////////////////////////////////////////////////////////////////////////////////////////////
+class DustSpecies {
+ public:
+  DustSpecies(Input &, DataBlock *);
+  void Init();                      // Enable the batched kernels once the dust fluids exist
+  void ShowConfig();
+
+  void ResetStage();
+  void ConvertConsToPrim();
+  void ConvertPrimToCons();
+  real ComputeTimestep();
+  void AddDragForce(const real);
+  void AddImplicitDrag(const real);
+
+  IdefixArray5D<real> Vc;           // Primitive variables of all of the species
+  IdefixArray5D<accum> Uc;          // Conservative variables of all of the species
+  IdefixArray4D<real> InvDt;        // Inverse time step of all of the species
+
+  int nSpecies;
+  int nvar;                         // Number of variables of each species (including tracers)
+  bool haveBatchedDrag{false};      // Whether the drag of all of the species is applied at once
+  bool haveImplicitDrag{false};     // Whether this drag is integrated implicitly
+
+ private:
+  DataBlock *data;
+  bool haveTracer{false};
+  IdefixArray1D<real> dragCoeff;    // Drag coefficient of each species
+  IdefixArray4D<real> gammai;       // User-defined drag coefficients of the implicit drag
+};
+
+#endif // FLUID_DUSTSPECIES_HPP_
@@ -40,6 +40,13 @@ template<typename T>
 void Fluid<Phys>::EnrollFluxBoundary(T myFunc) {
   // This is a proxy for userdef enrollment
   boundary->EnrollFluxBoundary(myFunc);
+  if(haveFusedSweep) {
+    // Flux boundaries need the intercell fluxes stored in FluxRiemann
+    IDEFIX_WARNING("User-defined flux boundaries are not compatible with fusedSweep "
+                   "and mpiOverlap, which are now disabled.");
+    haveFusedSweep = false;
+    haveMpiOverlap = false;
+  }
 }
 
 template<typename Phys>
@@ -10,9 +10,14 @@
 
 #include "fluid.hpp"
 #include "riemannSolver.hpp"
+#include "localTimeStepping.hpp"
 template<typename Phys>
 template<int dir>
 void Fluid<Phys>::LoopDir(const real t, const real dt) {
+  if(haveFusedSweep) {
+    // Steps 2 and 3 in a single kernel, the intercell fluxes are not stored in FluxRiemann
+    FusedSweep<dir>(t,dt,data->beg,data->end);
+  } else {
     // Step 2: compute the intercell flux with our Riemann solver, store the resulting InvDt
     this->rSolver->template CalcFlux<dir>(this->FluxRiemann);
 
@@ -30,8 +35,14 @@ void Fluid<Phys>::LoopDir(const real t, const real dt) {
       this->tracer->template CalcRightHandSide<dir, Phys>(this->FluxRiemann,t ,dt);
     }
 
-    // Recursive: do next dimension
-    if constexpr (dir+1 < DIMENSIONS) LoopDir<dir+1>(t, dt);
+    // Local time stepping: keep the fluxes through the interfaces between bands
+    if constexpr(dir == IDIR) {
+      if(data->haveLocalTimeStepping) data->lts->AccumulateFlux(this->FluxRiemann);
+    }
+  }
+
+  // Recursive: do next dimension
+  if constexpr (dir+1 < DIMENSIONS) LoopDir<dir+1>(t, dt);
 }
 
 
@@ -55,28 +66,38 @@ void Fluid<Phys>::EvolveStage(const real t, const real dt) {
   }
 
   // Loop on all of the directions
-  LoopDir<IDIR>(t,dt);
+  if(haveMpiOverlap) {
+    // Also completes the boundary conditions started by SetBoundariesBegin
+    OverlapSweeps(t,dt);
+  } else {
+    LoopDir<IDIR>(t,dt);
+  }
 
   // Step 4: add source terms to the conserved variables (curvature, rotation, etc)
   if(haveSourceTerms) AddSourceTerms(t, dt);
 
-  // Step 5: add drag when needed
-  if(haveDrag) drag->AddDragForce(dt);
+  // Step 5: add drag when needed (unless it is applied to all of the dust species at once)
+  if(haveDrag && !drag->isBatched) drag->AddDragForce(dt);
 
   if constexpr(Phys::mhd) {
     #if DIMENSIONS >= 2
       // Compute the field evolution according to CT
-      emf->CalcCornerEMF(t);
-      if(resistivityStatus.isExplicit || ambipolarStatus.isExplicit) {
-        emf->CalcNonidealEMF(t);
+      if(emf->haveFusedUpdate) {
+        // Corner EMFs, boundary conditions and field update in a single pass
+        emf->EvolveMagFieldFused(t, dt, Vs);
+      } else {
+        emf->CalcCornerEMF(t);
+        if(resistivityStatus.isExplicit || ambipolarStatus.isExplicit) {
+          emf->CalcNonidealEMF(t);
+        }
+        emf->EnforceEMFBoundary();
+        #ifdef EVOLVE_VECTOR_POTENTIAL
+          emf->EvolveVectorPotential(dt, Ve);
+          emf->ComputeMagFieldFromA(Ve, Vs);
+        #else
+          emf->EvolveMagField(t, dt, Vs);
+        #endif
       }
-      emf->EnforceEMFBoundary();
-      #ifdef EVOLVE_VECTOR_POTENTIAL
-        emf->EvolveVectorPotential(dt, Ve);
-        emf->ComputeMagFieldFromA(Ve, Vs);
-      #else
-        emf->EvolveMagField(t, dt, Vs);
-      #endif
 
       boundary->ReconstructVcField(Uc);
     #endif
@@ -11,6 +11,7 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <array>
 
 #include "idefix.hpp"
 #include "grid.hpp"
@@ -59,10 +60,17 @@ class Fluid {
   template <int> void CalcParabolicFlux(const real);
   template <int> void AddNonIdealMHDFlux(const real);
   template <int> void CalcRightHandSide(real, real );
+  template <int> void FusedSweep(const real, const real,
+                                 const std::array<int,3> &, const std::array<int,3> &);
+  template <int, typename Solver> void FusedSweepKernel(Solver, const real,
+                                                        const std::array<int,3> &,
+                                                        const std::array<int,3> &);
+  void FusedSweepBox(const real, const real, const std::array<int,3> &, const std::array<int,3> &);
+  void OverlapSweeps(const real, const real);
   void CalcCurrent();
   void AddSourceTerms(real, real );
-  void CoarsenFlow(IdefixArray4D<real>&);
-  void CoarsenMagField(IdefixArray4D<real>&);
+  template <typename T> void CoarsenFlow(IdefixArray4D<T>&);
+  void CoarsenMagField(IdefixArray4D<accum>&);
   real CheckDivB();
   void EvolveStage(const real, const real);
   void ResetStage();
@@ -79,6 +87,12 @@ class Fluid {
   // Source terms
   bool haveSourceTerms{false};
 
+  // Fused directional sweeps (Riemann solver and right hand side in a single kernel)
+  bool haveFusedSweep{false};
+
+  // Overlap of the MPI exchanges with the integration of the interior cells
+  bool haveMpiOverlap{false};
+
   // Parabolic terms
   bool haveExplicitParabolicTerms{false};
   bool haveRKLParabolicTerms{false};
@@ -165,9 +179,9 @@ class Fluid {
 
   // Arrays required by the Hydro object
   IdefixArray4D<real> Vc;      // Main cell-centered primitive variables index
-  IdefixArray4D<real> Vs;      // Main face-centered varariables
-  IdefixArray4D<real> Ve;      // Main edge-centered varariables (only when EVOLVE_VECTOR_POTENTIAL)
-  IdefixArray4D<real> Uc;      // Main cell-centered conservative variables
+  IdefixArray4D<accum> Vs;     // Main face-centered varariables
+  IdefixArray4D<accum> Ve;     // Main edge-centered varariables (only when EVOLVE_VECTOR_POTENTIAL)
+  IdefixArray4D<accum> Uc;     // Main cell-centered conservative variables
   IdefixArray4D<real> J;       // Electrical current
                                // (only defined when non-ideal MHD effects are enabled)
 
@@ -258,6 +272,7 @@ class Fluid {
 #include "drag.hpp"
 #include "checkNan.hpp"
 #include "tracer.hpp"
+#include "dustSpecies.hpp"
 
 
 template<typename Phys>
@@ -275,7 +290,7 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
   // Keep the instance # for later use
   instanceNumber = n;
 
-  #if ORDER < 1 || ORDER > 4
+  #if ORDER < 1 || ORDER > 5
      IDEFIX_ERROR("Reconstruction at chosen order is not implemented. Check your definitions file");
   #endif
 
@@ -526,15 +541,28 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
   /////////////////////////////////////////
 
   // We now allocate the fields required by the hydro solver
-  Vc = IdefixArray4D<real>(prefix+"_Vc", Phys::nvar+nTracer,
-                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-  Uc = IdefixArray4D<real>(prefix+"_Uc", Phys::nvar+nTracer,
-                           data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+  if(Phys::dust && data->dustSpecies) {
+    // Dust species are views of the arrays holding all of the species
+    Vc = Kokkos::subview(data->dustSpecies->Vc, n,
+                         Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL());
+    Uc = Kokkos::subview(data->dustSpecies->Uc, n,
+                         Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL());
+  } else {
+    Vc = IdefixArray4D<real>(prefix+"_Vc", Phys::nvar+nTracer,
+                             data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+    Uc = IdefixArray4D<accum>(prefix+"_Uc", Phys::nvar+nTracer,
+                             data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+  }
 
   data->states["current"].PushArray(Uc, State::center, prefix+"_Uc");
 
-  InvDt = IdefixArray3D<real>(prefix+"_InvDt",
-                              data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+  if(Phys::dust && data->dustSpecies) {
+    InvDt = Kokkos::subview(data->dustSpecies->InvDt, n,
+                            Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL());
+  } else {
+    InvDt = IdefixArray3D<real>(prefix+"_InvDt",
+                                data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
+  }
   cMax = IdefixArray3D<real>(prefix+"_cMax",
                               data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
   dMax = IdefixArray3D<real>(prefix+"_dMax",
@@ -543,13 +571,13 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
                                      data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
 
   if constexpr(Phys::mhd) {
-    Vs = IdefixArray4D<real>(prefix+"_Vs", DIMENSIONS,
+    Vs = IdefixArray4D<accum>(prefix+"_Vs", DIMENSIONS,
               data->np_tot[KDIR]+KOFFSET, data->np_tot[JDIR]+JOFFSET, data->np_tot[IDIR]+IOFFSET);
     #ifdef EVOLVE_VECTOR_POTENTIAL
       #if DIMENSIONS == 1
         IDEFIX_ERROR("EVOLVE_VECTOR_POTENTIAL is not compatible with 1D MHD");
       #else
-        Ve = IdefixArray4D<real>(prefix+"_Ve", AX3e+1,
+        Ve = IdefixArray4D<accum>(prefix+"_Ve", AX3e+1,
               data->np_tot[KDIR]+KOFFSET, data->np_tot[JDIR]+JOFFSET, data->np_tot[IDIR]+IOFFSET);
 
         data->states["current"].PushArray(Ve, State::center, prefix+"_Ve");
@@ -697,6 +725,11 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
   //** Child object allocation section
   //*********************************************
 
+  // Initialise the EOS (before the Riemann solver, whose reconstruction may use it)
+  if constexpr(Phys::eos) {
+    this->eos = std::make_unique<EquationOfState>(input, data, this->prefix);
+  }
+
     // Initialise Riemann Solver
   this->rSolver = std::make_unique<RiemannSolver<Phys>>(input, this);
 
@@ -704,11 +737,6 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
     this->emf = std::make_unique<ConstrainedTransport<Phys>>(input, this);
   }
 
-  // Initialise the EOS
-  if constexpr(Phys::eos) {
-    this->eos = std::make_unique<EquationOfState>(input, data, this->prefix);
-  }
-
   // Initialise boundary conditions
   boundary = std::make_unique<Boundary<Phys>>(this);
   this->haveAxis = data->haveAxis;
@@ -748,6 +776,54 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
     this->tracer= std::make_unique<Tracer>(this, nTracer);
   }
 
+  // Exchange with all of the MPI neighbours in a single phase
+  if(input.CheckEntry(std::string(Phys::prefix),"mpiExchangeAll")>=0) {
+    if(input.Get<bool>(std::string(Phys::prefix),"mpiExchangeAll",0)) {
+      boundary->EnableMpiExchangeAll();
+    }
+  }
+
+  // Fused directional sweeps
+  if(input.CheckEntry(std::string(Phys::prefix),"fusedSweep")>=0) {
+    this->haveFusedSweep = input.Get<bool>(std::string(Phys::prefix),"fusedSweep",0);
+  }
+  // Overlap of MPI exchanges and interior cells integration, which relies on fused sweeps
+  if(input.CheckEntry(std::string(Phys::prefix),"mpiOverlap")>=0) {
+    this->haveMpiOverlap = input.Get<bool>(std::string(Phys::prefix),"mpiOverlap",0);
+  }
+  if(haveMpiOverlap) {
+    if(rSolver->shockFlattening) {
+      IDEFIX_ERROR("mpiOverlap is not compatible with shock flattening");
+    }
+    if(input.CheckBlock("Fargo")) {
+      IDEFIX_ERROR("mpiOverlap is not compatible with Fargo");
+    }
+    #ifdef WITH_MPI
+      if(!Mpi::HaveAsyncExchanges()) {
+        IDEFIX_ERROR("mpiOverlap requires the MPI_PERSISTENT or MPI_NON_BLOCKING exchanges "
+                     "of mpi.cpp");
+      }
+    #endif
+    this->haveFusedSweep = true;
+  }
+  if(haveFusedSweep) {
+    if constexpr(Phys::mhd || Phys::dust) {
+      IDEFIX_ERROR("fusedSweep is only implemented for HD fluids");
+    }
+    if(haveTracer) {
+      IDEFIX_ERROR("fusedSweep is not compatible with passive tracers");
+    }
+    if(haveExplicitParabolicTerms) {
+      IDEFIX_ERROR("fusedSweep is not compatible with explicit parabolic terms. "
+                   "Use rkl integration for these terms instead.");
+    }
+    #if DIMENSIONS == 1
+      if(rSolver->GetSolver() == RiemannSolver<Phys>::ROE) {
+        IDEFIX_ERROR("fusedSweep is not compatible with the Roe solver in 1D");
+      }
+    #endif
+  }
+
   idfx::popRegion();
 }
 
@@ -759,6 +835,7 @@ Fluid<Phys>::Fluid(Grid &grid, Input &input, DataBlock *datain, int n) {
 #include "coarsenFlow.hpp"
 #include "convertConsToPrim.hpp"
 #include "checkDivB.hpp"
+#include "fusedSweep.hpp"
 #include "evolveStage.hpp"
 #include "showConfig.hpp"
 #endif // FLUID_FLUID_HPP_
@@ -0,0 +1,238 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef FLUID_FUSEDSWEEP_HPP_
+#define FLUID_FUSEDSWEEP_HPP_
+
+#include <algorithm>
+#include "fluid.hpp"
+#include "dataBlock.hpp"
+#include "riemannSolver.hpp"
+#include "calcRightHandSide.hpp"
+
+// Forward declarations of the HD Riemann solvers (see RiemannSolver/HDsolvers)
+template <typename Phys, int dir>
+struct RiemannSolver_HllHDFunctor;
+template <typename Phys, int dir>
+struct RiemannSolver_HllcHDFunctor;
+template <typename Phys, int dir>
+struct RiemannSolver_RoeHDFunctor;
+template <typename Phys, int dir>
+struct RiemannSolver_TvdlfHDFunctor;
+
+// Number of cells along the sweep direction handled by a single team for the JDIR and KDIR
+// sweeps. Each team computes fusedSweepTile+1 rows of interfaces, so that the fluxes of the
+// interfaces shared by two neighbouring tiles are computed twice.
+constexpr int fusedSweepTile = 8;
+
+// Fused directional sweep: compute the intercell fluxes with our Riemann solver and
+// immediately apply their divergence to Uc, without storing the fluxes in FluxRiemann.
+// Only the active cells in the box [beg,end) are updated.
+template<typename Phys>
+template<int dir>
+void Fluid<Phys>::FusedSweep(const real t, const real dt,
+                             const std::array<int,3> &beg, const std::array<int,3> &end) {
+  idfx::pushRegion("Fluid::FusedSweep");
+  if constexpr(!Phys::mhd && !Phys::dust) {
+    if constexpr(dir == IDIR) {
+      // enable shock flattening
+      if(rSolver->shockFlattening) rSolver->shockFlattening->FindShock();
+    }
+
+    // Update fargo velocity when needed
+    if(data->haveFargo && data->fargo->type == Fargo::userdef) {
+      data->fargo->GetFargoVelocity(t);
+    }
+
+    RiemannSolver<Phys> *rs = rSolver.get();
+    switch(rSolver->GetSolver()) {
+      case RiemannSolver<Phys>::TVDLF:
+        FusedSweepKernel<dir>(RiemannSolver_TvdlfHDFunctor<Phys,dir>(rs), dt, beg, end);
+        break;
+      case RiemannSolver<Phys>::HLL:
+        FusedSweepKernel<dir>(RiemannSolver_HllHDFunctor<Phys,dir>(rs), dt, beg, end);
+        break;
+      case RiemannSolver<Phys>::HLLC:
+        FusedSweepKernel<dir>(RiemannSolver_HllcHDFunctor<Phys,dir>(rs), dt, beg, end);
+        break;
+      case RiemannSolver<Phys>::ROE:
+        FusedSweepKernel<dir>(RiemannSolver_RoeHDFunctor<Phys,dir>(rs), dt, beg, end);
+        break;
+      default:
+        IDEFIX_ERROR("Internal error: fused sweeps only support HD Riemann solvers");
+        break;
+    }
+  } else {
+    IDEFIX_ERROR("Internal error: fused sweeps are not implemented for this fluid");
+  }
+  idfx::popRegion();
+}
+
+template<typename Phys>
+template<int dir, typename Solver>
+void Fluid<Phys>::FusedSweepKernel(Solver solver, const real dt,
+                                   const std::array<int,3> &beg, const std::array<int,3> &end) {
+  // Fluxes (and signal speed) of the interfaces of the cells handled by a team
+  using ScratchArray = Kokkos::View<real**,
+                                    Kokkos::DefaultExecutionSpace::scratch_memory_space,
+                                    Kokkos::MemoryTraits<Kokkos::Unmanaged>>;
+
+  auto fluxCorrection = Fluid_CorrectFluxFunctor<Phys,dir>(this,dt);
+  auto calcRHS = Fluid_CalcRHSFunctor<Phys,dir>(this,dt);
+
+  const int ibeg = beg[IDIR];
+  const int jbeg = beg[JDIR];
+  const int kbeg = beg[KDIR];
+  const int ni = end[IDIR] - beg[IDIR];
+  const int nj = end[JDIR] - beg[JDIR];
+  const int nk = end[KDIR] - beg[KDIR];
+  if(ni <= 0 || nj <= 0 || nk <= 0) return;
+
+  // A team treats one line of cells along IDIR, or a tile of ntile lines along IDIR
+  // stacked in the JDIR or KDIR direction.
+  const int nDir = end[dir] - beg[dir];
+  const int ntile = (dir == IDIR) ? 1 : std::min(fusedSweepTile, nDir);
+  const int nTilesDir = (dir == IDIR) ? 1 : (nDir + ntile - 1) / ntile;
+  const int nFaces = (dir == IDIR) ? ni+1 : (ntile+1)*ni;
+
+  const int league = (dir == IDIR) ? nk*nj : ((dir == JDIR) ? nk*nTilesDir : nj*nTilesDir);
+
+  const size_t scratchSize = ScratchArray::shmem_size(Phys::nvar+1, nFaces);
+  const int scratchLevel = (scratchSize <= team_policy::scratch_size_max(0)) ? 0 : 1;
+
+  Kokkos::parallel_for("FusedSweep",
+    team_policy(league, Kokkos::AUTO, KOKKOS_VECTOR_LENGTH)
+      .set_scratch_size(scratchLevel, Kokkos::PerTeam(scratchSize)),
+    KOKKOS_LAMBDA (member_type team) {
+      ScratchArray F(team.team_scratch(scratchLevel), Phys::nvar+1, nFaces);
+
+      // Locate the tile of this team. s0 is the first cell of the tile along dir
+      // and ns its number of cells along dir
+      int k = kbeg;
+      int j = jbeg;
+      int s0, ns;
+      if constexpr(dir == IDIR) {
+        k += team.league_rank() / nj;
+        j += team.league_rank() % nj;
+        s0 = ibeg;
+        ns = ni;
+      }
+      if constexpr(dir == JDIR) {
+        k += team.league_rank() / nTilesDir;
+        s0 = jbeg + (team.league_rank() % nTilesDir) * ntile;
+        ns = (s0 + ntile <= jbeg + nj) ? ntile : jbeg + nj - s0;
+      }
+      if constexpr(dir == KDIR) {
+        j += team.league_rank() / nTilesDir;
+        s0 = kbeg + (team.league_rank() % nTilesDir) * ntile;
+        ns = (s0 + ntile <= kbeg + nk) ? ntile : kbeg + nk - s0;
+      }
+
+      // Step 1: intercell fluxes, corrected for fargo/non-cartesian geometry
+      const int nf = (dir == IDIR) ? ns+1 : (ns+1)*ni;
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(team, nf), [&] (const int f) {
+        int kf = k;
+        int jf = j;
+        int i;
+        if constexpr(dir == IDIR) {
+          i = s0 + f;
+        } else {
+          const int r = f / ni;
+          i = ibeg + f - r*ni;
+          if constexpr(dir == JDIR) jf = s0 + r;
+          if constexpr(dir == KDIR) kf = s0 + r;
+        }
+        real flux[Phys::nvar];
+        real cmax;
+        solver(kf, jf, i, flux, cmax);
+        fluxCorrection.CorrectFlux(kf, jf, i, flux);
+
+        for(int nv = 0 ; nv < Phys::nvar ; nv++) {
+          F(nv,f) = flux[nv];
+        }
+        F(Phys::nvar,f) = cmax;
+      });
+
+      team.team_barrier();
+
+      // Step 2: conserved quantity budget from the fluxes divergence
+      // The right interface of cell c is interface c+stride in F
+      const int nc = (dir == IDIR) ? ns : ns*ni;
+      const int stride = (dir == IDIR) ? 1 : ni;
+      Kokkos::parallel_for(Kokkos::TeamVectorRange(team, nc), [&] (const int c) {
+        int kc = k;
+        int jc = j;
+        int i;
+        if constexpr(dir == IDIR) {
+          i = s0 + c;
+        } else {
+          const int r = c / ni;
+          i = ibeg + c - r*ni;
+          if constexpr(dir == JDIR) jc = s0 + r;
+          if constexpr(dir == KDIR) kc = s0 + r;
+        }
+        real FL[Phys::nvar];
+        real FR[Phys::nvar];
+        for(int nv = 0 ; nv < Phys::nvar ; nv++) {
+          FL[nv] = F(nv,c);
+          FR[nv] = F(nv,c+stride);
+        }
+        calcRHS.Apply(kc, jc, i, FL, FR, F(Phys::nvar,c), F(Phys::nvar,c+stride));
+      });
+    });
+}
+
+// Integrate the active cells in the box [beg,end) in all of the directions
+template<typename Phys>
+void Fluid<Phys>::FusedSweepBox(const real t, const real dt,
+                                const std::array<int,3> &beg, const std::array<int,3> &end) {
+  FusedSweep<IDIR>(t, dt, beg, end);
+  if constexpr(DIMENSIONS >= 2) FusedSweep<JDIR>(t, dt, beg, end);
+  if constexpr(DIMENSIONS == 3) FusedSweep<KDIR>(t, dt, beg, end);
+}
+
+// Overlap the MPI exchanges started by Boundary::SetBoundariesBegin with the integration of
+// the interior cells, whose stencil does not reach the ghost zones which are still to be
+// filled. The boundary shell is integrated once SetBoundariesEnd has completed.
+// Each cell receives the contributions of the directions in the same order as in LoopDir, so
+// that the result does not depend on the overlap.
+template<typename Phys>
+void Fluid<Phys>::OverlapSweeps(const real t, const real dt) {
+  idfx::pushRegion("Fluid::OverlapSweeps");
+  std::array<int,3> inBeg = data->beg;
+  std::array<int,3> inEnd = data->end;
+  for(int dir = boundary->pendingDir ; dir < DIMENSIONS ; dir++) {
+    inBeg[dir] = std::min(data->beg[dir] + data->nghost[dir], data->end[dir]);
+    inEnd[dir] = std::max(data->end[dir] - data->nghost[dir], inBeg[dir]);
+  }
+
+  // Interior cells
+  FusedSweepBox(t, dt, inBeg, inEnd);
+
+  // Complete the MPI exchanges and the other boundary conditions
+  boundary->SetBoundariesEnd(t);
+
+  // Boundary shell, decomposed in slabs: along KDIR first, then JDIR and IDIR, each slab
+  // being restricted to the interior in the directions already treated.
+  std::array<int,3> beg = data->beg;
+  std::array<int,3> end = data->end;
+  for(int dir = DIMENSIONS-1 ; dir >= 0 ; dir--) {
+    beg[dir] = data->beg[dir];
+    end[dir] = inBeg[dir];
+    FusedSweepBox(t, dt, beg, end);
+
+    beg[dir] = inEnd[dir];
+    end[dir] = data->end[dir];
+    FusedSweepBox(t, dt, beg, end);
+
+    beg[dir] = inBeg[dir];
+    end[dir] = inEnd[dir];
+  }
+  idfx::popRegion();
+}
+
+#endif // FLUID_FUSEDSWEEP_HPP_
@@ -39,8 +39,22 @@ void Fluid<Phys>::ShowConfig() {
     idfx::cout << "3rd order (LimO3)" << std::endl;
   #elif ORDER == 4
     idfx::cout << "4th order (PPM)" << std::endl;
+  #elif ORDER == 5
+    idfx::cout << "5th order (WENO-Z)" << std::endl;
   #endif
 
+  if(haveFusedSweep) {
+    idfx::cout << Phys::prefix << ": Fused directional sweeps ENABLED." << std::endl;
+  }
+  if(boundary->haveMpiExchangeAll) {
+    idfx::cout << Phys::prefix << ": MPI exchanges with all the neighbours in a single phase."
+               << std::endl;
+  }
+  if(haveMpiOverlap) {
+    idfx::cout << Phys::prefix << ": MPI exchanges overlapped with interior cells integration."
+               << std::endl;
+  }
+
 
 
   if(haveRotation) {
@@ -13,7 +13,7 @@ void Tracer::ConvertConsToPrim() {
   idfx::pushRegion("Tracer::ConvertConsToPrim");
 
   IdefixArray4D<real> Vc = this->Vc;
-  IdefixArray4D<real> Uc = this->Uc;
+  IdefixArray4D<accum> Uc = this->Uc;
 
   idefix_for("ConsToPrimScalar",
             nVar, nVar+nTracer,   // Loop on the index where scalars are lying
@@ -34,7 +34,7 @@ void Tracer::ConvertPrimToCons() {
   idfx::pushRegion("Tracer::ConvertPrimToCons");
 
   IdefixArray4D<real> Vc = this->Vc;
-  IdefixArray4D<real> Uc = this->Uc;
+  IdefixArray4D<accum> Uc = this->Uc;
 
   idefix_for("PrimToConsScalar",
              nVar, nVar+nTracer,  // Loop on the index where scalars are lying
@@ -27,7 +27,7 @@ class Tracer {
 
  private:
   IdefixArray4D<real> Vc;  // Vector of primitive variables for the passive tracer
-  IdefixArray4D<real> Uc;  // Vector of conservative variables for the passive tracer
+  IdefixArray4D<accum> Uc;  // Vector of conservative variables for the passive tracer
 
   std::string prefix;
 
@@ -59,7 +59,7 @@ void Tracer::CalcFlux(IdefixArray4D<real> &Flux) {
   idfx::pushRegion("Tracer::CalcFlux");
 
   IdefixArray4D<real> Vc = this->Vc;
-  IdefixArray4D<real> Uc = this->Uc;
+  IdefixArray4D<accum> Uc = this->Uc;
   IdefixArray3D<real> A    = data->A[dir];
 
   constexpr int ioffset = (dir==IDIR ? 1 : 0);
@@ -103,7 +103,7 @@ template <int dir, typename Phys>
 void Tracer::CalcRightHandSide(IdefixArray4D<real> &Flux, real t, real dt) {
   idfx::pushRegion("Tracer::ComputeRHS");
 
-  IdefixArray4D<real> Uc = this->Uc;
+  IdefixArray4D<accum> Uc = this->Uc;
   IdefixArray3D<real> dV  = data->dV;
 
   constexpr int ioffset = (dir==IDIR ? 1 : 0);
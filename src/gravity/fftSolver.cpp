@@ -0,0 +1,345 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <algorithm>
+#include <vector>
+#include "fftSolver.hpp"
+#include "dataBlock.hpp"
+#include "fluid.hpp"
+#include "gridHost.hpp"
+
+// Index of a local cell in the local lines of a direction (lines of nl cells)
+KOKKOS_INLINE_FUNCTION int LineIndex(int dir, int nl, int nx, int ny, int k, int j, int i) {
+  if(dir == IDIR) return((k*ny + j)*nl + i);
+  if(dir == JDIR) return((k*nx + i)*nl + j);
+  return((j*nx + i)*nl + k);
+}
+
+FftSolver::FftSolver(Laplacian &op, real error, int maxiter,
+                     std::array<Laplacian::LaplacianBoundaryType,3> lbound,
+                     std::array<Laplacian::LaplacianBoundaryType,3> rbound) :
+                     IterativeSolver<Laplacian>(op, error, maxiter, op.np_tot, op.beg, op.end) {
+  idfx::pushRegion("FftSolver::FftSolver");
+  DataBlock *data = op.data;
+
+  #if GEOMETRY != CARTESIAN
+    IDEFIX_ERROR("FftSolver:: the FFT solver requires a cartesian geometry");
+  #endif
+
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    for(int side = 0 ; side < 2 ; side++) {
+      const Laplacian::LaplacianBoundaryType bound = (side == 0) ? lbound[dir] : rbound[dir];
+      if(bound == Laplacian::shearingbox && dir == IDIR) {
+        shearing = true;
+      } else if(bound != Laplacian::periodic) {
+        IDEFIX_ERROR("FftSolver:: the FFT solver requires periodic boundaries "
+                     "(or shearingbox boundaries in X1)");
+      }
+    }
+  }
+  if(shearing) {
+    if(lbound[IDIR] != Laplacian::shearingbox || rbound[IDIR] != Laplacian::shearingbox) {
+      IDEFIX_ERROR("FftSolver:: both X1 boundaries should be shearingbox boundaries");
+    }
+    shear = data->hydro->sbS;
+  }
+
+  // The grid should be uniform
+  GridHost gh(*data->mygrid);
+  gh.SyncFromDevice();
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    dx[dir] = (gh.xend[dir] - gh.xbeg[dir]) / gh.np_int[dir];
+    for(int i = gh.nghost[dir] ; i < gh.nghost[dir] + gh.np_int[dir] ; i++) {
+      if(std::fabs(gh.dx[dir](i) - dx[dir]) > 1e-6*dx[dir]) {
+        IDEFIX_ERROR("FftSolver:: the FFT solver requires a uniform grid");
+      }
+    }
+    nloc[dir] = this->end[dir] - this->beg[dir];
+    offset[dir] = data->gbeg[dir] - data->nghost[dir];
+  }
+
+  u = IdefixArray3D<Complex>("FFT_Spectrum", nloc[KDIR], nloc[JDIR], nloc[IDIR]);
+  correction = IdefixArray3D<real>("FFT_Correction", this->ntot[KDIR],
+                                                     this->ntot[JDIR],
+                                                     this->ntot[IDIR]);
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    InitPencil(dir);
+  }
+  idfx::popRegion();
+}
+
+void FftSolver::InitPencil(int dir) {
+  Pencil &P = pencil[dir];
+  DataBlock *data = linearOperator.data;
+  P.n = data->mygrid->np_int[dir];
+  P.nloc = nloc[dir];
+  P.nt = nloc[IDIR]*nloc[JDIR]*nloc[KDIR]/nloc[dir];
+  P.nlines = P.nt;
+  P.radix = FftFactorise(P.n);
+  P.twiddle = FftTwiddle("FFT_Twiddle", P.n);
+
+  #ifdef WITH_MPI
+  P.nprocs = data->mygrid->nproc[dir];
+  if(P.nprocs > 1) {
+    int remainDims[3] = {false, false, false};
+    remainDims[dir] = true;
+    MPI_SAFE_CALL(MPI_Cart_sub(data->mygrid->CartComm, remainDims, &P.comm));
+    int rank;
+    MPI_SAFE_CALL(MPI_Comm_rank(P.comm, &rank));
+
+    // Blocks of the processes of the row
+    std::vector<int> size(P.nprocs);
+    MPI_SAFE_CALL(MPI_Allgather(&P.nloc, 1, MPI_INT, size.data(), 1, MPI_INT, P.comm));
+    P.first = IdefixArray1D<int>("FFT_First", P.nprocs+1);
+    P.owner = IdefixArray1D<int>("FFT_Owner", P.n);
+    auto firstH = Kokkos::create_mirror_view(P.first);
+    auto ownerH = Kokkos::create_mirror_view(P.owner);
+    firstH(0) = 0;
+    for(int q = 0 ; q < P.nprocs ; q++) {
+      firstH(q+1) = firstH(q) + size[q];
+      for(int g = firstH(q) ; g < firstH(q+1) ; g++) ownerH(g) = q;
+    }
+    Kokkos::deep_copy(P.first, firstH);
+    Kokkos::deep_copy(P.owner, ownerH);
+
+    // The local lines are shared in contiguous sets of (nearly) equal size
+    auto linesBeg = [&](int q) { return(q*(P.nt/P.nprocs) + std::min(q, P.nt%P.nprocs)); };
+    P.nlines = linesBeg(rank+1) - linesBeg(rank);
+    for(int q = 0 ; q < P.nprocs ; q++) {
+      // Counts in reals
+      P.sendCount.push_back(2*(linesBeg(q+1)-linesBeg(q))*P.nloc);
+      P.sendDispl.push_back(2*linesBeg(q)*P.nloc);
+      P.recvCount.push_back(2*P.nlines*size[q]);
+      P.recvDispl.push_back(2*P.nlines*firstH(q));
+    }
+    P.send = IdefixArray1D<Complex>("FFT_Send", P.nt*P.nloc);
+    P.recv = IdefixArray1D<Complex>("FFT_Recv", P.nlines*P.n);
+    P.line = IdefixArray1D<Complex>("FFT_Line", P.nlines*P.n);
+  } else {
+  #endif
+    // The local lines are complete lines
+    P.line = IdefixArray1D<Complex>("FFT_Line", P.nlines*P.n);
+    P.send = P.line;
+    P.recv = P.line;
+  #ifdef WITH_MPI
+  }
+  #endif
+  P.work = IdefixArray1D<Complex>("FFT_Work", P.nlines*P.n);
+}
+
+void FftSolver::Transform(int dir, int sign) {
+  idfx::pushRegion("FftSolver::Transform");
+  Pencil &P = pencil[dir];
+  if(P.n == 1) {
+    idfx::popRegion();
+    return;
+  }
+  IdefixArray3D<Complex> u = this->u;
+  IdefixArray1D<Complex> send = P.send;
+  const int nl = P.nloc;
+  const int nx = nloc[IDIR];
+  const int ny = nloc[JDIR];
+
+  idefix_for("FFT_ToLines", 0, nloc[KDIR], 0, ny, 0, nx,
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      send(LineIndex(dir, nl, nx, ny, k, j, i)) = u(k,j,i);
+    });
+
+  #ifdef WITH_MPI
+  if(P.nprocs > 1) {
+    IdefixArray1D<Complex> recv = P.recv;
+    IdefixArray1D<Complex> line = P.line;
+    IdefixArray1D<int> owner = P.owner;
+    IdefixArray1D<int> first = P.first;
+    const int n = P.n;
+    const int nlines = P.nlines;
+
+    Exchange(P, send, recv, true);
+    idefix_for("FFT_Unpack", 0, nlines, 0, n,
+      KOKKOS_LAMBDA (int l, int g) {
+        const int q = owner(g);
+        line(l*n + g) = recv(nlines*first(q) + l*(first(q+1)-first(q)) + g - first(q));
+      });
+
+    TransformLines(dir, sign);
+
+    idefix_for("FFT_Pack", 0, nlines, 0, n,
+      KOKKOS_LAMBDA (int l, int g) {
+        const int q = owner(g);
+        recv(nlines*first(q) + l*(first(q+1)-first(q)) + g - first(q)) = line(l*n + g);
+      });
+    Exchange(P, recv, send, false);
+  } else {
+  #endif
+    TransformLines(dir, sign);
+  #ifdef WITH_MPI
+  }
+  #endif
+
+  idefix_for("FFT_FromLines", 0, nloc[KDIR], 0, ny, 0, nx,
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      u(k,j,i) = send(LineIndex(dir, nl, nx, ny, k, j, i));
+    });
+  idfx::popRegion();
+}
+
+#ifdef WITH_MPI
+void FftSolver::Exchange(Pencil &P, IdefixArray1D<Complex> in, IdefixArray1D<Complex> out,
+                         bool toLines) {
+  Kokkos::fence();
+  if(toLines) {
+    MPI_SAFE_CALL(MPI_Alltoallv(in.data(), P.sendCount.data(), P.sendDispl.data(), realMPI,
+                                out.data(), P.recvCount.data(), P.recvDispl.data(), realMPI,
+                                P.comm));
+  } else {
+    MPI_SAFE_CALL(MPI_Alltoallv(in.data(), P.recvCount.data(), P.recvDispl.data(), realMPI,
+                                out.data(), P.sendCount.data(), P.sendDispl.data(), realMPI,
+                                P.comm));
+  }
+}
+#endif
+
+void FftSolver::TransformLines(int dir, int sign) {
+  idfx::pushRegion("FftSolver::TransformLines");
+  const Pencil &P = pencil[dir];
+  IdefixArray1D<Complex> line = P.line;
+  IdefixArray1D<Complex> work = P.work;
+  IdefixArray1D<Complex> twiddle = P.twiddle;
+  const FftRadices radix = P.radix;
+  const int n = P.n;
+
+  idefix_for("FFT_Lines", 0, P.nlines,
+    KOKKOS_LAMBDA (int l) {
+      FftTransform(line.data() + l*n, work.data() + l*n, 1, n, radix, twiddle, sign);
+    });
+  idfx::popRegion();
+}
+
+void FftSolver::ShearLines(int sign) {
+  IdefixArray3D<Complex> u = this->u;
+  const int ny = pencil[JDIR].n;
+  const real Lx = pencil[IDIR].n*dx[IDIR];
+  const real Ly = ny*dx[JDIR];
+  const real dx1 = dx[IDIR];
+  const real St = shear*linearOperator.data->t;
+  const int ox = offset[IDIR];
+  const int oy = offset[JDIR];
+
+  // A mode exp(i ky y) of the sheared frame is exp(i ky (y + S t x)) in the lab frame
+  idefix_for("FFT_Shear", 0, nloc[KDIR], 0, nloc[JDIR], 0, nloc[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const int g = j + oy;
+      const real ky = 2.0*M_PI*((2*g <= ny) ? g : g - ny)/Ly;
+      const real x = (i + ox + HALF_F)*dx1 - HALF_F*Lx;
+      const real phi = sign*ky*St*x;
+      u(k,j,i) *= Complex(std::cos(phi), std::sin(phi));
+    });
+}
+
+void FftSolver::DivideByEigenvalues() {
+  IdefixArray3D<Complex> u = this->u;
+  const int nx = pencil[IDIR].n, ny = pencil[JDIR].n, nz = pencil[KDIR].n;
+  const int ox = offset[IDIR], oy = offset[JDIR], oz = offset[KDIR];
+  const real dx1 = dx[IDIR], dx2 = dx[JDIR], dx3 = dx[KDIR];
+  const real St = shear*linearOperator.data->t;
+  const real ntot = static_cast<real>(nx)*ny*nz;
+
+  idefix_for("FFT_Divide", 0, nloc[KDIR], 0, nloc[JDIR], 0, nloc[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const int gx = i + ox, gy = j + oy, gz = k + oz;
+      const real kx = 2.0*M_PI*((2*gx <= nx) ? gx : gx - nx)/(nx*dx1);
+      const real ky = 2.0*M_PI*((2*gy <= ny) ? gy : gy - ny)/(ny*dx2);
+      const real kz = 2.0*M_PI*((2*gz <= nz) ? gz : gz - nz)/(nz*dx3);
+      // Eigenvalues of the second order finite differences (the X1 wavenumber is sheared)
+      real lambda = (TWO_F*std::cos((kx - ky*St)*dx1) - TWO_F)/(dx1*dx1);
+      #if DIMENSIONS > 1
+      lambda += (TWO_F*std::cos(ky*dx2) - TWO_F)/(dx2*dx2);
+      #endif
+      #if DIMENSIONS > 2
+      lambda += (TWO_F*std::cos(kz*dx3) - TWO_F)/(dx3*dx3);
+      #endif
+      // The mean of the potential is arbitrary
+      if(lambda == ZERO_F) {
+        u(k,j,i) = Complex(ZERO_F, ZERO_F);
+      } else {
+        u(k,j,i) /= lambda*ntot;
+      }
+    });
+}
+
+void FftSolver::Invert(IdefixArray3D<real> &r, IdefixArray3D<real> &z) {
+  idfx::pushRegion("FftSolver::Invert");
+  IdefixArray3D<Complex> u = this->u;
+  IdefixArray3D<real> in = r;
+  IdefixArray3D<real> out = z;
+  const int ib = this->beg[IDIR], jb = this->beg[JDIR], kb = this->beg[KDIR];
+
+  idefix_for("FFT_Load", 0, nloc[KDIR], 0, nloc[JDIR], 0, nloc[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      u(k,j,i) = Complex(in(k+kb, j+jb, i+ib), ZERO_F);
+    });
+
+  // The transform along X2 comes first, so that the modes can be sheared
+  Transform(JDIR, -1);
+  if(shearing) ShearLines(1);
+  Transform(IDIR, -1);
+  Transform(KDIR, -1);
+  DivideByEigenvalues();
+  Transform(KDIR, 1);
+  Transform(IDIR, 1);
+  if(shearing) ShearLines(-1);
+  Transform(JDIR, 1);
+
+  idefix_for("FFT_Store", 0, nloc[KDIR], 0, nloc[JDIR], 0, nloc[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      out(k+kb, j+jb, i+ib) = u(k,j,i).real();
+    });
+  idfx::popRegion();
+}
+
+int FftSolver::Solve(IdefixArray3D<real> &guess, IdefixArray3D<real> &rhs) {
+  idfx::pushRegion("FftSolver::Solve");
+  this->solution = guess;
+  this->rhs = rhs;
+  this->convStatus = false;
+
+  IdefixArray3D<real> x = this->solution;
+  IdefixArray3D<real> dpot = this->correction;
+
+  // A single correction is exact in a periodic box. In the shearing box, the interpolated
+  // boundaries are corrected iteratively.
+  this->SetRes();
+  this->TestErrorL2();
+  int n = 0;
+  while(this->convStatus != true && n < this->maxiter) {
+    Invert(this->res, dpot);
+    idefix_for("FFT_Correct", this->beg[KDIR], this->end[KDIR],
+                              this->beg[JDIR], this->end[JDIR],
+                              this->beg[IDIR], this->end[IDIR],
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        x(k,j,i) += dpot(k,j,i);
+      });
+    this->SetRes();
+    this->TestErrorL2();
+    n++;
+  }
+
+  if(this->convStatus != true) {
+    idfx::cout << "FftSolver:: Reached max iter." << std::endl;
+    IDEFIX_WARNING("FftSolver:: Failed to converge before reaching max iter.");
+  }
+  idfx::popRegion();
+  return(n);
+}
+
+void FftSolver::ShowConfig() {
+  idfx::cout << "FftSolver: " << (shearing ? "shearing-periodic" : "periodic")
+             << " FFT of " << pencil[IDIR].n << "x" << pencil[JDIR].n << "x" << pencil[KDIR].n
+             << " cells." << std::endl;
+  idfx::cout << "FftSolver: TargetError: " << this->targetError << std::endl;
+  idfx::cout << "FftSolver: Maximum iterations: " << this->maxiter << std::endl;
+}
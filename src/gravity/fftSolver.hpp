@@ -0,0 +1,92 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef GRAVITY_FFTSOLVER_HPP_
+#define GRAVITY_FFTSOLVER_HPP_
+
+#include <array>
+#include <vector>
+#include "idefix.hpp"
+#include "fft.hpp"
+#include "iterativesolver.hpp"
+#include "laplacian.hpp"
+#ifdef WITH_MPI
+#include "mpi.hpp"
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+/// Direct Poisson solver for uniform cartesian grids which are periodic in every direction, or
+/// shearing-periodic in X1 and periodic in the other directions. The discrete Laplacian is
+/// diagonalised by discrete Fourier transforms, its eigenvalues being those of the second order
+/// finite differences. Each transform is computed by the processes of a row of the domain
+/// decomposition: the lines of the row are redistributed so that each process holds complete
+/// lines (pencils), which are transformed by a self-contained mixed-radix Stockham FFT.
+/// In the shearing box, the potential is transformed along X2 first, and each mode is shifted
+/// to the sheared frame, in which it is periodic along X1 with the time dependent wavenumber
+/// kx - S t ky. The boundary conditions of the shearing box being interpolated, the inverse is
+/// then only approximate, and it is used to correct the residual until convergence.
+//////////////////////////////////////////////////////////////////////////////////////////////////
+class FftSolver : public IterativeSolver<Laplacian> {
+ public:
+  FftSolver(Laplacian &op, real error, int maxIter,
+            std::array<Laplacian::LaplacianBoundaryType,3> lbound,
+            std::array<Laplacian::LaplacianBoundaryType,3> rbound);
+
+  int Solve(IdefixArray3D<real> &guess, IdefixArray3D<real> &rhs);
+  void ShowConfig();
+
+  // Spectral inverse of the Laplacian: z is the solution of Laplacian(z)=r
+  void Invert(IdefixArray3D<real> &r, IdefixArray3D<real> &z);
+
+  // Internal functions (left public for Lambda capture)
+  void Transform(int, int);                 // Transform of u along a direction
+  void TransformLines(int, int);            // Transform of the lines held by this process
+  void ShearLines(int);                     // Shift of the modes to/from the sheared frame
+  void DivideByEigenvalues();
+
+  using Complex = FftComplex;
+
+ private:
+  // Pencil decomposition of a direction: the local block holds nt (transverse) lines of nloc
+  // cells, the process transforms nlines complete lines of n cells.
+  struct Pencil {
+    int n;                            // global number of cells
+    int nloc;                         // local number of cells
+    int nt;                           // number of local lines
+    int nlines;                       // number of lines transformed by this process
+    int nprocs{1};                    // number of processes along the direction
+    FftRadices radix;
+    IdefixArray1D<Complex> twiddle;   // exp(-2 i pi j/n)
+    IdefixArray1D<Complex> send;      // local lines, line after line
+    IdefixArray1D<Complex> recv;      // received pieces of lines, process after process
+    IdefixArray1D<Complex> line;      // complete lines
+    IdefixArray1D<Complex> work;      // FFT scratch
+    #ifdef WITH_MPI
+    MPI_Comm comm;
+    IdefixArray1D<int> owner;         // process holding each global cell
+    IdefixArray1D<int> first;         // first global cell of each process
+    std::vector<int> sendCount, sendDispl, recvCount, recvDispl;
+    #endif
+  };
+
+  std::array<Pencil,3> pencil;
+  IdefixArray3D<Complex> u;           // local block of the Fourier transform
+  IdefixArray3D<real> correction;
+
+  std::array<int,3> nloc;             // local number of cells
+  std::array<int,3> offset;           // global index of the first local cell
+  std::array<real,3> dx;              // uniform grid spacing
+  bool shearing{false};
+  real shear{0};                      // shear rate S of the shearing box
+
+  void InitPencil(int);
+  #ifdef WITH_MPI
+  void Exchange(Pencil &, IdefixArray1D<Complex>, IdefixArray1D<Complex>, bool);
+  #endif
+};
+
+#endif // GRAVITY_FFTSOLVER_HPP_
@@ -12,6 +12,7 @@
 #include "laplacian.hpp"
 #include "selfGravity.hpp"
 #include "dataBlock.hpp"
+#include "fluid.hpp"
 
 
 Laplacian::Laplacian(DataBlock *datain, std::array<LaplacianBoundaryType,3> leftBound,
@@ -86,6 +87,22 @@ Laplacian::Laplacian(DataBlock *datain, std::array<LaplacianBoundaryType,3> left
     InitInternalGrid();
   }
 
+  if(this->lbound[IDIR] == shearingbox || this->rbound[IDIR] == shearingbox) {
+    #if GEOMETRY != CARTESIAN
+      IDEFIX_ERROR("Laplacian:: Shearingbox boundaries require a cartesian geometry");
+    #endif
+    if(!data->hydro->haveShearingBox) {
+      IDEFIX_ERROR("Laplacian:: Shearingbox boundaries require the hydro shearingBox option");
+    }
+    if(data->mygrid->nproc[JDIR]>1) {
+      IDEFIX_ERROR("Laplacian:: Shearingbox boundaries are not compatible with "
+                   "MPI domain decomposition in X2");
+    }
+    this->sbArray = IdefixArray3D<real> ("SG_ShearingBoxArray", this->np_tot[KDIR],
+                                                                this->np_tot[JDIR],
+                                                                this->nghost[IDIR]);
+  }
+
   // Init preconditionner if needed
   if(havePreconditioner) {
     InitPreconditionner();
@@ -522,6 +539,35 @@ void Laplacian::EnforceBoundary(int dir, BoundarySide side, LaplacianBoundaryTyp
       break;
     }
 
+    case shearingbox: {
+      // Periodicity (already enforced by MPI), shifted along X2 by the shear of the box
+      if(data->mygrid->nproc[dir] == 1) EnforceBoundary(dir, side, periodic, arr);
+
+      IdefixArray3D<real> scrh = this->sbArray;
+      const real Lx = data->mygrid->xend[IDIR] - data->mygrid->xbeg[IDIR];
+      const real Ly = data->mygrid->xend[JDIR] - data->mygrid->xbeg[JDIR];
+      const real dy = Ly/nxj;
+
+      // Shift in # of cells, and remainder linearly interpolated
+      const int sign = 2*side-1;
+      const real dL = std::fmod(sign*data->hydro->sbS*Lx*data->t, Ly);
+      const int m = static_cast<int> (std::floor(dL/dy+HALF_F));
+      const real eps = dL / dy - m;
+
+      idefix_for("BoundaryShearingBox", kbeg, kend, jbeg, jend, ibeg, iend,
+            KOKKOS_LAMBDA (int k, int j, int i) {
+              const int jo = jghost + ((j-m-jghost)%nxj+nxj)%nxj;
+              const int jn = (eps >= ZERO_F) ? jghost + ((jo-1-jghost)%nxj+nxj)%nxj
+                                             : jghost + ((jo+1-jghost)%nxj+nxj)%nxj;
+              scrh(k,j,i-ibeg) = (ONE_F-FABS(eps))*localVar(k,jo,i) + FABS(eps)*localVar(k,jn,i);
+      });
+      idefix_for("BoundaryShearingBoxCopy", kbeg, kend, jbeg, jend, ibeg, iend,
+            KOKKOS_LAMBDA (int k, int j, int i) {
+              localVar(k,j,i) = scrh(k,j,i-ibeg);
+      });
+      break;
+    }
+
     case userdef: {
       if(this->haveUserDefBoundary) {
         // Warning: unlike hydro userdef boundary functions, the selfGravity
@@ -594,17 +640,17 @@ void Laplacian::EnforceBoundary(int dir, BoundarySide side, LaplacianBoundaryTyp
       // all have the same value.
       int iref = this->beg[IDIR];
 
-      real psiIn = 0.0;
+      accum psiIn = 0.0;
 
       idefix_reduce("meanPsiIn",
                     beg[KDIR], end[KDIR],
                     beg[JDIR], end[JDIR],
-                    KOKKOS_LAMBDA(int k, int j, real &psi) {
+                    KOKKOS_LAMBDA(int k, int j, accum &psi) {
                       psi += localVar(k,j,iref);
-                    },Kokkos::Sum<real> (psiIn));
+                    },Kokkos::Sum<accum> (psiIn));
 
       #ifdef WITH_MPI
-        MPI_Allreduce(MPI_IN_PLACE, &psiIn, 1, realMPI, MPI_SUM, originComm);
+        MPI_Allreduce(MPI_IN_PLACE, &psiIn, 1, accumMPI, MPI_SUM, originComm);
       #endif
       // Do a mean by dividing by the number of points
       psiIn = psiIn/(data->mygrid->np_int[JDIR]*data->mygrid->np_int[KDIR]);
@@ -26,6 +26,7 @@ class Laplacian {
                               userdef,
                               axis,
                               origin,
+                              shearingbox,
                               undefined};
 
   Laplacian() = default;
@@ -82,6 +83,7 @@ class Laplacian {
   std::array<LaplacianBoundaryType,3> rbound;  // Boundary condition to the right
                            // Warning : might differ from (M)HD solver !
 
+  IdefixArray3D<real> sbArray; //< Work array for shearingbox boundaries
   IdefixArray3D<real> precond; //< Diagonal preconditionner
   IdefixArray4D<real> Lx1; //< Laplacian operator in x1
   IdefixArray4D<real> Lx2; //< Laplacian operator in x2
@@ -0,0 +1,721 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include "multigrid.hpp"
+#include "dataBlock.hpp"
+
+Multigrid::Multigrid(Laplacian &op, real error, int maxiter, int degree,
+                     std::array<Laplacian::LaplacianBoundaryType,3> lbound,
+                     std::array<Laplacian::LaplacianBoundaryType,3> rbound) :
+                     IterativeSolver<Laplacian>(op, error, maxiter, op.np_tot, op.beg, op.end) {
+  idfx::pushRegion("Multigrid::Multigrid");
+  this->degree = degree;
+  if(degree < 1) {
+    IDEFIX_ERROR("Multigrid:: the degree of the smoother should be a strictly positive integer");
+  }
+  #ifdef WITH_MPI
+  nprocs = idfx::psize;
+  #endif
+
+  // Homogeneous boundary conditions of the coarse levels. Non-linear (userdef) and
+  // internal conditions are approximated by a vanishing correction in the ghost cells, and
+  // shearingbox conditions by unsheared periodic ones.
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    for(int side = 0 ; side < 2 ; side++) {
+      switch((side == 0) ? lbound[dir] : rbound[dir]) {
+        case Laplacian::periodic:
+        case Laplacian::shearingbox:
+          physicalBound[dir][side] = Bound::periodic;
+          break;
+        case Laplacian::nullgrad:
+        case Laplacian::axis:
+        case Laplacian::origin:
+          physicalBound[dir][side] = Bound::neumann;
+          break;
+        default:
+          physicalBound[dir][side] = Bound::dirichlet;
+      }
+    }
+  }
+
+  #ifdef WITH_MPI
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    MPI_SAFE_CALL(MPI_Cart_shift(op.data->mygrid->CartComm, dir, 1,
+                                 &neighbour[dir][0], &neighbour[dir][1]));
+  }
+  #endif
+
+  InitFinestLevel();
+
+  // Coarsen the distributed levels as long as all of the processes can
+  while(!levels.back().replicated) {
+    const Level &L = levels.back();
+    std::array<int,3> ratio = {1,1,1};
+    bool coarsen = false;
+    for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+      int even = (L.n[dir] % 2 == 0);
+      #ifdef WITH_MPI
+      MPI_SAFE_CALL(MPI_Allreduce(MPI_IN_PLACE, &even, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD));
+      #endif
+      if(even) {
+        ratio[dir] = 2;
+        coarsen = true;
+      }
+    }
+    int64_t ncells = static_cast<int64_t>(L.n[IDIR])*L.n[JDIR]*L.n[KDIR];
+    #ifdef WITH_MPI
+    MPI_SAFE_CALL(MPI_Allreduce(MPI_IN_PLACE, &ncells, 1, MPI_INT64_T, MPI_SUM, MPI_COMM_WORLD));
+    #endif
+
+    if(coarsen && ncells > agglomerationSize) {
+      AddCoarseLevel(ratio);
+    } else {
+      #ifdef WITH_MPI
+      AddGatheredLevel();
+      #endif
+    }
+  }
+
+  // Carry on with the replicated levels down to two cells per direction
+  while(true) {
+    const Level &L = levels.back();
+    std::array<int,3> ratio = {1,1,1};
+    bool coarsen = false;
+    for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+      if(L.n[dir] > 2) coarsen = true;
+      if(L.n[dir] > 1) ratio[dir] = 2;
+    }
+    if(!coarsen) break;
+    AddCoarseLevel(ratio);
+  }
+
+  this->correction = IdefixArray3D<real> ("MG_Correction", this->ntot[KDIR],
+                                                           this->ntot[JDIR],
+                                                           this->ntot[IDIR]);
+  idfx::popRegion();
+}
+
+void Multigrid::AllocateLevel(Level &L) {
+  std::array<int,3> size;
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    size[dir] = L.n[dir] + 2*L.first[dir];
+  }
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    L.c[dir] = IdefixArray3D<real>("MG_Coupling", size[KDIR], size[JDIR], size[IDIR]);
+  }
+  L.invDiag = IdefixArray3D<real>("MG_InvDiag", size[KDIR], size[JDIR], size[IDIR]);
+  L.r = IdefixArray3D<real>("MG_Residual", size[KDIR], size[JDIR], size[IDIR]);
+  L.d = IdefixArray3D<real>("MG_Update", size[KDIR], size[JDIR], size[IDIR]);
+  // The solution and rhs of the finest level are those of the solver
+  if(levels.size() > 0) {
+    L.vol = IdefixArray3D<real>("MG_Volume", size[KDIR], size[JDIR], size[IDIR]);
+    L.x = IdefixArray3D<real>("MG_Correction", size[KDIR], size[JDIR], size[IDIR]);
+    L.b = IdefixArray3D<real>("MG_Rhs", size[KDIR], size[JDIR], size[IDIR]);
+  }
+}
+
+void Multigrid::InitFinestLevel() {
+  idfx::pushRegion("Multigrid::InitFinestLevel");
+  Level L;
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    L.n[dir] = this->end[dir] - this->beg[dir];
+    L.first[dir] = this->beg[dir];
+  }
+  L.replicated = (nprocs == 1);
+  L.bound = physicalBound;   // unused: the boundaries are those of the Laplacian
+  AllocateLevel(L);
+  L.vol = linearOperator.dV;
+
+  // Symmetric couplings A/(h dx) of the Laplacian through the left face of each cell, and
+  // through the right face of the last one
+  IdefixArray3D<real> dV = linearOperator.dV;
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    IdefixArray4D<real> Lx = (dir == IDIR) ? linearOperator.Lx1 :
+                             (dir == JDIR) ? linearOperator.Lx2 : linearOperator.Lx3;
+    IdefixArray3D<real> c = L.c[dir];
+    const int ioffset = (dir == IDIR) ? 1 : 0;
+    const int joffset = (dir == JDIR) ? 1 : 0;
+    const int koffset = (dir == KDIR) ? 1 : 0;
+    const int iend = this->end[IDIR];
+    const int jend = this->end[JDIR];
+    const int kend = this->end[KDIR];
+    idefix_for("MG_Couplings", this->beg[KDIR], kend + koffset,
+                               this->beg[JDIR], jend + joffset,
+                               this->beg[IDIR], iend + ioffset,
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        if(i == iend || j == jend || k == kend) {
+          c(k,j,i) = Lx(1,k-koffset,j-joffset,i-ioffset)*dV(k-koffset,j-joffset,i-ioffset);
+        } else {
+          c(k,j,i) = Lx(0,k,j,i)*dV(k,j,i);
+        }
+      });
+  }
+  ComputeDiagonal(L);
+  levels.push_back(L);
+  idfx::popRegion();
+}
+
+void Multigrid::AddCoarseLevel(std::array<int,3> ratio) {
+  idfx::pushRegion("Multigrid::AddCoarseLevel");
+  const Level &F = levels.back();
+  Level C;
+  C.ratio = ratio;
+  C.replicated = F.replicated;
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    C.n[dir] = (F.n[dir] + ratio[dir] - 1)/ratio[dir];
+    C.first[dir] = (dir < DIMENSIONS) ? 1 : 0;
+    for(int side = 0 ; side < 2 ; side++) {
+      C.bound[dir][side] = physicalBound[dir][side];
+      #ifdef WITH_MPI
+      if(!C.replicated && dir < DIMENSIONS && linearOperator.data->mygrid->nproc[dir] > 1) {
+        if(neighbour[dir][side] != MPI_PROC_NULL) {
+          C.bound[dir][side] = Bound::exchange;
+        } else if(C.bound[dir][side] == Bound::periodic) {
+          // Periodic domain without a periodic MPI topology
+          C.bound[dir][side] = Bound::neumann;
+        }
+      }
+      #endif
+    }
+  }
+  AllocateLevel(C);
+
+  const int rx = ratio[IDIR], ry = ratio[JDIR], rz = ratio[KDIR];
+  const int nfx = F.n[IDIR], nfy = F.n[JDIR], nfz = F.n[KDIR];
+  const int ffx = F.first[IDIR], ffy = F.first[JDIR], ffz = F.first[KDIR];
+  const int ncx = C.n[IDIR], ncy = C.n[JDIR], ncz = C.n[KDIR];
+  const int fcx = C.first[IDIR], fcy = C.first[JDIR], fcz = C.first[KDIR];
+
+  // The coarse cells aggregate the volumes of the fine cells
+  IdefixArray3D<real> volF = F.vol;
+  IdefixArray3D<real> volC = C.vol;
+  idefix_for("MG_CoarseVolume", fcz, fcz+ncz, fcy, fcy+ncy, fcx, fcx+ncx,
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      real v = 0;
+      for(int oz = 0 ; oz < rz ; oz++) {
+        const int kf = rz*(k-fcz)+oz;
+        for(int oy = 0 ; oy < ry ; oy++) {
+          const int jf = ry*(j-fcy)+oy;
+          for(int ox = 0 ; ox < rx ; ox++) {
+            const int f = rx*(i-fcx)+ox;
+            if(f < nfx && jf < nfy && kf < nfz) v += volF(ffz+kf, ffy+jf, ffx+f);
+          }
+        }
+      }
+      volC(k,j,i) = v;
+    });
+
+  // and the couplings of the fine faces which lie on the coarse faces
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    IdefixArray3D<real> cF = F.c[dir];
+    IdefixArray3D<real> cC = C.c[dir];
+    const int ex = (dir == IDIR) ? 1 : 0;
+    const int ey = (dir == JDIR) ? 1 : 0;
+    const int ez = (dir == KDIR) ? 1 : 0;
+    idefix_for("MG_CoarseCouplings", fcz, fcz+ncz+ez, fcy, fcy+ncy+ey, fcx, fcx+ncx+ex,
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        real s = 0;
+        for(int oz = 0 ; oz < (ez ? 1 : rz) ; oz++) {
+          const int kf = ez ? (k-fcz < ncz ? rz*(k-fcz) : nfz) : rz*(k-fcz)+oz;
+          for(int oy = 0 ; oy < (ey ? 1 : ry) ; oy++) {
+            const int jf = ey ? (j-fcy < ncy ? ry*(j-fcy) : nfy) : ry*(j-fcy)+oy;
+            for(int ox = 0 ; ox < (ex ? 1 : rx) ; ox++) {
+              const int f = ex ? (i-fcx < ncx ? rx*(i-fcx) : nfx) : rx*(i-fcx)+ox;
+              if(f < nfx+ex && jf < nfy+ey && kf < nfz+ez) s += cF(ffz+kf, ffy+jf, ffx+f);
+            }
+          }
+        }
+        cC(k,j,i) = s;
+      });
+  }
+  ComputeDiagonal(C);
+  levels.push_back(C);
+  idfx::popRegion();
+}
+
+void Multigrid::ComputeDiagonal(Level &L) {
+  IdefixArray3D<real> vol = L.vol;
+  IdefixArray3D<real> invDiag = L.invDiag;
+  IdefixArray3D<real> c1 = L.c[IDIR];
+  [[maybe_unused]] IdefixArray3D<real> c2 = L.c[JDIR];
+  [[maybe_unused]] IdefixArray3D<real> c3 = L.c[KDIR];
+  idefix_for("MG_Diagonal", L.first[KDIR], L.first[KDIR]+L.n[KDIR],
+                            L.first[JDIR], L.first[JDIR]+L.n[JDIR],
+                            L.first[IDIR], L.first[IDIR]+L.n[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      real s = c1(k,j,i) + c1(k,j,i+1);
+      #if DIMENSIONS > 1
+      s += c2(k,j,i) + c2(k,j+1,i);
+      #endif
+      #if DIMENSIONS > 2
+      s += c3(k,j,i) + c3(k+1,j,i);
+      #endif
+      invDiag(k,j,i) = -vol(k,j,i)/s;
+    });
+}
+
+void Multigrid::FillGhosts(int l, IdefixArray3D<real> arr) {
+  const Level &L = levels[l];
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    #ifdef WITH_MPI
+    if(L.bound[dir][0] == Bound::exchange || L.bound[dir][1] == Bound::exchange) {
+      ExchangeGhosts(L, arr, dir);
+    }
+    #endif
+    for(int side = 0 ; side < 2 ; side++) {
+      if(L.bound[dir][side] == Bound::exchange) continue;
+      const int first = L.first[dir];
+      const int n = L.n[dir];
+      // Ghost cell and the cell it is copied from (vanishing ghost for Dirichlet)
+      const int ghost = (side == 0) ? first-1 : first+n;
+      int src = (side == 0) ? first : first+n-1;
+      if(L.bound[dir][side] == Bound::periodic) src = (side == 0) ? first+n-1 : first;
+      const bool copy = (L.bound[dir][side] != Bound::dirichlet);
+
+      std::array<int,3> b0 = L.first;
+      std::array<int,3> b1 = {L.first[IDIR]+L.n[IDIR], L.first[JDIR]+L.n[JDIR],
+                              L.first[KDIR]+L.n[KDIR]};
+      b0[dir] = ghost;
+      b1[dir] = ghost+1;
+      const int ex = (dir == IDIR) ? 1 : 0;
+      const int ey = (dir == JDIR) ? 1 : 0;
+      const int ez = (dir == KDIR) ? 1 : 0;
+      idefix_for("MG_FillGhosts", b0[KDIR], b1[KDIR], b0[JDIR], b1[JDIR], b0[IDIR], b1[IDIR],
+        KOKKOS_LAMBDA (int k, int j, int i) {
+          const int is = ex ? src : i;
+          const int js = ey ? src : j;
+          const int ks = ez ? src : k;
+          arr(k,j,i) = copy ? arr(ks,js,is) : ZERO_F;
+        });
+    }
+  }
+}
+
+void Multigrid::Residual(int l, bool zeroGuess) {
+  Level &L = levels[l];
+  IdefixArray3D<real> r = L.r;
+  IdefixArray3D<real> b = L.b;
+  IdefixArray3D<real> x = L.x;
+
+  if(zeroGuess) {
+    Kokkos::deep_copy(r, b);
+    return;
+  }
+  if(l == 0) {
+    linearOperator(x, r);
+    idefix_for("MG_Residual", this->beg[KDIR], this->end[KDIR],
+                              this->beg[JDIR], this->end[JDIR],
+                              this->beg[IDIR], this->end[IDIR],
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        r(k,j,i) = b(k,j,i) - r(k,j,i);
+      });
+    return;
+  }
+
+  FillGhosts(l, x);
+  IdefixArray3D<real> vol = L.vol;
+  IdefixArray3D<real> c1 = L.c[IDIR];
+  [[maybe_unused]] IdefixArray3D<real> c2 = L.c[JDIR];
+  [[maybe_unused]] IdefixArray3D<real> c3 = L.c[KDIR];
+  idefix_for("MG_Residual", L.first[KDIR], L.first[KDIR]+L.n[KDIR],
+                            L.first[JDIR], L.first[JDIR]+L.n[JDIR],
+                            L.first[IDIR], L.first[IDIR]+L.n[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const real x0 = x(k,j,i);
+      real s = c1(k,j,i)*(x(k,j,i-1)-x0) + c1(k,j,i+1)*(x(k,j,i+1)-x0);
+      #if DIMENSIONS > 1
+      s += c2(k,j,i)*(x(k,j-1,i)-x0) + c2(k,j+1,i)*(x(k,j+1,i)-x0);
+      #endif
+      #if DIMENSIONS > 2
+      s += c3(k,j,i)*(x(k-1,j,i)-x0) + c3(k+1,j,i)*(x(k+1,j,i)-x0);
+      #endif
+      r(k,j,i) = b(k,j,i) - s/vol(k,j,i);
+    });
+}
+
+void Multigrid::Smooth(int l, int nsteps, real ratio, bool zeroGuess) {
+  // Chebyshev iteration of D^-1 A on [lambdaMax/ratio, lambdaMax] (Saad 2003, Alg. 12.1)
+  Level &L = levels[l];
+  IdefixArray3D<real> x = L.x;
+  IdefixArray3D<real> r = L.r;
+  IdefixArray3D<real> d = L.d;
+  IdefixArray3D<real> invDiag = L.invDiag;
+
+  const real theta = HALF_F*lambdaMax*(ONE_F + ONE_F/ratio);
+  const real delta = HALF_F*lambdaMax*(ONE_F - ONE_F/ratio);
+  const real sigma = theta/delta;
+  real rho = ONE_F/sigma;
+
+  for(int n = 0 ; n < nsteps ; n++) {
+    const bool noGuess = zeroGuess && n == 0;
+    Residual(l, noGuess);
+    real cd = 0;
+    real cr = ONE_F/theta;
+    if(n > 0) {
+      const real rhoNew = ONE_F/(2*sigma - rho);
+      cd = rhoNew*rho;
+      cr = 2*rhoNew/delta;
+      rho = rhoNew;
+    }
+    idefix_for("MG_Smooth", L.first[KDIR], L.first[KDIR]+L.n[KDIR],
+                            L.first[JDIR], L.first[JDIR]+L.n[JDIR],
+                            L.first[IDIR], L.first[IDIR]+L.n[IDIR],
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        const real dn = (noGuess ? ZERO_F : cd*d(k,j,i)) + cr*invDiag(k,j,i)*r(k,j,i);
+        d(k,j,i) = dn;
+        x(k,j,i) = noGuess ? dn : x(k,j,i) + dn;
+      });
+  }
+}
+
+void Multigrid::Restrict(int l) {
+  const Level &F = levels[l];
+  const Level &C = levels[l+1];
+  IdefixArray3D<real> volF = F.vol;
+  IdefixArray3D<real> volC = C.vol;
+  IdefixArray3D<real> r = F.r;
+  IdefixArray3D<real> b = C.b;
+
+  const int rx = C.ratio[IDIR], ry = C.ratio[JDIR], rz = C.ratio[KDIR];
+  const int nfx = F.n[IDIR], nfy = F.n[JDIR], nfz = F.n[KDIR];
+  const int ffx = F.first[IDIR], ffy = F.first[JDIR], ffz = F.first[KDIR];
+  const int fcx = C.first[IDIR], fcy = C.first[JDIR], fcz = C.first[KDIR];
+
+  // Volume average of the fine residual
+  idefix_for("MG_Restrict", fcz, fcz+C.n[KDIR], fcy, fcy+C.n[JDIR], fcx, fcx+C.n[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      real s = 0;
+      for(int oz = 0 ; oz < rz ; oz++) {
+        const int kf = rz*(k-fcz)+oz;
+        for(int oy = 0 ; oy < ry ; oy++) {
+          const int jf = ry*(j-fcy)+oy;
+          for(int ox = 0 ; ox < rx ; ox++) {
+            const int f = rx*(i-fcx)+ox;
+            if(f < nfx && jf < nfy && kf < nfz) {
+              s += volF(ffz+kf, ffy+jf, ffx+f)*r(ffz+kf, ffy+jf, ffx+f);
+            }
+          }
+        }
+      }
+      b(k,j,i) = s/volC(k,j,i);
+    });
+}
+
+void Multigrid::Prolong(int l) {
+  const Level &F = levels[l];
+  const Level &C = levels[l+1];
+  IdefixArray3D<real> xF = F.x;
+  IdefixArray3D<real> xC = C.x;
+
+  const int rx = C.ratio[IDIR], ry = C.ratio[JDIR], rz = C.ratio[KDIR];
+  const int ffx = F.first[IDIR], ffy = F.first[JDIR], ffz = F.first[KDIR];
+  const int fcx = C.first[IDIR], fcy = C.first[JDIR], fcz = C.first[KDIR];
+  const real w = overCorrection;
+
+  idefix_for("MG_Prolong", ffz, ffz+F.n[KDIR], ffy, ffy+F.n[JDIR], ffx, ffx+F.n[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      xF(k,j,i) += w*xC(fcz + (k-ffz)/rz, fcy + (j-ffy)/ry, fcx + (i-ffx)/rx);
+    });
+}
+
+void Multigrid::VCycle(int l) {
+  if(l == static_cast<int>(levels.size())-1) {
+    Smooth(l, coarseDegree, coarseRatio, true);
+    return;
+  }
+  #ifdef WITH_MPI
+  if(levels[l+1].gathered) {
+    Gather(l, levels[l].b, levels[l+1].b, {0,0,0});
+    VCycle(l+1);
+    Scatter(l);
+    return;
+  }
+  #endif
+  Smooth(l, degree, smoothingRatio, true);
+  Residual(l, false);
+  Restrict(l);
+  VCycle(l+1);
+  Prolong(l);
+  Smooth(l, degree, smoothingRatio, false);
+}
+
+void Multigrid::Precondition(IdefixArray3D<real> &r, IdefixArray3D<real> &z) {
+  idfx::pushRegion("Multigrid::Precondition");
+  levels[0].b = r;
+  levels[0].x = z;
+  VCycle(0);
+  idfx::popRegion();
+}
+
+int Multigrid::Solve(IdefixArray3D<real> &guess, IdefixArray3D<real> &rhs) {
+  idfx::pushRegion("Multigrid::Solve");
+  this->solution = guess;
+  this->rhs = rhs;
+  this->convStatus = false;
+
+  IdefixArray3D<real> x = this->solution;
+  IdefixArray3D<real> dx = this->correction;
+
+  this->SetRes();
+  this->TestErrorL2();
+  int n = 0;
+  while(this->convStatus != true && n < this->maxiter) {
+    Precondition(this->res, dx);
+    idefix_for("MG_Correct", this->beg[KDIR], this->end[KDIR],
+                             this->beg[JDIR], this->end[JDIR],
+                             this->beg[IDIR], this->end[IDIR],
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        x(k,j,i) += dx(k,j,i);
+      });
+    this->SetRes();
+    this->TestErrorL2();
+    n++;
+  }
+
+  if(this->convStatus != true) {
+    idfx::cout << "Multigrid:: Reached max iter." << std::endl;
+    IDEFIX_WARNING("Multigrid:: Failed to converge before reaching max iter.");
+  }
+  idfx::popRegion();
+  return(n);
+}
+
+void Multigrid::ShowConfig() {
+  idfx::cout << "Multigrid: " << levels.size() << " levels, Chebyshev smoother of degree "
+             << degree << "." << std::endl;
+  for(int l = 0 ; l < levels.size() ; l++) {
+    if(levels[l].gathered) {
+      idfx::cout << "Multigrid: levels from #" << l << " ("
+                 << levels[l].n[IDIR]*levels[l].n[JDIR]*levels[l].n[KDIR]
+                 << " cells) are agglomerated on each process." << std::endl;
+    }
+  }
+  idfx::cout << "Multigrid: TargetError: " << this->targetError << std::endl;
+  idfx::cout << "Multigrid: Maximum iterations: " << this->maxiter << std::endl;
+}
+
+#ifdef WITH_MPI
+void Multigrid::AddGatheredLevel() {
+  idfx::pushRegion("Multigrid::AddGatheredLevel");
+  const int l = levels.size()-1;
+  std::array<int,3> nproc = linearOperator.data->mygrid->nproc;
+  std::array<int,3> xproc = linearOperator.data->mygrid->xproc;
+  MPI_Comm comm = linearOperator.data->mygrid->CartComm;
+
+  // Block coordinates and size of each process
+  std::vector<int> info(6*nprocs);
+  int myInfo[6] = {xproc[IDIR], xproc[JDIR], xproc[KDIR],
+                   levels[l].n[IDIR], levels[l].n[JDIR], levels[l].n[KDIR]};
+  MPI_SAFE_CALL(MPI_Allgather(myInfo, 6, MPI_INT, info.data(), 6, MPI_INT, comm));
+
+  std::array<std::vector<int>,3> beg;
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    std::vector<int> size(nproc[dir], 0);
+    for(int p = 0 ; p < nprocs ; p++) size[info[6*p+dir]] = info[6*p+3+dir];
+    beg[dir].assign(nproc[dir]+1, 0);
+    for(int c = 0 ; c < nproc[dir] ; c++) beg[dir][c+1] = beg[dir][c] + size[c];
+    myBeg[dir] = beg[dir][xproc[dir]];
+  }
+
+  Level G;
+  G.replicated = true;
+  G.gathered = true;
+  G.bound = physicalBound;
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    G.n[dir] = beg[dir][nproc[dir]];
+    G.first[dir] = (dir < DIMENSIONS) ? 1 : 0;
+  }
+  AllocateLevel(G);
+
+  // Offsets of each process in the gathered buffer
+  counts.resize(nprocs);
+  displs.resize(nprocs);
+  rankOf = IdefixArray3D<int>("MG_RankOf", nproc[KDIR], nproc[JDIR], nproc[IDIR]);
+  displ = IdefixArray1D<int>("MG_Displ", nprocs);
+  auto rankOfH = Kokkos::create_mirror_view(rankOf);
+  auto displH = Kokkos::create_mirror_view(displ);
+  int offset = 0;
+  for(int p = 0 ; p < nprocs ; p++) {
+    counts[p] = info[6*p+3]*info[6*p+4]*info[6*p+5];
+    displs[p] = offset;
+    displH(p) = offset;
+    rankOfH(info[6*p+2], info[6*p+1], info[6*p]) = p;
+    offset += counts[p];
+  }
+  Kokkos::deep_copy(rankOf, rankOfH);
+  Kokkos::deep_copy(displ, displH);
+
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    blockOf[dir] = IdefixArray1D<int>("MG_BlockOf", G.n[dir]);
+    blockBeg[dir] = IdefixArray1D<int>("MG_BlockBeg", nproc[dir]+1);
+    auto blockOfH = Kokkos::create_mirror_view(blockOf[dir]);
+    auto blockBegH = Kokkos::create_mirror_view(blockBeg[dir]);
+    for(int c = 0 ; c <= nproc[dir] ; c++) blockBegH(c) = beg[dir][c];
+    for(int c = 0 ; c < nproc[dir] ; c++) {
+      for(int i = beg[dir][c] ; i < beg[dir][c+1] ; i++) blockOfH(i) = c;
+    }
+    Kokkos::deep_copy(blockOf[dir], blockOfH);
+    Kokkos::deep_copy(blockBeg[dir], blockBegH);
+  }
+  sendBuffer = IdefixArray1D<real>("MG_SendBuffer", counts[idfx::prank]);
+  recvBuffer = IdefixArray1D<real>("MG_RecvBuffer", offset);
+
+  levels.push_back(G);
+
+  // Gather the volumes and the couplings
+  Gather(l, levels[l].vol, G.vol, {0,0,0});
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    // Left faces of the cells, then right face of the last cell
+    Gather(l, levels[l].c[dir], G.c[dir], {0,0,0});
+    IdefixArray3D<real> right = G.r;
+    std::array<int,3> shift = {0,0,0};
+    shift[dir] = 1;
+    Gather(l, levels[l].c[dir], right, shift);
+
+    IdefixArray3D<real> c = G.c[dir];
+    std::array<int,3> b0 = G.first;
+    std::array<int,3> b1 = {G.first[IDIR]+G.n[IDIR], G.first[JDIR]+G.n[JDIR],
+                            G.first[KDIR]+G.n[KDIR]};
+    b0[dir] = G.first[dir]+G.n[dir];
+    b1[dir] = b0[dir]+1;
+    const int ex = (dir == IDIR) ? 1 : 0;
+    const int ey = (dir == JDIR) ? 1 : 0;
+    const int ez = (dir == KDIR) ? 1 : 0;
+    idefix_for("MG_LastFace", b0[KDIR], b1[KDIR], b0[JDIR], b1[JDIR], b0[IDIR], b1[IDIR],
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        c(k,j,i) = right(k-ez,j-ey,i-ex);
+      });
+  }
+  ComputeDiagonal(levels.back());
+  idfx::popRegion();
+}
+
+void Multigrid::Gather(int l, IdefixArray3D<real> in, IdefixArray3D<real> out,
+                       std::array<int,3> shift) {
+  idfx::pushRegion("Multigrid::Gather");
+  const Level &L = levels[l];
+  const Level &G = levels[l+1];
+  IdefixArray1D<real> send = sendBuffer;
+  IdefixArray1D<real> recv = recvBuffer;
+
+  const int nx = L.n[IDIR], ny = L.n[JDIR];
+  const int fx = L.first[IDIR], fy = L.first[JDIR], fz = L.first[KDIR];
+  const int sx = shift[IDIR], sy = shift[JDIR], sz = shift[KDIR];
+  idefix_for("MG_Pack", fz, fz+L.n[KDIR], fy, fy+ny, fx, fx+nx,
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      send(((k-fz)*ny + (j-fy))*nx + (i-fx)) = in(k+sz, j+sy, i+sx);
+    });
+  Kokkos::fence();
+  MPI_SAFE_CALL(MPI_Allgatherv(send.data(), counts[idfx::prank], realMPI,
+                               recv.data(), counts.data(), displs.data(), realMPI,
+                               linearOperator.data->mygrid->CartComm));
+
+  IdefixArray1D<int> bx = blockOf[IDIR], by = blockOf[JDIR], bz = blockOf[KDIR];
+  IdefixArray1D<int> begx = blockBeg[IDIR], begy = blockBeg[JDIR], begz = blockBeg[KDIR];
+  IdefixArray3D<int> rankOf = this->rankOf;
+  IdefixArray1D<int> displ = this->displ;
+  const int gx = G.first[IDIR], gy = G.first[JDIR], gz = G.first[KDIR];
+  idefix_for("MG_Unpack", gz, gz+G.n[KDIR], gy, gy+G.n[JDIR], gx, gx+G.n[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const int I = i-gx, J = j-gy, K = k-gz;
+      const int cx = bx(I), cy = by(J), cz = bz(K);
+      const int lnx = begx(cx+1)-begx(cx);
+      const int lny = begy(cy+1)-begy(cy);
+      const int p = rankOf(cz,cy,cx);
+      out(k,j,i) = recv(displ(p) + ((K-begz(cz))*lny + (J-begy(cy)))*lnx + (I-begx(cx)));
+    });
+  idfx::popRegion();
+}
+
+void Multigrid::Scatter(int l) {
+  const Level &L = levels[l];
+  const Level &G = levels[l+1];
+  IdefixArray3D<real> x = L.x;
+  IdefixArray3D<real> xG = G.x;
+  const int ox = G.first[IDIR] + myBeg[IDIR] - L.first[IDIR];
+  const int oy = G.first[JDIR] + myBeg[JDIR] - L.first[JDIR];
+  const int oz = G.first[KDIR] + myBeg[KDIR] - L.first[KDIR];
+  idefix_for("MG_Scatter", L.first[KDIR], L.first[KDIR]+L.n[KDIR],
+                           L.first[JDIR], L.first[JDIR]+L.n[JDIR],
+                           L.first[IDIR], L.first[IDIR]+L.n[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      x(k,j,i) = xG(k+oz, j+oy, i+ox);
+    });
+}
+
+void Multigrid::ExchangeGhosts(const Level &L, IdefixArray3D<real> arr, int dir) {
+  idfx::pushRegion("Multigrid::ExchangeGhosts");
+  // Faces of the level, which are smaller than those of the first coarse level
+  const Level &L1 = levels[1];
+  if(exchangeBuffer[0].extent(0) == 0) {
+    int size = 1;
+    for(int d = 0 ; d < DIMENSIONS ; d++) {
+      int face = 1;
+      for(int t = 0 ; t < 3 ; t++) if(t != d) face *= L1.n[t];
+      size = std::max(size, face);
+    }
+    for(int b = 0 ; b < 4 ; b++) {
+      exchangeBuffer[b] = IdefixArray1D<real>("MG_ExchangeBuffer", size);
+    }
+  }
+
+  std::array<int,3> b0 = L.first;
+  std::array<int,3> b1 = {L.first[IDIR]+L.n[IDIR], L.first[JDIR]+L.n[JDIR],
+                          L.first[KDIR]+L.n[KDIR]};
+  const int n1 = (dir == IDIR) ? L.n[JDIR] : L.n[IDIR];
+  const int f0 = (dir == IDIR) ? L.first[JDIR] : L.first[IDIR];
+  const int f1 = (dir == KDIR) ? L.first[JDIR] : L.first[KDIR];
+  const int ex = (dir == IDIR) ? 1 : 0;
+  const int ey = (dir == JDIR) ? 1 : 0;
+  const int ez = (dir == KDIR) ? 1 : 0;
+  const int size = (b1[IDIR]-b0[IDIR])*(b1[JDIR]-b0[JDIR])*(b1[KDIR]-b0[KDIR])/L.n[dir];
+  const int first = L.first[dir];
+  const int last = L.first[dir]+L.n[dir]-1;
+
+  IdefixArray1D<real> sendLeft = exchangeBuffer[0];
+  IdefixArray1D<real> sendRight = exchangeBuffer[1];
+  IdefixArray1D<real> recvLeft = exchangeBuffer[2];
+  IdefixArray1D<real> recvRight = exchangeBuffer[3];
+
+  // Index of a cell of the face in the buffers
+  b0[dir] = 0;
+  b1[dir] = 1;
+  idefix_for("MG_PackGhosts", b0[KDIR], b1[KDIR], b0[JDIR], b1[JDIR], b0[IDIR], b1[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const int t0 = ex ? j : i;
+      const int t1 = ez ? j : k;
+      const int idx = (t1-f1)*n1 + (t0-f0);
+      sendLeft(idx) = arr(ez ? first : k, ey ? first : j, ex ? first : i);
+      sendRight(idx) = arr(ez ? last : k, ey ? last : j, ex ? last : i);
+    });
+  Kokkos::fence();
+
+  MPI_Comm comm = linearOperator.data->mygrid->CartComm;
+  MPI_Status status;
+  MPI_SAFE_CALL(MPI_Sendrecv(sendRight.data(), size, realMPI, neighbour[dir][1], 300,
+                             recvLeft.data(), size, realMPI, neighbour[dir][0], 300,
+                             comm, &status));
+  MPI_SAFE_CALL(MPI_Sendrecv(sendLeft.data(), size, realMPI, neighbour[dir][0], 301,
+                             recvRight.data(), size, realMPI, neighbour[dir][1], 301,
+                             comm, &status));
+
+  const bool left = (L.bound[dir][0] == Bound::exchange);
+  const bool right = (L.bound[dir][1] == Bound::exchange);
+  idefix_for("MG_UnpackGhosts", b0[KDIR], b1[KDIR], b0[JDIR], b1[JDIR], b0[IDIR], b1[IDIR],
+    KOKKOS_LAMBDA (int k, int j, int i) {
+      const int t0 = ex ? j : i;
+      const int t1 = ez ? j : k;
+      const int idx = (t1-f1)*n1 + (t0-f0);
+      if(left) arr(ez ? first-1 : k, ey ? first-1 : j, ex ? first-1 : i) = recvLeft(idx);
+      if(right) arr(ez ? last+1 : k, ey ? last+1 : j, ex ? last+1 : i) = recvRight(idx);
+    });
+  idfx::popRegion();
+}
+#endif
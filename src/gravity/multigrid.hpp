@@ -0,0 +1,104 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef GRAVITY_MULTIGRID_HPP_
+#define GRAVITY_MULTIGRID_HPP_
+
+#include <array>
+#include <vector>
+#include "idefix.hpp"
+#include "iterativesolver.hpp"
+#include "laplacian.hpp"
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+/// Geometric multigrid for the self-gravity Laplacian. The coarse levels aggregate 2 cells per
+/// direction, and their operators are obtained from the face couplings A/(h dx) of the finest
+/// one (Galerkin coarsening with piecewise constant interpolation), so that any geometry and
+/// grid stretching (including the origin internal grid) is handled. Each level is smoothed
+/// with a Chebyshev polynomial of the Jacobi-preconditioned operator. The coarse levels are
+/// distributed as the finest one until they cannot be coarsened further on each process. They
+/// are then gathered on all of the processes, which carry on the coarsening redundantly.
+/// The multigrid can be used as a solver on its own (V-cycles) or to precondition Cg/Bicgstab.
+//////////////////////////////////////////////////////////////////////////////////////////////////
+class Multigrid : public IterativeSolver<Laplacian> {
+ public:
+  Multigrid(Laplacian &op, real error, int maxIter, int degree,
+            std::array<Laplacian::LaplacianBoundaryType,3> lbound,
+            std::array<Laplacian::LaplacianBoundaryType,3> rbound);
+
+  int Solve(IdefixArray3D<real> &guess, IdefixArray3D<real> &rhs);
+  void ShowConfig();
+
+  // One V-cycle from a vanishing guess: z is an approximate solution of Laplacian(z)=r
+  void Precondition(IdefixArray3D<real> &r, IdefixArray3D<real> &z);
+
+  // Internal functions (left public for Lambda capture)
+  void VCycle(int);                         // V-cycle of a level for its rhs b
+  void Smooth(int, int, real, bool);        // Chebyshev smoothing of a level
+  void Residual(int, bool);                 // r = b - A x (or b when x vanishes)
+  void Restrict(int);                       // b of level l+1 from the residual of level l
+  void Prolong(int);                        // Add the correction of level l+1 to level l
+  void FillGhosts(int, IdefixArray3D<real>);
+
+ private:
+  enum class Bound {dirichlet, neumann, periodic, exchange};
+
+  struct Level {
+    std::array<int,3> n;                    // number of cells
+    std::array<int,3> first;                // index of the first cell in the arrays
+    std::array<int,3> ratio{1,1,1};         // coarsening ratio from the previous level
+    bool replicated{false};                 // the whole grid is stored by each process
+    bool gathered{false};                   // obtained by gathering the previous level
+    std::array<std::array<Bound,2>,3> bound;
+    IdefixArray3D<real> vol;                // cell volumes
+    std::array<IdefixArray3D<real>,3> c;    // couplings through the left face of each cell
+    IdefixArray3D<real> invDiag;            // inverse of the diagonal of the operator
+    IdefixArray3D<real> x;                  // correction
+    IdefixArray3D<real> b;                  // right hand side
+    IdefixArray3D<real> r;                  // residual
+    IdefixArray3D<real> d;                  // smoother update
+  };
+
+  std::vector<Level> levels;
+  int degree;                               // degree of the Chebyshev smoother
+  int nprocs{1};
+  std::array<std::array<Bound,2>,3> physicalBound;
+  IdefixArray3D<real> correction;           // correction of the V-cycles of the solver
+
+  // Parameters of the cycles
+  static constexpr real lambdaMax{2.0};     // bound of the spectrum of D^-1 A
+  static constexpr real smoothingRatio{30.0}; // lambdaMax/smallest eigenvalue to be smoothed
+  static constexpr real overCorrection{1.8};  // compensates the constant interpolation
+  static constexpr int coarseDegree{8};      // Chebyshev polynomial used on the coarsest level
+  static constexpr real coarseRatio{100.0};
+  static constexpr int agglomerationSize{4096};
+
+  void InitFinestLevel();
+  void AddCoarseLevel(std::array<int,3>);
+  void AddGatheredLevel();
+  void AllocateLevel(Level &);
+  void ComputeDiagonal(Level &);
+
+  #ifdef WITH_MPI
+  // Agglomeration: position of the blocks of each process in the gathered grid
+  std::array<IdefixArray1D<int>,3> blockOf;     // block coordinate of each global cell
+  std::array<IdefixArray1D<int>,3> blockBeg;    // first global cell of each block
+  IdefixArray3D<int> rankOf;                    // rank of each block
+  IdefixArray1D<int> displ;                     // offset of each rank in the gathered buffer
+  std::vector<int> counts, displs;
+  std::array<int,3> myBeg;                      // first global cell of this process
+  IdefixArray1D<real> sendBuffer, recvBuffer;
+  std::array<std::array<int,2>,3> neighbour;    // neighbouring processes in each direction
+  std::array<IdefixArray1D<real>,4> exchangeBuffer;
+
+  void Gather(int, IdefixArray3D<real>, IdefixArray3D<real>, std::array<int,3>);
+  void Scatter(int);
+  void ExchangeGhosts(const Level &, IdefixArray3D<real>, int);
+  #endif
+};
+
+#endif // GRAVITY_MULTIGRID_HPP_
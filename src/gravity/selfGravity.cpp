@@ -5,6 +5,8 @@
 // Licensed under CeCILL 2.1 License, see COPYING for more information
 // ***********************************************************************************
 
+#include <algorithm>
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
@@ -40,6 +42,18 @@ void SelfGravity::Init(Input &input, DataBlock *datain) {
   if(skipSelfGravity<1) {
     IDEFIX_ERROR("[SelfGravity]:skip should be a strictly positive integer");
   }
+  this->skipTolerance = input.GetOrSet<real>("SelfGravity","skipTolerance",0,0.0);
+  if(skipTolerance<0) {
+    IDEFIX_ERROR("[SelfGravity]:skipTolerance should be a positive real");
+  }
+  this->haveAdaptiveSkip = (skipTolerance > 0);
+
+  // Order of the extrapolation in time of the initial guess
+  this->extrapolationOrder = input.GetOrSet<int>("SelfGravity","extrapolation",0,0);
+  if(extrapolationOrder<0 || extrapolationOrder>2) {
+    IDEFIX_ERROR("[SelfGravity]:extrapolation should be 0 (previous potential), 1 (linear) "
+                 "or 2 (quadratic)");
+  }
 
   // Get the gravity-related boundary conditions
   for (int dir = 0 ; dir < 3 ; dir++) {
@@ -67,6 +81,12 @@ void SelfGravity::Init(Input &input, DataBlock *datain) {
     } else if(boundary.compare("axis") == 0) {
       this->lbound[dir] = Laplacian::LaplacianBoundaryType::axis;
       this->isPeriodic = false;
+    } else if(boundary.compare("shearingbox") == 0) {
+      // Shear-periodic: the density distribution remains periodic in the sheared frame
+      this->lbound[dir] = Laplacian::LaplacianBoundaryType::shearingbox;
+      if(dir != IDIR) {
+        IDEFIX_ERROR("Shearingbox boundary conditions are meaningful only on the X1 direction");
+      }
     } else if(boundary.compare("origin") == 0) {
       this->lbound[dir] = Laplacian::LaplacianBoundaryType::origin;
       this->isPeriodic = false;
@@ -102,6 +122,11 @@ void SelfGravity::Init(Input &input, DataBlock *datain) {
     } else if(boundary.compare("axis") == 0) {
       this->rbound[dir] = Laplacian::LaplacianBoundaryType::axis;
       this->isPeriodic = false;
+    } else if(boundary.compare("shearingbox") == 0) {
+      this->rbound[dir] = Laplacian::LaplacianBoundaryType::shearingbox;
+      if(dir != IDIR) {
+        IDEFIX_ERROR("Shearingbox boundary conditions are meaningful only on the X1 direction");
+      }
     } else {
       std::stringstream msg;
       msg << "SelfGravity:: Unknown boundary type " << boundary;
@@ -126,6 +151,14 @@ void SelfGravity::Init(Input &input, DataBlock *datain) {
       solver = MINRES;
     } else if(strSolver.compare("PMINRES")==0) {
       solver = PMINRES;
+    } else if(strSolver.compare("MG")==0) {
+      solver = MG;
+    } else if(strSolver.compare("MGCG")==0) {
+      solver = MGCG;
+    } else if(strSolver.compare("MGBICGSTAB")==0) {
+      solver = MGBICGSTAB;
+    } else if(strSolver.compare("FFT")==0) {
+      solver = FFT;
     } else {
       try {
         // Try to use the old solver definition with integer (deprecated)
@@ -136,7 +169,8 @@ void SelfGravity::Init(Input &input, DataBlock *datain) {
       } catch(const std::exception& e) {
         std::stringstream msg;
         msg << "SelfGravity: Unknown solver \"" << strSolver << "\"."
-            << "Use \"Jacobi\", \"BICGSTAB\" or \"PBICGSTAB\"."
+            << "Use \"Jacobi\", \"BICGSTAB\", \"PBICGSTAB\", \"CG\", \"PCG\", \"MINRES\", "
+            << "\"PMINRES\", \"MG\", \"MGCG\", \"MGBICGSTAB\" or \"FFT\"."
             << std::endl;
         IDEFIX_ERROR(msg);
       }
@@ -155,11 +189,22 @@ void SelfGravity::Init(Input &input, DataBlock *datain) {
 
   np_tot = laplacian->np_tot;
 
+  // Make the multigrid hierarchy
+  if(solver == MG || solver == MGCG || solver == MGBICGSTAB) {
+    const int degree = input.GetOrSet<int>("SelfGravity","mgDegree",0,3);
+    multigrid = std::make_unique<Multigrid>(*laplacian.get(), targetError, maxiter, degree,
+                                            lbound, rbound);
+  }
+
   // Instantiate the bicgstab solver
-  if(solver == BICGSTAB || solver == PBICGSTAB) {
+  if(solver == MG) {
+    iterativeSolver = multigrid.get();
+  } else if(solver == FFT) {
+    iterativeSolver = new FftSolver(*laplacian.get(), targetError, maxiter, lbound, rbound);
+  } else if(solver == BICGSTAB || solver == PBICGSTAB || solver == MGBICGSTAB) {
     iterativeSolver = new Bicgstab<Laplacian>(*laplacian.get(), targetError, maxiter,
                                               laplacian->np_tot, laplacian->beg, laplacian->end);
-  } else if(solver == CG || solver == PCG) {
+  } else if(solver == CG || solver == PCG || solver == MGCG) {
     iterativeSolver = new Cg<Laplacian>(*laplacian.get(), targetError, maxiter,
                                         laplacian->np_tot, laplacian->beg, laplacian->end);
   } else if(solver == MINRES || solver == PMINRES) {
@@ -172,6 +217,11 @@ void SelfGravity::Init(Input &input, DataBlock *datain) {
                                               laplacian->np_tot, laplacian->beg, laplacian->end);
   }
 
+  if(solver == MGCG || solver == MGBICGSTAB) {
+    Multigrid *mg = multigrid.get();
+    iterativeSolver->SetPreconditioner(
+      [mg](IdefixArray3D<real> &r, IdefixArray3D<real> &z) { mg->Precondition(r, z); });
+  }
 
   // Arrays initialisation
   this->density = IdefixArray3D<real> ("Density", this->np_tot[KDIR],
@@ -190,6 +240,17 @@ void SelfGravity::Init(Input &input, DataBlock *datain) {
                                                       this->np_tot[JDIR],
                                                       this->np_tot[IDIR]);
 
+  for(int n = 0 ; n < extrapolationOrder ; n++) {
+    history.push_back(IdefixArray3D<real> ("PotentialHistory", this->np_tot[KDIR],
+                                                                this->np_tot[JDIR],
+                                                                this->np_tot[IDIR]));
+  }
+  if(haveAdaptiveSkip) {
+    this->lastDensity = IdefixArray3D<real> ("LastDensity", this->np_tot[KDIR],
+                                                            this->np_tot[JDIR],
+                                                            this->np_tot[IDIR]);
+  }
+
 
   idfx::popRegion();
 }
@@ -220,6 +281,18 @@ void SelfGravity::ShowConfig() {
     case PMINRES:
       idfx::cout << "preconditionned MinRes";
       break;
+    case MG:
+      idfx::cout << "multigrid";
+      break;
+    case MGCG:
+      idfx::cout << "multigrid-preconditionned CG";
+      break;
+    case MGBICGSTAB:
+      idfx::cout << "multigrid-preconditionned BICGSTAB";
+      break;
+    case FFT:
+      idfx::cout << "FFT";
+      break;
     default:
       IDEFIX_ERROR("SelfGravity:: Unknown solver");
   }
@@ -238,11 +311,20 @@ void SelfGravity::ShowConfig() {
                << " additional radial points." << std::endl;
   }
 
-  if(this->skipSelfGravity>1) {
+  if(haveAdaptiveSkip) {
+    idfx::cout << "SelfGravity: self-gravity field will be updated when the density changes by "
+               << "more than " << skipTolerance << ", or every " << skipSelfGravity
+               << " cycles." << std::endl;
+  } else if(this->skipSelfGravity>1) {
     idfx::cout << "SelfGravity: self-gravity field will be updated every " << skipSelfGravity
                << " cycles." << std::endl;
   }
+  if(extrapolationOrder > 0) {
+    idfx::cout << "SelfGravity: initial guess extrapolated with order " << extrapolationOrder
+               << " from the previous potentials." << std::endl;
+  }
   iterativeSolver->ShowConfig();
+  if(solver == MGCG || solver == MGBICGSTAB) multigrid->ShowConfig();
 }
 
 
@@ -355,7 +437,7 @@ void SelfGravity::SubstractMeanDensity() {
 
   // Reduction on the whole grid
   #ifdef WITH_MPI
-  MPI_Allreduce(MPI_IN_PLACE, &meanDensityVector.v, 2, realMPI, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, &meanDensityVector.v, 2, accumMPI, MPI_SUM, MPI_COMM_WORLD);
   #endif
 
   real mean = meanDensityVector.v[0] / meanDensityVector.v[1];
@@ -378,6 +460,93 @@ void SelfGravity::EnrollUserDefBoundary(Laplacian::UserDefBoundaryFunc myFunc) {
 
 
 
+bool SelfGravity::IsSolveNeeded(int cycle) {
+  if(!haveAdaptiveSkip) return(cycle % skipSelfGravity == 0);
+
+  idfx::pushRegion("SelfGravity::IsSolveNeeded");
+  Kokkos::Timer timer;
+  elapsedTime -= timer.seconds();
+
+  InitSolver();
+  isDensityReady = true;
+  bool needed = true;
+  if(lastSolveCycle >= 0 && cycle - lastSolveCycle < skipSelfGravity) {
+    // The residual of the previous potential is the change of the density
+    needed = (ComputeDensityChange() > skipTolerance);
+  }
+  if(needed) {
+    lastSolveCycle = cycle;
+  } else {
+    isDensityReady = false;
+    this->nsteps = 0;
+  }
+
+  elapsedTime += timer.seconds();
+  idfx::popRegion();
+  return(needed);
+}
+
+real SelfGravity::ComputeDensityChange() {
+  idfx::pushRegion("SelfGravity::ComputeDensityChange");
+  IdefixArray3D<real> density = this->density;
+  IdefixArray3D<real> lastDensity = this->lastDensity;
+
+  MyVector norm;
+  idefix_reduce("DensityChange",
+                laplacian->beg[KDIR], laplacian->end[KDIR],
+                laplacian->beg[JDIR], laplacian->end[JDIR],
+                laplacian->beg[IDIR], laplacian->end[IDIR],
+                KOKKOS_LAMBDA (int k, int j, int i, MyVector &localVector) {
+                  const real drho = density(k,j,i) - lastDensity(k,j,i);
+                  localVector.v[0] += drho * drho;
+                  localVector.v[1] += density(k,j,i) * density(k,j,i);
+                },
+                Kokkos::Sum<MyVector>(norm));
+  #ifdef WITH_MPI
+  MPI_Allreduce(MPI_IN_PLACE, &norm.v, 2, accumMPI, MPI_SUM, MPI_COMM_WORLD);
+  #endif
+
+  idfx::popRegion();
+  if(norm.v[1] == 0) return(norm.v[0] > 0 ? 1.0 : 0.0);
+  return(std::sqrt(norm.v[0] / norm.v[1]));
+}
+
+void SelfGravity::PredictPotential() {
+  idfx::pushRegion("SelfGravity::PredictPotential");
+  const real t = data->t;
+
+  // Lagrange extrapolation from the last (order+1) solutions, or the last one only until
+  // enough solutions are known. Nothing to be done when solving again at the same time.
+  const int npoints = std::min<int>(historyTime.size(), extrapolationOrder+1);
+  if(npoints > 0 && t != historyTime[0]) {
+    std::array<real,3> w = {ZERO_F, ZERO_F, ZERO_F};
+    for(int n = 0 ; n < npoints ; n++) {
+      w[n] = 1.0;
+      for(int m = 0 ; m < npoints ; m++) {
+        if(m != n) w[n] *= (t - historyTime[m]) / (historyTime[n] - historyTime[m]);
+      }
+    }
+    const real w0 = w[0];
+    const real w1 = w[1];
+    const real w2 = w[2];
+    IdefixArray3D<real> phi0 = potential;
+    IdefixArray3D<real> phi1 = history[0];
+    IdefixArray3D<real> phi2 = history[npoints > 2 ? 1 : 0];
+    // The guess overwrites the oldest potential, which becomes the current one
+    IdefixArray3D<real> guess = history.back();
+    idefix_for("PredictPotential", 0, this->np_tot[KDIR],
+                                   0, this->np_tot[JDIR],
+                                   0, this->np_tot[IDIR],
+      KOKKOS_LAMBDA (int k, int j, int i) {
+        guess(k,j,i) = w0*phi0(k,j,i) + w1*phi1(k,j,i) + w2*phi2(k,j,i);
+      });
+    history.pop_back();
+    history.insert(history.begin(), potential);
+    potential = guess;
+  }
+  idfx::popRegion();
+}
+
 void SelfGravity::SolvePoisson() {
   idfx::pushRegion("SelfGravity::SolvePoisson");
 
@@ -385,7 +554,11 @@ void SelfGravity::SolvePoisson() {
 
   elapsedTime -= timer.seconds();
 
-  InitSolver(); // (Re)initialise the solver
+  // (Re)initialise the solver
+  if(!isDensityReady) InitSolver();
+  isDensityReady = false;
+
+  if(extrapolationOrder > 0) PredictPotential();
 
   this->nsteps = iterativeSolver->Solve(potential, density);
   if (this->nsteps<0) {
@@ -418,6 +591,12 @@ void SelfGravity::SolvePoisson() {
 
   currentError = iterativeSolver->GetError();
 
+  // Keep track of the solutions
+  if(extrapolationOrder > 0 && (historyTime.size() == 0 || historyTime[0] != data->t)) {
+    historyTime.insert(historyTime.begin(), data->t);
+    if(historyTime.size() > static_cast<size_t>(extrapolationOrder+1)) historyTime.pop_back();
+  }
+  if(haveAdaptiveSkip) Kokkos::deep_copy(lastDensity, density);
 
   elapsedTime += timer.seconds();
   idfx::popRegion();
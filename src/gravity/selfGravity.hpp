@@ -17,6 +17,8 @@
 #include "fluid_defs.hpp"
 #include "iterativesolver.hpp"
 #include "laplacian.hpp"
+#include "multigrid.hpp"
+#include "fftSolver.hpp"
 
 #ifdef WITH_MPI
 #include "mpi.hpp"
@@ -27,7 +29,8 @@ class DataBlock;
 
 class SelfGravity {
  public:
-  enum GravitySolver {JACOBI, BICGSTAB, PBICGSTAB, PCG, CG, PMINRES, MINRES};
+  enum GravitySolver {JACOBI, BICGSTAB, PBICGSTAB, PCG, CG, PMINRES, MINRES,
+                      MG, MGCG, MGBICGSTAB, FFT};
 
   void Init(Input &, DataBlock *);  // Initialisation of the class attributes
   void ShowConfig();                // display current configuration
@@ -35,7 +38,10 @@ class SelfGravity {
 
   void SubstractMeanDensity();  // Compute and substract the average input density
 
+  bool IsSolveNeeded(int);  // Whether the potential should be updated at a given cycle
   void SolvePoisson(); // Solve Poisson equation
+  void PredictPotential();  // Extrapolate the initial guess from the previous potentials
+  real ComputeDensityChange();  // Relative change of the density since the last solve
   void AddSelfGravityPotential(IdefixArray3D<real> &);
 
   void EnrollUserDefBoundary(Laplacian::UserDefBoundaryFunc myFunc);  // User-defined boundary
@@ -45,6 +51,9 @@ class SelfGravity {
   // The linear operator involved in Poisson equation
   std::unique_ptr<Laplacian> laplacian;
 
+  // Multigrid, used as a solver or a preconditioner
+  std::unique_ptr<Multigrid> multigrid;
+
   real currentError{0};       // last error of the iterative solver
   int nsteps{0};              // # of steps of the latest iteration
   double elapsedTime;        // time spent solving self gravity
@@ -52,6 +61,11 @@ class SelfGravity {
   // Whether we should skip self-gravity computation every n steps
   int skipSelfGravity{1};
 
+  // Adaptive skipping: the potential is only updated when the density has changed by more
+  // than skipTolerance (relative L2 norm), or every skipSelfGravity cycles
+  bool haveAdaptiveSkip{false};
+  real skipTolerance{0};
+
  private:
   DataBlock *data;  // My parent data object
   IdefixArray3D<real> potential;  // Gravitational potential
@@ -64,6 +78,16 @@ class SelfGravity {
   std::array<Laplacian::LaplacianBoundaryType,3> lbound;  // Boundary condition to the left
   std::array<Laplacian::LaplacianBoundaryType,3> rbound;  // Boundary condition to the right
 
+  // Previous potentials (most recent first) and times of the solutions, the current one
+  // being stored in potential
+  int extrapolationOrder{0};
+  std::vector<IdefixArray3D<real>> history;
+  std::vector<real> historyTime;
+
+  IdefixArray3D<real> lastDensity;  // density of the last solve (adaptive skipping)
+  int lastSolveCycle{-1};
+  bool isDensityReady{false};       // density already initialised for the next solve
+
   bool isPeriodic;
   bool havePreconditioner{false};
   GravitySolver solver; // The solver  used to solve Poisson
@@ -5,7 +5,9 @@
 // Licensed under CeCILL 2.1 License, see COPYING for more information
 // ***********************************************************************************
 
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include "idefix.hpp"
 #include "gridHost.hpp"
@@ -35,6 +37,11 @@ Grid::Grid(SubGrid * subgrid) {
 
   nproc = subgrid->parentGrid->nproc;
   xproc = subgrid->parentGrid->xproc;
+  np_proc = subgrid->parentGrid->np_proc;
+  predictedImbalance = subgrid->parentGrid->predictedImbalance;
+  #ifdef WITH_MPI
+  mpiTransport = subgrid->parentGrid->mpiTransport;
+  #endif
 
   // Now slice if along the chosen direction
   SliceMe(subgrid);
@@ -158,47 +165,41 @@ Grid::Grid(Input &input) {
   for(int i=0 ; i < 3 ; i++)
     period[i] = 0;
 
+  // Number of ghost cells exchanged in each direction
+  nexchange = nghost;
+  if(input.CheckBlock("Fargo")) {
+    // Fargo exchanges maxShift additional cells in the orbital direction
+    #if GEOMETRY == SPHERICAL
+      const int fargoDir = KDIR;
+    #else
+      const int fargoDir = JDIR;
+    #endif
+    int maxShift = 10;
+    if(input.CheckEntry("Fargo","maxShift")>=0) maxShift = input.Get<int>("Fargo","maxShift",0);
+    nexchange[fargoDir] += maxShift;
+  }
+
   // Check that number of procs > 1
   if(idfx::psize>1) {
-    int ngridtot=1;
-    for(int dir=0 ; dir < DIMENSIONS; dir++) {
-      ngridtot *= np_int[dir];
-    }
-    // Check that the total grid dimension is effectively divisible by number of procs
-    if(ngridtot % idfx::psize)
-      IDEFIX_ERROR("Total grid size must be a multiple of the number of mpi process");
     // Check that dec option has been passed
     if(input.CheckEntry("CommandLine","dec")  != DIMENSIONS) {
-      // No command line decomposition, make auto-decomposition if possible
-      // (only when nproc and dimensions are powers of 2, and in 1D)
-      if(DIMENSIONS == 1) {
-        nproc[0] = idfx::psize;
-      } else {
-        if(!isPow2(idfx::psize))
-          IDEFIX_ERROR(
-            "Automatic domain decomposition requires the number of processes to be a power of 2. "
-            "Alternatively, set a manual decomposition with -dec"
-          );
-        for(int dir = 0; dir < 3; dir++) {
-          if(!isPow2(np_int[dir]))
-            IDEFIX_ERROR(
-              "Automatic domain decomposition requires nx1, nx2 and nx3 to be powers of 2. "
-              "Alternatively, set a manual decomposition with -dec"
-            );
-        }
-        makeDomainDecomposition();
-      }
+      // No command line decomposition, look for the best one
+      makeDomainDecomposition();
     } else {
       // Manual domain decomposition (with -dec option)
       int ntot=1;
       for(int dir=0 ; dir < DIMENSIONS; dir++) {
         nproc[dir] = input.Get<int>("CommandLine","dec",dir);
-        // Check that the dimension is effectively divisible by number of procs along each direction
-        if(np_int[dir] % nproc[dir])
-          IDEFIX_ERROR("Grid size must be a multiple of the domain decomposition");
+        // Check that each process gets enough points to fill the ghost zones of its neighbours
+        if(nproc[dir] > 1 && np_int[dir] / nproc[dir] < nghost[dir])
+          IDEFIX_ERROR("Grid size is too small for the domain decomposition");
         // Count the total number of procs we'll need for the specified domain decomposition
         ntot = ntot * nproc[dir];
       }
+      // Axis exchanges pair each process with the one facing it across the axis
+      if(haveAxis && nproc[KDIR] > 1 && np_int[KDIR] % nproc[KDIR])
+        IDEFIX_ERROR("With axis boundaries, X3 grid size must be a multiple of the "
+                     "domain decomposition");
       if(ntot != idfx::psize) {
         std::stringstream msg;
         msg << "The number of MPI process (" << idfx::psize
@@ -218,6 +219,11 @@ Grid::Grid(Input &input) {
     if(rbound[dir] == periodic || rbound[dir] == shearingbox) period[dir] = 1;
   }
 
+  // Transport of the MPI halo buffers (device, pinned, host or auto)
+  if(input.CheckEntry("CommandLine","mpiTransport")>=0) {
+    mpiTransport = input.Get<std::string>("CommandLine","mpiTransport",0);
+  }
+
   // Create cartesian communicator along with cartesian coordinates.
   MPI_Cart_create(MPI_COMM_WORLD, 3, nproc.data(), period, 0, &CartComm);
   MPI_Cart_coords(CartComm, idfx::prank, 3, xproc.data());
@@ -233,6 +239,9 @@ Grid::Grid(Input &input) {
   }
 #endif
 
+  // Number of points of each process in each direction
+  makeProcExtents();
+
   // init coarsening
   if(input.CheckEntry("Grid","coarsening")>=0) {
     std::string coarsenType = input.Get<std::string>("Grid","coarsening",0);
@@ -268,44 +277,171 @@ Grid::Grid(Input &input) {
   idfx::popRegion();
 }
 
-bool Grid::isPow2(int n) {
-  return( (n & (n-1)) == 0);
+// Distribute the points of each direction between the processes of this direction. When the
+// number of points is not a multiple of the number of processes, the first processes get one
+// additional point.
+void Grid::makeProcExtents() {
+  double workMin = 1;
+  double workMax = 1;
+  double workMean = 1;
+  for(int dir = 0; dir < 3; dir++) {
+    np_proc[dir].resize(nproc[dir]);
+    for(int p = 0 ; p < nproc[dir] ; p++) {
+      np_proc[dir][p] = np_int[dir] / nproc[dir] + ((p < np_int[dir] % nproc[dir]) ? 1 : 0);
+    }
+    workMin *= np_int[dir] / nproc[dir];
+    workMax *= np_proc[dir][0];
+    workMean *= static_cast<double>(np_int[dir]) / nproc[dir];
+  }
+  predictedImbalance = (workMax-workMin)/workMean*100;
 }
 
-// Produce a domain decomposition in nProc assuming psize and np_int[] are powers of 2
-void Grid::makeDomainDecomposition() {
-  // initialize the routine
-  int nleft=idfx::psize;
-  int nlocal[3];
+// First active cell (excluding ghosts) of the process of coordinate coord along dir
+int Grid::GetProcOffset(int dir, int coord) {
+  int offset = 0;
+  for(int p = 0 ; p < coord ; p++) {
+    offset += np_proc[dir][p];
+  }
+  return(offset);
+}
+
+// Whether the decomposition n can be used
+bool Grid::isValidDecomposition(const std::array<int,3> &n) {
   for(int dir = 0; dir < 3; dir++) {
-    nproc[dir] = 1;
-    nlocal[dir] = np_int[dir];
+    if(dir >= DIMENSIONS && n[dir] > 1) return(false);
+    // Each process should fill the ghost zones of its neighbours
+    if(n[dir] > 1 && np_int[dir] / n[dir] < nexchange[dir]) return(false);
+  }
+  // Axis exchanges pair each process with the one facing it across the axis
+  if(haveAxis && n[KDIR] > 1) {
+    if(n[KDIR] % 2 || np_int[KDIR] % n[KDIR]) return(false);
+  }
+  // Shearing box boundaries do not support a decomposition in X2
+  if((lbound[IDIR] == shearingbox || rbound[IDIR] == shearingbox) && n[JDIR] > 1) return(false);
+  return(true);
+}
+
+// Move the boundaries between processes so as to even out their compute time, assuming the time
+// measured on each process is evenly spread over its cells. This is a collective call, which
+// returns true when the extents of the processes have changed.
+bool Grid::Rebalance(double computeTime) {
+  bool changed = false;
+  #ifdef WITH_MPI
+  double newImbalance = 0;
+  for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+    if(nproc[dir] == 1) continue;
+    // Compute time of each slab of processes sharing the same coordinate along dir
+    std::vector<double> slabTime(nproc[dir], 0.0);
+    slabTime[xproc[dir]] = computeTime;
+    MPI_Allreduce(MPI_IN_PLACE, slabTime.data(), nproc[dir], MPI_DOUBLE, MPI_SUM, CartComm);
+
+    // Axis exchanges pair processes across the axis, and grid coarsening requires a given
+    // number of cells in each process: keep the current extents in these cases.
+    bool canMove = (np_int[dir] >= nproc[dir]*nexchange[dir]);
+    if(haveAxis && dir == KDIR) canMove = false;
+    if(haveGridCoarsening && coarseningDirection[dir]) canMove = false;
+
+    // cumul[i] is the compute time of cells [0,i) along dir
+    std::vector<double> cumul(np_int[dir]+1, 0.0);
+    int i = 0;
+    for(int p = 0 ; p < nproc[dir] ; p++) {
+      for(int n = 0 ; n < np_proc[dir][p] ; n++, i++) {
+        cumul[i+1] = cumul[i] + slabTime[p]/np_proc[dir][p];
+      }
+    }
+
+    std::vector<int> extent = np_proc[dir];
+    if(canMove) {
+      // Cut the cumulated time in nproc equal parts, keeping at least nexchange cells per process
+      int start = 0;
+      for(int p = 0 ; p < nproc[dir]-1 ; p++) {
+        const double target = cumul[np_int[dir]]*(p+1)/nproc[dir];
+        int end = start + nexchange[dir];
+        while(end < np_int[dir] && cumul[end] < target) end++;
+        if(end > start + nexchange[dir] && target-cumul[end-1] < cumul[end]-target) end--;
+        end = std::min(end, np_int[dir] - (nproc[dir]-1-p)*nexchange[dir]);
+        extent[p] = end - start;
+        start = end;
+      }
+      extent[nproc[dir]-1] = np_int[dir] - start;
+    }
+
+    // Expected time of each slab with the new extents
+    double tMin = cumul[np_int[dir]];
+    double tMax = 0;
+    int start = 0;
+    for(int p = 0 ; p < nproc[dir] ; p++) {
+      const double t = cumul[start+extent[p]] - cumul[start];
+      tMin = std::min(tMin, t);
+      tMax = std::max(tMax, t);
+      start += extent[p];
+    }
+    if(cumul[np_int[dir]] > 0) {
+      newImbalance = std::max(newImbalance, (tMax-tMin)/cumul[np_int[dir]]*nproc[dir]*100);
+    }
+
+    if(extent != np_proc[dir]) {
+      np_proc[dir] = extent;
+      changed = true;
+    }
   }
+  if(changed) predictedImbalance = newImbalance;
+  #endif
+  return(changed);
+}
 
-  // Loop
-  while(nleft>1) {
-    // Find the direction where there is a maximum of point
-    int dirmax;
-    int nmax=1;
-    int ndir=2;
+// Produce the domain decomposition in idfx::psize processes which minimises the estimated cost
+// of the most loaded process: the number of cells it updates, plus the number of ghost cells
+// it exchanges with its neighbours. Any number of processes and grid size is accepted.
+// Every cell is assumed to cost the same: the extra work of the cells close to the axis or in
+// coarsened regions is not modelled, and is only evened out by the runtime rebalancing.
+void Grid::makeDomainDecomposition() {
+  double bestCost = -1;
+  double bestHalo = 0;
+  std::array<int,3> best = {1, 1, 1};
+  for(int n1 = 1 ; n1 <= idfx::psize ; n1++) {
+    if(idfx::psize % n1) continue;
+    for(int n2 = 1 ; n2 <= idfx::psize/n1 ; n2++) {
+      if((idfx::psize/n1) % n2) continue;
+      std::array<int,3> n = {n1, n2, idfx::psize/n1/n2};
+      if(!isValidDecomposition(n)) continue;
+
+      // Size of the largest subdomain
+      std::array<double,3> size;
+      for(int dir = 0; dir < 3; dir++) {
+        size[dir] = (np_int[dir] + n[dir] - 1) / n[dir];
+      }
+      const double work = size[IDIR]*size[JDIR]*size[KDIR];
+      double halo = 0;
+      for(int dir = 0; dir < 3; dir++) {
+        if(n[dir] == 1) continue;
+        double surface = 2*nexchange[dir];
+        for(int perp = 0; perp < 3; perp++) {
+          if(perp != dir) surface *= size[perp] + 2*nghost[perp];
+        }
+        halo += surface;
+      }
+      const double cost = work + halo;
 
-    for(int dir = ndir; dir >= 0; dir--) {
-      // We do this loop backward so that we divide the domain first in the last dimension
+      // For equal costs, we divide the domain first in the last dimension
       // (better for cache optimisation)
-      if(nlocal[dir]>nmax ) {
-        nmax=nlocal[dir];
-        dirmax=dir;
+      bool isBetter = (bestCost < 0) || (cost < bestCost);
+      if(cost == bestCost) {
+        isBetter = (n[KDIR] > best[KDIR]) || (n[KDIR] == best[KDIR] && n[JDIR] > best[JDIR]);
+      }
+      if(isBetter) {
+        bestCost = cost;
+        bestHalo = halo;
+        best = n;
       }
     }
-    // At this point, we have nmax points in direction dirmax,
-    // which is the direction we're going to divide by 2
-    if(nmax==1)
-      IDEFIX_ERROR("Your domain size is too small to be decomposed "
-                   "on this number of MPI processes");
-    nlocal[dirmax]=nlocal[dirmax]/2;
-    nproc[dirmax]=nproc[dirmax]*2;
-    nleft=nleft/2;
   }
+  if(bestCost < 0)
+    IDEFIX_ERROR("Your domain size is too small to be decomposed "
+                 "on this number of MPI processes");
+  nproc = best;
+  idfx::cout << "Grid: automatic domain decomposition exchanges " << bestHalo
+             << " ghost cells per process and cycle stage." << std::endl;
 }
 /*
 Grid& Grid::operator=(const Grid& grid) {
@@ -404,6 +540,9 @@ void Grid::ShowConfig() {
       if(dir < 2) idfx::cout << ", ";
     }
     idfx::cout << ")" << std::endl;
+    idfx::cout << "Grid: MPI halo buffers transport: " << mpiTransport << std::endl;
+    idfx::cout << "Grid: predicted MPI imbalance from the domain decomposition: "
+               << predictedImbalance << "%" << std::endl;
   #endif
   if(haveGridCoarsening) {
     if(haveGridCoarsening == GridCoarsening::enabled ) {
@@ -464,4 +603,5 @@ void Grid::SliceMe(SubGrid *subgrid) {
     nproc[dir] = 1;
     xproc[dir] = 0;
   #endif
+  np_proc[dir] = std::vector<int>(1, 1);
 }
@@ -9,6 +9,7 @@
 #define GRID_HPP_
 #include <vector>
 #include <memory>
+#include <string>
 #include "idefix.hpp"
 #include "input.hpp"
 
@@ -48,11 +49,14 @@ class Grid {
   // MPI data
   std::array<int,3> nproc;           ///</< Total number of procs in each direction
   std::array<int,3> xproc;           ///</< Coordinates of current proc in the array of procs
+  std::array<std::vector<int>,3> np_proc; ///< # of active cells of each proc in each direction
+  double predictedImbalance{0};      ///< Load imbalance (%) expected from the decomposition
 
   #ifdef WITH_MPI
   MPI_Comm CartComm;                ///< Cartesian communicator for the planned domain decomposition
   MPI_Comm AxisComm;                ///< Cartesian communicator to exchange data accross the axis
                                     ///< (when applicable)
+  std::string mpiTransport{"device"}; ///< How halo buffers are given to MPI (see Mpi::Init)
   #endif
 
   // Constructor
@@ -62,13 +66,17 @@ class Grid {
   void ShowConfig();
 
   void SliceMe(SubGrid *);       ///< Slice this grid according to the subgrid (internal function)
+  int GetProcOffset(int, int);   ///< First active cell of a proc in a given direction
+  bool Rebalance(double);        ///< Even out the proc extents from their measured compute time
 
   Grid() = default;
 
  private:
-  // Check if number is a power of 2
-  bool isPow2(int);
   void makeDomainDecomposition();
+  void makeProcExtents();
+  bool isValidDecomposition(const std::array<int,3> &);
+
+  std::array<int,3> nexchange;      ///< # of ghost cells exchanged by each proc in each direction
 };
 
 /**
@@ -20,7 +20,7 @@ using Device = Kokkos::DefaultExecutionSpace;
 using Layout = Kokkos::LayoutRight;
 
 /// Type of loops we admit in idefix (see loop.hpp for details)
-enum class LoopPattern { SIMDFOR, RANGE, MDRANGE, TPX, TPTTRTVR, UNDEFINED };
+enum class LoopPattern { SIMDFOR, RANGE, MDRANGE, TPX, TPTTRTVR, TILED, AUTO, UNDEFINED };
 
 #define     YES     255
 #define     NO      0
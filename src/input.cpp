@@ -57,6 +57,11 @@ Input::Input(int argc, char* argv[] ) {
   // Parse command line (may replace the input file)
   ParseCommandLine(argc,argv);
 
+  // Read back the loop patterns selected by a previous run
+  if constexpr(haveLoopTuner) {
+    idfx::loopTuner.Load();
+  }
+
   file.open(this->inputFileName);
 
   if(!file) {
@@ -131,6 +136,12 @@ void Input::ParseCommandLine(int argc, char **argv) {
         // Store this
         inputParameters["CommandLine"]["dec"].push_back(std::string(argv[i]));
       }
+    } else if(std::string(argv[i]) == "-mpitransport") {
+      #ifndef WITH_MPI
+      IDEFIX_ERROR("Option '-mpitransport' only makes sense when MPI is enabled");
+      #endif
+      if((++i) >= argc) IDEFIX_ERROR("You must specify -mpitransport device|pinned|host|auto");
+      inputParameters["CommandLine"]["mpiTransport"].push_back(std::string(argv[i]));
     } else if(std::string(argv[i]) == "-restart") {
       std::string sirestart{};
       bool explicitDump = true;     // by default, assume a restart dump # was given
@@ -176,6 +187,20 @@ void Input::ParseCommandLine(int argc, char **argv) {
       enableLogs = false;
     } else if(std::string(argv[i]) == "-profile") {
       idfx::prof.EnablePerformanceProfiling();
+    } else if(std::string(argv[i]) == "-looptile") {
+      if constexpr(defaultLoop != LoopPattern::TILED) {
+        IDEFIX_ERROR("Option '-looptile' requires Idefix_LOOP_PATTERN=Tiled");
+      }
+      if((i+2) >= argc) IDEFIX_ERROR("You must specify -looptile nk nj");
+      const int nk = std::stoi(std::string(argv[++i]));
+      const int nj = std::stoi(std::string(argv[++i]));
+      idfx::loopTuner.SetTile(nk, nj);
+    } else if(std::string(argv[i]) == "-looptuning") {
+      if constexpr(!haveLoopTuner) {
+        IDEFIX_ERROR("Option '-looptuning' requires Idefix_LOOP_PATTERN=Tiled or Auto");
+      }
+      if((i+1) >= argc) IDEFIX_ERROR("You must specify -looptuning filename");
+      idfx::loopTuner.filename = std::string(argv[++i]);
     } else if(std::string(argv[i]) == "-Werror") {
       idfx::warningsAreErrors = true;
     } else if(std::string(argv[i]) == "-version" || std::string(argv[i]) == "-v") {
@@ -232,7 +257,10 @@ void Input::ShowConfig() {
   idfx::cout << "-----------------------------------------------------------------------------"
              << std::endl;
 
-  #ifdef SINGLE_PRECISION
+  #if defined(MIXED_PRECISION)
+    idfx::cout << "Input: Compiled with MIXED PRECISION arithmetic "
+               << "(single precision storage, double precision accumulations)." << std::endl;
+  #elif defined(SINGLE_PRECISION)
     idfx::cout << "Input: Compiled with SINGLE PRECISION arithmetic." << std::endl;
   #else
     idfx::cout << "Input: Compiled with DOUBLE PRECISION arithmetic." << std::endl;
@@ -243,6 +271,9 @@ void Input::ShowConfig() {
   #ifdef WITH_MPI
     idfx::cout << "Input: MPI ENABLED." << std::endl;
   #endif
+  if constexpr(haveLoopTuner) {
+    idfx::loopTuner.ShowConfig();
+  }
 }
 
 // This routine is called whenever a specific OS signal is caught
@@ -389,6 +420,10 @@ void Input::PrintOptions() {
             << std::endl;
     idfx::cout << "         Force an mpi domain decomposition with n processes in each direction"
                << std::endl;
+    idfx::cout << " -mpitransport device|pinned|host|auto" << std::endl;
+    idfx::cout << "         Give MPI the device halo buffers (default), or stage them in pinned"
+               << " or regular host memory." << std::endl;
+    idfx::cout << "         auto selects the fastest one at startup." << std::endl;
   #endif
   idfx::cout << " -restart n" << std::endl;
   idfx::cout << "         Restart from dumpfile n. If n is ommited, Idefix restart from the latest"
@@ -404,6 +439,16 @@ void Input::PrintOptions() {
   idfx::cout << "         Do not generate any output file." << std::endl;
   idfx::cout << " -nolog" << std::endl;
   idfx::cout << "         Do not write any log file." << std::endl;
+  if constexpr(defaultLoop == LoopPattern::TILED) {
+    idfx::cout << " -looptile nk nj" << std::endl;
+    idfx::cout << "         Use tiles of nk x nj pencils in all of the loops, instead of tuning"
+               << " them for each kernel." << std::endl;
+  }
+  if constexpr(haveLoopTuner) {
+    idfx::cout << " -looptuning xxx" << std::endl;
+    idfx::cout << "         Read and save the loop patterns selected for each kernel in the file"
+               << " xxx instead of idefix.tuning." << std::endl;
+  }
   idfx::cout << " -profile" << std::endl;
   idfx::cout << "         Enable on-the-fly performance profiling." << std::endl;
   idfx::cout << " -Werror" << std::endl;
@@ -12,11 +12,17 @@
 #ifndef LOOP_HPP_
 #define LOOP_HPP_
 
+#include <algorithm>
 #include <string>
 #include "idefix.hpp"
 #include "global.hpp"
 
-#define KOKKOS_VECTOR_LENGTH  8
+// Vector length of the TeamPolicy loops, which can be set at compile time
+#ifndef KOKKOS_VECTOR_LENGTH
+  #define KOKKOS_VECTOR_LENGTH  8
+#endif
+
+#include "loopTuner.hpp"
 
 
 #ifdef INNER_TTR_LOOP
@@ -43,6 +49,10 @@ typedef Kokkos::TeamPolicy<>::member_type  member_type;
   constexpr LoopPattern defaultLoop = LoopPattern::TPX;
 #elif defined(LOOP_PATTERN_TPTTRTVR)
   constexpr LoopPattern defaultLoop = LoopPattern::TPTTRTVR;
+#elif defined(LOOP_PATTERN_TILED)
+  constexpr LoopPattern defaultLoop = LoopPattern::TILED;
+#elif defined(LOOP_PATTERN_AUTO)
+  constexpr LoopPattern defaultLoop = LoopPattern::AUTO;
 #else // no loop strategy has been defined
   // Default loops
   #if defined(KOKKOS_ENABLE_OPENMP)
@@ -59,6 +69,22 @@ typedef Kokkos::TeamPolicy<>::member_type  member_type;
   #endif
 #endif
 
+// Whether the pattern of each kernel is selected at runtime by idfx::loopTuner
+constexpr bool haveLoopTuner = (defaultLoop == LoopPattern::TILED
+                                || defaultLoop == LoopPattern::AUTO);
+
+// Team policy of league teams with the team and vector sizes of config, the team size being
+// bounded by the largest one allowed for the kernel function
+template <typename Function>
+inline team_policy idefix_team_policy(const int league, const idfx::LoopConfig &config,
+                                      const Function &function) {
+  if(config.teamSize > 0) {
+    const int teamMax = team_policy(league, 1, config.vectorLength)
+                          .team_size_max(function, Kokkos::ParallelForTag());
+    return(team_policy(league, std::min(config.teamSize, teamMax), config.vectorLength));
+  }
+  return(team_policy(league, Kokkos::AUTO, config.vectorLength));
+}
 
 
 // 1D loop
@@ -83,17 +109,14 @@ inline void idefix_for(const std::string & NAME,
 }
 
 
-// 2D loop
-template <typename Function>
-inline void idefix_for(const std::string & NAME,
-                       const int & JB, const int & JE,
-                       const int & IB, const int & IE,
-                       Function function) {
-  #ifdef DEBUG
-  idfx::pushRegion("idefix_for("+NAME+")");
-  #endif
+// 2D loop with the pattern P
+template <LoopPattern P, typename Function>
+inline void idefix_for_pattern(const std::string & NAME, const idfx::LoopConfig & config,
+                               const int & JB, const int & JE,
+                               const int & IB, const int & IE,
+                               Function function) {
   // Kokkos 1D Range
-  if constexpr(defaultLoop == LoopPattern::RANGE) {
+  if constexpr(P == LoopPattern::RANGE) {
     const int NJ = JE - JB;
     const int NI = IE - IB;
     const int NJNI = NJ * NI;
@@ -107,25 +130,40 @@ inline void idefix_for(const std::string & NAME,
     });
 
     // MDRange loops
-  } else if constexpr(defaultLoop == LoopPattern::MDRANGE) {
+  } else if constexpr(P == LoopPattern::MDRANGE) {
     Kokkos::parallel_for(NAME,
       Kokkos::MDRangePolicy<Kokkos::Rank<2, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
         ({JB,IB},{JE,IE}), function);
 
     // TeamPolicies with single inner loops
-  } else if constexpr(defaultLoop == LoopPattern::TPX || defaultLoop == LoopPattern::TPTTRTVR ) {
+  } else if constexpr(P == LoopPattern::TPX || P == LoopPattern::TPTTRTVR ) {
     const int NJ = JE - JB;
-    Kokkos::parallel_for(NAME, team_policy (NJ, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
-      KOKKOS_LAMBDA (member_type team_member) {
+    auto kernel = KOKKOS_LAMBDA (member_type team_member) {
         const int j = team_member.league_rank() + JB;
         Kokkos::parallel_for(TPINNERLOOP<>(team_member,IB,IE),
                              [&] (const int i) {
                                function(j,i);
                             });
+    };
+    Kokkos::parallel_for(NAME, idefix_team_policy(NJ, config, kernel), kernel);
+
+    // Cache-blocked loops on tiles of lines along i
+  } else if constexpr(P == LoopPattern::TILED) {
+    const int NJ = JE - JB;
+    const int TJ = config.nj;
+    const int NT = (NJ + TJ - 1) / TJ;
+    Kokkos::parallel_for(NAME, NT,
+      KOKKOS_LAMBDA (const int& T) {
+        const int j0 = T*TJ + JB;
+        const int j1 = (j0 + TJ < JE) ? j0 + TJ : JE;
+        for (int j = j0; j < j1; j++)
+#pragma omp simd
+          for (int i = IB; i < IE; i++)
+            function(j,i);
     });
 
     // SIMD FOR loops
-  } else if constexpr(defaultLoop == LoopPattern::SIMDFOR) {
+  } else if constexpr(P == LoopPattern::SIMDFOR) {
     for (auto j = JB; j < JE; j++)
 #pragma omp simd
       for (auto i = IB; i < IE; i++)
@@ -133,25 +171,18 @@ inline void idefix_for(const std::string & NAME,
   } else {
     throw std::runtime_error("Unknown/undefined LoopPattern used.");
   }
-  #ifdef DEBUG
-  Kokkos::fence();
-  idfx::popRegion();
-  #endif
 }
 
 
-// 3D loop
-template <typename Function>
-inline void idefix_for(const std::string & NAME,
-                       const int & KB, const int & KE,
-                       const int & JB, const int & JE,
-                       const int & IB, const int & IE,
-                       Function function) {
-  #ifdef DEBUG
-  idfx::pushRegion("idefix_for("+NAME+")");
-  #endif
+// 3D loop with the pattern P
+template <LoopPattern P, typename Function>
+inline void idefix_for_pattern(const std::string & NAME, const idfx::LoopConfig & config,
+                               const int & KB, const int & KE,
+                               const int & JB, const int & JE,
+                               const int & IB, const int & IE,
+                               Function function) {
   // Kokkos 1D Range
-  if constexpr(defaultLoop == LoopPattern::RANGE) {
+  if constexpr(P == LoopPattern::RANGE) {
     const int NK = KE - KB;
     const int NJ = JE - JB;
     const int NI = IE - IB;
@@ -169,33 +200,30 @@ inline void idefix_for(const std::string & NAME,
     });
 
   // MDRange loops
-  } else if constexpr(defaultLoop == LoopPattern::MDRANGE) {
+  } else if constexpr(P == LoopPattern::MDRANGE) {
     Kokkos::parallel_for(NAME,
       Kokkos::MDRangePolicy<Kokkos::Rank<3, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
         ({KB,JB,IB},{KE,JE,IE}), function);
 
   // TeamPolicy with single inner loops
-  } else if constexpr(defaultLoop == LoopPattern::TPX) {
+  } else if constexpr(P == LoopPattern::TPX) {
     const int NK = KE - KB;
     const int NJ = JE - JB;
     const int NKNJ = NK * NJ;
-    Kokkos::parallel_for(NAME,
-      team_policy (NKNJ, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
-      KOKKOS_LAMBDA (member_type team_member) {
+    auto kernel = KOKKOS_LAMBDA (member_type team_member) {
         const int k = team_member.league_rank() / NJ + KB;
         const int j = team_member.league_rank() % NJ + JB;
         Kokkos::parallel_for(TPINNERLOOP<>(team_member,IB,IE),
           [&] (const int i) {
             function(k,j,i);
         });
-      });
+      };
+    Kokkos::parallel_for(NAME, idefix_team_policy(NKNJ, config, kernel), kernel);
 
   // TeamPolicy with nested TeamThreadRange and ThreadVectorRange
-  } else if constexpr(defaultLoop == LoopPattern::TPTTRTVR) {
+  } else if constexpr(P == LoopPattern::TPTTRTVR) {
     const int NK = KE - KB;
-    Kokkos::parallel_for(NAME,
-      team_policy (NK, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
-      KOKKOS_LAMBDA (member_type team_member) {
+    auto kernel = KOKKOS_LAMBDA (member_type team_member) {
         const int k = team_member.league_rank() + KB;
         Kokkos::parallel_for(
           Kokkos::TeamThreadRange<>(team_member,JB,JE),
@@ -206,10 +234,33 @@ inline void idefix_for(const std::string & NAME,
                 function(k,j,i);
               });
           });
-      });
+      };
+    Kokkos::parallel_for(NAME, idefix_team_policy(NK, config, kernel), kernel);
+
+  // Cache-blocked loops on tiles of pencils along i, so that the neighbouring planes used by
+  // stencils are still in cache when the next pencils are computed
+  } else if constexpr(P == LoopPattern::TILED) {
+    const int NK = KE - KB;
+    const int NJ = JE - JB;
+    const int TK = config.nk;
+    const int TJ = config.nj;
+    const int NTJ = (NJ + TJ - 1) / TJ;
+    const int NT = ((NK + TK - 1) / TK) * NTJ;
+    Kokkos::parallel_for(NAME, NT,
+      KOKKOS_LAMBDA (const int& T) {
+        const int k0 = (T / NTJ)*TK + KB;
+        const int j0 = (T % NTJ)*TJ + JB;
+        const int k1 = (k0 + TK < KE) ? k0 + TK : KE;
+        const int j1 = (j0 + TJ < JE) ? j0 + TJ : JE;
+        for (int k = k0; k < k1; k++)
+          for (int j = j0; j < j1; j++)
+#pragma omp simd
+            for (int i = IB; i < IE; i++)
+              function(k,j,i);
+    });
 
   // SIMD FOR loops
-  } else if constexpr(defaultLoop == LoopPattern::SIMDFOR) {
+  } else if constexpr(P == LoopPattern::SIMDFOR) {
     for (auto k = KB; k < KE; k++)
       for (auto j = JB; j < JE; j++)
 #pragma omp simd
@@ -218,25 +269,18 @@ inline void idefix_for(const std::string & NAME,
   } else {
     throw std::runtime_error("Unknown/undefined LoopPattern used.");
   }
-  #ifdef DEBUG
-  Kokkos::fence();
-  idfx::popRegion();
-  #endif
 }
 
-// 4D loop
-template <typename Function>
-inline void idefix_for(const std::string & NAME,
-                       const int NB, const int NE,
-                       const int KB, const int KE,
-                       const int JB, const int JE,
-                       const int IB, const int IE,
-                       Function function) {
-  #ifdef DEBUG
-  idfx::pushRegion("idefix_for("+NAME+")");
-  #endif
+// 4D loop with the pattern P
+template <LoopPattern P, typename Function>
+inline void idefix_for_pattern(const std::string & NAME, const idfx::LoopConfig & config,
+                               const int NB, const int NE,
+                               const int KB, const int KE,
+                               const int JB, const int JE,
+                               const int IB, const int IE,
+                               Function function) {
   // Kokkos 1D Range
-  if constexpr(defaultLoop == LoopPattern::RANGE) {
+  if constexpr(P == LoopPattern::RANGE) {
     const int NN = (NE) - (NB);
     const int NK = (KE) - (KB);
     const int NJ = (JE) - (JB);
@@ -258,21 +302,19 @@ inline void idefix_for(const std::string & NAME,
     });
 
   // MDRange loops
-  } else if constexpr(defaultLoop == LoopPattern::MDRANGE) {
+  } else if constexpr(P == LoopPattern::MDRANGE) {
     Kokkos::parallel_for(NAME,
       Kokkos::MDRangePolicy<Kokkos::Rank<4,Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
         ({NB,KB,JB,IB},{NE,KE,JE,IE}), function);
 
   // TeamPolicy loops
-  } else if constexpr(defaultLoop == LoopPattern::TPX) {
+  } else if constexpr(P == LoopPattern::TPX) {
     const int NN = NE - NB;
     const int NK = KE - KB;
     const int NJ = JE - JB;
     const int NKNJ = NK * NJ;
     const int NNNKNJ = NN * NK * NJ;
-    Kokkos::parallel_for(NAME,
-      team_policy (NNNKNJ, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
-      KOKKOS_LAMBDA (member_type team_member) {
+    auto kernel = KOKKOS_LAMBDA (member_type team_member) {
         int n = team_member.league_rank() / NKNJ;
         int k = (team_member.league_rank() - n*NKNJ) / NJ;
         int j = team_member.league_rank() - n*NKNJ - k*NJ + JB;
@@ -283,16 +325,15 @@ inline void idefix_for(const std::string & NAME,
           [&] (const int i) {
             function(n,k,j,i);
           });
-      });
+      };
+    Kokkos::parallel_for(NAME, idefix_team_policy(NNNKNJ, config, kernel), kernel);
 
   // TeamPolicy with nested TeamThreadRange and ThreadVectorRange
-  } else if constexpr(defaultLoop == LoopPattern::TPTTRTVR) {
+  } else if constexpr(P == LoopPattern::TPTTRTVR) {
     const int NN = NE - NB;
     const int NK = KE - KB;
     const int NNNK = NN * NK;
-    Kokkos::parallel_for(NAME,
-      team_policy (NNNK, Kokkos::AUTO,KOKKOS_VECTOR_LENGTH),
-      KOKKOS_LAMBDA (member_type team_member) {
+    auto kernel = KOKKOS_LAMBDA (member_type team_member) {
         int n = team_member.league_rank() / NK + NB;
         int k = team_member.league_rank() % NK + KB;
         Kokkos::parallel_for(
@@ -304,10 +345,34 @@ inline void idefix_for(const std::string & NAME,
                 function(n,k,j,i);
               });
           });
-      });
+      };
+    Kokkos::parallel_for(NAME, idefix_team_policy(NNNK, config, kernel), kernel);
+
+  // Cache-blocked loops on tiles of pencils along i, for each n
+  } else if constexpr(P == LoopPattern::TILED) {
+    const int NN = NE - NB;
+    const int NK = KE - KB;
+    const int NJ = JE - JB;
+    const int TK = config.nk;
+    const int TJ = config.nj;
+    const int NTJ = (NJ + TJ - 1) / TJ;
+    const int NTKNTJ = ((NK + TK - 1) / TK) * NTJ;
+    Kokkos::parallel_for(NAME, NN*NTKNTJ,
+      KOKKOS_LAMBDA (const int& T) {
+        const int n = T / NTKNTJ + NB;
+        const int k0 = ((T % NTKNTJ) / NTJ)*TK + KB;
+        const int j0 = (T % NTJ)*TJ + JB;
+        const int k1 = (k0 + TK < KE) ? k0 + TK : KE;
+        const int j1 = (j0 + TJ < JE) ? j0 + TJ : JE;
+        for (int k = k0; k < k1; k++)
+          for (int j = j0; j < j1; j++)
+#pragma omp simd
+            for (int i = IB; i < IE; i++)
+              function(n,k,j,i);
+    });
 
   // SIMD FOR loops
-  } else if constexpr(defaultLoop == LoopPattern::SIMDFOR) {
+  } else if constexpr(P == LoopPattern::SIMDFOR) {
     for (auto n = NB; n < NE; n++)
       for (auto k = KB; k < KE; k++)
         for (auto j = JB; j < JE; j++)
@@ -317,6 +382,95 @@ inline void idefix_for(const std::string & NAME,
   } else {
     throw std::runtime_error("Unknown/undefined LoopPattern used.");
   }
+}
+
+
+// Launch the kernel NAME on NK*NJ pencils of NI cells with the defaultLoop pattern, or with the
+// pattern selected by idfx::loopTuner for the Tiled and Auto patterns. Only the patterns which
+// can be selected are instantiated.
+template <typename... Args>
+inline void idefix_for_dispatch(const std::string & NAME,
+                                const int NK, const int NJ, const int NI,
+                                Args... args) {
+  if constexpr(defaultLoop == LoopPattern::AUTO) {
+    const idfx::LoopConfig config = idfx::loopTuner.Begin(NAME, NK, NJ, NI, idfx::LoopKind::For);
+    switch(config.pattern) {
+      case LoopPattern::RANGE:
+        idefix_for_pattern<LoopPattern::RANGE>(NAME, config, args...);
+        break;
+      case LoopPattern::MDRANGE:
+        idefix_for_pattern<LoopPattern::MDRANGE>(NAME, config, args...);
+        break;
+      case LoopPattern::TPX:
+        idefix_for_pattern<LoopPattern::TPX>(NAME, config, args...);
+        break;
+      case LoopPattern::TPTTRTVR:
+        idefix_for_pattern<LoopPattern::TPTTRTVR>(NAME, config, args...);
+        break;
+      case LoopPattern::TILED:
+        idefix_for_pattern<LoopPattern::TILED>(NAME, config, args...);
+        break;
+      default:
+        throw std::runtime_error("Unknown/undefined LoopPattern used.");
+    }
+    idfx::loopTuner.End();
+  } else if constexpr(defaultLoop == LoopPattern::TILED) {
+    const idfx::LoopConfig config = idfx::loopTuner.Begin(NAME, NK, NJ, NI, idfx::LoopKind::For);
+    idefix_for_pattern<LoopPattern::TILED>(NAME, config, args...);
+    idfx::loopTuner.End();
+  } else {
+    idefix_for_pattern<defaultLoop>(NAME, idfx::LoopConfig{defaultLoop}, args...);
+  }
+}
+
+
+// 2D loop
+template <typename Function>
+inline void idefix_for(const std::string & NAME,
+                       const int & JB, const int & JE,
+                       const int & IB, const int & IE,
+                       Function function) {
+  #ifdef DEBUG
+  idfx::pushRegion("idefix_for("+NAME+")");
+  #endif
+  idefix_for_dispatch(NAME, 1, JE - JB, IE - IB, JB, JE, IB, IE, function);
+  #ifdef DEBUG
+  Kokkos::fence();
+  idfx::popRegion();
+  #endif
+}
+
+
+// 3D loop
+template <typename Function>
+inline void idefix_for(const std::string & NAME,
+                       const int & KB, const int & KE,
+                       const int & JB, const int & JE,
+                       const int & IB, const int & IE,
+                       Function function) {
+  #ifdef DEBUG
+  idfx::pushRegion("idefix_for("+NAME+")");
+  #endif
+  idefix_for_dispatch(NAME, KE - KB, JE - JB, IE - IB, KB, KE, JB, JE, IB, IE, function);
+  #ifdef DEBUG
+  Kokkos::fence();
+  idfx::popRegion();
+  #endif
+}
+
+// 4D loop
+template <typename Function>
+inline void idefix_for(const std::string & NAME,
+                       const int NB, const int NE,
+                       const int KB, const int KE,
+                       const int JB, const int JE,
+                       const int IB, const int IE,
+                       Function function) {
+  #ifdef DEBUG
+  idfx::pushRegion("idefix_for("+NAME+")");
+  #endif
+  idefix_for_dispatch(NAME, KE - KB, JE - JB, IE - IB, NB, NE, KB, KE, JB, JE, IB, IE,
+                      function);
   #ifdef DEBUG
   Kokkos::fence();
   idfx::popRegion();
@@ -0,0 +1,215 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "idefix.hpp"
+#include "loopTuner.hpp"
+#include "global.hpp"
+
+namespace idfx {
+
+LoopTuner loopTuner;
+
+// Names of the patterns in the file of the selected patterns
+static const std::vector<std::pair<LoopPattern, std::string>> patternNames = {
+  {LoopPattern::SIMDFOR, "SIMD"},
+  {LoopPattern::RANGE, "Range"},
+  {LoopPattern::MDRANGE, "MDRange"},
+  {LoopPattern::TPX, "TeamPolicy"},
+  {LoopPattern::TPTTRTVR, "TeamPolicyInnerVector"},
+  {LoopPattern::TILED, "Tiled"}
+};
+
+std::vector<LoopConfig> LoopTuner::Candidates(int nk, int nj, LoopKind kind) {
+  std::vector<LoopConfig> candidates;
+  auto add = [&](LoopPattern pattern, int teamSize, int vectorLength, int tk, int tj) {
+    LoopConfig config;
+    config.pattern = pattern;
+    config.teamSize = teamSize;
+    config.vectorLength = vectorLength;
+    config.nk = tk;
+    config.nj = tj;
+    candidates.push_back(config);
+  };
+
+  if constexpr(defaultLoop == LoopPattern::AUTO) {
+    if(kind == LoopKind::For) {
+      add(LoopPattern::RANGE, 0, KOKKOS_VECTOR_LENGTH, 1, 1);
+    }
+    add(LoopPattern::MDRANGE, 0, KOKKOS_VECTOR_LENGTH, 1, 1);
+    if(kind == LoopKind::For) {
+      #if defined(KOKKOS_ENABLE_CUDA) || defined(KOKKOS_ENABLE_HIP)
+        // Vector lengths up to a warp, and a few explicit team sizes for the nested loops
+        const int vectorMax = team_policy::vector_length_max();
+        for(int vectorLength : {8, 32}) {
+          if(vectorLength > vectorMax) continue;
+          add(LoopPattern::TPX, 0, vectorLength, 1, 1);
+          for(int teamSize : {0, 4, 16}) {
+            add(LoopPattern::TPTTRTVR, teamSize, vectorLength, 1, 1);
+          }
+        }
+      #else
+        add(LoopPattern::TPX, 0, KOKKOS_VECTOR_LENGTH, 1, 1);
+        add(LoopPattern::TPTTRTVR, 0, KOKKOS_VECTOR_LENGTH, 1, 1);
+      #endif
+    }
+  }
+
+  #if !defined(KOKKOS_ENABLE_CUDA) && !defined(KOKKOS_ENABLE_HIP)
+    // Whole (k,j) planes, then tiles of a few pencils which fit in the L2 cache
+    add(LoopPattern::TILED, 0, KOKKOS_VECTOR_LENGTH, 1, nj);
+    for(int tk : {1, 4}) {
+      for(int tj : {4, 8, 16, 32}) {
+        if(tk <= nk && tj < nj) add(LoopPattern::TILED, 0, KOKKOS_VECTOR_LENGTH, tk, tj);
+      }
+    }
+  #endif
+  return(candidates);
+}
+
+LoopConfig LoopTuner::Begin(const std::string &name, int nk, int nj, int ni, LoopKind kind) {
+  nk = std::max(nk, 1);
+  nj = std::max(nj, 1);
+  if(haveFixedTile) {
+    LoopConfig config = fixedTile;
+    config.nk = std::min(fixedTile.nk, nk);
+    config.nj = std::min(fixedTile.nj, nj);
+    return(config);
+  }
+
+  const std::string key = name + "(" + std::to_string(nk) + "," + std::to_string(nj)
+                          + "," + std::to_string(ni) + ")"
+                          + ((kind == LoopKind::Reduce) ? "/reduce" : "");
+  Kernel &kernel = kernels[key];
+  if(kernel.candidates.empty()) {
+    kernel.candidates = Candidates(nk, nj, kind);
+    // Reuse the pattern of a previous run when it is still one of the candidates
+    auto it = saved.find(key);
+    if(it != saved.end() && std::find(kernel.candidates.begin(), kernel.candidates.end(),
+                                      it->second) != kernel.candidates.end()) {
+      kernel.candidates.assign(1, it->second);
+    }
+    kernel.time.assign(kernel.candidates.size(), -1.0);
+    if(kernel.candidates.size() == 1) kernel.best = 0;
+  }
+  if(kernel.best >= 0) return(kernel.candidates[kernel.best]);
+
+  // Time this invocation with the next candidate
+  current = &kernel;
+  currentCandidate = kernel.trial % static_cast<int>(kernel.candidates.size());
+  Kokkos::fence();
+  timer.reset();
+  return(kernel.candidates[currentCandidate]);
+}
+
+void LoopTuner::End() {
+  if(current == nullptr) return;
+  Kokkos::fence();
+  const double t = timer.seconds();
+  Kernel &kernel = *current;
+  current = nullptr;
+
+  double &best = kernel.time[currentCandidate];
+  if(best < 0 || t < best) best = t;
+
+  kernel.trial++;
+  if(kernel.trial == trialsPerCandidate*static_cast<int>(kernel.candidates.size())) {
+    kernel.best = std::min_element(kernel.time.begin(), kernel.time.end()) - kernel.time.begin();
+  }
+}
+
+void LoopTuner::SetTile(int nk, int nj) {
+  if(nk < 1 || nj < 1) {
+    IDEFIX_ERROR("The tiles of the Tiled loop pattern should contain at least one pencil");
+  }
+  haveFixedTile = true;
+  fixedTile.pattern = LoopPattern::TILED;
+  fixedTile.nk = nk;
+  fixedTile.nj = nj;
+}
+
+// Each line of the file holds the pattern, team size, vector length and tile of a kernel,
+// followed by the name and loop extents of the kernel
+void LoopTuner::Load() {
+  if(haveFixedTile) return;
+  std::ifstream file(filename);
+  if(!file.is_open()) return;
+  std::string line;
+  while(std::getline(file, line)) {
+    if(line.empty() || line[0] == '#') continue;
+    std::istringstream fields(line);
+    std::string patternName;
+    LoopConfig config;
+    fields >> patternName >> config.teamSize >> config.vectorLength >> config.nk >> config.nj;
+    std::string key;
+    std::getline(fields >> std::ws, key);
+    if(fields.fail() || key.empty()) {
+      IDEFIX_WARNING("Ignoring the malformed line '" + line + "' of " + filename);
+      continue;
+    }
+    for(const auto &p : patternNames) {
+      if(p.second == patternName) config.pattern = p.first;
+    }
+    if(config.pattern == LoopPattern::UNDEFINED) {
+      IDEFIX_WARNING("Ignoring the unknown loop pattern " + patternName + " in " + filename);
+      continue;
+    }
+    saved[key] = config;
+  }
+  idfx::cout << "LoopTuner: read back the loop patterns of " << saved.size()
+             << " kernels from " << filename << "." << std::endl;
+}
+
+void LoopTuner::Save() {
+  if(haveFixedTile || idfx::prank != 0) return;
+  // Keep the patterns of the kernels which have not been invoked by this run
+  std::unordered_map<std::string, LoopConfig> table = saved;
+  for(const auto &kernel : kernels) {
+    const Kernel &k = kernel.second;
+    if(k.best >= 0) table[kernel.first] = k.candidates[k.best];
+  }
+  std::vector<std::string> keys;
+  for(const auto &entry : table) keys.push_back(entry.first);
+  std::sort(keys.begin(), keys.end());
+
+  std::ofstream file(filename);
+  if(!file.is_open()) {
+    IDEFIX_WARNING("Cannot write the loop patterns to " + filename);
+    return;
+  }
+  file << "# pattern teamSize vectorLength tileK tileJ kernel(nk,nj,ni)" << std::endl;
+  for(const auto &key : keys) {
+    const LoopConfig &config = table[key];
+    for(const auto &p : patternNames) {
+      if(p.first == config.pattern) file << p.second;
+    }
+    file << " " << config.teamSize << " " << config.vectorLength << " " << config.nk
+         << " " << config.nj << " " << key << std::endl;
+  }
+  idfx::cout << "LoopTuner: loop patterns of " << keys.size() << " kernels saved in "
+             << filename << "." << std::endl;
+}
+
+void LoopTuner::ShowConfig() {
+  if(haveFixedTile) {
+    idfx::cout << "Input: Tiled loop pattern with tiles of " << fixedTile.nk << "x"
+               << fixedTile.nj << " pencils." << std::endl;
+  } else if constexpr(defaultLoop == LoopPattern::AUTO) {
+    idfx::cout << "Input: loop patterns tuned for each kernel, saved in " << filename << "."
+               << std::endl;
+  } else {
+    idfx::cout << "Input: Tiled loop pattern with tiles tuned for each kernel, saved in "
+               << filename << "." << std::endl;
+  }
+}
+
+} // namespace idfx
@@ -0,0 +1,89 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef LOOPTUNER_HPP_
+#define LOOPTUNER_HPP_
+
+// This file is included by loop.hpp, after the declaration of LoopPattern in idefix.hpp
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <Kokkos_Core.hpp>
+
+namespace idfx {
+
+// Loop pattern used by a kernel, with its parameters
+struct LoopConfig {
+  LoopPattern pattern{LoopPattern::UNDEFINED};
+  int teamSize{0};                          // threads per team of the TeamPolicy patterns
+                                            // (0 for Kokkos::AUTO)
+  int vectorLength{KOKKOS_VECTOR_LENGTH};   // vector length of the TeamPolicy patterns
+  int nk{1};                                // tile of the Tiled pattern: each tile is made of
+  int nj{1};                                // nk*nj pencils of cells along i, traversed by a
+                                            // single thread
+};
+
+inline bool operator==(const LoopConfig &a, const LoopConfig &b) {
+  return(a.pattern == b.pattern && a.teamSize == b.teamSize && a.vectorLength == b.vectorLength
+         && a.nk == b.nk && a.nj == b.nj);
+}
+
+enum class LoopKind { For, Reduce };
+
+// Selection of the loop pattern of each kernel, identified by its name and loop extents, for the
+// Tiled and Auto loop patterns. The first invocations of a kernel each time one of a set of
+// candidate patterns (tiles of the Tiled pattern, and Range, MDRange and TeamPolicies of several
+// team and vector sizes for the Auto pattern), the fastest candidate being used for all of the
+// following invocations. The selected patterns can be saved in a file, and reused by the
+// following runs instead of being tuned again.
+class LoopTuner {
+ public:
+  // Pattern to be used by the next invocation of the kernel name on nk*nj pencils of ni cells.
+  // Each call should be followed by a call to End() once the kernel has been launched.
+  LoopConfig Begin(const std::string &name, int nk, int nj, int ni, LoopKind kind);
+  void End();
+
+  // Use the same tile for all of the kernels, without tuning
+  void SetTile(int nk, int nj);
+
+  // Read back the patterns saved by a previous run in filename, and write the patterns selected
+  // by this run in the same file (on the root process only)
+  void Load();
+  void Save();
+
+  void ShowConfig();
+
+  std::string filename{"idefix.tuning"};  // file of the selected patterns
+
+ private:
+  struct Kernel {
+    std::vector<LoopConfig> candidates;
+    std::vector<double> time;         // fastest time measured for each candidate
+    int trial{0};                     // number of invocations timed so far
+    int best{-1};                     // selected candidate, once tuned
+  };
+
+  std::vector<LoopConfig> Candidates(int nk, int nj, LoopKind kind);
+
+  static constexpr int trialsPerCandidate = 2;
+
+  std::unordered_map<std::string, Kernel> kernels;
+  std::unordered_map<std::string, LoopConfig> saved;  // patterns read from filename
+  Kernel *current{nullptr};           // kernel being timed
+  int currentCandidate{0};
+  Kokkos::Timer timer;
+
+  bool haveFixedTile{false};
+  LoopConfig fixedTile;
+};
+
+extern LoopTuner loopTuner;       //< patterns of the Tiled and Auto loop patterns
+
+} // namespace idfx
+
+#endif // LOOPTUNER_HPP_
@@ -24,6 +24,8 @@
 #include <cstdlib>
 #include <cstring>
 #include <string>
+#include <memory>
+#include <utility>
 
 #include <Kokkos_Core.hpp>
 
@@ -89,10 +91,11 @@ int main( int argc, char* argv[] ) {
     gridHost.SyncToDevice();
 
     // instantiate required objects.
-    DataBlock data(grid, input);
-    TimeIntegrator Tint(input,data);
-    Output output(input, data);
-    Setup mysetup(input, grid, data, output);
+    // These are rebuilt when the domain decomposition is rebalanced
+    auto data = std::make_unique<DataBlock>(grid, input);
+    TimeIntegrator Tint(input,*data);
+    auto output = std::make_unique<Output>(input, *data);
+    auto mysetup = std::make_unique<Setup>(input, grid, *data, *output);
     idfx::cout << "Main: initialisation finished." << std::endl;
 
     char host[1024];
@@ -109,7 +112,7 @@ int main( int argc, char* argv[] ) {
     }
     input.ShowConfig();
     grid.ShowConfig();
-    data.ShowConfig();
+    data->ShowConfig();
     Tint.ShowConfig();
 
     ///////////////////////////////
@@ -119,28 +122,28 @@ int main( int argc, char* argv[] ) {
     if(input.restartRequested) {
       if(input.forceInitRequested) {
         idfx::pushRegion("Setup::Initflow");
-        mysetup.InitFlow(data);
-        data.DeriveVectorPotential();
+        mysetup->InitFlow(*data);
+        data->DeriveVectorPotential();
         idfx::popRegion();
       }
       idfx::cout << "Main: Restarting from dump file."  << std::endl;
-      bool restartSuccess = output.RestartFromDump(data,input.restartFileNumber);
+      bool restartSuccess = output->RestartFromDump(*data,input.restartFileNumber);
       if(!restartSuccess) {
         idfx::cout << "Main: restart aborted." << std::endl;
         input.restartRequested = false;
       } else {
-        data.SetBoundaries();
+        data->SetBoundaries();
       }
     }
     if(!input.restartRequested) {
       idfx::cout << "Main: Creating initial conditions." << std::endl;
       idfx::pushRegion("Setup::Initflow");
-      mysetup.InitFlow(data);
+      mysetup->InitFlow(*data);
       idfx::popRegion();
-      data.DeriveVectorPotential();   // This does something only when evolveVectorPotential is on
-      data.SetBoundaries();
-      data.Validate();
-      output.CheckForWrites(data);
+      data->DeriveVectorPotential();   // This does something only when evolveVectorPotential is on
+      data->SetBoundaries();
+      data->Validate();
+      output->CheckForWrites(*data);
     }
 
     ///////////////////////////////
@@ -149,14 +152,14 @@ int main( int argc, char* argv[] ) {
     idfx::cout << "Main: Cycling Time Integrator..." << std::endl;
 
     Kokkos::Timer timer;
-    output.ResetTimer();
+    output->ResetTimer();
 
     real tstop = input.Get<real>("TimeIntegrator","tstop",0);
 
-    while(data.t < tstop) {
-      if(tstop-data.t < data.dt) data.dt = tstop-data.t;
+    while(data->t < tstop) {
+      if(tstop-data->t < data->dt) data->dt = tstop-data->t;
       try {
-        Tint.Cycle(data);
+        Tint.Cycle(*data);
       } catch(std::exception &e) {
         idfx::cout << "Main: WARNING! Caught an exception in TimeIntegrator." << std::endl;
         #ifdef WITH_MPI
@@ -170,15 +173,33 @@ int main( int argc, char* argv[] ) {
         #endif
         idfx::cout << e.what() << std::endl;
         idfx::cout << "Main: attempting to save the current state for inspection." << std::endl;
-        output.ForceWriteVtk(data);
+        output->ForceWriteVtk(*data);
         idfx::cout << "Main: Aborting current calculation." << std::endl;
         returnCode = 1;
         break;
       }
-      output.CheckForWrites(data);
+      output->CheckForWrites(*data);
+      if(Tint.RebalanceRequested() && grid.Rebalance(Tint.GetRebalanceTime())) {
+        // Rebuild the datablock, the outputs and the setup on the new domain decomposition, as
+        // for a restart, and move the current state to them.
+        idfx::cout << "Main: Rebalancing the domain decomposition." << std::endl;
+        // The new outputs continue the files of the current run
+        input.restartRequested = true;
+        auto newData = std::make_unique<DataBlock>(grid, input);
+        auto newOutput = std::make_unique<Output>(input, *newData);
+        auto newSetup = std::make_unique<Setup>(input, grid, *newData, *newOutput);
+        newData->dump->Redistribute(*data->dump);
+        mysetup = std::move(newSetup);
+        output = std::move(newOutput);
+        data = std::move(newData);
+        Tint.AttachDataBlock(*data);
+        data->SetBoundaries();
+        idfx::cout << "Main: predicted MPI imbalance after rebalancing: "
+                   << grid.predictedImbalance << "%" << std::endl;
+      }
       if(input.CheckForAbort() || Tint.CheckForMaxRuntime() ) {
         idfx::cout << "Main: Saving current state and aborting calculation." << std::endl;
-        output.ForceWriteDump(data);
+        output->ForceWriteDump(*data);
         returnCode = -1;
         break;
       }
@@ -203,7 +224,7 @@ int main( int argc, char* argv[] ) {
     double perfs = timer.seconds() / grid.np_int[IDIR] / grid.np_int[JDIR]
                             / grid.np_int[KDIR] / Tint.GetNCycles() * idfx::psize;
 
-    idfx::cout << "Main: Reached t=" << data.t << std::endl;
+    idfx::cout << "Main: Reached t=" << data->t << std::endl;
     idfx::cout << "Main: Completed in ";
     if (n_days > 0) {
       idfx::cout << n_days << " day";
@@ -245,10 +266,14 @@ int main( int argc, char* argv[] ) {
     #endif
 
     idfx::cout << "Outputs represent "
-               << static_cast<int>(100.0*output.GetTimer()/timer.seconds())
+               << static_cast<int>(100.0*output->GetTimer()/timer.seconds())
               << "% of total run time." << std::endl;
     // Show profiler output
     idfx::prof.Show();
+    // Save the loop patterns selected for each kernel, for the following runs
+    if constexpr(haveLoopTuner) {
+      idfx::loopTuner.Save();
+    }
   }
 
   if(returnCode<0) {
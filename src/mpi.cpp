@@ -28,11 +28,6 @@
 // init the number of instances
 int Mpi::nInstances = 0;
 
-// MPI Routines exchange
-void Mpi::ExchangeAll() {
-  IDEFIX_ERROR("Not Implemented");
-}
-
 ///
 /// Initialise an instance of the MPI class.
 /// @param grid: pointer to the grid object (needed to get the MPI neighbours)
@@ -90,11 +85,6 @@ void Mpi::Init(Grid *grid, std::vector<int> inputMap,
   }
 
 
-  BufferRecvX1[faceLeft ] = Buffer(bufferSizeX1);
-  BufferRecvX1[faceRight] = Buffer(bufferSizeX1);
-  BufferSendX1[faceLeft ] = Buffer(bufferSizeX1);
-  BufferSendX1[faceRight] = Buffer(bufferSizeX1);
-
   // Number of cells in X2 boundary condition (only required when problem >2D):
 #if DIMENSIONS >= 2
   bufferSizeX2 = ntot[IDIR] * nghost[JDIR] * nint[KDIR] * mapNVars;
@@ -109,11 +99,6 @@ void Mpi::Init(Grid *grid, std::vector<int> inputMap,
     #endif  // DIMENSIONS
   }
 
-  BufferRecvX2[faceLeft ] = Buffer(bufferSizeX2);
-  BufferRecvX2[faceRight] = Buffer(bufferSizeX2);
-  BufferSendX2[faceLeft ] = Buffer(bufferSizeX2);
-  BufferSendX2[faceRight] = Buffer(bufferSizeX2);
-
 #endif
 // Number of cells in X3 boundary condition (only required when problem is 3D):
 #if DIMENSIONS ==3
@@ -128,12 +113,40 @@ void Mpi::Init(Grid *grid, std::vector<int> inputMap,
     bufferSizeX3 += ntot[IDIR] * ntot[JDIR] * nghost[KDIR];
   }
 
-  BufferRecvX3[faceLeft ] = Buffer(bufferSizeX3);
-  BufferRecvX3[faceRight] = Buffer(bufferSizeX3);
-  BufferSendX3[faceLeft ] = Buffer(bufferSizeX3);
-  BufferSendX3[faceRight] = Buffer(bufferSizeX3);
 #endif // DIMENSIONS
 
+  // Choose how the buffers are handed to MPI
+  if(mygrid->mpiTransport == "device") {
+    transport = Buffer::Transport::device;
+  } else if(mygrid->mpiTransport == "pinned") {
+    transport = Buffer::Transport::pinned;
+  } else if(mygrid->mpiTransport == "host") {
+    transport = Buffer::Transport::host;
+  } else if(mygrid->mpiTransport == "auto") {
+    transport = SelectTransport();
+  } else {
+    IDEFIX_ERROR("Unknown MPI transport "+mygrid->mpiTransport);
+  }
+
+  BufferRecvX1[faceLeft ] = Buffer(bufferSizeX1, transport);
+  BufferRecvX1[faceRight] = Buffer(bufferSizeX1, transport);
+  BufferSendX1[faceLeft ] = Buffer(bufferSizeX1, transport);
+  BufferSendX1[faceRight] = Buffer(bufferSizeX1, transport);
+
+#if DIMENSIONS >= 2
+  BufferRecvX2[faceLeft ] = Buffer(bufferSizeX2, transport);
+  BufferRecvX2[faceRight] = Buffer(bufferSizeX2, transport);
+  BufferSendX2[faceLeft ] = Buffer(bufferSizeX2, transport);
+  BufferSendX2[faceRight] = Buffer(bufferSizeX2, transport);
+#endif
+
+#if DIMENSIONS == 3
+  BufferRecvX3[faceLeft ] = Buffer(bufferSizeX3, transport);
+  BufferRecvX3[faceRight] = Buffer(bufferSizeX3, transport);
+  BufferSendX3[faceLeft ] = Buffer(bufferSizeX3, transport);
+  BufferSendX3[faceRight] = Buffer(bufferSizeX3, transport);
+#endif
+
 #ifdef MPI_PERSISTENT
   // Init persistent MPI communications
   int procSend, procRecv;
@@ -231,6 +244,10 @@ Mpi::~Mpi() {
       #endif
       }
     #endif
+    for(int n = 0 ; n < sendRequestAll.size() ; n++) {
+      MPI_Request_free( &sendRequestAll[n]);
+      MPI_Request_free( &recvRequestAll[n]);
+    }
     if(thisInstance==1) {
       idfx::cout << "Mpi(" << thisInstance << "): measured throughput is "
                 << bytesSentOrReceived/myTimer/1024.0/1024.0 << " MB/s" << std::endl;
@@ -238,14 +255,27 @@ Mpi::~Mpi() {
       idfx::cout << "        X1: " << bufferSizeX1*sizeof(real)/1024.0/1024.0 << " MB" << std::endl;
       idfx::cout << "        X2: " << bufferSizeX2*sizeof(real)/1024.0/1024.0 << " MB" << std::endl;
       idfx::cout << "        X3: " << bufferSizeX3*sizeof(real)/1024.0/1024.0 << " MB" << std::endl;
+      if(haveExchangeAll) {
+        idfx::cout << "        All: " << bufferSizeAll*sizeof(real)/1024.0/1024.0 << " MB"
+                   << std::endl;
+      }
     }
     isInitialized = false;
   }
   idfx::popRegion();
 }
 
-void Mpi::ExchangeX1(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
+template <typename T>
+void Mpi::ExchangeX1(IdefixArray4D<T> Vc, IdefixArray4D<accum> Vs) {
   idfx::pushRegion("Mpi::ExchangeX1");
+  ExchangeX1Begin(Vc, Vs);
+  ExchangeX1End(Vc, Vs);
+  idfx::popRegion();
+}
+
+template <typename T>
+void Mpi::ExchangeX1Begin(IdefixArray4D<T> Vc, IdefixArray4D<accum> Vs) {
+  idfx::pushRegion("Mpi::ExchangeX1Begin");
 
   // Load  the buffers with data
   int ibeg,iend,jbeg,jend,kbeg,kend,offset,nx;
@@ -257,9 +287,6 @@ void Mpi::ExchangeX1(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   myTimer -= MPI_Wtime();
   double tStart = MPI_Wtime();
 #ifdef MPI_PERSISTENT
-  MPI_Status sendStatus[2];
-  MPI_Status recvStatus[2];
-
   MPI_SAFE_CALL(MPI_Startall(2, recvRequestX1));
   idfx::mpiCallsTimer += MPI_Wtime() - tStart;
 #endif
@@ -323,45 +350,40 @@ void Mpi::ExchangeX1(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
     #endif
   }
 
+  // Stage the buffers on the host when needed
+  BufferLeft.ToHost();
+  BufferRight.ToHost();
+
   // Wait for completion before sending out everything
   Kokkos::fence();
   myTimer -= MPI_Wtime();
   tStart = MPI_Wtime();
 #ifdef MPI_PERSISTENT
   MPI_SAFE_CALL(MPI_Startall(2, sendRequestX1));
-  // Wait for buffers to be received
-  MPI_Waitall(2,recvRequestX1,recvStatus);
 
 #else
   int procSend, procRecv;
 
   #ifdef MPI_NON_BLOCKING
-  MPI_Status sendStatus[2];
-  MPI_Status recvStatus[2];
-  MPI_Request sendRequest[2];
-  MPI_Request recvRequest[2];
-
+  // The requests are completed by ExchangeX1End
   // We receive from procRecv, and we send to procSend
   MPI_SAFE_CALL(MPI_Cart_shift(mygrid->CartComm,0,1,&procRecv,&procSend ));
 
-  MPI_SAFE_CALL(MPI_Isend(BufferSendX1[faceRight].data(), bufferSizeX1, realMPI, procSend, 100,
-                mygrid->CartComm, &sendRequest[0]));
+  MPI_SAFE_CALL(MPI_Isend(BufferSendX1[faceRight].data(), bufferSizeX1, realMPI, procSend,
+                thisInstance*1000, mygrid->CartComm, &sendRequestX1[0]));
 
-  MPI_SAFE_CALL(MPI_Irecv(BufferRecvX1[faceLeft].data(), bufferSizeX1, realMPI, procRecv, 100,
-                mygrid->CartComm, &recvRequest[0]));
+  MPI_SAFE_CALL(MPI_Irecv(BufferRecvX1[faceLeft].data(), bufferSizeX1, realMPI, procRecv,
+                thisInstance*1000, mygrid->CartComm, &recvRequestX1[0]));
 
   // Send to the left
   // We receive from procRecv, and we send to procSend
   MPI_SAFE_CALL(MPI_Cart_shift(mygrid->CartComm,0,-1,&procRecv,&procSend ));
 
-  MPI_SAFE_CALL(MPI_Isend(BufferSendX1[faceLeft].data(), bufferSizeX1, realMPI, procSend, 101,
-                mygrid->CartComm, &sendRequest[1]));
+  MPI_SAFE_CALL(MPI_Isend(BufferSendX1[faceLeft].data(), bufferSizeX1, realMPI, procSend,
+                thisInstance*1000+1, mygrid->CartComm, &sendRequestX1[1]));
 
-  MPI_SAFE_CALL(MPI_Irecv(BufferRecvX1[faceRight].data(), bufferSizeX1, realMPI, procRecv, 101,
-                mygrid->CartComm, &recvRequest[1]));
-
-  // Wait for recv to complete (we don't care about the sends)
-  MPI_Waitall(2, recvRequest, recvStatus);
+  MPI_SAFE_CALL(MPI_Irecv(BufferRecvX1[faceRight].data(), bufferSizeX1, realMPI, procRecv,
+                thisInstance*1000+1, mygrid->CartComm, &recvRequestX1[1]));
 
   #else
   MPI_Status status;
@@ -384,10 +406,43 @@ void Mpi::ExchangeX1(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
 #endif
   myTimer += MPI_Wtime();
   idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+
+  idfx::popRegion();
+}
+
+template <typename T>
+void Mpi::ExchangeX1End(IdefixArray4D<T> Vc, IdefixArray4D<accum> Vs) {
+  idfx::pushRegion("Mpi::ExchangeX1End");
+
+  int ibeg,iend,jbeg,jend,kbeg,kend,offset;
+  IdefixArray1D<int> map = this->mapVars;
+
+  // Coordinates of the ghost region which needs to be transfered
+  ibeg   = 0;
+  iend   = nghost[IDIR];
+  offset = end[IDIR];     // Distance between beginning of left and right ghosts
+  jbeg   = beg[JDIR];
+  jend   = end[JDIR];
+
+  kbeg   = beg[KDIR];
+  kend   = end[KDIR];
+
+  myTimer -= MPI_Wtime();
+  double tStart = MPI_Wtime();
+#if defined(MPI_PERSISTENT) || defined(MPI_NON_BLOCKING)
+  MPI_Status recvStatus[2];
+  // Wait for buffers to be received
+  MPI_Waitall(2,recvRequestX1,recvStatus);
+#endif
+  myTimer += MPI_Wtime();
+  idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+
   // Unpack
-  BufferLeft=BufferRecvX1[faceLeft];
-  BufferRight=BufferRecvX1[faceRight];
+  Buffer BufferLeft=BufferRecvX1[faceLeft];
+  Buffer BufferRight=BufferRecvX1[faceRight];
 
+  BufferLeft.FromHost();
+  BufferRight.FromHost();
   BufferLeft.ResetPointer();
   BufferRight.ResetPointer();
 
@@ -431,12 +486,8 @@ void Mpi::ExchangeX1(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   }
 
 myTimer -= MPI_Wtime();
-#ifdef MPI_NON_BLOCKING
-  // Wait for the sends if they have not yet completed
-  MPI_Waitall(2, sendRequest, sendStatus);
-#endif
-
-#ifdef MPI_PERSISTENT
+#if defined(MPI_PERSISTENT) || defined(MPI_NON_BLOCKING)
+  MPI_Status sendStatus[2];
   MPI_Waitall(2, sendRequestX1, sendStatus);
 #endif
   myTimer += MPI_Wtime();
@@ -446,8 +497,17 @@ myTimer -= MPI_Wtime();
 }
 
 
-void Mpi::ExchangeX2(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
+template <typename T>
+void Mpi::ExchangeX2(IdefixArray4D<T> Vc, IdefixArray4D<accum> Vs) {
   idfx::pushRegion("Mpi::ExchangeX2");
+  ExchangeX2Begin(Vc, Vs);
+  ExchangeX2End(Vc, Vs);
+  idfx::popRegion();
+}
+
+template <typename T>
+void Mpi::ExchangeX2Begin(IdefixArray4D<T> Vc, IdefixArray4D<accum> Vs) {
+  idfx::pushRegion("Mpi::ExchangeX2Begin");
 
   // Load  the buffers with data
   int ibeg,iend,jbeg,jend,kbeg,kend,offset,ny;
@@ -459,9 +519,6 @@ void Mpi::ExchangeX2(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   myTimer -= MPI_Wtime();
   double tStart = MPI_Wtime();
 #ifdef MPI_PERSISTENT
-  MPI_Status sendStatus[2];
-  MPI_Status recvStatus[2];
-
   MPI_SAFE_CALL(MPI_Startall(2, recvRequestX2));
   idfx::mpiCallsTimer += MPI_Wtime() - tStart;
 #endif
@@ -521,6 +578,10 @@ void Mpi::ExchangeX2(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
     #endif
   }
 
+  // Stage the buffers on the host when needed
+  BufferLeft.ToHost();
+  BufferRight.ToHost();
+
   // Send to the right
   Kokkos::fence();
 
@@ -528,38 +589,30 @@ void Mpi::ExchangeX2(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   tStart = MPI_Wtime();
 #ifdef MPI_PERSISTENT
   MPI_SAFE_CALL(MPI_Startall(2, sendRequestX2));
-  MPI_Waitall(2,recvRequestX2,recvStatus);
 
 #else
   int procSend, procRecv;
 
   #ifdef MPI_NON_BLOCKING
-  MPI_Status sendStatus[2];
-  MPI_Status recvStatus[2];
-  MPI_Request sendRequest[2];
-  MPI_Request recvRequest[2];
-
+  // The requests are completed by ExchangeX2End
   // We receive from procRecv, and we send to procSend
   MPI_SAFE_CALL(MPI_Cart_shift(mygrid->CartComm,1,1,&procRecv,&procSend ));
 
-  MPI_SAFE_CALL(MPI_Isend(BufferSendX2[faceRight].data(), bufferSizeX2, realMPI, procSend, 100,
-                mygrid->CartComm, &sendRequest[0]));
+  MPI_SAFE_CALL(MPI_Isend(BufferSendX2[faceRight].data(), bufferSizeX2, realMPI, procSend,
+                thisInstance*1000+10, mygrid->CartComm, &sendRequestX2[0]));
 
-  MPI_SAFE_CALL(MPI_Irecv(BufferRecvX2[faceLeft].data(), bufferSizeX2, realMPI, procRecv, 100,
-                mygrid->CartComm, &recvRequest[0]));
+  MPI_SAFE_CALL(MPI_Irecv(BufferRecvX2[faceLeft].data(), bufferSizeX2, realMPI, procRecv,
+                thisInstance*1000+10, mygrid->CartComm, &recvRequestX2[0]));
 
   // Send to the left
   // We receive from procRecv, and we send to procSend
   MPI_SAFE_CALL(MPI_Cart_shift(mygrid->CartComm,1,-1,&procRecv,&procSend ));
 
-  MPI_SAFE_CALL(MPI_Isend(BufferSendX2[faceLeft].data(), bufferSizeX2, realMPI, procSend, 101,
-                mygrid->CartComm, &sendRequest[1]));
-
-  MPI_SAFE_CALL(MPI_Irecv(BufferRecvX2[faceRight].data(), bufferSizeX2, realMPI, procRecv, 101,
-                mygrid->CartComm, &recvRequest[1]));
+  MPI_SAFE_CALL(MPI_Isend(BufferSendX2[faceLeft].data(), bufferSizeX2, realMPI, procSend,
+                thisInstance*1000+11, mygrid->CartComm, &sendRequestX2[1]));
 
-  // Wait for recv to complete (we don't care about the sends)
-  MPI_Waitall(2, recvRequest, recvStatus);
+  MPI_SAFE_CALL(MPI_Irecv(BufferRecvX2[faceRight].data(), bufferSizeX2, realMPI, procRecv,
+                thisInstance*1000+11, mygrid->CartComm, &recvRequestX2[1]));
 
   #else
   MPI_Status status;
@@ -582,10 +635,44 @@ void Mpi::ExchangeX2(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
 #endif
   myTimer += MPI_Wtime();
   idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+
+  idfx::popRegion();
+}
+
+template <typename T>
+void Mpi::ExchangeX2End(IdefixArray4D<T> Vc, IdefixArray4D<accum> Vs) {
+  idfx::pushRegion("Mpi::ExchangeX2End");
+
+  int ibeg,iend,jbeg,jend,kbeg,kend,offset;
+  IdefixArray1D<int> map = this->mapVars;
+
+  // Coordinates of the ghost region which needs to be transfered
+  ibeg   = 0;
+  iend   = ntot[IDIR];
+
+  jbeg   = 0;
+  jend   = nghost[JDIR];
+  offset = end[JDIR];     // Distance between beginning of left and right ghosts
+
+  kbeg   = beg[KDIR];
+  kend   = end[KDIR];
+
+  myTimer -= MPI_Wtime();
+  double tStart = MPI_Wtime();
+#if defined(MPI_PERSISTENT) || defined(MPI_NON_BLOCKING)
+  MPI_Status recvStatus[2];
+  // Wait for buffers to be received
+  MPI_Waitall(2,recvRequestX2,recvStatus);
+#endif
+  myTimer += MPI_Wtime();
+  idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+
   // Unpack
-  BufferLeft=BufferRecvX2[faceLeft];
-  BufferRight=BufferRecvX2[faceRight];
+  Buffer BufferLeft=BufferRecvX2[faceLeft];
+  Buffer BufferRight=BufferRecvX2[faceRight];
 
+  BufferLeft.FromHost();
+  BufferRight.FromHost();
   BufferLeft.ResetPointer();
   BufferRight.ResetPointer();
 
@@ -628,12 +715,8 @@ void Mpi::ExchangeX2(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   }
 
   myTimer -= MPI_Wtime();
-#ifdef MPI_NON_BLOCKING
-  // Wait for the sends if they have not yet completed
-  MPI_Waitall(2, sendRequest, sendStatus);
-#endif
-
-#ifdef MPI_PERSISTENT
+#if defined(MPI_PERSISTENT) || defined(MPI_NON_BLOCKING)
+  MPI_Status sendStatus[2];
   MPI_Waitall(2, sendRequestX2, sendStatus);
 #endif
   myTimer += MPI_Wtime();
@@ -643,8 +726,17 @@ void Mpi::ExchangeX2(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
 }
 
 
-void Mpi::ExchangeX3(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
+template <typename T>
+void Mpi::ExchangeX3(IdefixArray4D<T> Vc, IdefixArray4D<accum> Vs) {
   idfx::pushRegion("Mpi::ExchangeX3");
+  ExchangeX3Begin(Vc, Vs);
+  ExchangeX3End(Vc, Vs);
+  idfx::popRegion();
+}
+
+template <typename T>
+void Mpi::ExchangeX3Begin(IdefixArray4D<T> Vc, IdefixArray4D<accum> Vs) {
+  idfx::pushRegion("Mpi::ExchangeX3Begin");
 
 
   // Load  the buffers with data
@@ -658,9 +750,6 @@ void Mpi::ExchangeX3(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
 
   double tStart = MPI_Wtime();
 #ifdef MPI_PERSISTENT
-  MPI_Status sendStatus[2];
-  MPI_Status recvStatus[2];
-
   MPI_SAFE_CALL(MPI_Startall(2, recvRequestX3));
   idfx::mpiCallsTimer += MPI_Wtime() - tStart;
 #endif
@@ -721,6 +810,10 @@ void Mpi::ExchangeX3(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
     #endif
   }
 
+  // Stage the buffers on the host when needed
+  BufferLeft.ToHost();
+  BufferRight.ToHost();
+
   // Send to the right
   Kokkos::fence();
 
@@ -728,39 +821,30 @@ void Mpi::ExchangeX3(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   tStart = MPI_Wtime();
 #ifdef MPI_PERSISTENT
   MPI_SAFE_CALL(MPI_Startall(2, sendRequestX3));
-  MPI_Waitall(2,recvRequestX3,recvStatus);
-  idfx::mpiCallsTimer += MPI_Wtime() - tStart;
 
 #else
   int procSend, procRecv;
 
   #ifdef MPI_NON_BLOCKING
-  MPI_Status sendStatus[2];
-  MPI_Status recvStatus[2];
-  MPI_Request sendRequest[2];
-  MPI_Request recvRequest[2];
-
+  // The requests are completed by ExchangeX3End
   // We receive from procRecv, and we send to procSend
   MPI_SAFE_CALL(MPI_Cart_shift(mygrid->CartComm,2,1,&procRecv,&procSend ));
 
-  MPI_SAFE_CALL(MPI_Isend(BufferSendX3[faceRight].data(), bufferSizeX3, realMPI, procSend, 100,
-                mygrid->CartComm, &sendRequest[0]));
+  MPI_SAFE_CALL(MPI_Isend(BufferSendX3[faceRight].data(), bufferSizeX3, realMPI, procSend,
+                thisInstance*1000+20, mygrid->CartComm, &sendRequestX3[0]));
 
-  MPI_SAFE_CALL(MPI_Irecv(BufferRecvX3[faceLeft].data(), bufferSizeX3, realMPI, procRecv, 100,
-                mygrid->CartComm, &recvRequest[0]));
+  MPI_SAFE_CALL(MPI_Irecv(BufferRecvX3[faceLeft].data(), bufferSizeX3, realMPI, procRecv,
+                thisInstance*1000+20, mygrid->CartComm, &recvRequestX3[0]));
 
   // Send to the left
   // We receive from procRecv, and we send to procSend
   MPI_SAFE_CALL(MPI_Cart_shift(mygrid->CartComm,2,-1,&procRecv,&procSend ));
 
-  MPI_SAFE_CALL(MPI_Isend(BufferSendX3[faceLeft].data(), bufferSizeX3, realMPI, procSend, 101,
-                mygrid->CartComm, &sendRequest[1]));
+  MPI_SAFE_CALL(MPI_Isend(BufferSendX3[faceLeft].data(), bufferSizeX3, realMPI, procSend,
+                thisInstance*1000+21, mygrid->CartComm, &sendRequestX3[1]));
 
-  MPI_SAFE_CALL(MPI_Irecv(BufferRecvX3[faceRight].data(), bufferSizeX3, realMPI, procRecv, 101,
-                mygrid->CartComm, &recvRequest[1]));
-
-  // Wait for recv to complete (we don't care about the sends)
-  MPI_Waitall(2, recvRequest, recvStatus);
+  MPI_SAFE_CALL(MPI_Irecv(BufferRecvX3[faceRight].data(), bufferSizeX3, realMPI, procRecv,
+                thisInstance*1000+21, mygrid->CartComm, &recvRequestX3[1]));
 
   #else
   MPI_Status status;
@@ -782,10 +866,44 @@ void Mpi::ExchangeX3(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
 #endif
   myTimer += MPI_Wtime();
   idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+
+  idfx::popRegion();
+}
+
+template <typename T>
+void Mpi::ExchangeX3End(IdefixArray4D<T> Vc, IdefixArray4D<accum> Vs) {
+  idfx::pushRegion("Mpi::ExchangeX3End");
+
+  int ibeg,iend,jbeg,jend,kbeg,kend,offset;
+  IdefixArray1D<int> map = this->mapVars;
+
+  // Coordinates of the ghost region which needs to be transfered
+  ibeg   = 0;
+  iend   = ntot[IDIR];
+
+  jbeg   = 0;
+  jend   = ntot[JDIR];
+
+  kbeg   = 0;
+  kend   = nghost[KDIR];
+  offset = end[KDIR];     // Distance between beginning of left and right ghosts
+
+  myTimer -= MPI_Wtime();
+  double tStart = MPI_Wtime();
+#if defined(MPI_PERSISTENT) || defined(MPI_NON_BLOCKING)
+  MPI_Status recvStatus[2];
+  // Wait for buffers to be received
+  MPI_Waitall(2,recvRequestX3,recvStatus);
+#endif
+  myTimer += MPI_Wtime();
+  idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+
   // Unpack
-  BufferLeft=BufferRecvX3[faceLeft];
-  BufferRight=BufferRecvX3[faceRight];
+  Buffer BufferLeft=BufferRecvX3[faceLeft];
+  Buffer BufferRight=BufferRecvX3[faceRight];
 
+  BufferLeft.FromHost();
+  BufferRight.FromHost();
   BufferLeft.ResetPointer();
   BufferRight.ResetPointer();
 
@@ -831,12 +949,8 @@ void Mpi::ExchangeX3(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
   }
 
   myTimer -= MPI_Wtime();
-#ifdef MPI_NON_BLOCKING
-  // Wait for the sends if they have not yet completed
-  MPI_Waitall(2, sendRequest, sendStatus);
-#endif
-
-#ifdef MPI_PERSISTENT
+#if defined(MPI_PERSISTENT) || defined(MPI_NON_BLOCKING)
+  MPI_Status sendStatus[2];
   MPI_Waitall(2, sendRequestX3, sendStatus);
 #endif
   myTimer += MPI_Wtime();
@@ -847,6 +961,322 @@ void Mpi::ExchangeX3(IdefixArray4D<real> Vc, IdefixArray4D<real> Vs) {
 
 
 
+///
+/// Initialise the single phase exchange with all of the neighbours of CartComm.
+/// Each neighbour has its own buffers and persistent requests. The tag of a message is
+/// given by its direction, so that a neighbour found at several offsets (when nproc=2 in a
+/// periodic direction) is not mistaken.
+///
+void Mpi::InitExchangeAll() {
+  idfx::pushRegion("Mpi::InitExchangeAll");
+  if(!isInitialized) {
+    IDEFIX_ERROR("InitExchangeAll requires an initialized Mpi instance");
+  }
+
+  int dims[3], periods[3], coords[3];
+  MPI_SAFE_CALL(MPI_Cart_get(mygrid->CartComm, 3, dims, periods, coords));
+
+  // Number of components of Vs which are exchanged
+  const int nVs = haveVs ? DIMENSIONS : 0;
+
+  bufferSizeAll = 0;
+  for(int ok = -1 ; ok <= 1 ; ok++) {
+    for(int oj = -1 ; oj <= 1 ; oj++) {
+      for(int oi = -1 ; oi <= 1 ; oi++) {
+        std::array<int,3> offset = {oi, oj, ok};
+        bool valid = (oi != 0 || oj != 0 || ok != 0);
+        for(int dir = 0 ; dir < 3 ; dir++) {
+          if(offset[dir] != 0 && mygrid->nproc[dir] == 1) valid = false;
+        }
+        if(!valid) continue;
+
+        // Size of the region exchanged with this neighbour
+        int size = 1;
+        for(int dir = 0 ; dir < 3 ; dir++) {
+          auto range = NeighbourRange(dir, offset[dir], true, false);
+          size *= range.second - range.first;
+        }
+        size *= mapNVars;
+        for(int comp = 0 ; comp < nVs ; comp++) {
+          int sizeVs = 1;
+          for(int dir = 0 ; dir < 3 ; dir++) {
+            auto range = NeighbourRange(dir, offset[dir], true, dir == comp);
+            sizeVs *= range.second - range.first;
+          }
+          size += sizeVs;
+        }
+
+        neighbourOffset.push_back(offset);
+        BufferSendAll.push_back(Buffer(size, transport));
+        BufferRecvAll.push_back(Buffer(size, transport));
+        bufferSizeAll += size;
+      }
+    }
+  }
+
+  const int nNeighbours = neighbourOffset.size();
+  sendRequestAll.resize(nNeighbours);
+  recvRequestAll.resize(nNeighbours);
+
+  for(int n = 0 ; n < nNeighbours ; n++) {
+    const std::array<int,3> &offset = neighbourOffset[n];
+    // Rank of the neighbour (MPI_PROC_NULL across non-periodic domain boundaries)
+    int procNeighbour;
+    int coordsNeighbour[3];
+    bool exists = true;
+    for(int dir = 0 ; dir < 3 ; dir++) {
+      coordsNeighbour[dir] = coords[dir] + offset[dir];
+      if(coordsNeighbour[dir] < 0 || coordsNeighbour[dir] >= dims[dir]) {
+        if(periods[dir]) {
+          coordsNeighbour[dir] = (coordsNeighbour[dir] + dims[dir]) % dims[dir];
+        } else {
+          exists = false;
+        }
+      }
+    }
+    if(exists) {
+      MPI_SAFE_CALL(MPI_Cart_rank(mygrid->CartComm, coordsNeighbour, &procNeighbour));
+    } else {
+      procNeighbour = MPI_PROC_NULL;
+    }
+    neighbourProc.push_back(procNeighbour);
+
+    // We send towards offset, and we receive what our neighbour sent towards -offset
+    const int tagSend = thisInstance*1000+100 + (offset[IDIR]+1)
+                                              + 3*(offset[JDIR]+1) + 9*(offset[KDIR]+1);
+    const int tagRecv = thisInstance*1000+100 + (1-offset[IDIR])
+                                              + 3*(1-offset[JDIR]) + 9*(1-offset[KDIR]);
+    const int size = BufferSendAll[n].Size();
+
+    MPI_SAFE_CALL(MPI_Send_init(BufferSendAll[n].data(), size, realMPI, procNeighbour,
+                  tagSend, mygrid->CartComm, &sendRequestAll[n]));
+    MPI_SAFE_CALL(MPI_Recv_init(BufferRecvAll[n].data(), size, realMPI, procNeighbour,
+                  tagRecv, mygrid->CartComm, &recvRequestAll[n]));
+  }
+
+  haveExchangeAll = true;
+  idfx::popRegion();
+}
+
+std::pair<int,int> Mpi::NeighbourRange(int dir, int offset, bool send, bool staggered) {
+  // Directions which are not decomposed are exchanged over their full extent
+  if(mygrid->nproc[dir] == 1) return(std::make_pair(0, ntot[dir] + (staggered ? 1 : 0)));
+
+  const int ng = nghost[dir];
+  if(offset < 0) {
+    // The face-centered field on the left face of the domain is not exchanged
+    if(send) return(std::make_pair(beg[dir] + (staggered ? 1 : 0),
+                                   beg[dir] + ng + (staggered ? 1 : 0)));
+    return(std::make_pair(0, ng));
+  }
+  if(offset > 0) {
+    if(send) return(std::make_pair(end[dir] - ng, end[dir]));
+    return(std::make_pair(end[dir] + (staggered ? 1 : 0), end[dir] + ng + (staggered ? 1 : 0)));
+  }
+  return(std::make_pair(beg[dir], end[dir] + (staggered ? 1 : 0)));
+}
+
+template <typename T>
+void Mpi::PackAll(Buffer &buffer, IdefixArray4D<T> &Vc, IdefixArray4D<accum> &Vs,
+                  const std::array<int,3> &offset) {
+  IdefixArray1D<int> map = this->mapVars;
+  buffer.ResetPointer();
+  buffer.Pack(Vc, map, NeighbourRange(IDIR, offset[IDIR], true, false),
+                       NeighbourRange(JDIR, offset[JDIR], true, false),
+                       NeighbourRange(KDIR, offset[KDIR], true, false));
+  if(haveVs) {
+    buffer.Pack(Vs, BX1s, NeighbourRange(IDIR, offset[IDIR], true, true),
+                          NeighbourRange(JDIR, offset[JDIR], true, false),
+                          NeighbourRange(KDIR, offset[KDIR], true, false));
+    #if DIMENSIONS >= 2
+    buffer.Pack(Vs, BX2s, NeighbourRange(IDIR, offset[IDIR], true, false),
+                          NeighbourRange(JDIR, offset[JDIR], true, true),
+                          NeighbourRange(KDIR, offset[KDIR], true, false));
+    #endif
+    #if DIMENSIONS == 3
+    buffer.Pack(Vs, BX3s, NeighbourRange(IDIR, offset[IDIR], true, false),
+                          NeighbourRange(JDIR, offset[JDIR], true, false),
+                          NeighbourRange(KDIR, offset[KDIR], true, true));
+    #endif
+  }
+}
+
+template <typename T>
+void Mpi::UnpackAll(Buffer &buffer, IdefixArray4D<T> &Vc, IdefixArray4D<accum> &Vs,
+                    const std::array<int,3> &offset) {
+  IdefixArray1D<int> map = this->mapVars;
+  buffer.ResetPointer();
+  buffer.Unpack(Vc, map, NeighbourRange(IDIR, offset[IDIR], false, false),
+                         NeighbourRange(JDIR, offset[JDIR], false, false),
+                         NeighbourRange(KDIR, offset[KDIR], false, false));
+  if(haveVs) {
+    buffer.Unpack(Vs, BX1s, NeighbourRange(IDIR, offset[IDIR], false, true),
+                            NeighbourRange(JDIR, offset[JDIR], false, false),
+                            NeighbourRange(KDIR, offset[KDIR], false, false));
+    #if DIMENSIONS >= 2
+    buffer.Unpack(Vs, BX2s, NeighbourRange(IDIR, offset[IDIR], false, false),
+                            NeighbourRange(JDIR, offset[JDIR], false, true),
+                            NeighbourRange(KDIR, offset[KDIR], false, false));
+    #endif
+    #if DIMENSIONS == 3
+    buffer.Unpack(Vs, BX3s, NeighbourRange(IDIR, offset[IDIR], false, false),
+                            NeighbourRange(JDIR, offset[JDIR], false, false),
+                            NeighbourRange(KDIR, offset[KDIR], false, true));
+    #endif
+  }
+}
+
+// Exchange the ghost zones with all of the neighbours (including the diagonal ones) at once,
+// instead of exchanging X1, X2 and X3 one after the other so that corners propagate.
+template <typename T>
+void Mpi::ExchangeAll(IdefixArray4D<T> Vc, IdefixArray4D<accum> Vs) {
+  idfx::pushRegion("Mpi::ExchangeAll");
+  ExchangeAllBegin(Vc, Vs);
+  ExchangeAllEnd(Vc, Vs);
+  idfx::popRegion();
+}
+
+template <typename T>
+void Mpi::ExchangeAllBegin(IdefixArray4D<T> Vc, IdefixArray4D<accum> Vs) {
+  idfx::pushRegion("Mpi::ExchangeAllBegin");
+  if(!haveExchangeAll) {
+    IDEFIX_ERROR("ExchangeAll requires a call to InitExchangeAll");
+  }
+  const int nNeighbours = neighbourOffset.size();
+
+  // Start receiving even before the buffers are filled
+  myTimer -= MPI_Wtime();
+  double tStart = MPI_Wtime();
+  MPI_SAFE_CALL(MPI_Startall(nNeighbours, recvRequestAll.data()));
+  idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+  myTimer += MPI_Wtime();
+
+  for(int n = 0 ; n < nNeighbours ; n++) {
+    if(neighbourProc[n] == MPI_PROC_NULL) continue;
+    PackAll(BufferSendAll[n], Vc, Vs, neighbourOffset[n]);
+    // The staging copies are queued behind the packing kernels on the same execution space
+    // instance, so that they do not overlap the packing of the next buffers
+    BufferSendAll[n].ToHost();
+  }
+
+  // Wait for completion before sending out everything
+  Kokkos::fence();
+  myTimer -= MPI_Wtime();
+  tStart = MPI_Wtime();
+  MPI_SAFE_CALL(MPI_Startall(nNeighbours, sendRequestAll.data()));
+  myTimer += MPI_Wtime();
+  idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+
+  idfx::popRegion();
+}
+
+template <typename T>
+void Mpi::ExchangeAllEnd(IdefixArray4D<T> Vc, IdefixArray4D<accum> Vs) {
+  idfx::pushRegion("Mpi::ExchangeAllEnd");
+  const int nNeighbours = neighbourOffset.size();
+
+  myTimer -= MPI_Wtime();
+  double tStart = MPI_Wtime();
+  // Wait for buffers to be received
+  MPI_Waitall(nNeighbours, recvRequestAll.data(), MPI_STATUSES_IGNORE);
+  myTimer += MPI_Wtime();
+  idfx::mpiCallsTimer += MPI_Wtime() - tStart;
+
+  // Unpack. Ghost zones without neighbours are left to the physical boundary conditions
+  for(int n = 0 ; n < nNeighbours ; n++) {
+    if(neighbourProc[n] == MPI_PROC_NULL) continue;
+    BufferRecvAll[n].FromHost();
+    UnpackAll(BufferRecvAll[n], Vc, Vs, neighbourOffset[n]);
+  }
+
+  myTimer -= MPI_Wtime();
+  MPI_Waitall(nNeighbours, sendRequestAll.data(), MPI_STATUSES_IGNORE);
+  myTimer += MPI_Wtime();
+  bytesSentOrReceived += 2*bufferSizeAll*sizeof(real);
+
+  idfx::popRegion();
+}
+
+// Measure the time needed to exchange our buffers with our neighbours for each of the
+// transports, and return the fastest one. Timings are reduced over all of the processes,
+// so that they all make the same choice.
+Buffer::Transport Mpi::SelectTransport() {
+  idfx::pushRegion("Mpi::SelectTransport");
+  const int nTransports = 3;
+  const Buffer::Transport candidates[nTransports] = {Buffer::Transport::device,
+                                                     Buffer::Transport::pinned,
+                                                     Buffer::Transport::host};
+  const int bufferSize[3] = {bufferSizeX1, bufferSizeX2, bufferSizeX3};
+  const int nIter = 10;
+  double elapsed[nTransports];
+
+  for(int t = 0 ; t < nTransports ; t++) {
+    elapsed[t] = 0;
+    for(int dir = 0 ; dir < DIMENSIONS ; dir++) {
+      if(mygrid->nproc[dir] == 1) continue;
+      int procSend, procRecv;
+      MPI_SAFE_CALL(MPI_Cart_shift(mygrid->CartComm,dir,1,&procRecv,&procSend ));
+      Buffer bufferSend(bufferSize[dir], candidates[t]);
+      Buffer bufferRecv(bufferSize[dir], candidates[t]);
+      const int tag = thisInstance*1000+500+dir;
+      // The first exchange is not timed
+      for(int iter = 0 ; iter <= nIter ; iter++) {
+        MPI_Barrier(mygrid->CartComm);
+        double tStart = MPI_Wtime();
+        bufferSend.ToHost();
+        Kokkos::fence();
+        MPI_SAFE_CALL(MPI_Sendrecv(bufferSend.data(), bufferSize[dir], realMPI, procSend, tag,
+                                   bufferRecv.data(), bufferSize[dir], realMPI, procRecv, tag,
+                                   mygrid->CartComm, MPI_STATUS_IGNORE));
+        bufferRecv.FromHost();
+        Kokkos::fence();
+        if(iter > 0) elapsed[t] += MPI_Wtime() - tStart;
+      }
+    }
+  }
+  MPI_SAFE_CALL(MPI_Allreduce(MPI_IN_PLACE, elapsed, nTransports, MPI_DOUBLE, MPI_MAX,
+                              mygrid->CartComm));
+
+  int best = 0;
+  for(int t = 1 ; t < nTransports ; t++) {
+    if(elapsed[t] < elapsed[best]) best = t;
+  }
+
+  // elapsed holds the time of one exchange in each of the decomposed directions
+  idfx::cout << "Mpi(" << thisInstance << "): time of one halo exchange with ";
+  for(int t = 0 ; t < nTransports ; t++) {
+    idfx::cout << TransportName(candidates[t]) << " buffers: " << elapsed[t]/nIter << " s";
+    idfx::cout << ((t < nTransports-1) ? ", " : ".");
+  }
+  idfx::cout << std::endl;
+  idfx::cout << "Mpi(" << thisInstance << "): using " << TransportName(candidates[best])
+             << " buffers." << std::endl;
+
+  idfx::popRegion();
+  return(candidates[best]);
+}
+
+std::string Mpi::TransportName(Buffer::Transport transport) {
+  switch(transport) {
+    case Buffer::Transport::device:
+      return("device");
+    case Buffer::Transport::pinned:
+      return("pinned host-staged");
+    case Buffer::Transport::host:
+      return("host-staged");
+  }
+  return("unknown");
+}
+
+bool Mpi::HaveAsyncExchanges() {
+#if defined(MPI_PERSISTENT) || defined(MPI_NON_BLOCKING)
+  return(true);
+#else
+  // The blocking MPI_Sendrecv are completed within ExchangeXnBegin
+  return(false);
+#endif
+}
+
 void Mpi::CheckConfig() {
   idfx::pushRegion("Mpi::CheckConfig");
   // compile time check
@@ -963,3 +1393,32 @@ bool Mpi::CheckSync(real timeout) {
 
   return(true);
 }
+
+// Exchanges of the primitive variables and, in mixed precision, of the conservative variables,
+// which are stored in double precision
+template void Mpi::ExchangeAll(IdefixArray4D<real>, IdefixArray4D<accum>);
+template void Mpi::ExchangeX1(IdefixArray4D<real>, IdefixArray4D<accum>);
+template void Mpi::ExchangeX2(IdefixArray4D<real>, IdefixArray4D<accum>);
+template void Mpi::ExchangeX3(IdefixArray4D<real>, IdefixArray4D<accum>);
+template void Mpi::ExchangeX1Begin(IdefixArray4D<real>, IdefixArray4D<accum>);
+template void Mpi::ExchangeX1End(IdefixArray4D<real>, IdefixArray4D<accum>);
+template void Mpi::ExchangeX2Begin(IdefixArray4D<real>, IdefixArray4D<accum>);
+template void Mpi::ExchangeX2End(IdefixArray4D<real>, IdefixArray4D<accum>);
+template void Mpi::ExchangeX3Begin(IdefixArray4D<real>, IdefixArray4D<accum>);
+template void Mpi::ExchangeX3End(IdefixArray4D<real>, IdefixArray4D<accum>);
+template void Mpi::ExchangeAllBegin(IdefixArray4D<real>, IdefixArray4D<accum>);
+template void Mpi::ExchangeAllEnd(IdefixArray4D<real>, IdefixArray4D<accum>);
+#ifdef MIXED_PRECISION
+template void Mpi::ExchangeAll(IdefixArray4D<accum>, IdefixArray4D<accum>);
+template void Mpi::ExchangeX1(IdefixArray4D<accum>, IdefixArray4D<accum>);
+template void Mpi::ExchangeX2(IdefixArray4D<accum>, IdefixArray4D<accum>);
+template void Mpi::ExchangeX3(IdefixArray4D<accum>, IdefixArray4D<accum>);
+template void Mpi::ExchangeX1Begin(IdefixArray4D<accum>, IdefixArray4D<accum>);
+template void Mpi::ExchangeX1End(IdefixArray4D<accum>, IdefixArray4D<accum>);
+template void Mpi::ExchangeX2Begin(IdefixArray4D<accum>, IdefixArray4D<accum>);
+template void Mpi::ExchangeX2End(IdefixArray4D<accum>, IdefixArray4D<accum>);
+template void Mpi::ExchangeX3Begin(IdefixArray4D<accum>, IdefixArray4D<accum>);
+template void Mpi::ExchangeX3End(IdefixArray4D<accum>, IdefixArray4D<accum>);
+template void Mpi::ExchangeAllBegin(IdefixArray4D<accum>, IdefixArray4D<accum>);
+template void Mpi::ExchangeAllEnd(IdefixArray4D<accum>, IdefixArray4D<accum>);
+#endif
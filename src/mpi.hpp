@@ -11,20 +11,62 @@
 #include <signal.h>
 #include <vector>
 #include <utility>
+#include <array>
+#include <string>
 #include "idefix.hpp"
 #include "grid.hpp"
 
 
+// Host memory used to stage the buffers, pinned when the backend provides it
+#ifdef KOKKOS_HAS_SHARED_HOST_PINNED_SPACE
+using BufferPinnedArray = Kokkos::View<real*, Kokkos::SharedHostPinnedSpace>;
+#else
+using BufferPinnedArray = Kokkos::View<real*, Kokkos::HostSpace>;
+#endif
+
 class DataBlock;
 class Buffer {
  public:
+  // How the buffer is handed to MPI
+  enum class Transport {device, pinned, host};
+
   Buffer() = default;
-  explicit Buffer(size_t size): pointer{0}, array{IdefixArray1D<real>("BufferArray",size)} { };
+  explicit Buffer(size_t size, Transport inputTransport = Transport::device):
+                  pointer{0}, transport{inputTransport},
+                  array{IdefixArray1D<real>("BufferArray",size)} {
+    if(transport == Transport::pinned) {
+      pinnedArray = BufferPinnedArray("BufferPinnedArray",size);
+    } else if(transport == Transport::host) {
+      hostArray = IdefixHostArray1D<real>("BufferHostArray",size);
+    }
+  }
 
+  // Memory given to MPI calls
   void* data() {
+    if(transport == Transport::pinned) return(pinnedArray.data());
+    if(transport == Transport::host) return(hostArray.data());
     return(array.data());
   }
 
+  // Copy the packed buffer to its host stage. The copy is asynchronous, and should be
+  // completed by a fence before the MPI calls.
+  void ToHost() {
+    if(transport == Transport::pinned) {
+      Kokkos::deep_copy(Kokkos::DefaultExecutionSpace(), pinnedArray, array);
+    } else if(transport == Transport::host) {
+      Kokkos::deep_copy(Kokkos::DefaultExecutionSpace(), hostArray, array);
+    }
+  }
+
+  // Copy the received host stage back to the buffer, before unpacking
+  void FromHost() {
+    if(transport == Transport::pinned) {
+      Kokkos::deep_copy(Kokkos::DefaultExecutionSpace(), array, pinnedArray);
+    } else if(transport == Transport::host) {
+      Kokkos::deep_copy(Kokkos::DefaultExecutionSpace(), array, hostArray);
+    }
+  }
+
   int Size() {
     return(array.size());
   }
@@ -55,7 +97,9 @@ class Buffer {
     this->pointer += ninjnk;
   }
 
-  void Pack(IdefixArray4D<real>& in,
+  // 4D arrays may hold the state in accum precision, which is rounded to real in the buffers
+  template <typename T>
+  void Pack(IdefixArray4D<T>& in,
        const int var,
        std::pair<int,int> ib,
        std::pair<int,int> jb,
@@ -71,14 +115,15 @@ class Buffer {
     auto arr = this->array;
     idefix_for("LoadBuffer4D",kb.first,kb.second,jb.first,jb.second,ib.first,ib.second,
       KOKKOS_LAMBDA (int k, int j, int i) {
-      arr(i-ibeg + (j-jbeg)*ni + (k-kbeg)*ninj + offset ) = in(var, k,j,i);
+      arr(i-ibeg + (j-jbeg)*ni + (k-kbeg)*ninj + offset ) = static_cast<real>(in(var, k,j,i));
     });
 
     // Update pointer
     this->pointer += ninjnk;
   }
 
-  void Pack(IdefixArray4D<real>& in,
+  template <typename T>
+  void Pack(IdefixArray4D<T>& in,
        IdefixArray1D<int>& map,
        std::pair<int,int> ib,
        std::pair<int,int> jb,
@@ -97,7 +142,8 @@ class Buffer {
                              jb.first,jb.second,
                              ib.first,ib.second,
       KOKKOS_LAMBDA (int n, int k, int j, int i) {
-      arr(i-ibeg + (j-jbeg)*ni + (k-kbeg)*ninj + n*ninjnk + offset ) = in(map(n), k,j,i);
+      arr(i-ibeg + (j-jbeg)*ni + (k-kbeg)*ninj + n*ninjnk + offset ) =
+        static_cast<real>(in(map(n), k,j,i));
     });
 
     // Update pointer
@@ -126,7 +172,8 @@ class Buffer {
     this->pointer += ninjnk;
   }
 
-  void Unpack(IdefixArray4D<real>& out,
+  template <typename T>
+  void Unpack(IdefixArray4D<T>& out,
        const int var,
        std::pair<int,int> ib,
        std::pair<int,int> jb,
@@ -149,7 +196,8 @@ class Buffer {
     this->pointer += ninjnk;
   }
 
-  void Unpack(IdefixArray4D<real>& out,
+  template <typename T>
+  void Unpack(IdefixArray4D<T>& out,
        IdefixArray1D<int>& map,
        std::pair<int,int> ib,
        std::pair<int,int> jb,
@@ -178,34 +226,79 @@ class Buffer {
 
  private:
   size_t pointer;
+  Transport transport{Transport::device};
   IdefixArray1D<real> array;
+  BufferPinnedArray pinnedArray;
+  IdefixHostArray1D<real> hostArray;
 };
 
 class Mpi {
  public:
   Mpi() = default;
   // MPI Exchange functions
-  void ExchangeAll();   ///< Exchange boundary elements in all directions (todo)
-  void ExchangeX1(IdefixArray4D<real> inputVc,
-                  IdefixArray4D<real> inputVs = IdefixArray4D<real>());
+  template <typename T>
+  void ExchangeAll(IdefixArray4D<T> inputVc,
+                   IdefixArray4D<accum> inputVs = IdefixArray4D<accum>());
+                                      ///< Exchange boundary elements with all the neighbours
+  template <typename T>
+  void ExchangeX1(IdefixArray4D<T> inputVc,
+                  IdefixArray4D<accum> inputVs = IdefixArray4D<accum>());
                                       ///< Exchange boundary elements in the X1 direction
-  void ExchangeX2(IdefixArray4D<real> inputVc,
-                IdefixArray4D<real> inputVs = IdefixArray4D<real>());
+  template <typename T>
+  void ExchangeX2(IdefixArray4D<T> inputVc,
+                  IdefixArray4D<accum> inputVs = IdefixArray4D<accum>());
                                     ///< Exchange boundary elements in the X2 direction
-  void ExchangeX3(IdefixArray4D<real> inputVc,
-                IdefixArray4D<real> inputVs = IdefixArray4D<real>());
+  template <typename T>
+  void ExchangeX3(IdefixArray4D<T> inputVc,
+                  IdefixArray4D<accum> inputVs = IdefixArray4D<accum>());
                                       ///< Exchange boundary elements in the X3 direction
 
+  // Split exchanges: Begin packs the buffers and starts the communications, End waits for them
+  // to complete and fills the ghost zones. Active cells can be computed in between.
+  template <typename T>
+  void ExchangeX1Begin(IdefixArray4D<T> inputVc,
+                       IdefixArray4D<accum> inputVs = IdefixArray4D<accum>());
+  template <typename T>
+  void ExchangeX1End(IdefixArray4D<T> inputVc,
+                     IdefixArray4D<accum> inputVs = IdefixArray4D<accum>());
+  template <typename T>
+  void ExchangeX2Begin(IdefixArray4D<T> inputVc,
+                       IdefixArray4D<accum> inputVs = IdefixArray4D<accum>());
+  template <typename T>
+  void ExchangeX2End(IdefixArray4D<T> inputVc,
+                     IdefixArray4D<accum> inputVs = IdefixArray4D<accum>());
+  template <typename T>
+  void ExchangeX3Begin(IdefixArray4D<T> inputVc,
+                       IdefixArray4D<accum> inputVs = IdefixArray4D<accum>());
+  template <typename T>
+  void ExchangeX3End(IdefixArray4D<T> inputVc,
+                     IdefixArray4D<accum> inputVs = IdefixArray4D<accum>());
+  template <typename T>
+  void ExchangeAllBegin(IdefixArray4D<T> inputVc,
+                        IdefixArray4D<accum> inputVs = IdefixArray4D<accum>());
+  template <typename T>
+  void ExchangeAllEnd(IdefixArray4D<T> inputVc,
+                      IdefixArray4D<accum> inputVs = IdefixArray4D<accum>());
+
   // Init from datablock
   void Init(Grid *grid, std::vector<int> inputMap,
             int nghost[3], int nint[3], bool inputHaveVs = false );
 
+  // Init the buffers and persistent requests of ExchangeAll (called after Init)
+  void InitExchangeAll();
+
   // Check that MPI will work with the designated target (in particular GPU Direct)
   static void CheckConfig();
 
   // Check that MPI processes are synced
   static bool CheckSync(real);
 
+  // Name of a buffer transport
+  static std::string TransportName(Buffer::Transport);
+
+  // Whether ExchangeXnBegin returns before the exchange is completed by ExchangeXnEnd
+  static bool HaveAsyncExchanges();
+
 
   // Destructor
   ~Mpi();
@@ -248,6 +341,10 @@ class Mpi {
 
   bool haveVs{false};
 
+  // How the buffers are handed to MPI (see Grid::mpiTransport)
+  Buffer::Transport transport{Buffer::Transport::device};
+  Buffer::Transport SelectTransport();   //< measure the fastest transport for our buffers
+
   // Requests for MPI persistent communications
   MPI_Request sendRequestX1[2];
   MPI_Request sendRequestX2[2];
@@ -258,6 +355,27 @@ class Mpi {
 
   Grid *mygrid;
 
+  // Single phase exchange with all of the neighbours (faces, edges and corners) of
+  // CartComm. Neighbours are only looked for in the directions which are decomposed.
+  bool haveExchangeAll{false};
+  std::vector<std::array<int,3>> neighbourOffset;  //< offset of each neighbour in CartComm
+  std::vector<int> neighbourProc;                  //< rank of each neighbour (or MPI_PROC_NULL)
+  std::vector<Buffer> BufferSendAll;
+  std::vector<Buffer> BufferRecvAll;
+  std::vector<MPI_Request> sendRequestAll;
+  std::vector<MPI_Request> recvRequestAll;
+  int bufferSizeAll{0};   //< total number of elements sent by ExchangeAll
+
+  // Index range of the region sent to or received from a neighbour located at offset
+  // in direction dir. Staggered is true for the face-centered field normal to dir.
+  std::pair<int,int> NeighbourRange(int dir, int offset, bool send, bool staggered);
+  template <typename T>
+  void PackAll(Buffer &, IdefixArray4D<T> &, IdefixArray4D<accum> &,
+               const std::array<int,3> &);
+  template <typename T>
+  void UnpackAll(Buffer &, IdefixArray4D<T> &, IdefixArray4D<accum> &,
+                 const std::array<int,3> &);
+
   // MPI throughput timer specific to this object
   double myTimer{0};
   int64_t bytesSentOrReceived{0};
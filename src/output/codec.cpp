@@ -0,0 +1,178 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "codec.hpp"
+
+std::unique_ptr<Codec> Codec::Create(Id id) {
+  switch(id) {
+    case none:
+      return(std::make_unique<NoneCodec>());
+    case lz:
+      return(std::make_unique<LzCodec>());
+    default:
+      std::stringstream msg;
+      msg << "Unknown compression codec " << static_cast<int>(id) << ".";
+      IDEFIX_ERROR(msg);
+  }
+  return(nullptr);
+}
+
+std::unique_ptr<Codec> Codec::Create(const std::string &name) {
+  if(name.compare("none") == 0) return(Create(none));
+  if(name.compare("lz") == 0) return(Create(lz));
+  IDEFIX_ERROR("Unknown compression codec "+name+". Valid codecs are none and lz.");
+  return(nullptr);
+}
+
+std::vector<uint8_t> NoneCodec::Compress(const real *in, int64_t n) {
+  std::vector<uint8_t> out(n*sizeof(real));
+  std::memcpy(out.data(), in, n*sizeof(real));
+  return(out);
+}
+
+void NoneCodec::Decompress(const uint8_t *in, int64_t size, real *out, int64_t n) {
+  if(size != n*sizeof(real)) IDEFIX_ERROR("Corrupted data in compressed stream");
+  std::memcpy(out, in, size);
+}
+
+// The compressed stream is a series of sequences, each made of:
+// - a token: 4 bits for the number of literals, 4 bits for the match length minus minMatch
+// - additional bytes for the number of literals when it is >= 15 (255 means more to come)
+// - the literals
+// - the offset of the match (2 bytes, little endian)
+// - additional bytes for the match length when it is >= 15+minMatch
+// The last sequence only contains literals.
+namespace {
+constexpr int minMatch = 4;
+constexpr int hashLog = 16;
+constexpr int64_t maxOffset = 65535;
+
+inline uint32_t Read32(const uint8_t *p) {
+  uint32_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return(v);
+}
+
+inline void WriteLength(std::vector<uint8_t> &out, int64_t len) {
+  while(len >= 255) {
+    out.push_back(255);
+    len -= 255;
+  }
+  out.push_back(static_cast<uint8_t>(len));
+}
+
+inline int64_t ReadLength(const uint8_t *&ip, const uint8_t *iend) {
+  int64_t len = 0;
+  uint8_t b;
+  do {
+    if(ip >= iend) IDEFIX_ERROR("Corrupted data in compressed stream");
+    b = *ip++;
+    len += b;
+  } while(b == 255);
+  return(len);
+}
+
+void WriteSequence(std::vector<uint8_t> &out, const uint8_t *lit, int64_t nlit,
+                   int64_t offset, int64_t matchLength) {
+  const int64_t mlen = matchLength - minMatch;
+  uint8_t token = static_cast<uint8_t>((nlit < 15 ? nlit : 15) << 4);
+  if(matchLength > 0) token |= static_cast<uint8_t>(mlen < 15 ? mlen : 15);
+  out.push_back(token);
+  if(nlit >= 15) WriteLength(out, nlit - 15);
+  out.insert(out.end(), lit, lit + nlit);
+  if(matchLength > 0) {
+    out.push_back(static_cast<uint8_t>(offset & 0xFF));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+    if(mlen >= 15) WriteLength(out, mlen - 15);
+  }
+}
+}  // namespace
+
+std::vector<uint8_t> LzCodec::Compress(const real *in, int64_t n) {
+  const int64_t size = n*sizeof(real);
+
+  // Shuffle the bytes of the reals
+  std::vector<uint8_t> src(size);
+  const uint8_t *raw = reinterpret_cast<const uint8_t *>(in);
+  for(int64_t i = 0 ; i < n ; i++) {
+    for(int b = 0 ; b < sizeof(real) ; b++) {
+      src[b*n + i] = raw[i*sizeof(real) + b];
+    }
+  }
+
+  std::vector<uint8_t> out;
+  out.reserve(size/2);
+  std::vector<int64_t> table(1 << hashLog, -1);
+  int64_t anchor = 0;
+  int64_t ip = 0;
+  while(ip + minMatch <= size) {
+    const uint32_t seq = Read32(&src[ip]);
+    const uint32_t h = (seq * 2654435761U) >> (32 - hashLog);
+    const int64_t ref = table[h];
+    table[h] = ip;
+    if(ref >= 0 && ip - ref <= maxOffset && Read32(&src[ref]) == seq) {
+      int64_t length = minMatch;
+      while(ip + length < size && src[ref + length] == src[ip + length]) length++;
+      WriteSequence(out, &src[anchor], ip - anchor, ip - ref, length);
+      ip += length;
+      anchor = ip;
+    } else {
+      ip++;
+    }
+  }
+  // Remaining literals
+  WriteSequence(out, src.data() + anchor, size - anchor, 0, 0);
+  return(out);
+}
+
+void LzCodec::Decompress(const uint8_t *in, int64_t size, real *out, int64_t n) {
+  const int64_t outSize = n*sizeof(real);
+  std::vector<uint8_t> dst(outSize);
+  const uint8_t *ip = in;
+  const uint8_t *iend = in + size;
+  int64_t op = 0;
+  while(ip < iend) {
+    const uint8_t token = *ip++;
+    int64_t nlit = token >> 4;
+    if(nlit == 15) nlit += ReadLength(ip, iend);
+    if(ip + nlit > iend || op + nlit > outSize) {
+      IDEFIX_ERROR("Corrupted data in compressed stream");
+    }
+    std::memcpy(&dst[op], ip, nlit);
+    ip += nlit;
+    op += nlit;
+    // The last sequence has no match
+    if(ip >= iend) break;
+
+    if(ip + 2 > iend) IDEFIX_ERROR("Corrupted data in compressed stream");
+    const int64_t offset = ip[0] | (ip[1] << 8);
+    ip += 2;
+    int64_t length = (token & 15);
+    if(length == 15) length += ReadLength(ip, iend);
+    length += minMatch;
+    if(offset == 0 || offset > op || op + length > outSize) {
+      IDEFIX_ERROR("Corrupted data in compressed stream");
+    }
+    // Matches may overlap the bytes being written, hence the byte per byte copy
+    for(int64_t i = 0 ; i < length ; i++, op++) {
+      dst[op] = dst[op - offset];
+    }
+  }
+  if(op != outSize) IDEFIX_ERROR("Corrupted data in compressed stream");
+
+  // Unshuffle the bytes of the reals
+  uint8_t *raw = reinterpret_cast<uint8_t *>(out);
+  for(int64_t i = 0 ; i < n ; i++) {
+    for(int b = 0 ; b < sizeof(real) ; b++) {
+      raw[i*sizeof(real) + b] = dst[b*n + i];
+    }
+  }
+}
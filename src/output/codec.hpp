@@ -0,0 +1,56 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef OUTPUT_CODEC_HPP_
+#define OUTPUT_CODEC_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "idefix.hpp"
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+/// A Codec compresses arrays of reals without loss, for compressed outputs. Codecs are identified
+/// in the files by their Id, so that new codecs can be added without breaking older files.
+//////////////////////////////////////////////////////////////////////////////////////////////////
+class Codec {
+ public:
+  enum Id {none = 0, lz = 1};
+
+  virtual ~Codec() = default;
+
+  // Compress n reals, and return the compressed bytes
+  virtual std::vector<uint8_t> Compress(const real *, int64_t n) = 0;
+  // Decompress a stream of bytes of the given size into n reals
+  virtual void Decompress(const uint8_t *, int64_t size, real *, int64_t n) = 0;
+
+  virtual Id GetId() = 0;
+
+  static std::unique_ptr<Codec> Create(Id);
+  static std::unique_ptr<Codec> Create(const std::string &);   // From the codec name
+};
+
+// Raw copy
+class NoneCodec : public Codec {
+ public:
+  std::vector<uint8_t> Compress(const real *, int64_t) override;
+  void Decompress(const uint8_t *, int64_t, real *, int64_t) override;
+  Id GetId() override { return(none); }
+};
+
+// Built-in codec: the bytes of the reals are first shuffled (all of the first bytes, then all
+// of the second bytes...) so that the slowly varying exponents and leading mantissa bytes
+// form long repeated patterns, which are then compressed by an LZ77 scheme similar to LZ4.
+class LzCodec : public Codec {
+ public:
+  std::vector<uint8_t> Compress(const real *, int64_t) override;
+  void Decompress(const uint8_t *, int64_t, real *, int64_t) override;
+  Id GetId() override { return(lz); }
+};
+
+#endif // OUTPUT_CODEC_HPP_
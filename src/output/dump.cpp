@@ -17,8 +17,11 @@
   #error "Missing the <filesystem> header."
 #endif
 #include <iomanip>
+#include <limits>
 #include <string>
+#include <vector>
 #include <cstdio>
+#include <cstring>
 #include "dump.hpp"
 #include "version.hpp"
 #include "dataBlockHost.hpp"
@@ -63,6 +66,16 @@ void  Dump::RegisterVariable(IdefixHostArray4D<real>& in,
     dumpFieldMap.emplace(name, DumpField(in, varnum, loc, dir));
 }
 
+#ifdef MIXED_PRECISION
+void  Dump::RegisterVariable(IdefixArray4D<accum>& in,
+                        std::string name,
+                        int varnum,
+                        int dir,
+                        DumpField::ArrayLocation loc) {
+    dumpFieldMap.emplace(name, DumpField(in, varnum, loc, dir));
+}
+#endif
+
 
 
 void Dump::CreateMPIDataType(GridBox gb, bool read) {
@@ -225,6 +238,17 @@ Dump::Dump(Input &input, DataBlock *datain) {
   } else {
     outputDirectory = "./";
   }
+  if(input.CheckEntry("Output","dmp_async")>=0) {
+    haveAsyncWrite = input.Get<bool>("Output","dmp_async",0);
+  }
+  if(input.CheckEntry("Output","dmp_compression")>=0) {
+    std::string codecName = input.Get<std::string>("Output","dmp_compression",0);
+    if(codecName.compare("none") != 0) codec = Codec::Create(codecName);
+  }
+  if(codec && haveAsyncWrite) {
+    IDEFIX_WARNING("Compressed dumps are written synchronously, ignoring dmp_async");
+    haveAsyncWrite = false;
+  }
   Init(datain);
 }
 
@@ -237,6 +261,11 @@ Dump::Dump(DataBlock *datain) {
 }
 
 Dump::~Dump() {
+  // Make sure the last dump is complete before leaving. Errors can't be raised from here.
+  if(!CompleteAsyncWrite()) {
+    idfx::cerr << "Dump: unable to write " << asyncFilename
+               << ". Check your filesystem permissions and disk quota." << std::endl;
+  }
   delete scrch;
 }
 
@@ -347,6 +376,7 @@ void Dump::WriteDistributed(IdfxFileHandler fileHdl, int ndim, int *dim, int *gd
   #else
   type = SingleType;
   #endif
+  if(codec) type = CompressedType;
 
   // Write field name
   WriteString(fileHdl, name, NAMESIZE);
@@ -383,13 +413,23 @@ void Dump::WriteDistributed(IdfxFileHandler fileHdl, int ndim, int *dim, int *gd
       nglob = nglob * gdim[n];
     }
 
+    if(codec) {
+      WriteCompressed(fileHdl, dim, data);
+      return;
+    }
+
     // Write raw data
     if(type == DoubleType) MpiType=MPI_DOUBLE;
     if(type == SingleType) MpiType=MPI_FLOAT;
 
-    MPI_SAFE_CALL(MPI_File_set_view(fileHdl, offset, MpiType,
-                                    descriptor, "native", MPI_INFO_NULL ));
-    MPI_SAFE_CALL(MPI_File_write_all(fileHdl, data, ntot, MpiType, MPI_STATUS_IGNORE));
+    if(haveAsyncWrite) {
+      // Raw data are written later on by StartAsyncWrite
+      asyncBlocks.push_back({data, ntot, offset, descriptor});
+    } else {
+      MPI_SAFE_CALL(MPI_File_set_view(fileHdl, offset, MpiType,
+                                      descriptor, "native", MPI_INFO_NULL ));
+      MPI_SAFE_CALL(MPI_File_write_all(fileHdl, data, ntot, MpiType, MPI_STATUS_IGNORE));
+    }
 
     offset=offset+nglob*sizeof(real);
 
@@ -412,8 +452,17 @@ void Dump::WriteDistributed(IdfxFileHandler fileHdl, int ndim, int *dim, int *gd
       ntot = ntot * dim[n];
     }
 
+    if(codec) {
+      WriteCompressed(fileHdl, dim, data);
+      return;
+    }
+
     // Write raw data
-    if(fwrite(data, sizeof(real), ntot, fileHdl) != ntot) {
+    if(haveAsyncWrite) {
+      // Raw data are written later on by StartAsyncWrite: leave room for them
+      asyncBlocks.push_back({data, ntot, ftell(fileHdl), descriptor});
+      fseek(fileHdl, ntot*sizeof(real), SEEK_CUR);
+    } else if(fwrite(data, sizeof(real), ntot, fileHdl) != ntot) {
       IDEFIX_ERROR("Unable to write to file. Check your filesystem permissions and disk quota.");
     }
   #endif
@@ -542,6 +591,13 @@ void Dump::Skip(IdfxFileHandler fileHdl, int ndim, int *dim,
   if(type == SingleType) size=sizeof(float);
   if(type == IntegerType) size=sizeof(int);
   if(type == BoolType) size=sizeof(bool);
+  if(type == CompressedType) {
+    // The size of compressed data is stored before them
+    int64_t payloadSize;
+    ReadRaw(fileHdl, &payloadSize, sizeof(int64_t));
+    ntot = payloadSize;
+    size = 1;
+  }
 
   #ifdef WITH_MPI
     offset+= ntot*size;
@@ -550,6 +606,172 @@ void Dump::Skip(IdfxFileHandler fileHdl, int ndim, int *dim,
   #endif
 }
 
+// Read raw bytes from the current position of the file, and share them with all processes
+void Dump::ReadRaw(IdfxFileHandler fileHdl, void *buffer, int64_t size) {
+  #ifdef WITH_MPI
+    MPI_Status status;
+    MPI_SAFE_CALL(MPI_File_set_view(fileHdl, this->offset, MPI_BYTE,
+                                    MPI_CHAR, "native", MPI_INFO_NULL ));
+    if(idfx::prank==0) {
+      MPI_SAFE_CALL(MPI_File_read(fileHdl, buffer, size, MPI_BYTE, &status));
+    }
+    offset += size;
+    MPI_SAFE_CALL(MPI_Bcast(buffer, size, MPI_BYTE, 0, MPI_COMM_WORLD));
+  #else
+    if(fread(buffer, 1, size, fileHdl) != size) {
+      IDEFIX_ERROR("Error: unexpected end of dump file");
+    }
+  #endif
+}
+
+// Write the data of a compressed field: each process compresses its own subdomain in a chunk.
+// The chunks are preceded by the size of what follows, the type of the reals, the codec, and
+// an index giving the start, size and compressed size of each chunk.
+void Dump::WriteCompressed(IdfxFileHandler fileHdl, int *dim, real *data) {
+  #ifndef SINGLE_PRECISION
+  const int realType = DoubleType;
+  #else
+  const int realType = SingleType;
+  #endif
+  const int64_t ntot = static_cast<int64_t>(dim[IDIR])*dim[JDIR]*dim[KDIR];
+  std::vector<uint8_t> chunk = codec->Compress(data, ntot);
+
+  constexpr int indexSize = 7;
+  int64_t myIndex[indexSize];
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    myIndex[dir] = this->data->gbeg[dir] - this->data->nghost[dir];
+    myIndex[3+dir] = dim[dir];
+  }
+  myIndex[6] = chunk.size();
+
+  #ifdef WITH_MPI
+    const int nchunks = idfx::psize;
+    std::vector<int64_t> index(indexSize*nchunks);
+    MPI_SAFE_CALL(MPI_Allgather(myIndex, indexSize, MPI_INT64_T,
+                                index.data(), indexSize, MPI_INT64_T, MPI_COMM_WORLD));
+  #else
+    const int nchunks = 1;
+    std::vector<int64_t> index(myIndex, myIndex+indexSize);
+  #endif
+
+  int64_t chunkOffset = 0;    // Position of our chunk in the chunks
+  int64_t chunksSize = 0;
+  for(int p = 0 ; p < nchunks ; p++) {
+    if(p < idfx::prank) chunkOffset += index[indexSize*p+6];
+    chunksSize += index[indexSize*p+6];
+  }
+  const int header[3] = {realType, codec->GetId(), nchunks};
+  const int64_t payloadSize = sizeof(header) + index.size()*sizeof(int64_t) + chunksSize;
+
+  std::vector<uint8_t> meta(sizeof(int64_t) + sizeof(header) + index.size()*sizeof(int64_t));
+  std::memcpy(meta.data(), &payloadSize, sizeof(int64_t));
+  std::memcpy(meta.data() + sizeof(int64_t), header, sizeof(header));
+  std::memcpy(meta.data() + sizeof(int64_t) + sizeof(header), index.data(),
+              index.size()*sizeof(int64_t));
+
+  #ifdef WITH_MPI
+    MPI_Status status;
+    if(chunk.size() > std::numeric_limits<int>::max()) {
+      IDEFIX_ERROR("Compressed chunk is too large for MPI I/O, use more processes");
+    }
+    MPI_SAFE_CALL(MPI_File_set_view(fileHdl, offset, MPI_BYTE,
+                                    MPI_CHAR, "native", MPI_INFO_NULL ));
+    if(idfx::prank==0) {
+      MPI_SAFE_CALL(MPI_File_write(fileHdl, meta.data(), meta.size(), MPI_BYTE, &status));
+    }
+    offset += meta.size();
+    MPI_SAFE_CALL(MPI_File_set_view(fileHdl, offset, MPI_BYTE,
+                                    MPI_BYTE, "native", MPI_INFO_NULL ));
+    MPI_SAFE_CALL(MPI_File_write_at_all(fileHdl, chunkOffset, chunk.data(), chunk.size(),
+                                        MPI_BYTE, MPI_STATUS_IGNORE));
+    offset += chunksSize;
+  #else
+    if(fwrite(meta.data(), 1, meta.size(), fileHdl) != meta.size() ||
+       fwrite(chunk.data(), 1, chunk.size(), fileHdl) != chunk.size()) {
+      IDEFIX_ERROR("Unable to write to file. Check your filesystem permissions and disk quota.");
+    }
+  #endif
+}
+
+// Read the part of a compressed field which lies in box. The chunks may come from a
+// different domain decomposition.
+void Dump::ReadCompressed(IdfxFileHandler fileHdl, const GridBox &box, real *data) {
+  #ifndef SINGLE_PRECISION
+  const int realType = DoubleType;
+  #else
+  const int realType = SingleType;
+  #endif
+  constexpr int indexSize = 7;
+
+  int64_t payloadSize;
+  int header[3];
+  ReadRaw(fileHdl, &payloadSize, sizeof(int64_t));
+  ReadRaw(fileHdl, header, sizeof(header));
+  if(header[0] != realType) {
+    IDEFIX_ERROR("Compressed dumps can only be read with the precision they were written with");
+  }
+  std::unique_ptr<Codec> chunkCodec = Codec::Create(static_cast<Codec::Id>(header[1]));
+  const int nchunks = header[2];
+  std::vector<int64_t> index(indexSize*nchunks);
+  ReadRaw(fileHdl, index.data(), index.size()*sizeof(int64_t));
+
+  #ifdef WITH_MPI
+    const MPI_Offset chunksStart = offset;
+    MPI_SAFE_CALL(MPI_File_set_view(fileHdl, 0, MPI_BYTE,
+                                    MPI_BYTE, "native", MPI_INFO_NULL ));
+  #else
+    const int64_t chunksStart = ftell(fileHdl);
+  #endif
+
+  std::vector<uint8_t> chunk;
+  std::vector<real> chunkData;
+  int64_t chunkOffset = 0;
+  for(int c = 0 ; c < nchunks ; c++) {
+    const int64_t *cstart = &index[indexSize*c];
+    const int64_t *csize = &index[indexSize*c+3];
+    const int64_t cbytes = index[indexSize*c+6];
+    // Overlap between the chunk and our box
+    int64_t lo[3], hi[3];
+    bool overlap = true;
+    for(int dir = 0 ; dir < 3 ; dir++) {
+      lo[dir] = std::max<int64_t>(box.start[dir], cstart[dir]);
+      hi[dir] = std::min<int64_t>(box.start[dir] + box.size[dir], cstart[dir] + csize[dir]);
+      if(hi[dir] <= lo[dir]) overlap = false;
+    }
+    if(overlap) {
+      chunk.resize(cbytes);
+      #ifdef WITH_MPI
+        MPI_SAFE_CALL(MPI_File_read_at(fileHdl, chunksStart + chunkOffset, chunk.data(), cbytes,
+                                       MPI_BYTE, MPI_STATUS_IGNORE));
+      #else
+        fseek(fileHdl, chunksStart + chunkOffset, SEEK_SET);
+        if(fread(chunk.data(), 1, cbytes, fileHdl) != cbytes) {
+          IDEFIX_ERROR("Error: unexpected end of dump file");
+        }
+      #endif
+      chunkData.resize(csize[IDIR]*csize[JDIR]*csize[KDIR]);
+      chunkCodec->Decompress(chunk.data(), cbytes, chunkData.data(), chunkData.size());
+      for(int64_t k = lo[KDIR] ; k < hi[KDIR] ; k++) {
+        for(int64_t j = lo[JDIR] ; j < hi[JDIR] ; j++) {
+          for(int64_t i = lo[IDIR] ; i < hi[IDIR] ; i++) {
+            data[(i-box.start[IDIR]) + (j-box.start[JDIR])*box.size[IDIR]
+                  + (k-box.start[KDIR])*box.size[IDIR]*box.size[JDIR]] =
+              chunkData[(i-cstart[IDIR]) + (j-cstart[JDIR])*csize[IDIR]
+                        + (k-cstart[KDIR])*csize[IDIR]*csize[JDIR]];
+          }
+        }
+      }
+    }
+    chunkOffset += cbytes;
+  }
+
+  #ifdef WITH_MPI
+    offset = chunksStart + chunkOffset;
+  #else
+    fseek(fileHdl, chunksStart + chunkOffset, SEEK_SET);
+  #endif
+}
+
 void Dump::ReadDistributed(IdfxFileHandler fileHdl, int ndim, int *dim, int *gdim,
                                  IdfxDataDescriptor &descriptor, void* data) {
   int64_t ntot=1;
@@ -637,6 +859,9 @@ bool Dump::Read(Output& output, int readNumber ) {
 
   idfx::pushRegion("Dump::Read");
 
+  // We may be reading the dump we are writing
+  WaitForWrite();
+
   fs::path readDir = this->outputDirectory;
 
   if(readNumber<0) {
@@ -748,7 +973,15 @@ bool Dump::Read(Output& output, int readNumber ) {
               if(i!=direction) nx[i] ++;
             }
           }
-          if(scalar.GetLocation() == DumpField::ArrayLocation::Center) {
+          if(type == CompressedType) {
+            GridBox box;
+            for(int dir = 0 ; dir < 3; dir++) {
+              box.start[dir] = data->gbeg[dir] - data->nghost[dir];
+              box.size[dir] = nx[dir];
+              box.sizeGlob[dir] = nxglob[dir];
+            }
+            ReadCompressed(fileHdl, box, scrch);
+          } else if(scalar.GetLocation() == DumpField::ArrayLocation::Center) {
             ReadDistributed(fileHdl, ndim, nx, nxglob, descCR, scrch);
           } else if(scalar.GetLocation() == DumpField::ArrayLocation::Face) {
             ReadDistributed(fileHdl, ndim, nx, nxglob, descSR[direction], scrch);
@@ -808,6 +1041,143 @@ bool Dump::Read(Output& output, int readNumber ) {
   return(true);
 }
 
+// The distributed fields are sent to the processes which hold them in the new domain
+// decomposition, without going through a file. Both dump objects should belong to the same grid.
+void Dump::Redistribute(Dump &source) {
+  idfx::pushRegion("Dump::Redistribute");
+  timer.reset();
+
+  // First active cell and number of active cells of each process, in the source domain
+  // decomposition (box 0) and in ours (box 1)
+  const int boxSize = 12;
+  std::vector<int> boxes(boxSize*idfx::psize);
+  int myBoxes[boxSize];
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    myBoxes[dir] = source.data->gbeg[dir] - source.data->nghost[dir];
+    myBoxes[3+dir] = source.data->np_int[dir];
+    myBoxes[6+dir] = data->gbeg[dir] - data->nghost[dir];
+    myBoxes[9+dir] = data->np_int[dir];
+  }
+  #ifdef WITH_MPI
+  MPI_SAFE_CALL(MPI_Allgather(myBoxes, boxSize, MPI_INT, boxes.data(), boxSize, MPI_INT,
+                              MPI_COMM_WORLD));
+  #else
+  std::copy(myBoxes, myBoxes+boxSize, boxes.begin());
+  #endif
+
+  // Range of the field held in the box of a process. The faces shared by two processes
+  // are sent by the left one only, but every process needs all of its faces.
+  auto range = [&](const DumpField &field, int proc, int box, int dir, bool needed,
+                   int &begin, int &end) {
+    begin = boxes[boxSize*proc + 6*box + dir];
+    end = begin + boxes[boxSize*proc + 6*box + 3 + dir];
+    const int fieldDir = field.GetDirection();
+    const bool staggered =
+          (field.GetLocation() == DumpField::ArrayLocation::Face && dir == fieldDir)
+       || (field.GetLocation() == DumpField::ArrayLocation::Edge && dir != fieldDir
+                                                                 && dir < DIMENSIONS);
+    if(staggered && (needed || end == data->mygrid->np_int[dir])) end++;
+  };
+  // Number of elements shared by the source box of a process and our box of another one
+  auto overlap = [&](const DumpField &field, int from, int to,
+                     std::array<int,3> &begin, std::array<int,3> &end) {
+    int64_t size = 1;
+    for(int dir = 0 ; dir < 3 ; dir++) {
+      int fromBegin, fromEnd, toBegin, toEnd;
+      range(field, from, 0, dir, false, fromBegin, fromEnd);
+      range(field, to, 1, dir, true, toBegin, toEnd);
+      begin[dir] = std::max(fromBegin, toBegin);
+      end[dir] = std::min(fromEnd, toEnd);
+      size *= std::max(end[dir]-begin[dir], 0);
+    }
+    return(size);
+  };
+
+  std::vector<int> sendCount(idfx::psize), sendDispl(idfx::psize);
+  std::vector<int> recvCount(idfx::psize), recvDispl(idfx::psize);
+  std::vector<real> sendBuffer, recvBuffer;
+  std::array<int,3> begin, end;
+
+  for(auto &[name, field] : dumpFieldMap) {
+    auto it = source.dumpFieldMap.find(name);
+    if(it == source.dumpFieldMap.end()) {
+      IDEFIX_WARNING("Cannot find "+name+" in the previous domain decomposition. Skipping.");
+      continue;
+    }
+    const DumpField &sourceField = it->second;
+    if(field.GetType() != DumpField::Type::IdefixArray) {
+      // Fundamental type, identical on all of the processes
+      size_t size = field.GetSize();
+      if(field.GetType() == DumpField::Type::Int) size *= sizeof(int);
+      if(field.GetType() == DumpField::Type::Single) size *= sizeof(float);
+      if(field.GetType() == DumpField::Type::Double) size *= sizeof(double);
+      if(field.GetType() == DumpField::Type::Bool) size *= sizeof(bool);
+      if(sourceField.GetType() != field.GetType() || sourceField.GetSize() != field.GetSize()) {
+        IDEFIX_ERROR("Size of field "+name+" do not match");
+      }
+      std::memcpy(field.GetHostField<void*>(), sourceField.GetHostField<void*>(), size);
+      continue;
+    }
+
+    // Distributed field
+    auto fromArray = sourceField.GetHostField<IdefixHostArray3D<real>>();
+    auto toArray = field.GetHostField<IdefixHostArray3D<real>>();
+    sendBuffer.clear();
+    for(int p = 0 ; p < idfx::psize ; p++) {
+      sendDispl[p] = sendBuffer.size();
+      sendCount[p] = static_cast<int>(overlap(field, idfx::prank, p, begin, end));
+      if(sendCount[p] == 0) continue;
+      for(int k = begin[KDIR] ; k < end[KDIR] ; k++) {
+        for(int j = begin[JDIR] ; j < end[JDIR] ; j++) {
+          for(int i = begin[IDIR] ; i < end[IDIR] ; i++) {
+            sendBuffer.push_back(fromArray(k - myBoxes[KDIR] + source.data->beg[KDIR],
+                                           j - myBoxes[JDIR] + source.data->beg[JDIR],
+                                           i - myBoxes[IDIR] + source.data->beg[IDIR]));
+          }
+        }
+      }
+    }
+    int recvSize = 0;
+    for(int p = 0 ; p < idfx::psize ; p++) {
+      recvDispl[p] = recvSize;
+      recvCount[p] = static_cast<int>(overlap(field, p, idfx::prank, begin, end));
+      recvSize += recvCount[p];
+    }
+    recvBuffer.resize(recvSize);
+    #ifdef WITH_MPI
+    MPI_SAFE_CALL(MPI_Alltoallv(sendBuffer.data(), sendCount.data(), sendDispl.data(), realMPI,
+                                recvBuffer.data(), recvCount.data(), recvDispl.data(), realMPI,
+                                MPI_COMM_WORLD));
+    #else
+    recvBuffer = sendBuffer;
+    #endif
+    for(int p = 0 ; p < idfx::psize ; p++) {
+      if(recvCount[p] == 0) continue;
+      overlap(field, p, idfx::prank, begin, end);
+      int n = recvDispl[p];
+      for(int k = begin[KDIR] ; k < end[KDIR] ; k++) {
+        for(int j = begin[JDIR] ; j < end[JDIR] ; j++) {
+          for(int i = begin[IDIR] ; i < end[IDIR] ; i++) {
+            toArray(k - myBoxes[6+KDIR] + data->beg[KDIR],
+                    j - myBoxes[6+JDIR] + data->beg[JDIR],
+                    i - myBoxes[6+IDIR] + data->beg[IDIR]) = recvBuffer[n++];
+          }
+        }
+      }
+    }
+    field.SyncFrom(toArray);
+  }
+
+  for(auto const &[name, sourceField] : source.dumpFieldMap) {
+    if(dumpFieldMap.count(name) == 0) {
+      IDEFIX_WARNING(name+" is not registered in the new domain decomposition. Skipping.");
+    }
+  }
+
+  idfx::cout << "Dump: redistributed the current state in " << timer.seconds() << " s."
+             << std::endl;
+  idfx::popRegion();
+}
 
 int Dump::Write(Output& output) {
   fs::path filename;
@@ -824,6 +1194,9 @@ int Dump::Write(Output& output) {
 
   idfx::pushRegion("Dump::Write");
 
+  // The staging buffers can only be reused once the previous write is complete
+  WaitForWrite();
+
   idfx::cout << "Dump: Write file n " << dumpFileNumber << "..." << std::flush;
 
   // Reset timer
@@ -929,23 +1302,29 @@ int Dump::Write(Output& output) {
         }
       }
 
-      // Load the dataset in the scratch array
+      // Load the dataset in the scratch array, or in the staging buffer of this field when the
+      // write is asynchronous
+      real *buffer = scrch;
+      if(haveAsyncWrite) {
+        asyncBuffer[name].resize(nx[IDIR]*nx[JDIR]*nx[KDIR]);
+        buffer = asyncBuffer[name].data();
+      }
       for(int k = 0; k < nx[KDIR]; k++) {
         for(int j = 0 ; j < nx[JDIR]; j++) {
           for(int i = 0; i < nx[IDIR]; i++) {
-            scrch[i + j*nx[IDIR] + k*nx[IDIR]*nx[JDIR]] = toWrite(k+data->beg[KDIR],
-                                                                  j+data->beg[JDIR],
-                                                                  i+data->beg[IDIR]);
+            buffer[i + j*nx[IDIR] + k*nx[IDIR]*nx[JDIR]] = toWrite(k+data->beg[KDIR],
+                                                                   j+data->beg[JDIR],
+                                                                   i+data->beg[IDIR]);
           }
         }
       }
 
       if(scalar.GetLocation() == DumpField::ArrayLocation::Center) {
-        WriteDistributed(fileHdl, 3, nx, nxtot, fieldName, this->descCW, scrch);
+        WriteDistributed(fileHdl, 3, nx, nxtot, fieldName, this->descCW, buffer);
       } else if(scalar.GetLocation() == DumpField::ArrayLocation::Face) {
-        WriteDistributed(fileHdl, 3, nx, nxtot, fieldName, this->descSW[dir], scrch);
+        WriteDistributed(fileHdl, 3, nx, nxtot, fieldName, this->descSW[dir], buffer);
       } else if(scalar.GetLocation() == DumpField::ArrayLocation::Edge) {
-         WriteDistributed(fileHdl, 3, nx, nxtot, fieldName, this->descEW[dir], scrch);
+         WriteDistributed(fileHdl, 3, nx, nxtot, fieldName, this->descEW[dir], buffer);
       } else {
         IDEFIX_ERROR("Unknown scalar type for dump write");
       }
@@ -970,6 +1349,15 @@ int Dump::Write(Output& output) {
   nx[0] = 1;
   WriteSerial(fileHdl, 1, nx, realType, fieldName, scrch);
 
+  if(haveAsyncWrite) {
+    asyncFilename = filename;
+    StartAsyncWrite(fileHdl);
+    idfx::cout << "staged in " << timer.seconds() << " s, writing in the background."
+               << std::endl;
+    idfx::popRegion();
+    return(0);
+  }
+
 #ifdef WITH_MPI
   MPI_SAFE_CALL(MPI_File_close(&fileHdl));
 #else
@@ -983,3 +1371,80 @@ int Dump::Write(Output& output) {
 
   return(0);
 }
+
+// Write the staged distributed fields of the current dump, without waiting for completion
+void Dump::StartAsyncWrite(IdfxFileHandler fileHdl) {
+  idfx::pushRegion("Dump::StartAsyncWrite");
+  asyncFileHdl = fileHdl;
+  asyncWritePending = true;
+  asyncWriteFailed = false;
+  #ifdef WITH_MPI
+    // All of the fields are written with a single non-blocking collective call, using a file view
+    // which gathers the descriptors of all of the fields at their position in the file
+    const int nblocks = asyncBlocks.size();
+    std::vector<int> fileLength(nblocks, 1);
+    std::vector<MPI_Aint> fileDispl(nblocks);
+    std::vector<MPI_Datatype> fileType(nblocks);
+    std::vector<int> memLength(nblocks);
+    std::vector<MPI_Aint> memDispl(nblocks);
+    std::vector<MPI_Datatype> memType(nblocks, realMPI);
+    for(int n = 0 ; n < nblocks ; n++) {
+      fileDispl[n] = asyncBlocks[n].fileOffset;
+      fileType[n] = asyncBlocks[n].descriptor;
+      memLength[n] = asyncBlocks[n].size;
+      MPI_SAFE_CALL(MPI_Get_address(asyncBlocks[n].data, &memDispl[n]));
+    }
+    MPI_SAFE_CALL(MPI_Type_create_struct(nblocks, fileLength.data(), fileDispl.data(),
+                                         fileType.data(), &asyncFileType));
+    MPI_SAFE_CALL(MPI_Type_commit(&asyncFileType));
+    MPI_SAFE_CALL(MPI_Type_create_struct(nblocks, memLength.data(), memDispl.data(),
+                                         memType.data(), &asyncMemType));
+    MPI_SAFE_CALL(MPI_Type_commit(&asyncMemType));
+
+    MPI_SAFE_CALL(MPI_File_set_view(asyncFileHdl, 0, realMPI, asyncFileType,
+                                    "native", MPI_INFO_NULL ));
+    MPI_SAFE_CALL(MPI_File_iwrite_all(asyncFileHdl, MPI_BOTTOM, 1, asyncMemType, &asyncRequest));
+  #else
+    // Without MPI, the fields are written by a dedicated thread
+    asyncThread = std::thread([this]() {
+      for(auto const &block : asyncBlocks) {
+        if(fseek(asyncFileHdl, block.fileOffset, SEEK_SET) != 0 ||
+           fwrite(block.data, sizeof(real), block.size, asyncFileHdl) != block.size) {
+          asyncWriteFailed = true;
+          return;
+        }
+      }
+    });
+  #endif
+  idfx::popRegion();
+}
+
+void Dump::WaitForWrite() {
+  if(!asyncWritePending) return;
+  idfx::pushRegion("Dump::WaitForWrite");
+  if(!CompleteAsyncWrite()) {
+    std::stringstream msg;
+    msg << "Unable to write " << asyncFilename
+        << ". Check your filesystem permissions and disk quota.";
+    IDEFIX_ERROR(msg);
+  }
+  idfx::popRegion();
+}
+
+// Complete the write in progress without raising any error, so that it can be called from the
+// destructor
+bool Dump::CompleteAsyncWrite() {
+  if(!asyncWritePending) return(true);
+  #ifdef WITH_MPI
+    if(MPI_Wait(&asyncRequest, MPI_STATUS_IGNORE) != MPI_SUCCESS) asyncWriteFailed = true;
+    if(MPI_File_close(&asyncFileHdl) != MPI_SUCCESS) asyncWriteFailed = true;
+    MPI_Type_free(&asyncFileType);
+    MPI_Type_free(&asyncMemType);
+  #else
+    asyncThread.join();
+    if(fclose(asyncFileHdl) != 0) asyncWriteFailed = true;
+  #endif
+  asyncWritePending = false;
+  asyncBlocks.clear();
+  return(!asyncWriteFailed);
+}
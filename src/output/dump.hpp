@@ -9,7 +9,12 @@
 #define OUTPUT_DUMP_HPP_
 #include <string>
 #include <map>
+#include <memory>
 #include <array>
+#include <vector>
+#ifndef WITH_MPI
+#include <thread>
+#endif
 #if __has_include(<filesystem>)
   #include <filesystem> // NOLINT [build/c++17]
   namespace fs = std::filesystem;
@@ -22,9 +27,11 @@
 #include "idefix.hpp"
 #include "input.hpp"
 #include "dataBlock.hpp"
+#include "codec.hpp"
 
 
-enum DataType {DoubleType, SingleType, IntegerType, BoolType};
+// Compressed arrays of reals are stored as a set of chunks (one per MPI process when written)
+enum DataType {DoubleType, SingleType, IntegerType, BoolType, CompressedType};
 
 // Define data descriptor used for distributed I/O when MPI is enabled
 #ifdef WITH_MPI
@@ -42,7 +49,7 @@ class DataBlock;
 class DumpField {
  public:
   enum Type {Int, Single, Double, Bool, IdefixArray};
-  enum ArrayType {Device3D, Device4D, Host3D, Host4D};
+  enum ArrayType {Device3D, Device4D, Host3D, Host4D, Device4DAccum};
   enum ArrayLocation {Center, Face, Edge};
 
   DumpField(IdefixArray4D<real>& in, const int varnum, const ArrayLocation loc, const int dir):
@@ -53,6 +60,13 @@ class DumpField {
     h4Darray{in}, var{varnum}, arrayType{Host4D},
     type{IdefixArray}, arrayLocation{loc}, direction{dir} {};
 
+  #ifdef MIXED_PRECISION
+  // The evolved state is stored in double precision, and rounded to real in dumps
+  DumpField(IdefixArray4D<accum>& in, const int varnum, const ArrayLocation loc, const int dir):
+    d4Daccum{in}, var{varnum}, arrayType{Device4DAccum},
+    type{IdefixArray}, arrayLocation{loc}, direction{dir} {};
+  #endif
+
   DumpField(IdefixArray3D<real>& in, const ArrayLocation loc, const int dir):
     d3Darray{in}, arrayType{Device3D},
     type{IdefixArray}, arrayLocation{loc}, direction{dir} {};
@@ -97,6 +111,17 @@ class DumpField {
         IdefixHostArray3D<real> arr3D = Kokkos::create_mirror(arrDev3D);
         Kokkos::deep_copy(arr3D,arrDev3D);
         return(arr3D);
+      } else if(arrayType==Device4DAccum) {
+        IdefixArray3D<accum> arrDev3D = Kokkos::subview(
+                                        d4Daccum, var, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
+        IdefixHostArray3D<accum> accum3D = Kokkos::create_mirror(arrDev3D);
+        Kokkos::deep_copy(accum3D,arrDev3D);
+        IdefixHostArray3D<real> arr3D("DumpFieldHost", accum3D.extent(0), accum3D.extent(1),
+                                                       accum3D.extent(2));
+        for(size_t n = 0 ; n < accum3D.size() ; n++) {
+          arr3D.data()[n] = static_cast<real>(accum3D.data()[n]);
+        }
+        return(arr3D);
       } else {
         IDEFIX_ERROR("unknown field");
         return(h3Darray);
@@ -123,6 +148,12 @@ class DumpField {
         IdefixArray3D<real> arrDev3D = Kokkos::subview(
                                        d4Darray, var, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
         Kokkos::deep_copy(arrDev3D,in);
+      } else if(arrayType==Device4DAccum) {
+        IdefixArray3D<accum> arrDev3D = Kokkos::subview(
+                                        d4Daccum, var, Kokkos::ALL, Kokkos::ALL, Kokkos::ALL);
+        IdefixHostArray3D<accum> accum3D = Kokkos::create_mirror(arrDev3D);
+        for(size_t n = 0 ; n < accum3D.size() ; n++) accum3D.data()[n] = in.data()[n];
+        Kokkos::deep_copy(arrDev3D,accum3D);
       }
     }
     // Nothing to sync otherwise
@@ -155,6 +186,7 @@ class DumpField {
   IdefixArray3D<real> d3Darray;
   IdefixHostArray4D<real> h4Darray;
   IdefixHostArray3D<real> h3Darray;
+  IdefixArray4D<accum> d4Daccum;
 
   void *rawData;
   int rawSize;
@@ -183,6 +215,10 @@ class Dump {
   int Write(Output&);
   // Read and load a dump file as current state of the code
   bool Read(Output&, int);
+  // Load the state registered in the dump object of another domain decomposition
+  void Redistribute(Dump &);
+  // Wait for the completion of an asynchronous write
+  void WaitForWrite();
 
   // Register IdefixArrays
   void RegisterVariable(IdefixArray3D<real>&,
@@ -207,6 +243,14 @@ class Dump {
                         int dir = -1,
                         DumpField::ArrayLocation loc = DumpField::ArrayLocation::Center );
 
+  #ifdef MIXED_PRECISION
+  void RegisterVariable(IdefixArray4D<accum>&,
+                        std::string,
+                        int varnum,
+                        int dir = -1,
+                        DumpField::ArrayLocation loc = DumpField::ArrayLocation::Center );
+  #endif
+
   // Register any other fundamental type
   template<typename T>
   void RegisterVariable(T*,
@@ -247,10 +291,39 @@ class Dump {
   void ReadSerial(IdfxFileHandler, int, int*, DataType, void*);
   void ReadDistributed(IdfxFileHandler, int, int*, int*, IdfxDataDescriptor&, void*);
   void Skip(IdfxFileHandler, int, int *, DataType);
+  void ReadRaw(IdfxFileHandler, void *, int64_t);
+  void WriteCompressed(IdfxFileHandler, int*, real*);
+  void ReadCompressed(IdfxFileHandler, const GridBox &, real*);
   int GetLastDumpInDirectory(fs::path &);
   void CreateMPIDataType(GridBox, bool);
 
   fs::path outputDirectory;
+  std::unique_ptr<Codec> codec;    // Codec of distributed fields (uncompressed when null)
+
+  // Asynchronous writes: distributed fields are staged on the host, and written while
+  // the integration proceeds
+  struct AsyncBlock {
+    real *data;                   // Staged data of the process
+    int64_t size;                 // # of elements staged by the process
+    int64_t fileOffset;           // Position of the field data in the file
+    IdfxDataDescriptor descriptor;  // Descriptor of the field in the file
+  };
+  bool haveAsyncWrite{false};     // Whether dumps are written asynchronously
+  bool asyncWritePending{false};  // Whether an asynchronous write is in progress
+  bool asyncWriteFailed{false};   // Whether the last asynchronous write failed
+  std::map<std::string, std::vector<real>> asyncBuffer;  // Host staging buffers
+  std::vector<AsyncBlock> asyncBlocks;  // Blocks of the write in progress
+  IdfxFileHandler asyncFileHdl;
+  fs::path asyncFilename;
+#ifdef WITH_MPI
+  MPI_Request asyncRequest;
+  MPI_Datatype asyncFileType;
+  MPI_Datatype asyncMemType;
+#else
+  std::thread asyncThread;
+#endif
+  void StartAsyncWrite(IdfxFileHandler);
+  bool CompleteAsyncWrite();      // Wait for the write in progress, false when it failed
 };
 
 
@@ -75,6 +75,16 @@ Output::Output(Input &input, DataBlock &data) {
     analysisEnabled = true;
   }
 
+  // initialise time series of in-situ reductions
+  if(input.CheckEntry("Output","tseries")>0) {
+    tseriesPeriod = input.Get<real>("Output","tseries",0);
+    if(tseriesPeriod>=0.0) {
+      tseriesLast = data.t - tseriesPeriod; // write something in the next CheckForWrite()
+      tseries = std::make_unique<TimeSeries>(input, data);
+      tseriesEnabled = true;
+    }
+  }
+
   // Initialise userdefined outputs
   if(input.CheckEntry("Output","uservar")>0) {
     int nvars = input.CheckEntry("Output","uservar");
@@ -119,6 +129,7 @@ Output::Output(Input &input, DataBlock &data) {
   // Register variables that are needed in restart dumps
   data.dump->RegisterVariable(&dumpLast, "dumpLast");
   data.dump->RegisterVariable(&analysisLast, "analysisLast");
+  data.dump->RegisterVariable(&tseriesLast, "tseriesLast");
   data.dump->RegisterVariable(&vtkLast, "vtkLast");
   #ifdef WITH_HDF5
   data.dump->RegisterVariable(&xdmfLast, "xdmfLast");
@@ -223,6 +234,25 @@ int Output::CheckForWrites(DataBlock &data) {
     }
   }
 
+  // Do we need a time series output?
+  if(tseriesEnabled) {
+    if(data.t >= tseriesLast + tseriesPeriod) {
+      elapsedTime -= timer.seconds();
+      tseriesLast += tseriesPeriod;
+      tseries->Write(data);
+      nfiles++;
+      elapsedTime += timer.seconds();
+
+      // Check if our next predicted output should already have happened
+      if((tseriesLast+tseriesPeriod <= data.t) && tseriesPeriod>0.0) {
+        // Move forward tseriesLast
+        while(tseriesLast <= data.t - tseriesPeriod) {
+          tseriesLast += tseriesPeriod;
+        }
+      }
+    }
+  }
+
   if(haveSlices) {
     for(int i = 0 ; i < slices.size() ; i++) {
       slices[i]->CheckForWrite(data);
@@ -276,7 +306,10 @@ bool Output::RestartFromDump(DataBlock &data, int readNumber) {
   idfx::pushRegion("Output::RestartFromDump");
 
   bool result = data.dump->Read(*this, readNumber);
-  if(result) data.DeriveVectorPotential();
+  if(result) {
+    data.DeriveVectorPotential();
+    if(tseriesEnabled) tseries->Truncate(data.t);
+  }
 
   idfx::popRegion();
   return(result);
@@ -20,6 +20,7 @@
 #endif
 #include "dump.hpp"
 #include "slice.hpp"
+#include "timeSeries.hpp"
 
 using AnalysisFunc = void (*) (DataBlock &);
 
@@ -68,6 +69,11 @@ class Output {
   real analysisPeriod = 0.0;
   real analysisLast = 0.0;
 
+  bool tseriesEnabled = false;
+  real tseriesPeriod = 0.0;
+  real tseriesLast = 0.0;
+  std::unique_ptr<TimeSeries> tseries;
+
   bool haveAnalysisFunc = false;
   AnalysisFunc analysisFunc;
 
@@ -0,0 +1,42 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <sstream>
+#include <string>
+#include "quantizer.hpp"
+
+Quantizer::Quantizer(Input &input) {
+  // Entries are of the form VAR or VAR:bits, with bits=8 or 16 (default)
+  const int nentries = input.CheckEntry("Output","quantize");
+  for(int n = 0 ; n < nentries ; n++) {
+    std::string entry = input.Get<std::string>("Output","quantize",n);
+    std::string name = entry;
+    int nbits = 16;
+    const size_t sep = entry.find(':');
+    if(sep != std::string::npos) {
+      name = entry.substr(0, sep);
+      try {
+        nbits = std::stoi(entry.substr(sep+1));
+      } catch(std::exception &e) {
+        nbits = -1;
+      }
+    }
+    if(nbits != 8 && nbits != 16) {
+      std::stringstream msg;
+      msg << "Invalid entry " << entry << " in [Output] quantize." << std::endl
+          << "Variables can only be quantized on 8 or 16 bits (e.g. RHO:8).";
+      IDEFIX_ERROR(msg);
+    }
+    bits[name] = nbits;
+  }
+}
+
+int Quantizer::GetBits(const std::string &name) const {
+  auto it = bits.find(name);
+  if(it == bits.end()) return(0);
+  return(it->second);
+}
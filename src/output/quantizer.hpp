@@ -0,0 +1,90 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef OUTPUT_QUANTIZER_HPP_
+#define OUTPUT_QUANTIZER_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <string>
+#include "idefix.hpp"
+#include "input.hpp"
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+/// The Quantizer reduces the precision of the visualisation outputs (vtk, xdmf and slices). The
+/// variables listed in [Output] quantize are stored as 8 or 16 bits unsigned integers q, and the
+/// physical value is recovered as offset + scale*q, where offset and scale are computed from the
+/// global extrema of each field and stored alongside it.
+//////////////////////////////////////////////////////////////////////////////////////////////////
+class Quantizer {
+ public:
+  explicit Quantizer(Input &);
+
+  #ifdef WITH_MPI
+  void SetCommunicator(MPI_Comm comm) { this->comm = comm; }
+  #endif
+
+  // Number of bits used to store a variable, 0 when it is kept in floating point
+  int GetBits(const std::string &) const;
+  bool IsEnabled() const { return(!bits.empty()); }
+
+  // Compute the offset and scale of n values distributed over the communicator
+  template <typename T>
+  void Range(const T *, int64_t n, int bits, double &offset, double &scale);
+
+  // Quantize n values with a given offset and scale
+  template <typename T, typename Q>
+  static void Encode(const T *, int64_t n, Q *, double offset, double scale);
+
+ private:
+  std::map<std::string, int> bits;
+
+  #ifdef WITH_MPI
+  MPI_Comm comm{MPI_COMM_WORLD};
+  #endif
+};
+
+template <typename T>
+void Quantizer::Range(const T *in, int64_t n, int nbits, double &offset, double &scale) {
+  double extrema[2] = {std::numeric_limits<double>::max(),
+                       std::numeric_limits<double>::max()};
+  for(int64_t i = 0 ; i < n ; i++) {
+    const double v = static_cast<double>(in[i]);
+    if(!std::isfinite(v)) continue;
+    extrema[0] = std::fmin(extrema[0], v);
+    extrema[1] = std::fmin(extrema[1], -v);
+  }
+  #ifdef WITH_MPI
+  MPI_Allreduce(MPI_IN_PLACE, extrema, 2, MPI_DOUBLE, MPI_MIN, comm);
+  #endif
+  const double vmin = extrema[0];
+  const double vmax = -extrema[1];
+  if(vmax < vmin) {
+    // No finite value at all
+    offset = 0;
+    scale = 1;
+    return;
+  }
+  offset = vmin;
+  scale = (vmax - vmin) / static_cast<double>((1 << nbits) - 1);
+  if(scale <= 0) scale = 1;
+}
+
+template <typename T, typename Q>
+void Quantizer::Encode(const T *in, int64_t n, Q *out, double offset, double scale) {
+  const double qmax = static_cast<double>(std::numeric_limits<Q>::max());
+  for(int64_t i = 0 ; i < n ; i++) {
+    double q = std::round((static_cast<double>(in[i]) - offset) / scale);
+    // Non-finite values are mapped to 0
+    if(!std::isfinite(q)) q = 0;
+    out[i] = static_cast<Q>(std::fmin(std::fmax(q, 0.0), qmax));
+  }
+}
+
+#endif // OUTPUT_QUANTIZER_HPP_
@@ -0,0 +1,429 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "timeSeries.hpp"
+#include "version.hpp"
+#include "dataBlock.hpp"
+#include "fluid.hpp"
+#include "gridHost.hpp"
+
+TimeSeries::TimeSeries(Input &input, DataBlock &data) {
+  idfx::pushRegion("TimeSeries::TimeSeries");
+  filename = input.GetOrSet<std::string>("Output","tseries_file",0,"timeseries.dat");
+
+  GridHost grid(*data.mygrid);
+  grid.SyncFromDevice();
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    // Keep the coordinates of the active cells only
+    x[dir] = IdefixArray1D<real>::HostMirror("TimeSeriesX", grid.np_int[dir]);
+    for(int i = 0 ; i < grid.np_int[dir] ; i++) {
+      x[dir](i) = grid.x[dir](i + grid.nghost[dir]);
+    }
+    np_int[dir] = grid.np_int[dir];
+  }
+
+  // Parse the reductions, in the form tseriesN type variable [parameters]
+  const std::vector<std::string> &names = data.hydro->VcName;
+  int n = 1;
+  while(input.CheckEntry("Output","tseries"+std::to_string(n))>0) {
+    const std::string entry = "tseries"+std::to_string(n);
+    const std::string typeStr = input.Get<std::string>("Output",entry,0);
+    Reduction red;
+    red.varName = input.Get<std::string>("Output",entry,1);
+    auto it = std::find(names.begin(), names.end(), red.varName);
+    if(it == names.end()) {
+      IDEFIX_ERROR("Unknown variable "+red.varName+" in [Output] "+entry);
+    }
+    red.var = static_cast<int>(it - names.begin());
+
+    if(typeStr.compare("sum") == 0) {
+      red.type = Type::sum;
+      red.columns.push_back("sum("+red.varName+")");
+    } else if(typeStr.compare("mean") == 0) {
+      red.type = Type::mean;
+      red.columns.push_back("mean("+red.varName+")");
+    } else if(typeStr.compare("min") == 0 || typeStr.compare("max") == 0) {
+      red.type = typeStr.compare("min") == 0 ? Type::min : Type::max;
+      const std::string col = typeStr+"("+red.varName+")";
+      red.columns.push_back(col);
+      red.columns.push_back(col+"_x1");
+      red.columns.push_back(col+"_x2");
+      red.columns.push_back(col+"_x3");
+    } else if(typeStr.compare("profile") == 0) {
+      red.type = Type::profile;
+      red.dir = input.Get<int>("Output",entry,2);
+      if(red.dir < 0 || red.dir >= DIMENSIONS) {
+        IDEFIX_ERROR("Invalid direction for the profile of [Output] "+entry);
+      }
+      const std::string col = "profile("+red.varName+",x"+std::to_string(red.dir+1)+")_";
+      for(int i = 0 ; i < np_int[red.dir] ; i++) {
+        red.columns.push_back(col+std::to_string(i));
+      }
+    } else if(typeStr.compare("histogram") == 0) {
+      red.type = Type::histogram;
+      red.nbins = input.Get<int>("Output",entry,2);
+      red.vmin = input.Get<real>("Output",entry,3);
+      red.vmax = input.Get<real>("Output",entry,4);
+      if(input.CheckEntry("Output",entry) > 5) {
+        const std::string scale = input.Get<std::string>("Output",entry,5);
+        if(scale.compare("log") == 0) {
+          red.logBins = true;
+        } else if(scale.compare("linear") != 0) {
+          IDEFIX_ERROR("Histogram bins of [Output] "+entry+" should be either linear or log");
+        }
+      }
+      if(red.nbins < 1 || red.vmax <= red.vmin || (red.logBins && red.vmin <= 0)) {
+        IDEFIX_ERROR("Invalid bins for the histogram of [Output] "+entry);
+      }
+      const std::string col = "histogram("+red.varName+")_";
+      for(int i = 0 ; i < red.nbins ; i++) {
+        red.columns.push_back(col+std::to_string(i));
+      }
+    } else {
+      IDEFIX_ERROR("Unknown reduction "+typeStr+" in [Output] "+entry+". Valid reductions are "
+                   "sum, mean, min, max, profile and histogram.");
+    }
+    reductions.push_back(red);
+    n++;
+  }
+  if(reductions.empty()) {
+    IDEFIX_WARNING("Time series are enabled, but no reduction is defined (tseries1...)");
+  }
+
+  // Total volume of the domain, used to normalise means and histograms
+  IdefixArray3D<real> dV = data.dV;
+  accum volume = 0;
+  idefix_reduce("TimeSeries::Volume",
+                data.beg[KDIR], data.end[KDIR],
+                data.beg[JDIR], data.end[JDIR],
+                data.beg[IDIR], data.end[IDIR],
+                KOKKOS_LAMBDA (int k, int j, int i, accum &localVolume) {
+                  localVolume += dV(k,j,i);
+                },
+                Kokkos::Sum<accum>(volume));
+  totalVolume = volume;
+  #ifdef WITH_MPI
+  MPI_Allreduce(MPI_IN_PLACE, &totalVolume, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  #endif
+
+  // Start a new file, unless we're continuing the file of a previous run
+  if(!input.restartRequested || !std::ifstream(filename).good()) {
+    WriteHeader();
+  } else {
+    CheckHeader();
+  }
+
+  idfx::popRegion();
+}
+
+std::vector<std::string> TimeSeries::Header() {
+  std::vector<std::string> header;
+  std::ostringstream line;
+  line.precision(precision);
+  line << std::scientific;
+  for(auto const &red : reductions) {
+    if(red.type == Type::profile) {
+      line.str("");
+      line << "# profile(" << red.varName << ",x" << red.dir+1 << ") abscissa:";
+      for(int i = 0 ; i < np_int[red.dir] ; i++) line << " " << x[red.dir](i);
+      header.push_back(line.str());
+    }
+    if(red.type == Type::histogram) {
+      line.str("");
+      line << "# histogram(" << red.varName << ") bin edges:";
+      for(int i = 0 ; i <= red.nbins ; i++) {
+        const real f = static_cast<real>(i)/red.nbins;
+        if(red.logBins) {
+          line << " " << std::pow(10.0, std::log10(red.vmin)
+                                        + f*(std::log10(red.vmax)-std::log10(red.vmin)));
+        } else {
+          line << " " << red.vmin + f*(red.vmax-red.vmin);
+        }
+      }
+      header.push_back(line.str());
+    }
+  }
+  line.str("");
+  line << "# t";
+  for(auto const &red : reductions) {
+    for(auto const &col : red.columns) line << " " << col;
+  }
+  header.push_back(line.str());
+  return(header);
+}
+
+void TimeSeries::WriteHeader() {
+  if(idfx::prank != 0) return;
+  std::ofstream file(filename, std::ios::trunc);
+  file << "# Idefix " << IDEFIX_VERSION << " time series" << std::endl;
+  for(auto const &line : Header()) file << line << std::endl;
+  file.close();
+}
+
+void TimeSeries::CheckHeader() {
+  if(idfx::prank != 0) return;
+  // The first line holds the version of the code which wrote the file, and may differ
+  std::ifstream file(filename);
+  std::vector<std::string> header;
+  std::string line;
+  std::getline(file, line);
+  while(file.peek() == '#' && std::getline(file, line)) header.push_back(line);
+  file.close();
+  if(header != Header()) {
+    IDEFIX_ERROR("The columns of the time series file "+filename+" do not match the tseriesN "
+                 "entries of [Output]. Move the file away or change tseries_file to restart.");
+  }
+}
+
+void TimeSeries::Truncate(real t) {
+  idfx::pushRegion("TimeSeries::Truncate");
+  if(idfx::prank == 0) {
+    // Drop the lines written after the restart time, which are computed again. Times are
+    // written with a finite precision, hence the tolerance.
+    const double tmax = t + std::fabs(t)*std::pow(10.0, -precision);
+    std::ifstream file(filename);
+    std::vector<std::string> lines;
+    std::string line;
+    while(std::getline(file, line)) {
+      if(line.empty()) continue;
+      if(line[0] == '#' || std::stod(line) <= tmax) lines.push_back(line);
+    }
+    file.close();
+    std::ofstream out(filename, std::ios::trunc);
+    for(auto const &l : lines) out << l << std::endl;
+    out.close();
+  }
+  idfx::popRegion();
+}
+
+void TimeSeries::Write(DataBlock &data) {
+  idfx::pushRegion("TimeSeries::Write");
+
+  std::vector<double> sums;
+  std::vector<Extremum> extrema;
+  std::vector<double> coords;
+
+  for(auto &red : reductions) {
+    switch(red.type) {
+      case Type::sum:
+      case Type::mean:
+        red.offset = sums.size();
+        ReduceSum(data, red, sums);
+        break;
+      case Type::profile:
+        red.offset = sums.size();
+        ReduceProfile(data, red, sums);
+        break;
+      case Type::histogram:
+        red.offset = sums.size();
+        ReduceHistogram(data, red, sums);
+        break;
+      case Type::min:
+      case Type::max:
+        red.offset = extrema.size();
+        ReduceExtremum(data, red, extrema, coords);
+        break;
+    }
+  }
+
+  #ifdef WITH_MPI
+  // A single reduction for all of the sums, and one for all of the extrema
+  if(sums.size() > 0) {
+    MPI_Allreduce(MPI_IN_PLACE, sums.data(), sums.size(), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  }
+  if(extrema.size() > 0) {
+    MPI_Allreduce(MPI_IN_PLACE, extrema.data(), extrema.size(), MPI_DOUBLE_INT, MPI_MINLOC,
+                  MPI_COMM_WORLD);
+    // Only keep the coordinates of the extrema found by this process
+    for(size_t n = 0 ; n < extrema.size() ; n++) {
+      if(extrema[n].rank != idfx::prank) {
+        for(int dir = 0 ; dir < 3 ; dir++) coords[3*n+dir] = 0;
+      }
+    }
+    MPI_Reduce(idfx::prank == 0 ? MPI_IN_PLACE : coords.data(), coords.data(), coords.size(),
+               MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+  }
+  #endif
+
+  if(idfx::prank == 0) {
+    std::ofstream file(filename, std::ios::app);
+    file.precision(precision);
+    file << std::scientific << data.t;
+    for(auto const &red : reductions) {
+      switch(red.type) {
+        case Type::sum:
+          file << " " << sums[red.offset];
+          break;
+        case Type::mean:
+          file << " " << sums[red.offset]/totalVolume;
+          break;
+        case Type::profile:
+          for(int i = 0 ; i < np_int[red.dir] ; i++) {
+            // Volume-weighted average over the two other directions
+            file << " " << sums[red.offset+i]/sums[red.offset+np_int[red.dir]+i];
+          }
+          break;
+        case Type::histogram:
+          // Fraction of the volume of the domain in each bin
+          for(int i = 0 ; i < red.nbins ; i++) {
+            file << " " << sums[red.offset+i]/totalVolume;
+          }
+          break;
+        case Type::min:
+        case Type::max:
+          // Maxima are stored as minima of the opposite value
+          file << " " << (red.type == Type::min ? 1 : -1) * extrema[red.offset].value;
+          for(int dir = 0 ; dir < 3 ; dir++) file << " " << coords[3*red.offset+dir];
+          break;
+      }
+    }
+    file << std::endl;
+    file.close();
+  }
+
+  idfx::popRegion();
+}
+
+void TimeSeries::ReduceSum(DataBlock &data, const Reduction &red, std::vector<double> &sums) {
+  IdefixArray4D<real> Vc = data.hydro->Vc;
+  IdefixArray3D<real> dV = data.dV;
+  const int nv = red.var;
+
+  accum sum = 0;
+  idefix_reduce("TimeSeries::Sum",
+                data.beg[KDIR], data.end[KDIR],
+                data.beg[JDIR], data.end[JDIR],
+                data.beg[IDIR], data.end[IDIR],
+                KOKKOS_LAMBDA (int k, int j, int i, accum &localSum) {
+                  localSum += Vc(nv,k,j,i) * dV(k,j,i);
+                },
+                Kokkos::Sum<accum>(sum));
+  sums.push_back(sum);
+}
+
+void TimeSeries::ReduceProfile(DataBlock &data, const Reduction &red, std::vector<double> &sums) {
+  IdefixArray4D<real> Vc = data.hydro->Vc;
+  IdefixArray3D<real> dV = data.dV;
+  const int nv = red.var;
+  const int dir = red.dir;
+  const int beg = data.beg[dir];
+
+  // Weighted sum of the variable and volume of each slab of the local domain
+  IdefixArray2D<real> profile("TimeSeriesProfile", 2, data.np_int[dir]);
+  idefix_for("TimeSeries::Profile",
+             data.beg[KDIR], data.end[KDIR],
+             data.beg[JDIR], data.end[JDIR],
+             data.beg[IDIR], data.end[IDIR],
+             KOKKOS_LAMBDA (int k, int j, int i) {
+               const int m = (dir == IDIR ? i : (dir == JDIR ? j : k)) - beg;
+               Kokkos::atomic_add(&profile(0,m), Vc(nv,k,j,i) * dV(k,j,i));
+               Kokkos::atomic_add(&profile(1,m), dV(k,j,i));
+             });
+  auto profileHost = Kokkos::create_mirror_view(profile);
+  Kokkos::deep_copy(profileHost, profile);
+
+  // Place the local slabs in the global profile
+  const size_t start = sums.size();
+  const int offset = data.gbeg[dir] - data.nghost[dir];
+  sums.resize(start + 2*np_int[dir], 0.0);
+  for(int m = 0 ; m < data.np_int[dir] ; m++) {
+    sums[start + offset + m] = profileHost(0,m);
+    sums[start + np_int[dir] + offset + m] = profileHost(1,m);
+  }
+}
+
+void TimeSeries::ReduceHistogram(DataBlock &data, const Reduction &red,
+                                 std::vector<double> &sums) {
+  IdefixArray4D<real> Vc = data.hydro->Vc;
+  IdefixArray3D<real> dV = data.dV;
+  const int nv = red.var;
+  const int nbins = red.nbins;
+  const bool logBins = red.logBins;
+  const real lmin = logBins ? std::log10(red.vmin) : red.vmin;
+  const real lmax = logBins ? std::log10(red.vmax) : red.vmax;
+  const real dbin = (lmax - lmin) / nbins;
+
+  // Volume of the cells in each bin
+  IdefixArray1D<real> histogram("TimeSeriesHistogram", nbins);
+  idefix_for("TimeSeries::Histogram",
+             data.beg[KDIR], data.end[KDIR],
+             data.beg[JDIR], data.end[JDIR],
+             data.beg[IDIR], data.end[IDIR],
+             KOKKOS_LAMBDA (int k, int j, int i) {
+               real v = Vc(nv,k,j,i);
+               if(logBins) v = (v > 0 ? std::log10(v) : lmin - 1);
+               // Values out of the bins (and NaNs) are discarded
+               if(v >= lmin && v < lmax) {
+                 const int b = std::min(static_cast<int>((v - lmin) / dbin), nbins-1);
+                 Kokkos::atomic_add(&histogram(b), dV(k,j,i));
+               }
+             });
+  auto histogramHost = Kokkos::create_mirror_view(histogram);
+  Kokkos::deep_copy(histogramHost, histogram);
+  for(int b = 0 ; b < nbins ; b++) {
+    sums.push_back(histogramHost(b));
+  }
+}
+
+void TimeSeries::ReduceExtremum(DataBlock &data, const Reduction &red,
+                                std::vector<Extremum> &extrema, std::vector<double> &coords) {
+  IdefixArray4D<real> Vc = data.hydro->Vc;
+  const int nv = red.var;
+  const int nx1 = data.np_tot[IDIR];
+  const int nx2 = data.np_tot[JDIR];
+
+  // Local extremum and the flattened index of its cell
+  double value;
+  int index;
+  if(red.type == Type::min) {
+    Kokkos::MinLoc<real,int>::value_type result;
+    idefix_reduce("TimeSeries::Min",
+                  data.beg[KDIR], data.end[KDIR],
+                  data.beg[JDIR], data.end[JDIR],
+                  data.beg[IDIR], data.end[IDIR],
+                  KOKKOS_LAMBDA (int k, int j, int i, Kokkos::MinLoc<real,int>::value_type &loc) {
+                    if(Vc(nv,k,j,i) < loc.val) {
+                      loc.val = Vc(nv,k,j,i);
+                      loc.loc = i + nx1*(j + nx2*k);
+                    }
+                  },
+                  Kokkos::MinLoc<real,int>(result));
+    value = result.val;
+    index = result.loc;
+  } else {
+    Kokkos::MaxLoc<real,int>::value_type result;
+    idefix_reduce("TimeSeries::Max",
+                  data.beg[KDIR], data.end[KDIR],
+                  data.beg[JDIR], data.end[JDIR],
+                  data.beg[IDIR], data.end[IDIR],
+                  KOKKOS_LAMBDA (int k, int j, int i, Kokkos::MaxLoc<real,int>::value_type &loc) {
+                    if(Vc(nv,k,j,i) > loc.val) {
+                      loc.val = Vc(nv,k,j,i);
+                      loc.loc = i + nx1*(j + nx2*k);
+                    }
+                  },
+                  Kokkos::MaxLoc<real,int>(result));
+    value = -result.val;
+    index = result.loc;
+  }
+  extrema.push_back({value, idfx::prank});
+
+  // Global coordinates of the cell
+  const int idx[3] = {index % nx1, (index / nx1) % nx2, index / (nx1*nx2)};
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    const int g = std::clamp(idx[dir] - data.beg[dir] + data.gbeg[dir] - data.nghost[dir],
+                             0, np_int[dir]-1);
+    coords.push_back(x[dir](g));
+  }
+}
@@ -0,0 +1,75 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef OUTPUT_TIMESERIES_HPP_
+#define OUTPUT_TIMESERIES_HPP_
+
+#include <array>
+#include <string>
+#include <vector>
+#include "idefix.hpp"
+#include "input.hpp"
+
+// Forward class declaration
+class DataBlock;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+/// TimeSeries computes reductions of the hydro variables on the device (volume integrals and
+/// averages, extrema with their location, profiles averaged over two directions and
+/// histograms). The reductions are listed in the [Output] block with entries tseriesN, reduced
+/// once over all of the MPI processes, and appended as a single line to an ascii file.
+//////////////////////////////////////////////////////////////////////////////////////////////////
+class TimeSeries {
+ public:
+  TimeSeries(Input &, DataBlock &);
+  void Write(DataBlock &);    // Compute all of the reductions and append them to the file
+  void Truncate(real);        // Drop the lines written after this time, when restarting
+
+ private:
+  enum class Type {sum, mean, min, max, profile, histogram};
+
+  struct Reduction {
+    Type type;
+    std::string varName;
+    int var;                    // index of the variable in Vc
+    int dir{0};                 // direction of profiles
+    int nbins{0};               // histograms
+    real vmin{0}, vmax{0};
+    bool logBins{false};
+    std::vector<std::string> columns;
+    size_t offset{0};           // position of the results in the reduced buffers
+  };
+
+  // Extremum of one process, with the layout of MPI_DOUBLE_INT for MPI_MINLOC
+  struct Extremum {
+    double value;
+    int rank;
+  };
+
+  std::vector<Reduction> reductions;
+  std::string filename;
+  int precision{10};
+  double totalVolume{0};
+
+  // Global coordinates of the cell centers
+  std::array<IdefixArray1D<real>::HostMirror,3> x;
+  std::array<int,3> np_int;
+
+  // Each reduction adds its local contribution to the sums, or to the extrema and their
+  // coordinates, which are then reduced together over all of the processes
+  void ReduceSum(DataBlock &, const Reduction &, std::vector<double> &);
+  void ReduceProfile(DataBlock &, const Reduction &, std::vector<double> &);
+  void ReduceHistogram(DataBlock &, const Reduction &, std::vector<double> &);
+  void ReduceExtremum(DataBlock &, const Reduction &, std::vector<Extremum> &,
+                      std::vector<double> &);
+
+  std::vector<std::string> Header();   // Lines of the header, but the version of the code
+  void WriteHeader();
+  void CheckHeader();         // Check that a file we continue has the same columns
+};
+
+#endif // OUTPUT_TIMESERIES_HPP_
@@ -11,6 +11,8 @@
 #include <cstdio>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include <type_traits>
 #if __has_include(<filesystem>)
   #include <filesystem> // NOLINT [build/c++17]
   namespace fs = std::filesystem;
@@ -61,7 +63,7 @@ void Vtk::WriteHeaderNodes(IdfxFileHandler fvtk) {
 }
 
 /*init the object */
-Vtk::Vtk(Input &input, DataBlock *datain, std::string filebase) {
+Vtk::Vtk(Input &input, DataBlock *datain, std::string filebase): quantizer(input) {
   // Initialize the output structure
   // Create a local datablock as an image of gridin
   this->data = datain;
@@ -104,14 +106,50 @@ Vtk::Vtk(Input &input, DataBlock *datain, std::string filebase) {
   for (int dir=0; dir<3; dir++) {
     this->periodicity[dir] = (datain->mygrid->lbound[dir] == periodic);
   }
+
+  // Strided downsampling: either one stride for all directions, or one per direction
+  const int nstride = input.CheckEntry("Output","vtk_stride");
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    stride[dir] = 1;
+    if(nstride > 0) stride[dir] = input.Get<int>("Output","vtk_stride",std::min(dir,nstride-1));
+    if(stride[dir] < 1) {
+      IDEFIX_ERROR("[Output] vtk_stride should be larger or equal to 1");
+    }
+    // Directions made of a single cell are never downsampled
+    if(grid.np_int[dir] == 1) stride[dir] = 1;
+  }
+
+  // The cell c of the output is the cell c*stride of the grid, so that each process
+  // writes the sampled cells that it owns, whatever the domain decomposition.
+  int64_t nglob[3], nloc[3], cstart[3];
+  for(int dir = 0 ; dir < 3 ; dir++) {
+    const int64_t lstart = data->gbeg[dir] - data->nghost[dir];
+    const int64_t lend = lstart + data->np_int[dir];
+    nglob[dir] = (grid.np_int[dir] + stride[dir] - 1) / stride[dir];
+    cstart[dir] = (lstart + stride[dir] - 1) / stride[dir];
+    nloc[dir] = (lend + stride[dir] - 1) / stride[dir] - cstart[dir];
+    sampleBeg[dir] = data->beg[dir] + cstart[dir]*stride[dir] - lstart;
+    if(nloc[dir] < 1) {
+      std::stringstream msg;
+      msg << "[Output] vtk_stride=" << stride[dir] << " is larger than the number of cells "
+          << "of the local subdomain (" << data->np_int[dir] << ") in direction " << dir << "."
+          << std::endl << "Use a smaller stride or fewer MPI processes in this direction.";
+      IDEFIX_ERROR(msg);
+    }
+  }
+  // Index (including ghosts) in the grid of the left interface of the output cell c
+  auto node = [&](int dir, int64_t c) {
+    return(std::min<int64_t>(c*stride[dir], grid.np_int[dir]) + grid.nghost[dir]);
+  };
+
   // Create the coordinate array required in VTK files
-  this->nx1 = grid.np_int[IDIR];
-  this->nx2 = grid.np_int[JDIR];
-  this->nx3 = grid.np_int[KDIR];
+  this->nx1 = nglob[IDIR];
+  this->nx2 = nglob[JDIR];
+  this->nx3 = nglob[KDIR];
 
-  this->nx1loc = data->np_int[IDIR];
-  this->nx2loc = data->np_int[JDIR];
-  this->nx3loc = data->np_int[KDIR];
+  this->nx1loc = nloc[IDIR];
+  this->nx2loc = nloc[JDIR];
+  this->nx3loc = nloc[KDIR];
 
   this->ioffset = datain->mygrid->np_tot[IDIR] == 1 ? 0 : 1;
   this->joffset = datain->mygrid->np_tot[JDIR] == 1 ? 0 : 1;
@@ -119,6 +157,9 @@ Vtk::Vtk(Input &input, DataBlock *datain, std::string filebase) {
 
   // Temporary storage on host for 3D arrays
   this->vect3D = new float[nx1loc*nx2loc*nx3loc];
+  if(quantizer.IsEnabled()) {
+    quantizeBuffer.resize(nx1loc*nx2loc*nx3loc*sizeof(uint16_t));
+  }
 
   // Store coordinates for later use
   this->xnode = new float[nx1+ioffset];
@@ -129,19 +170,19 @@ Vtk::Vtk(Input &input, DataBlock *datain, std::string filebase) {
     if(grid.np_tot[IDIR] == 1) // only one dimension in this direction
       xnode[i] = bigEndian(static_cast<float>(grid.x[IDIR](i)));
     else
-      xnode[i] = bigEndian(static_cast<float>(grid.xl[IDIR](i + grid.nghost[IDIR])));
+      xnode[i] = bigEndian(static_cast<float>(grid.xl[IDIR](node(IDIR, i))));
   }
   for (int32_t j = 0; j < nx2 + joffset; j++)    {
     if(grid.np_tot[JDIR] == 1) // only one dimension in this direction
       ynode[j] = bigEndian(static_cast<float>(grid.x[JDIR](j)));
     else
-      ynode[j] = bigEndian(static_cast<float>(grid.xl[JDIR](j + grid.nghost[JDIR])));
+      ynode[j] = bigEndian(static_cast<float>(grid.xl[JDIR](node(JDIR, j))));
   }
   for (int32_t k = 0; k < nx3 + koffset; k++) {
     if(grid.np_tot[KDIR] == 1)
       znode[k] = bigEndian(static_cast<float>(grid.x[KDIR](k)));
     else
-      znode[k] = bigEndian(static_cast<float>(grid.xl[KDIR](k + grid.nghost[KDIR])));
+      znode[k] = bigEndian(static_cast<float>(grid.xl[KDIR](node(KDIR, k))));
   }
 #if VTK_FORMAT == VTK_STRUCTURED_GRID   // VTK_FORMAT
   /* -- Allocate memory for node_coord which is later used -- */
@@ -152,9 +193,9 @@ Vtk::Vtk(Input &input, DataBlock *datain, std::string filebase) {
   int nodesubsize[4];
 
   for(int dir = 0; dir < 3 ; dir++) {
-    nodesize[2-dir] = datain->mygrid->np_int[dir];
-    nodestart[2-dir] = datain->gbeg[dir]-datain->nghost[dir];
-    nodesubsize[2-dir] = datain->np_int[dir];
+    nodesize[2-dir] = nglob[dir];
+    nodestart[2-dir] = cstart[dir];
+    nodesubsize[2-dir] = nloc[dir];
   }
 
   // In the 4th dimension, we always have the 3 components
@@ -195,9 +236,9 @@ Vtk::Vtk(Input &input, DataBlock *datain, std::string filebase) {
     for (int32_t j = 0; j < nodesubsize[1]; j++) {
       for (int32_t i = 0; i < nodesubsize[2]; i++) {
         // bigEndian allows us to get back to little endian when needed
-          x1 = grid.xl[IDIR](i + data->gbeg[IDIR]);
-          x2 = grid.xl[JDIR](j + data->gbeg[JDIR]);
-          x3 = grid.xl[KDIR](k + data->gbeg[KDIR]);
+          x1 = grid.xl[IDIR](node(IDIR, i + cstart[IDIR]));
+          x2 = grid.xl[JDIR](node(JDIR, j + cstart[JDIR]));
+          x3 = grid.xl[KDIR](node(KDIR, k + cstart[KDIR]));
 
   #if (GEOMETRY == CARTESIAN) || (GEOMETRY == CYLINDRICAL)
         node_coord(k,j,i,0) = bigEndian(x1);
@@ -239,15 +280,22 @@ Vtk::Vtk(Input &input, DataBlock *datain, std::string filebase) {
 
   for(int dir = 0; dir < 3 ; dir++) {
     // VTK assumes Fortran array ordering, hence arrays dimensions are filled backwards
-    start[2-dir] = data->gbeg[dir]-grid.nghost[dir];
-    size[2-dir] = grid.np_int[dir];
-    subsize[2-dir] = data->np_int[dir];
+    start[2-dir] = cstart[dir];
+    size[2-dir] = nglob[dir];
+    subsize[2-dir] = nloc[dir];
   }
 
   MPI_SAFE_CALL(MPI_Type_create_subarray(3, size, subsize, start, MPI_ORDER_C,
                                          MPI_FLOAT, &this->view));
   MPI_SAFE_CALL(MPI_Type_commit(&this->view));
+  MPI_SAFE_CALL(MPI_Type_create_subarray(3, size, subsize, start, MPI_ORDER_C,
+                                         MPI_UNSIGNED_SHORT, &this->viewShort));
+  MPI_SAFE_CALL(MPI_Type_commit(&this->viewShort));
+  MPI_SAFE_CALL(MPI_Type_create_subarray(3, size, subsize, start, MPI_ORDER_C,
+                                         MPI_UNSIGNED_CHAR, &this->viewChar));
+  MPI_SAFE_CALL(MPI_Type_commit(&this->viewChar));
   this->comm = datain->mygrid->CartComm;
+  quantizer.SetCommunicator(this->comm);
   this->isRoot =   (data->mygrid->xproc[0] == 0)
                 && (data->mygrid->xproc[1] == 0)
                 && (data->mygrid->xproc[2] == 0);
@@ -302,20 +350,41 @@ int Vtk::Write() {
   }
 #endif
 
+  // The offset and scale of the quantized fields are stored in the header
+  quantizeRange.clear();
+  for(auto const& [name, scalar] : vtkScalarMap) {
+    const int bits = quantizer.GetBits(name);
+    if(bits > 0) {
+      const int64_t n = SampleField(scalar);
+      double offset, scale;
+      quantizer.Range(vect3D, n, bits, offset, scale);
+      quantizeRange[name] = {offset, scale};
+    }
+  }
+
   WriteHeader(fileHdl, this->data->t);
 
   // Write field one by one
   for(auto const& [name, scalar] : vtkScalarMap) {
-    auto Vcin = scalar.GetHostField();
-    for(int k = data->beg[KDIR]; k < data->end[KDIR] ; k++ ) {
-      for(int j = data->beg[JDIR]; j < data->end[JDIR] ; j++ ) {
-        for(int i = data->beg[IDIR]; i < data->end[IDIR] ; i++ ) {
-          vect3D[i-data->beg[IDIR] + (j-data->beg[JDIR])*nx1loc + (k-data->beg[KDIR])*nx1loc*nx2loc]
-              = bigEndian(static_cast<float>(Vcin(k,j,i)));
-        }
+    const int64_t n = SampleField(scalar);
+    const int bits = quantizer.GetBits(name);
+    if(bits == 0) {
+      for(int64_t i = 0 ; i < n ; i++) {
+        vect3D[i] = bigEndian(vect3D[i]);
       }
+      WriteScalar(fileHdl, vect3D, name);
+    } else if(bits == 8) {
+      uint8_t *q = quantizeBuffer.data();
+      Quantizer::Encode(vect3D, n, q, quantizeRange[name][0], quantizeRange[name][1]);
+      WriteScalar(fileHdl, q, name);
+    } else {
+      uint16_t *q = reinterpret_cast<uint16_t *>(quantizeBuffer.data());
+      Quantizer::Encode(vect3D, n, q, quantizeRange[name][0], quantizeRange[name][1]);
+      for(int64_t i = 0 ; i < n ; i++) {
+        q[i] = bigEndian(q[i]);
+      }
+      WriteScalar(fileHdl, q, name);
     }
-    WriteScalar(fileHdl, vect3D, name);
   }
 
 #ifdef WITH_MPI
@@ -334,6 +403,21 @@ int Vtk::Write() {
 }
 
 
+int64_t Vtk::SampleField(const ScalarField &scalar) {
+  auto Vcin = scalar.GetHostField();
+  for(int k = 0; k < nx3loc ; k++ ) {
+    for(int j = 0; j < nx2loc ; j++ ) {
+      for(int i = 0; i < nx1loc ; i++ ) {
+        vect3D[i + j*nx1loc + k*nx1loc*nx2loc] =
+            static_cast<float>(Vcin(sampleBeg[KDIR] + k*stride[KDIR],
+                                    sampleBeg[JDIR] + j*stride[JDIR],
+                                    sampleBeg[IDIR] + i*stride[IDIR]));
+      }
+    }
+  }
+  return(nx1loc*nx2loc*nx3loc);
+}
+
 /* ********************************************************************* */
 void Vtk::WriteHeader(IdfxFileHandler fvtk, real time) {
 /*!
@@ -375,8 +459,8 @@ void Vtk::WriteHeader(IdfxFileHandler fvtk, real time) {
 #elif VTK_FORMAT == VTK_STRUCTURED_GRID
   ssheader << "DATASET STRUCTURED_GRID" << std::endl;
 #endif
-  // fields: geometry, periodicity, time
-  int nfields = 3;
+  // fields: geometry, periodicity, time, and the offset and scale of quantized fields
+  int nfields = 3 + static_cast<int>(quantizeRange.size());
 
   // Write grid geometry in the VTK file
   ssheader << "FIELD FieldData " << nfields << std::endl;
@@ -426,6 +510,18 @@ void Vtk::WriteHeader(IdfxFileHandler fvtk, real time) {
   // Done, add cariage return for next ascii write
   ssheader << std::endl;
 
+  // Quantized fields: physical value = offset + scale*stored value
+  for(auto const& [name, range] : quantizeRange) {
+    ssheader << name << "_QUANTIZATION 2 1 double" << std::endl;
+    header = ssheader.str();
+    WriteHeaderString(header.c_str(), fvtk);
+    ssheader.str(std::string());
+
+    double rangeBE[2] = {bigEndian(range[0]), bigEndian(range[1])};
+    WriteHeaderBinary(rangeBE, 2, fvtk);
+    ssheader << std::endl;
+  }
+
 
 
   ssheader << "DIMENSIONS " << nx1 + ioffset << " " << nx2 + joffset << " " << nx3 + koffset
@@ -488,31 +584,56 @@ void Vtk::WriteHeader(IdfxFileHandler fvtk, real time) {
 
 
 /* ********************************************************************* */
-void Vtk::WriteScalar(IdfxFileHandler fvtk, float* Vin,  const std::string &var_name) {
+template <typename T>
+void Vtk::WriteScalar(IdfxFileHandler fvtk, T* Vin,  const std::string &var_name) {
 /*!
 * Write VTK scalar field.
 *
 *********************************************************************** */
 
   std::stringstream ssheader;
+  std::string type;
+#ifdef WITH_MPI
+  MPI_Datatype mpiType, fileView;
+#endif
+  if constexpr(std::is_same<T, float>::value) {
+    type = "float";
+#ifdef WITH_MPI
+    mpiType = MPI_FLOAT;
+    fileView = this->view;
+#endif
+  } else if constexpr(std::is_same<T, uint16_t>::value) {
+    type = "unsigned_short";
+#ifdef WITH_MPI
+    mpiType = MPI_UNSIGNED_SHORT;
+    fileView = this->viewShort;
+#endif
+  } else {
+    static_assert(std::is_same<T, uint8_t>::value, "Unsupported vtk scalar type");
+    type = "unsigned_char";
+#ifdef WITH_MPI
+    mpiType = MPI_UNSIGNED_CHAR;
+    fileView = this->viewChar;
+#endif
+  }
 
-  ssheader << std::endl << "SCALARS " << var_name.c_str() << " float" << std::endl;
+  ssheader << std::endl << "SCALARS " << var_name.c_str() << " " << type << std::endl;
   ssheader << "LOOKUP_TABLE default" << std::endl;
   std::string header(ssheader.str());
 
   WriteHeaderString(header.c_str(), fvtk);
 
 #ifdef WITH_MPI
-  MPI_SAFE_CALL(MPI_File_set_view(fvtk, this->offset, MPI_FLOAT, this->view,
+  MPI_SAFE_CALL(MPI_File_set_view(fvtk, this->offset, mpiType, fileView,
                                   "native", MPI_INFO_NULL));
 
   int nwrite = nx1loc*nx2loc*nx3loc;
   //if(idfx::prank != 0) nwrite = 0;
-  MPI_SAFE_CALL(MPI_File_write_all(fvtk, Vin, nwrite, MPI_FLOAT, MPI_STATUS_IGNORE));
+  MPI_SAFE_CALL(MPI_File_write_all(fvtk, Vin, nwrite, mpiType, MPI_STATUS_IGNORE));
 
-  this->offset = this->offset + sizeof(float)*nx1*nx2*nx3;
+  this->offset = this->offset + sizeof(T)*nx1*nx2*nx3;
 #else
-  if(fwrite(Vin,sizeof(float),nx1loc*nx2loc*nx3loc,fvtk) != nx1loc*nx2loc*nx3loc) {
+  if(fwrite(Vin,sizeof(T),nx1loc*nx2loc*nx3loc,fvtk) != nx1loc*nx2loc*nx3loc) {
     IDEFIX_ERROR("Unable to write to file. Check your filesystem permissions and disk quota.");
   }
 #endif
@@ -7,8 +7,10 @@
 
 #ifndef OUTPUT_VTK_HPP_
 #define OUTPUT_VTK_HPP_
+#include <array>
 #include <string>
 #include <map>
+#include <vector>
 #if __has_include(<filesystem>)
   #include <filesystem> // NOLINT [build/c++17]
   namespace fs = std::filesystem;
@@ -24,6 +26,7 @@
 #include "dataBlock.hpp"
 #include "bigEndian.hpp"
 #include "scalarField.hpp"
+#include "quantizer.hpp"
 
 
 // Forward class declaration
@@ -127,6 +130,16 @@ class Vtk : public BaseVtk {
   // offset in each direction (used by the vtk grid)
   int ioffset, joffset, koffset;
 
+  // Strided downsampling: one cell every stride[dir] is written, starting from the cell
+  // sampleBeg[dir] of the local datablock
+  std::array<int,3> stride;
+  std::array<int,3> sampleBeg;
+
+  // Reduced precision of the variables
+  Quantizer quantizer;
+  std::map<std::string, std::array<double,2>> quantizeRange;   // offset and scale of each field
+  std::vector<uint8_t> quantizeBuffer;
+
   // Coordinates needed by VTK outputs
   float *xnode, *ynode, *znode;
 
@@ -141,12 +154,16 @@ class Vtk : public BaseVtk {
   // File offset
 #ifdef WITH_MPI
   MPI_Datatype view;
+  MPI_Datatype viewShort;   // views of quantized fields
+  MPI_Datatype viewChar;
   MPI_Datatype nodeView;
   MPI_Comm comm;
 #endif
 
   void WriteHeader(IdfxFileHandler, real);
-  void WriteScalar(IdfxFileHandler, float*,  const std::string &);
+  template <typename T>
+  void WriteScalar(IdfxFileHandler, T*,  const std::string &);
+  int64_t SampleField(const ScalarField &);  // Fill vect3D with the sampled cells of a field
   void WriteHeaderNodes(IdfxFileHandler);
 
   // output directory
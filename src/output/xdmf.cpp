@@ -31,7 +31,7 @@
 #define WRITE_TIME
 
 
-Xdmf::Xdmf(Input &input, DataBlock *datain) {
+Xdmf::Xdmf(Input &input, DataBlock *datain): quantizer(input) {
   // Initialize the output structure
   // Create a local datablock as an image of gridin
 
@@ -176,6 +176,12 @@ Xdmf::Xdmf(Input &input, DataBlock *datain) {
   */
   // Temporary storage on host for 3D arrays
   this->vect3D = new DUMP_DATATYPE[nx1loc*nx2loc*nx3loc];
+  if(quantizer.IsEnabled()) {
+    quantizeBuffer.resize(nx1loc*nx2loc*nx3loc*sizeof(uint16_t));
+  }
+  #ifdef WITH_MPI
+  quantizer.SetCommunicator(data->mygrid->CartComm);
+  #endif
 
   // fill the node_coord array
   DUMP_DATATYPE x1 = 0.0;
@@ -404,8 +410,24 @@ int Xdmf::Write() {
         }
       }
     }
-    WriteScalar(vect3D, name, field_data_size, ssfileName.str(), filename_xmf,
-                memspace, dataspace, plist_id_mpiio, static_cast<hid_t&>(group_fields));
+    const int bits = quantizer.GetBits(name);
+    if(bits == 0) {
+      WriteScalar(vect3D, name, field_data_size, ssfileName.str(), filename_xmf,
+                  memspace, dataspace, plist_id_mpiio, static_cast<hid_t&>(group_fields));
+    } else {
+      const int64_t n = nx1loc*nx2loc*nx3loc;
+      double offset, scale;
+      quantizer.Range(vect3D, n, bits, offset, scale);
+      if(bits == 8) {
+        Quantizer::Encode(vect3D, n, quantizeBuffer.data(), offset, scale);
+      } else {
+        Quantizer::Encode(vect3D, n, reinterpret_cast<uint16_t *>(quantizeBuffer.data()),
+                          offset, scale);
+      }
+      WriteScalar(quantizeBuffer.data(), name, field_data_size, ssfileName.str(), filename_xmf,
+                  memspace, dataspace, plist_id_mpiio, static_cast<hid_t&>(group_fields),
+                  bits, offset, scale);
+    }
   }
   WriteFooter(ssfileName.str(), filename_xmf);
 
@@ -792,7 +814,7 @@ void Xdmf::WriteHeader(
 
 /* ********************************************************************* */
 void Xdmf::WriteScalar(
-                       DUMP_DATATYPE* Vin,
+                       void* Vin,
                        const std::string &var_name,
                        const hsize_t *dims,
                        const std::string filename,
@@ -800,9 +822,13 @@ void Xdmf::WriteScalar(
                        hid_t &memspace,
                        hid_t &dataspace,
                        hid_t &plist_id_mpiio,
-                       hid_t &group_fields) {
+                       hid_t &group_fields,
+                       int bits,
+                       double offset,
+                       double scale) {
 /*!
-* Write HDF5 scalar field.
+* Write HDF5 scalar field. Quantized fields (bits>0) are stored as unsigned integers q,
+* the physical value being offset + scale*q.
 *
 *********************************************************************** */
 
@@ -818,15 +844,29 @@ void Xdmf::WriteScalar(
 
   // We define the dataset that contain the fields.
 
-  dataset = H5Dcreate(group_fields, var_name.c_str(), H5_DUMP_DATATYPE,
+  hid_t datatype = H5_DUMP_DATATYPE;
+  if(bits == 8) datatype = H5T_NATIVE_UCHAR;
+  if(bits == 16) datatype = H5T_NATIVE_USHORT;
+
+  dataset = H5Dcreate(group_fields, var_name.c_str(), datatype,
                         dataspace, H5P_DEFAULT);
   #ifdef WITH_MPI
-  err = H5Dwrite(dataset, H5_DUMP_DATATYPE, memspace, dataspace,
+  err = H5Dwrite(dataset, datatype, memspace, dataspace,
                  plist_id_mpiio, Vin);
   #else
-  err = H5Dwrite(dataset, H5_DUMP_DATATYPE, memspace, dataspace,
+  err = H5Dwrite(dataset, datatype, memspace, dataspace,
                  H5P_DEFAULT, Vin);
   #endif
+  if(bits > 0) {
+    hid_t aspace = H5Screate(H5S_SCALAR);
+    hid_t attr = H5Acreate(dataset, "offset", H5T_NATIVE_DOUBLE, aspace, H5P_DEFAULT);
+    err = H5Awrite(attr, H5T_NATIVE_DOUBLE, &offset);
+    H5Aclose(attr);
+    attr = H5Acreate(dataset, "scale", H5T_NATIVE_DOUBLE, aspace, H5P_DEFAULT);
+    err = H5Awrite(attr, H5T_NATIVE_DOUBLE, &scale);
+    H5Aclose(attr);
+    H5Sclose(aspace);
+  }
   H5Dclose(dataset);
 
   if (idfx::prank == 0) {
@@ -834,21 +874,35 @@ void Xdmf::WriteScalar(
     ssxmfcontent << "     <Attribute Name=\"" << dataset_label;
     ssxmfcontent << "\" AttributeType=\"Scalar\" Center=\"Cell\">" << std::endl;
 
-    ssxmfcontent << "       <DataItem Dimensions=\"";
+    std::stringstream ssdims;
     for (int dir = 0; dir < DIMENSIONS; dir++) {
-     ssxmfcontent << dims[dir];
+     ssdims << dims[dir];
      if (dir<(DIMENSIONS-1))
-       ssxmfcontent << " ";
+       ssdims << " ";
     }
 
+    if(bits > 0) {
+      // Let the reader recover the physical values of quantized fields
+      ssxmfcontent << std::setprecision(17);
+      ssxmfcontent << "       <DataItem ItemType=\"Function\" Dimensions=\"" << ssdims.str();
+      ssxmfcontent << "\" Function=\"" << offset << " + " << scale << " * $0\">" << std::endl;
+    }
+    ssxmfcontent << "       <DataItem Dimensions=\"" << ssdims.str();
+    if(bits == 8) {
+      ssxmfcontent << "\" NumberType=\"UChar\" Precision=\"1\" Format=\"HDF\">" << std::endl;
+    } else if(bits == 16) {
+      ssxmfcontent << "\" NumberType=\"UInt\" Precision=\"2\" Format=\"HDF\">" << std::endl;
+    } else {
     #ifndef XDMF_DOUBLE
-    ssxmfcontent << "\" NumberType=\"Float\" Precision=\"4\" Format=\"HDF\">" << std::endl;
+      ssxmfcontent << "\" NumberType=\"Float\" Precision=\"4\" Format=\"HDF\">" << std::endl;
     #else
-    ssxmfcontent << "\" NumberType=\"Float\" Precision=\"8\" Format=\"HDF\">" << std::endl;
+      ssxmfcontent << "\" NumberType=\"Float\" Precision=\"8\" Format=\"HDF\">" << std::endl;
     #endif
+    }
     ssxmfcontent << "        " << filename << ":";
     ssxmfcontent << ssgroup_name.str() << dataset_name << std::endl;
     ssxmfcontent << "       </DataItem>" << std::endl;
+    if(bits > 0) ssxmfcontent << "       </DataItem>" << std::endl;
     ssxmfcontent << "     </Attribute>" << std::endl;
 
     std::ofstream xmfFile(filename_xmf, std::ios::app);
@@ -18,9 +18,11 @@
   error "Missing the <filesystem> header."
 #endif
 #include <map>
+#include <vector>
 #include "idefix.hpp"
 #include "input.hpp"
 #include "scalarField.hpp"
+#include "quantizer.hpp"
 
 #define H5_USE_16_API
 #include "hdf5.h"
@@ -76,6 +78,10 @@ class Xdmf {
   // Array designed to store the temporary vector array
   DUMP_DATATYPE *vect3D;
 
+  // Reduced precision of the variables
+  Quantizer quantizer;
+  std::vector<uint8_t> quantizeBuffer;
+
   // Timer
   Kokkos::Timer timer;
 
@@ -108,7 +114,7 @@ class Xdmf {
                        const std::string ,
                        const std::string );
   void WriteScalar(
-                       DUMP_DATATYPE* ,
+                       void* ,
                        const std::string &,
                        const hsize_t * ,
                        const std::string ,
@@ -116,7 +122,10 @@ class Xdmf {
                        hid_t & ,
                        hid_t & ,
                        hid_t & ,
-                       hid_t & );
+                       hid_t & ,
+                       int bits = 0,
+                       double offset = 0,
+                       double scale = 1);
 };
 
 template<typename T>
@@ -24,6 +24,22 @@
   #endif
 #endif // SINGLE_PRECISION
 
+// Type of the evolved state (conservative variables Uc, face-centered field Vs and vector
+// potential Ve) and of the sums of reductions. With MIXED_PRECISION, the other arrays (primitive
+// variables, fluxes, MPI buffers) are stored in single precision (real) while the state is
+// updated and the sums are carried out in double precision
+#ifdef MIXED_PRECISION
+  using accum = double;
+  #ifdef WITH_MPI
+    #define accumMPI    MPI_DOUBLE
+  #endif
+#else
+  using accum = real;
+  #ifdef WITH_MPI
+    #define accumMPI    realMPI
+  #endif
+#endif // MIXED_PRECISION
+
 // math function
 #ifdef SINGLE_PRECISION
 
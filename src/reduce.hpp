@@ -15,6 +15,7 @@
 #include <string>
 #include "idefix.hpp"
 #include "global.hpp"
+#include "loop.hpp"
 
 
 // 1D default loop pattern
@@ -34,6 +35,130 @@ inline void idefix_reduce(const std::string & NAME,
     #endif
 }
 
+// We only implement MDRange reductions here since the other implementations are too
+// complicated to be implemented for any reduction operator on any class, except for the
+// Tiled pattern, whose tiles are reduced sequentially. All of the other patterns P fall back to
+// MDRange reductions.
+
+// 2D reduction with the pattern P
+template <LoopPattern P, typename Function, typename Reducer>
+inline void idefix_reduce_pattern(const std::string & NAME, const idfx::LoopConfig & config,
+                const int & JB, const int & JE,
+                const int & IB, const int & IE,
+                Function function,
+                Reducer redFunction) {
+    if constexpr(P == LoopPattern::TILED) {
+      using value_type = typename Reducer::value_type;
+      const int NJ = JE - JB;
+      const int TJ = config.nj;
+      const int NT = (NJ + TJ - 1) / TJ;
+      Kokkos::parallel_reduce(NAME, NT,
+        KOKKOS_LAMBDA (const int& T, value_type &localValue) {
+          const int j0 = T*TJ + JB;
+          const int j1 = (j0 + TJ < JE) ? j0 + TJ : JE;
+          for (int j = j0; j < j1; j++)
+            for (int i = IB; i < IE; i++)
+              function(j,i,localValue);
+        }, redFunction);
+    } else {
+      Kokkos::parallel_reduce(NAME,
+        Kokkos::MDRangePolicy<Kokkos::Rank<2, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
+          ({JB,IB},{JE,IE}), function, redFunction);
+    }
+}
+
+// 3D reduction with the pattern P
+template <LoopPattern P, typename Function, typename Reducer>
+inline void idefix_reduce_pattern(const std::string & NAME, const idfx::LoopConfig & config,
+                const int & KB, const int & KE,
+                const int & JB, const int & JE,
+                const int & IB, const int & IE,
+                Function function,
+                Reducer redFunction) {
+    if constexpr(P == LoopPattern::TILED) {
+      using value_type = typename Reducer::value_type;
+      const int NK = KE - KB;
+      const int NJ = JE - JB;
+      const int TK = config.nk;
+      const int TJ = config.nj;
+      const int NTJ = (NJ + TJ - 1) / TJ;
+      const int NT = ((NK + TK - 1) / TK) * NTJ;
+      Kokkos::parallel_reduce(NAME, NT,
+        KOKKOS_LAMBDA (const int& T, value_type &localValue) {
+          const int k0 = (T / NTJ)*TK + KB;
+          const int j0 = (T % NTJ)*TJ + JB;
+          const int k1 = (k0 + TK < KE) ? k0 + TK : KE;
+          const int j1 = (j0 + TJ < JE) ? j0 + TJ : JE;
+          for (int k = k0; k < k1; k++)
+            for (int j = j0; j < j1; j++)
+              for (int i = IB; i < IE; i++)
+                function(k,j,i,localValue);
+        }, redFunction);
+    } else {
+      Kokkos::parallel_reduce(NAME,
+        Kokkos::MDRangePolicy<Kokkos::Rank<3, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
+          ({KB,JB,IB},{KE,JE,IE}), function, redFunction);
+    }
+}
+
+// 4D reduction with the pattern P
+template <LoopPattern P, typename Function, typename Reducer>
+inline void idefix_reduce_pattern(const std::string & NAME, const idfx::LoopConfig & config,
+                const int & NB, const int & NE,
+                const int & KB, const int & KE,
+                const int & JB, const int & JE,
+                const int & IB, const int & IE,
+                Function function,
+                Reducer redFunction) {
+    if constexpr(P == LoopPattern::TILED) {
+      using value_type = typename Reducer::value_type;
+      const int NN = NE - NB;
+      const int NK = KE - KB;
+      const int NJ = JE - JB;
+      const int TK = config.nk;
+      const int TJ = config.nj;
+      const int NTJ = (NJ + TJ - 1) / TJ;
+      const int NTKNTJ = ((NK + TK - 1) / TK) * NTJ;
+      Kokkos::parallel_reduce(NAME, NN*NTKNTJ,
+        KOKKOS_LAMBDA (const int& T, value_type &localValue) {
+          const int n = T / NTKNTJ + NB;
+          const int k0 = ((T % NTKNTJ) / NTJ)*TK + KB;
+          const int j0 = (T % NTJ)*TJ + JB;
+          const int k1 = (k0 + TK < KE) ? k0 + TK : KE;
+          const int j1 = (j0 + TJ < JE) ? j0 + TJ : JE;
+          for (int k = k0; k < k1; k++)
+            for (int j = j0; j < j1; j++)
+              for (int i = IB; i < IE; i++)
+                function(n,k,j,i,localValue);
+        }, redFunction);
+    } else {
+      Kokkos::parallel_reduce(NAME,
+        Kokkos::MDRangePolicy<Kokkos::Rank<4, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
+          ({NB,KB,JB,IB},{NE,KE,JE,IE}), function, redFunction);
+    }
+}
+
+// Launch the reduction NAME on NK*NJ pencils of NI cells with the MDRange pattern, or with the
+// pattern selected by idfx::loopTuner for the Tiled and Auto patterns
+template <typename... Args>
+inline void idefix_reduce_dispatch(const std::string & NAME,
+                                   const int NK, const int NJ, const int NI,
+                                   Args... args) {
+    if constexpr(haveLoopTuner) {
+      const idfx::LoopConfig config = idfx::loopTuner.Begin(NAME, NK, NJ, NI,
+                                                            idfx::LoopKind::Reduce);
+      if(config.pattern == LoopPattern::TILED) {
+        idefix_reduce_pattern<LoopPattern::TILED>(NAME, config, args...);
+      } else {
+        idefix_reduce_pattern<LoopPattern::MDRANGE>(NAME, config, args...);
+      }
+      idfx::loopTuner.End();
+    } else {
+      idefix_reduce_pattern<LoopPattern::MDRANGE>(NAME, idfx::LoopConfig{LoopPattern::MDRANGE},
+                                                  args...);
+    }
+}
+
 // 2D default loop pattern
 template <typename Function, typename Reducer>
 inline void idefix_reduce(const std::string & NAME,
@@ -44,13 +169,7 @@ inline void idefix_reduce(const std::string & NAME,
     #ifdef DEBUG
     idfx::pushRegion("idefix_reduce("+NAME+")");
     #endif
-
-    // We only implement MDRange reductions here since the other implementations are too
-    // complicated to be implemented for any reduction operator on any class
-    Kokkos::parallel_reduce(NAME,
-      Kokkos::MDRangePolicy<Kokkos::Rank<2, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
-        ({JB,IB},{JE,IE}), function, redFunction);
-
+    idefix_reduce_dispatch(NAME, 1, JE - JB, IE - IB, JB, JE, IB, IE, function, redFunction);
     #ifdef DEBUG
     Kokkos::fence();
     idfx::popRegion();
@@ -65,15 +184,11 @@ inline void idefix_reduce(const std::string & NAME,
                 const int & IB, const int & IE,
                 Function function,
                 Reducer redFunction) {
-    // We only implement MDRange reductions here since the other implementations are too
-    // complicated to be implemented for any reduction operator on any class
     #ifdef DEBUG
     idfx::pushRegion("idefix_reduce("+NAME+")");
     #endif
-    Kokkos::parallel_reduce(NAME,
-      Kokkos::MDRangePolicy<Kokkos::Rank<3, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
-        ({KB,JB,IB},{KE,JE,IE}), function, redFunction);
-
+    idefix_reduce_dispatch(NAME, KE - KB, JE - JB, IE - IB, KB, KE, JB, JE, IB, IE,
+                           function, redFunction);
     #ifdef DEBUG
     Kokkos::fence();
     idfx::popRegion();
@@ -89,15 +204,11 @@ inline void idefix_reduce(const std::string & NAME,
                 const int & IB, const int & IE,
                 Function function,
                 Reducer redFunction) {
-    // We only implement MDRange reductions here since the other implementations are too
-    // complicated to be implemented for any reduction operator on any class
     #ifdef DEBUG
     idfx::pushRegion("idefix_reduce("+NAME+")");
     #endif
-    Kokkos::parallel_reduce(NAME,
-      Kokkos::MDRangePolicy<Kokkos::Rank<4, Kokkos::Iterate::Right, Kokkos::Iterate::Right>>
-        ({NB,KB,JB,IB},{NE,KE,JE,IE}), function, redFunction);
-
+    idefix_reduce_dispatch(NAME, KE - KB, JE - JB, IE - IB, NB, NE, KB, KE, JB, JE, IB, IE,
+                           function, redFunction);
     #ifdef DEBUG
     Kokkos::fence();
     idfx::popRegion();
@@ -0,0 +1,321 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef RKL_IMPLICITPARABOLIC_HPP_
+#define RKL_IMPLICITPARABOLIC_HPP_
+
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+
+#include "idefix.hpp"
+#include "input.hpp"
+#include "bicgstab.hpp"
+
+template<typename Phys>
+class RKLegendre;
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+/// Linearly implicit theta scheme for the parabolic terms handled by RKLegendre. The variables
+/// evolved by RKL (active cells of the cell-centered variables, followed by the face-centered
+/// field) are packed in a 1D vector U, and the parabolic step solves
+///     (I - theta dt J) dU = dt L(U0)
+/// with Bicgstab, L being the parabolic right hand side computed by RKLegendre::EvolveStage and
+/// J its Jacobian. The operator is applied matrix-free: J v is the finite difference
+/// (L(U0 + eps v) - L(U0))/eps, so that each Krylov iteration costs two evaluations of L.
+/// theta=1 is the backward Euler scheme, and theta=1/2 the Crank-Nicolson scheme.
+//////////////////////////////////////////////////////////////////////////////////////////////////
+template<typename Phys>
+class ImplicitParabolic {
+ public:
+  ImplicitParabolic(Input &, RKLegendre<Phys> *);
+  void Cycle();                     // Advance the parabolic terms by one hyperbolic time step
+  void ShowConfig();
+
+  // Operator of the linear system: out = in - theta dt J in
+  void operator() (IdefixArray3D<real> in, IdefixArray3D<real> out);
+
+  // Internal functions (left public for Lambda capture)
+  template <typename T>
+  void Pack(IdefixArray4D<T>, IdefixArray4D<T>, IdefixArray3D<real>);
+  void SetState(IdefixArray3D<real>, real);    // Uc=Uc0+a*vec, Vs=Vs0+a*vec
+  void Evaluate(real);                         // L(U) of the current state, in rkl->dU/dB
+
+  int nEval{0};                     // number of evaluations of L during the last cycle
+
+ private:
+  RKLegendre<Phys> *rkl;
+  DataBlock *data;
+  Fluid<Phys> *hydro;
+
+  real theta;
+  real targetError;
+  int maxIter;
+  real dt;                          // current time step
+  real time;                        // time at which L is evaluated
+  real normU0;                      // norm of the packed initial state
+
+  int ncells{0};                    // number of packed cell-centered values
+  int size{0};                      // size of the packed vector
+
+  IdefixArray3D<real> x;            // increment of the packed state
+  IdefixArray3D<real> rhs;          // dt L(U0)
+  IdefixArray3D<real> L0;           // L(U0)
+  std::unique_ptr<Bicgstab<ImplicitParabolic<Phys>>> solver;
+};
+
+template<typename Phys>
+ImplicitParabolic<Phys>::ImplicitParabolic(Input &input, RKLegendre<Phys> *rklin) {
+  idfx::pushRegion("ImplicitParabolic::Init");
+  this->rkl = rklin;
+  this->hydro = rklin->hydro;
+  this->data = rklin->data;
+
+  this->theta = input.GetOrSet<real>("RKL","theta",0, 1.0);
+  if(theta < 0.5 || theta > 1.0) {
+    IDEFIX_ERROR("RKL: theta should be between 0.5 (Crank-Nicolson) and 1 (backward Euler)");
+  }
+  this->targetError = input.GetOrSet<real>("RKL","targetError",0, 1e-6);
+  this->maxIter = input.GetOrSet<int>("RKL","maxIter",0, 100);
+
+  #ifdef EVOLVE_VECTOR_POTENTIAL
+  if(rkl->haveVs) {
+    IDEFIX_ERROR("The implicit RKL scheme is not compatible with EVOLVE_VECTOR_POTENTIAL");
+  }
+  #endif
+
+  // Size of the packed vector
+  if(rkl->haveVc) {
+    ncells = rkl->nvarRKL*data->np_int[IDIR]*data->np_int[JDIR]*data->np_int[KDIR];
+  }
+  size = ncells;
+  if(rkl->haveVs) {
+    size += DIMENSIONS*(data->np_int[IDIR]+IOFFSET)
+                      *(data->np_int[JDIR]+JOFFSET)
+                      *(data->np_int[KDIR]+KOFFSET);
+  }
+
+  x = IdefixArray3D<real>("Implicit_x", 1, 1, size);
+  rhs = IdefixArray3D<real>("Implicit_rhs", 1, 1, size);
+  L0 = IdefixArray3D<real>("Implicit_L0", 1, 1, size);
+
+  solver = std::make_unique<Bicgstab<ImplicitParabolic<Phys>>>(*this, targetError, maxIter,
+                                                              std::array<int,3>{size, 1, 1},
+                                                              std::array<int,3>{0, 0, 0},
+                                                              std::array<int,3>{size, 1, 1});
+  idfx::popRegion();
+}
+
+template<typename Phys>
+void ImplicitParabolic<Phys>::ShowConfig() {
+  if(theta == 1.0) {
+    idfx::cout << "RKLegendre: implicit backward Euler scheme ENABLED." << std::endl;
+  } else if(theta == 0.5) {
+    idfx::cout << "RKLegendre: implicit Crank-Nicolson scheme ENABLED." << std::endl;
+  } else {
+    idfx::cout << "RKLegendre: implicit theta scheme ENABLED with theta=" << theta
+               << "." << std::endl;
+  }
+  idfx::cout << "RKLegendre: Bicgstab target error " << targetError << ", at most "
+             << maxIter << " iterations." << std::endl;
+}
+
+// Pack the active cells of the RKL variables of U and the active faces of B in vec
+template<typename Phys>
+template<typename T>
+void ImplicitParabolic<Phys>::Pack(IdefixArray4D<T> U, IdefixArray4D<T> B,
+                                   IdefixArray3D<real> vec) {
+  idfx::pushRegion("ImplicitParabolic::Pack");
+  IdefixArray1D<int> varList = rkl->varList;
+  const int ib = data->beg[IDIR];
+  const int jb = data->beg[JDIR];
+  const int kb = data->beg[KDIR];
+  if(rkl->haveVc) {
+    const int nx = data->np_int[IDIR];
+    const int ny = data->np_int[JDIR];
+    const int nz = data->np_int[KDIR];
+    idefix_for("Implicit_PackCells",
+              0, rkl->nvarRKL,
+              data->beg[KDIR],data->end[KDIR],
+              data->beg[JDIR],data->end[JDIR],
+              data->beg[IDIR],data->end[IDIR],
+      KOKKOS_LAMBDA (int n, int k, int j, int i) {
+        vec(0,0,((n*nz + k-kb)*ny + j-jb)*nx + i-ib) = U(varList(n),k,j,i);
+      });
+  }
+  if(rkl->haveVs) {
+    const int nx = data->np_int[IDIR]+IOFFSET;
+    const int ny = data->np_int[JDIR]+JOFFSET;
+    const int nz = data->np_int[KDIR]+KOFFSET;
+    const int offset = ncells;
+    idefix_for("Implicit_PackFaces",
+              0, DIMENSIONS,
+              data->beg[KDIR],data->end[KDIR]+KOFFSET,
+              data->beg[JDIR],data->end[JDIR]+JOFFSET,
+              data->beg[IDIR],data->end[IDIR]+IOFFSET,
+      KOKKOS_LAMBDA (int n, int k, int j, int i) {
+        vec(0,0,offset + ((n*nz + k-kb)*ny + j-jb)*nx + i-ib) = B(n,k,j,i);
+      });
+  }
+  idfx::popRegion();
+}
+
+// Set the state to U0 + a*vec, and the primitive variables accordingly
+template<typename Phys>
+void ImplicitParabolic<Phys>::SetState(IdefixArray3D<real> vec, real a) {
+  idfx::pushRegion("ImplicitParabolic::SetState");
+  IdefixArray1D<int> varList = rkl->varList;
+  IdefixArray4D<accum> Uc = hydro->Uc;
+  IdefixArray4D<accum> Uc0 = rkl->Uc0;
+  IdefixArray4D<accum> Vs = hydro->Vs;
+  IdefixArray4D<accum> Vs0 = rkl->Vs0;
+  const int ib = data->beg[IDIR];
+  const int jb = data->beg[JDIR];
+  const int kb = data->beg[KDIR];
+  if(rkl->haveVc) {
+    const int nx = data->np_int[IDIR];
+    const int ny = data->np_int[JDIR];
+    const int nz = data->np_int[KDIR];
+    idefix_for("Implicit_SetCells",
+              0, rkl->nvarRKL,
+              data->beg[KDIR],data->end[KDIR],
+              data->beg[JDIR],data->end[JDIR],
+              data->beg[IDIR],data->end[IDIR],
+      KOKKOS_LAMBDA (int n, int k, int j, int i) {
+        const int nv = varList(n);
+        Uc(nv,k,j,i) = Uc0(nv,k,j,i) + a*vec(0,0,((n*nz + k-kb)*ny + j-jb)*nx + i-ib);
+      });
+  }
+  if(rkl->haveVs) {
+    const int nx = data->np_int[IDIR]+IOFFSET;
+    const int ny = data->np_int[JDIR]+JOFFSET;
+    const int nz = data->np_int[KDIR]+KOFFSET;
+    const int offset = ncells;
+    idefix_for("Implicit_SetFaces",
+              0, DIMENSIONS,
+              data->beg[KDIR],data->end[KDIR]+KOFFSET,
+              data->beg[JDIR],data->end[JDIR]+JOFFSET,
+              data->beg[IDIR],data->end[IDIR]+IOFFSET,
+      KOKKOS_LAMBDA (int n, int k, int j, int i) {
+        Vs(n,k,j,i) = Vs0(n,k,j,i) + a*vec(0,0,offset + ((n*nz + k-kb)*ny + j-jb)*nx + i-ib);
+      });
+    hydro->boundary->ReconstructVcField(Uc);
+  }
+
+  // Coarsen the flow if needed
+  if(data->haveGridCoarsening) {
+    data->Coarsen();
+  }
+  hydro->ConvertConsToPrim();
+  idfx::popRegion();
+}
+
+template<typename Phys>
+void ImplicitParabolic<Phys>::Evaluate(real t) {
+  rkl->SetBoundaries(t);
+  rkl->EvolveStage(t);
+  nEval++;
+}
+
+template<typename Phys>
+void ImplicitParabolic<Phys>::operator() (IdefixArray3D<real> in, IdefixArray3D<real> out) {
+  idfx::pushRegion("ImplicitParabolic::Operator");
+  const real norm = std::sqrt(solver->ComputeDotProduct(in, in));
+  if(norm == 0) {
+    Kokkos::deep_copy(out, ZERO_F);
+    idfx::popRegion();
+    return;
+  }
+  // Finite difference step of the Jacobian-vector product
+  const real eps = std::sqrt(std::numeric_limits<real>::epsilon())*(ONE_F + normU0)/norm;
+
+  SetState(in, eps);
+  Evaluate(time);
+  Pack(rkl->dU, rkl->dB, out);
+
+  IdefixArray3D<real> L0 = this->L0;
+  const real coeff = theta*dt/eps;
+  idefix_for("Implicit_Operator",
+             0, size,
+    KOKKOS_LAMBDA (int i) {
+      out(0,0,i) = in(0,0,i) - coeff*(out(0,0,i) - L0(0,0,i));
+    });
+  idfx::popRegion();
+}
+
+template<typename Phys>
+void ImplicitParabolic<Phys>::Cycle() {
+  idfx::pushRegion("ImplicitParabolic::Cycle");
+  this->time = data->t;
+  this->dt = data->dt;
+  this->nEval = 0;
+
+  // Tell the datablock that we're performing the RKL cycle
+  data->rklCycle = true;
+
+  // First evaluation, on the full set of variables
+  rkl->stage = 1;
+  hydro->boundary->SetBoundaries(time);
+  hydro->ConvertPrimToCons();
+  if(data->haveGridCoarsening) {
+    data->Coarsen();
+  }
+  rkl->Copy(rkl->Uc0, hydro->Uc);
+  if(rkl->haveVs) {
+    Kokkos::deep_copy(rkl->Vs0, hydro->Vs);
+  }
+  rkl->EvolveStage(time);
+  nEval++;
+
+  // The following evaluations are only needed on the RKL variables
+  rkl->stage = 2;
+
+  Pack(rkl->Uc0, rkl->Vs0, rhs);
+  normU0 = std::sqrt(solver->ComputeDotProduct(rhs, rhs));
+  Pack(rkl->dU, rkl->dB, L0);
+
+  IdefixArray3D<real> L0 = this->L0;
+  IdefixArray3D<real> rhs = this->rhs;
+  const real dt = this->dt;
+  idefix_for("Implicit_Rhs",
+             0, size,
+    KOKKOS_LAMBDA (int i) {
+      rhs(0,0,i) = dt*L0(0,0,i);
+    });
+
+  Kokkos::deep_copy(x, ZERO_F);
+  // Nothing to solve when the parabolic terms vanish
+  if(solver->ComputeDotProduct(rhs, rhs) > 0) {
+    int n = solver->Solve(x, rhs);
+    if(n < 0) {
+      idfx::cout << "RKLegendre:: BICGSTAB failed, resetting the implicit step" << std::endl;
+      Kokkos::deep_copy(x, ZERO_F);
+      n = solver->Solve(x, rhs);
+      if(n < 0) {
+        IDEFIX_ERROR("RKLegendre:: BICGSTAB failed despite restart");
+      }
+    }
+  }
+
+  // Final state
+  SetState(x, ONE_F);
+  if(rkl->checkNan) {
+    if(data->CheckNan()>0) {
+      throw std::runtime_error(std::string("Nan found during the implicit parabolic step"));
+    }
+  }
+
+  // Report the number of evaluations of the parabolic terms
+  rkl->stage = nEval;
+
+  // Tell the datablock that we're done
+  data->rklCycle = false;
+  idfx::popRegion();
+}
+
+#endif // RKL_IMPLICITPARABOLIC_HPP_
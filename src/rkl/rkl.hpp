@@ -8,6 +8,7 @@
 #ifndef RKL_RKL_HPP_
 #define RKL_RKL_HPP_
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -24,6 +25,9 @@
 template <typename Phys>
 struct RKLegendre_ResetStageFunctor;
 
+template <typename Phys>
+class ImplicitParabolic;
+
 template<typename Phys>
 class RKLegendre {
  public:
@@ -35,23 +39,23 @@ class RKLegendre {
   template <int> void CalcParabolicRHS(real);
   void ComputeDt();
   void ShowConfig();
-  void Copy(IdefixArray4D<real>&, IdefixArray4D<real>&);
+  template <typename T> void Copy(IdefixArray4D<T>&, IdefixArray4D<T>&);
 
   IdefixArray4D<real> dU;      // variation of main cell-centered conservative variables
-  IdefixArray4D<real> dU0;      // dU of the first stage
-  IdefixArray4D<real> Uc0;      // Uc at initial stage
-  IdefixArray4D<real> Uc1;      // Uc of the previous stage, Uc1 = Uc(stage-1)
+  IdefixArray4D<real> dU0;     // dU of the first stage
+  IdefixArray4D<accum> Uc0;    // Uc at initial stage
+  IdefixArray4D<accum> Uc1;    // Uc of the previous stage, Uc1 = Uc(stage-1)
 
   IdefixArray4D<real> dB;      // Variation of cell-centered magnetic variables
   IdefixArray4D<real> dB0;     // dB of the first stage
-  IdefixArray4D<real> Vs0;     // Vs of initial stage
-  IdefixArray4D<real> Vs1;     // Vs of previous stage
+  IdefixArray4D<accum> Vs0;    // Vs of initial stage
+  IdefixArray4D<accum> Vs1;    // Vs of previous stage
 
   #ifdef EVOLVE_VECTOR_POTENTIAL
   IdefixArray4D<real> dA;      // Variation of edge-centered vector potential
   IdefixArray4D<real> dA0;     // dA of the first stage
-  IdefixArray4D<real> Ve0;     // Ve of initial stage
-  IdefixArray4D<real> Ve1;     // Ve of previous stage
+  IdefixArray4D<accum> Ve0;    // Ve of initial stage
+  IdefixArray4D<accum> Ve1;    // Ve of previous stage
   #endif
 
   IdefixArray1D<int> varList;  // List of variables which should be evolved
@@ -60,8 +64,12 @@ class RKLegendre {
   real dt, cfl_rkl, rmax_par;
   int stage{0};
 
+  bool isImplicit{false};       // Whether the parabolic terms are integrated implicitly
+
  private:
   friend struct RKLegendre_ResetStageFunctor<Phys>;
+  friend class ImplicitParabolic<Phys>;
+  std::unique_ptr<ImplicitParabolic<Phys>> implicit;
   void SetBoundaries(real);        // Enforce boundary conditions on the variables solved by RKL
 
   DataBlock *data;
@@ -83,6 +91,7 @@ class RKLegendre {
 
 #include "fluid.hpp"
 #include "calcParabolicFlux.hpp"
+#include "implicitParabolic.hpp"
 
 #ifndef RKL_ORDER
   #define RKL_ORDER       2
@@ -106,7 +115,8 @@ void RKLegendre<Phys>::AddVariable(int var, std::vector<int> &varListHost ) {
 
 // Copy just the variables required by the RK scheme
 template<typename Phys>
-void RKLegendre<Phys>::Copy(IdefixArray4D<real> &out, IdefixArray4D<real> &in) {
+template<typename T>
+void RKLegendre<Phys>::Copy(IdefixArray4D<T> &out, IdefixArray4D<T> &in) {
   IdefixArray1D<int> vars = this->varList;
 
   idefix_for("RKL_Copy",
@@ -138,6 +148,13 @@ RKLegendre<Phys>::RKLegendre(Input &input, Fluid<Phys>* hydroin) {
 
   this->checkNan = input.GetOrSet<bool>("RKL","check_nan",0, this->checkNan);
 
+  std::string scheme = input.GetOrSet<std::string>("RKL","scheme",0, "legendre");
+  if(scheme.compare("implicit") == 0) {
+    isImplicit = true;
+  } else if(scheme.compare("legendre") != 0) {
+    IDEFIX_ERROR("Unknown RKL scheme " + scheme + ". Use legendre or implicit.");
+  }
+
   // Make a list of variables
 
   std::vector<int> varListHost;
@@ -208,9 +225,9 @@ RKLegendre<Phys>::RKLegendre(Input &input, Fluid<Phys>* hydroin) {
                            data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
   dU0 = IdefixArray4D<real>("RKL_dU0", NVAR,
                            data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-  Uc0 = IdefixArray4D<real>("RKL_Uc0", NVAR,
+  Uc0 = IdefixArray4D<accum>("RKL_Uc0", NVAR,
                            data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
-  Uc1 = IdefixArray4D<real>("RKL_Uc1", NVAR,
+  Uc1 = IdefixArray4D<accum>("RKL_Uc1", NVAR,
                            data->np_tot[KDIR], data->np_tot[JDIR], data->np_tot[IDIR]);
 
   if(haveVs) {
@@ -223,11 +240,11 @@ RKLegendre<Phys>::RKLegendre(Input &input, Fluid<Phys>* hydroin) {
                         data->np_tot[KDIR]+KOFFSET,
                         data->np_tot[JDIR]+JOFFSET,
                         data->np_tot[IDIR]+IOFFSET);
-      Ve0 = IdefixArray4D<real>("RKL_Ve0", AX3e+1,
+      Ve0 = IdefixArray4D<accum>("RKL_Ve0", AX3e+1,
                         data->np_tot[KDIR]+KOFFSET,
                         data->np_tot[JDIR]+JOFFSET,
                         data->np_tot[IDIR]+IOFFSET);
-      Ve1 = IdefixArray4D<real>("RKL_Ve1", AX3e+1,
+      Ve1 = IdefixArray4D<accum>("RKL_Ve1", AX3e+1,
                         data->np_tot[KDIR]+KOFFSET,
                         data->np_tot[JDIR]+JOFFSET,
                         data->np_tot[IDIR]+IOFFSET);
@@ -240,32 +257,40 @@ RKLegendre<Phys>::RKLegendre(Input &input, Fluid<Phys>* hydroin) {
                         data->np_tot[KDIR]+KOFFSET,
                         data->np_tot[JDIR]+JOFFSET,
                         data->np_tot[IDIR]+IOFFSET);
-      Vs0 = IdefixArray4D<real>("RKL_Vs0", DIMENSIONS,
+      Vs0 = IdefixArray4D<accum>("RKL_Vs0", DIMENSIONS,
                         data->np_tot[KDIR]+KOFFSET,
                         data->np_tot[JDIR]+JOFFSET,
                         data->np_tot[IDIR]+IOFFSET);
-      Vs1 = IdefixArray4D<real>("RKL_Vs1", DIMENSIONS,
+      Vs1 = IdefixArray4D<accum>("RKL_Vs1", DIMENSIONS,
                         data->np_tot[KDIR]+KOFFSET,
                         data->np_tot[JDIR]+JOFFSET,
                         data->np_tot[IDIR]+IOFFSET);
     #endif
   }
 
+  if(isImplicit) {
+    implicit = std::make_unique<ImplicitParabolic<Phys>>(input, this);
+  }
+
   idfx::popRegion();
 }
 
 template<typename Phys>
 void RKLegendre<Phys>::ShowConfig() {
-  #if RKL_ORDER == 1
-    idfx::cout << "RKLegendre: 1st order scheme ENABLED." << std::endl;
-  #elif RKL_ORDER == 2
-    idfx::cout << "RKLegendre: 2nd order scheme ENABLED." << std::endl;
-  #else
-    IDEFIX_ERROR("Unknown RKL scheme order");
-  #endif
-  idfx::cout << "RKLegendre: RKL cfl set to " << cfl_rkl <<  "." << std::endl;
-  idfx::cout << "RKLegendre: maximum ratio hyperbolic/parabolic timestep "
-             << rmax_par <<  "." << std::endl;
+  if(isImplicit) {
+    implicit->ShowConfig();
+  } else {
+    #if RKL_ORDER == 1
+      idfx::cout << "RKLegendre: 1st order scheme ENABLED." << std::endl;
+    #elif RKL_ORDER == 2
+      idfx::cout << "RKLegendre: 2nd order scheme ENABLED." << std::endl;
+    #else
+      IDEFIX_ERROR("Unknown RKL scheme order");
+    #endif
+    idfx::cout << "RKLegendre: RKL cfl set to " << cfl_rkl <<  "." << std::endl;
+    idfx::cout << "RKLegendre: maximum ratio hyperbolic/parabolic timestep "
+               << rmax_par <<  "." << std::endl;
+  }
   if(haveVc) {
      idfx::cout << "RKLegendre: will evolve cell-centered fields Vc." << std::endl;
   }
@@ -280,26 +305,30 @@ void RKLegendre<Phys>::ShowConfig() {
 
 template<typename Phys>
 void RKLegendre<Phys>::Cycle() {
+  if(isImplicit) {
+    implicit->Cycle();
+    return;
+  }
   idfx::pushRegion("RKLegendre::Cycle");
 
   IdefixArray4D<real> dU = this->dU;
   IdefixArray4D<real> dU0 = this->dU0;
-  IdefixArray4D<real> Uc = hydro->Uc;
-  IdefixArray4D<real> Uc0 = this->Uc0;
-  IdefixArray4D<real> Uc1 = this->Uc1;
+  IdefixArray4D<accum> Uc = hydro->Uc;
+  IdefixArray4D<accum> Uc0 = this->Uc0;
+  IdefixArray4D<accum> Uc1 = this->Uc1;
 
   IdefixArray4D<real> dB = this->dB;
   IdefixArray4D<real> dB0 = this->dB0;
-  IdefixArray4D<real> Vs = hydro->Vs;
-  IdefixArray4D<real> Vs0 = this->Vs0;
-  IdefixArray4D<real> Vs1 = this->Vs1;
+  IdefixArray4D<accum> Vs = hydro->Vs;
+  IdefixArray4D<accum> Vs0 = this->Vs0;
+  IdefixArray4D<accum> Vs1 = this->Vs1;
 
   #ifdef EVOLVE_VECTOR_POTENTIAL
   IdefixArray4D<real> dA = this->dA;
   IdefixArray4D<real> dA0 = this->dA0;
-  IdefixArray4D<real> Ve = hydro->Ve;
-  IdefixArray4D<real> Ve0 = this->Ve0;
-  IdefixArray4D<real> Ve1 = this->Ve1;
+  IdefixArray4D<accum> Ve = hydro->Ve;
+  IdefixArray4D<accum> Ve0 = this->Ve0;
+  IdefixArray4D<accum> Ve1 = this->Ve1;
   #endif
 
   IdefixArray1D<int> varList = this->varList;
@@ -472,7 +501,7 @@ void RKLegendre<Phys>::Cycle() {
               data->beg[IDIR],data->end[IDIR],
         KOKKOS_LAMBDA (int n, int k, int j, int i) {
           const int nv = varList(n);
-          real Y = mu_j*Uc(nv,k,j,i) + nu_j*Uc1(nv,k,j,i);
+          accum Y = mu_j*Uc(nv,k,j,i) + nu_j*Uc1(nv,k,j,i);
           Uc1(nv,k,j,i) = Uc(nv,k,j,i);
   #if RKL_ORDER == 1
           Uc(nv,k,j,i) = Y + dt_hyp*mu_tilde_j*dU(nv,k,j,i);
@@ -492,7 +521,7 @@ void RKLegendre<Phys>::Cycle() {
                 data->beg[JDIR],data->end[JDIR]+JOFFSET,
                 data->beg[IDIR],data->end[IDIR]+IOFFSET,
           KOKKOS_LAMBDA (int n, int k, int j, int i) {
-            real Y = mu_j*Ve(n,k,j,i) + nu_j*Ve1(n,k,j,i);
+            accum Y = mu_j*Ve(n,k,j,i) + nu_j*Ve1(n,k,j,i);
             Ve1(n,k,j,i) = Ve(n,k,j,i);
             #if RKL_ORDER == 1
               Ve(n,k,j,i) = Y + dt_hyp*mu_tilde_j*dA(n,k,j,i);
@@ -511,7 +540,7 @@ void RKLegendre<Phys>::Cycle() {
                 data->beg[JDIR],data->end[JDIR]+JOFFSET,
                 data->beg[IDIR],data->end[IDIR]+IOFFSET,
           KOKKOS_LAMBDA (int n, int k, int j, int i) {
-            real Y = mu_j*Vs(n,k,j,i) + nu_j*Vs1(n,k,j,i);
+            accum Y = mu_j*Vs(n,k,j,i) + nu_j*Vs1(n,k,j,i);
             Vs1(n,k,j,i) = Vs(n,k,j,i);
             #if RKL_ORDER == 1
               Vs(n,k,j,i) = Y + dt_hyp*mu_tilde_j*dB(n,k,j,i);
@@ -17,6 +17,7 @@
 #include "dataBlock.hpp"
 #include "stateContainer.hpp"
 #include "fluid.hpp"
+#include "localTimeStepping.hpp"
 #include "planetarySystem.hpp"
 
 
@@ -27,7 +28,22 @@ TimeIntegrator::TimeIntegrator(Input & input, DataBlock & data) {
   this->lastLog=timer.seconds();
   this->lastMpiLog=idfx::mpiCallsTimer + idfx::mpiCallsTimer;
 
-  nstages=input.Get<int>("TimeIntegrator","nstages",0);
+  // Time integration scheme. The historical schemes can also be selected from nstages
+  if(input.CheckEntry("TimeIntegrator","scheme")>0) {
+    scheme = input.Get<std::string>("TimeIntegrator","scheme",0);
+  } else {
+    nstages = input.Get<int>("TimeIntegrator","nstages",0);
+    if(nstages==1) {
+      scheme = "euler";
+    } else if(nstages==2) {
+      scheme = "rk2";
+    } else if(nstages==3) {
+      scheme = "rk3";
+    } else {
+      IDEFIX_ERROR("nstages should be 1, 2 or 3. Use [TimeIntegrator] scheme for other schemes");
+    }
+  }
+  MakeScheme();
 
   if(input.CheckEntry("TimeIntegrator","fixed_dt")>0) {
     this->haveFixedDt = true;
@@ -56,32 +72,116 @@ TimeIntegrator::TimeIntegrator(Input & input, DataBlock & data) {
   this->maxdivB = input.GetOrSet<real>("TimeIntegrator","maxdivB", 0,maxdivBDefault);
 
 
+  // Measure the compute time of each process over the first cycles to rebalance the domain
+  // decomposition
+  #ifdef WITH_MPI
+  if(idfx::psize>1) {
+    this->rebalanceCycles = input.GetOrSet<int>("TimeIntegrator","rebalance", 0, -1);
+  }
+  #endif
+
   data.t=0.0;
   ncycles=0;
 
-  if(nstages==2) {
-    wc[0] = 0.5;
-    w0[0] = 0.5;
-  }
-  if(nstages==3) {
-    wc[0] = 0.25;
-    w0[0] = 0.75;
-    wc[1] = 2.0/3.0;
-    w0[1] = 1.0/3.0;
-  }
-
   // Init the RKL scheme if it's needed
   if(data.hydro->haveRKLParabolicTerms) {
     haveRKL = true;
   }
 
-  // If multi-stage, create a new state in the datablock called "begin"
-  if(nstages>1) {
+  AttachDataBlock(data);
+
+  idfx::popRegion();
+}
+
+void TimeIntegrator::MakeScheme() {
+  if(scheme.compare("euler") == 0) {
+    stages.resize(1);
+  } else if(scheme.compare("rk2") == 0) {
+    stages.resize(2);
+    stages[1].combine = true;
+    stages[1].wc = 0.5;
+    stages[1].w0 = 0.5;
+  } else if(scheme.compare("rk3") == 0) {
+    stages.resize(3);
+    stages[1].combine = true;
+    stages[1].wc = 0.25;
+    stages[1].w0 = 0.75;
+    stages[2].combine = true;
+    stages[2].wc = 2.0/3.0;
+    stages[2].w0 = 1.0/3.0;
+  } else if(scheme.compare("ssprk42") == 0) {
+    // SSPRK(4,2): 3 Euler steps of dt/3, then average with the initial state
+    stages.resize(4);
+    for(auto &stage : stages) stage.dtFactor = 1.0/3.0;
+    stages[3].combine = true;
+    stages[3].wc = 0.75;
+    stages[3].w0 = 0.25;
+    sspCoefficient = 3;
+  } else if(scheme.compare("ssprk43") == 0) {
+    // SSPRK(4,3) of Kraaijevanger (1991)
+    stages.resize(4);
+    for(auto &stage : stages) stage.dtFactor = 0.5;
+    stages[2].combine = true;
+    stages[2].wc = 1.0/3.0;
+    stages[2].w0 = 2.0/3.0;
+    sspCoefficient = 2;
+  } else if(scheme.compare("ssprk104") == 0) {
+    // Low-storage SSPRK(10,4) of Ketcheson (2008)
+    stages.resize(10);
+    for(auto &stage : stages) stage.dtFactor = 1.0/6.0;
+    stages[4].updateBegin = true;
+    stages[4].wb[0] = 1.0/25.0;
+    stages[4].wb[1] = 9.0/25.0;
+    stages[4].combine = true;
+    stages[4].wc = -5.0;
+    stages[4].w0 = 15.0;
+    stages[9].combine = true;
+    stages[9].wc = 0.6;
+    stages[9].w0 = 1.0;
+    sspCoefficient = 6;
+  } else {
+    IDEFIX_ERROR("Unknown time integration scheme "+scheme+". Valid schemes are euler, rk2, rk3, "
+                 "ssprk42, ssprk43 and ssprk104.");
+  }
+  nstages = stages.size();
+  for(auto const &stage : stages) {
+    if(stage.combine || stage.updateBegin) haveBeginState = true;
+  }
+}
+
+void TimeIntegrator::AttachDataBlock(DataBlock &data) {
+  // If the scheme needs it, create a new state in the datablock called "begin"
+  if(haveBeginState) {
     data.states["begin"] = StateContainer();
     data.states["begin"].AllocateAs(data.states["current"]);
   }
-
-  idfx::popRegion();
+  predictedImbalance = data.mygrid->predictedImbalance;
+
+  if(data.haveLocalTimeStepping) {
+    if(haveFixedDt) IDEFIX_ERROR("Local time stepping requires an adaptive time step");
+    // Time step factor, time and weight in the complete step of the right hand side of each
+    // stage, obtained by following the registers of the scheme
+    std::vector<real> dtFactor(nstages), stageTime(nstages);
+    std::vector<real> current(nstages, 0), begin(nstages, 0);
+    real tCurrent = 0;
+    real tBegin = 0;
+    for(int s = 0 ; s < nstages ; s++) {
+      const RKStage &rk = stages[s];
+      dtFactor[s] = rk.dtFactor;
+      stageTime[s] = tCurrent;
+      current[s] += rk.dtFactor;
+      tCurrent += rk.dtFactor;
+      if(rk.updateBegin) {
+        for(int n = 0 ; n < nstages ; n++) begin[n] = rk.wb[0]*begin[n] + rk.wb[1]*current[n];
+        tBegin = rk.wb[0]*tBegin + rk.wb[1]*tCurrent;
+      }
+      if(rk.combine) {
+        for(int n = 0 ; n < nstages ; n++) current[n] = rk.wc*current[n] + rk.w0*begin[n];
+        tCurrent = rk.wc*tCurrent + rk.w0*tBegin;
+      }
+    }
+    data.lts->SetScheme(dtFactor, stageTime, current);
+  }
 }
 
 
@@ -224,6 +324,8 @@ double TimeIntegrator::ComputeBalance() {
           idfx::cout << "-------------------------------------------------------------"<< std::endl;
           idfx::cout << "Warning: MPI imbalance found in this run " << std::endl;
           idfx::cout << std::fixed;
+          idfx::cout << "Measured imbalance: " << imbalance << "%, expected from the domain "
+                     << "decomposition: " << predictedImbalance << "%" << std::endl;
           for(int i = 0 ; i < idfx::psize ; i++) {
             if(computeLogPerCore[i]/computeMean - 1> allowedImbalance/2/100) {
               idfx::cout << "+" << 100*(computeLogPerCore[i]/computeMean-1)
@@ -261,10 +363,20 @@ void TimeIntegrator::Cycle(DataBlock &data) {
 
   // save t at the begining of the cycle
   const real t0 = data.t;
+  // time of the "begin" register
+  real tBegin = t0;
 
   // Reinit datablock for a new stage
   data.ResetStage();
 
+  // With local time stepping, the cycle is made of passes, each of them advancing the bands of
+  // one level by their own step
+  int npasses = 1;
+  if(data.haveLocalTimeStepping) {
+    data.lts->BeginCycle(t0);
+    npasses = data.lts->GetNPasses();
+  }
+
 #ifdef WITH_MPI
   MPI_Request dtReduce;
 #endif
@@ -272,9 +384,26 @@ void TimeIntegrator::Cycle(DataBlock &data) {
   /////////////////////////////////////////////////
   // BEGIN STAGES LOOP                           //
   /////////////////////////////////////////////////
-  for(int stage=0; stage < nstages ; stage++) {
-    // Apply Boundary conditions
-    data.SetBoundaries();
+  for(int step=0; step < npasses*nstages ; step++) {
+    const int pass = step / nstages;
+    const int stage = step % nstages;
+    const RKStage &rk = stages[stage];
+    real stageDt = rk.dtFactor*data.dt;
+
+    if(data.haveLocalTimeStepping) {
+      if(stage==0) data.t = data.lts->BeginPass(pass);
+      stageDt = rk.dtFactor*data.lts->GetPassDt();
+    }
+
+    // Apply Boundary conditions (possibly completed in EvolveStage when mpiOverlap is on).
+    // The exchanges in flight are safe with the kernels which follow until EvolveStage: the
+    // send buffers have been packed (and fenced) by SetBoundariesBegin, and the received ghost
+    // zones are only unpacked by SetBoundariesEnd. PrimToCons converts stale ghost cells, but
+    // the conservative variables of the ghost zones are never used by the update. Self-gravity
+    // only reads the active cells, and its own exchanges use different tags. User-defined
+    // potentials and body forces should not read the hydro ghost cells in this mode. Fargo,
+    // which would modify Vc, is not compatible with mpiOverlap.
+    data.SetBoundariesBegin();
 
     // Remove Fargo velocity so that the integrator works on the residual
     if(data.haveFargo) data.fargo->SubstractVelocity(data.t);
@@ -283,8 +412,9 @@ void TimeIntegrator::Cycle(DataBlock &data) {
     data.PrimToCons();
 
     // Store (deep copy) initial stage for multi-stage time integrators
-    if(nstages>1 && stage==0) {
+    if(haveBeginState && stage==0) {
       data.states["begin"].CopyFrom(data.states["current"]);
+      tBegin = data.t;
     }
     // If gravity is needed, update it
     if(data.haveGravity) {
@@ -292,14 +422,23 @@ void TimeIntegrator::Cycle(DataBlock &data) {
     }
 
     Kokkos::fence();
-    computeLastLog -= timer.seconds();
+    const double computeStart = timer.seconds();
+    const double mpiStart = idfx::mpiCallsTimer;
     // Update Uc & Vs
-    data.EvolveStage();
+    if(data.haveLocalTimeStepping) {
+      data.lts->EvolveStage(stage);
+    } else {
+      data.EvolveStage(stageDt);
+    }
     Kokkos::fence();
-    computeLastLog += timer.seconds();
+    computeLastLog += timer.seconds() - computeStart;
+    if(ncycles < rebalanceCycles) {
+      // Exclude the time spent waiting for the neighbours
+      computeRebalance += timer.seconds() - computeStart - (idfx::mpiCallsTimer - mpiStart);
+    }
 
     // evolve dt accordingly
-    data.t += data.dt;
+    data.t += stageDt;
 
     // Look for Nans every now and then (this actually cost a lot of time on GPUs
     // because streams are divergent)
@@ -310,27 +449,32 @@ void TimeIntegrator::Cycle(DataBlock &data) {
     }
 
     // Compute next time_step during first stage
-    if(stage==0) {
-      if(!haveFixedDt) {
-        newdt = cfl*data.ComputeTimestep();
-        #ifdef WITH_MPI
-          if(idfx::psize>1) {
-            MPI_SAFE_CALL(MPI_Iallreduce(MPI_IN_PLACE, &newdt, 1, realMPI, MPI_MIN, MPI_COMM_WORLD,
-                                        &dtReduce));
-          }
-        #endif
-      }
+    if(data.haveLocalTimeStepping) {
+      // Each level measures its time step during its first pass
+      if(stage==0) data.lts->MeasureTimestep();
+    } else if(step==0 && !haveFixedDt) {
+      newdt = cfl*sspCoefficient*data.ComputeTimestep();
+      #ifdef WITH_MPI
+        if(idfx::psize>1) {
+          MPI_SAFE_CALL(MPI_Iallreduce(MPI_IN_PLACE, &newdt, 1, realMPI, MPI_MIN, MPI_COMM_WORLD,
+                                      &dtReduce));
+        }
+      #endif
     }
 
-    // Is this not the first stage?
-    if(stage>0) {
-      // do the partial evolution required by the multi-step
-      real wcs=wc[stage-1];
-      real w0s=w0[stage-1];
-      data.states["current"].AddAndStore(wcs, w0s, data.states["begin"]);
-
+    // Combine the registers as required by the scheme
+    if(rk.updateBegin) {
+      data.states["begin"].AddAndStore(rk.wb[0], rk.wb[1], data.states["current"]);
+      tBegin = rk.wb[0]*tBegin + rk.wb[1]*data.t;
+    }
+    if(rk.combine) {
+      data.states["current"].AddAndStore(rk.wc, rk.w0, data.states["begin"]);
       // update t
-      data.t = wcs*data.t + w0s*t0;
+      data.t = rk.wc*data.t + rk.w0*tBegin;
+    }
+    // Correct the interfaces between bands which are synchronised at the end of this pass
+    if(data.haveLocalTimeStepping && stage==nstages-1) {
+      data.lts->EndPass();
     }
     // Shift solution according to fargo if this is our last stage
     if(data.haveFargo && stage==nstages-1) {
@@ -352,9 +496,14 @@ void TimeIntegrator::Cycle(DataBlock &data) {
   // END STAGES LOOP                             //
   /////////////////////////////////////////////////
 
+  // Time step measured by the passes, which also sets the levels of the next cycle
+  if(data.haveLocalTimeStepping) {
+    newdt = data.lts->ComputeTimestep(cfl*sspCoefficient);
+  }
+
   // Wait for dt MPI reduction
 #ifdef WITH_MPI
-  if(!haveFixedDt && idfx::psize>1) {
+  if(!haveFixedDt && !data.haveLocalTimeStepping && idfx::psize>1) {
     MPI_SAFE_CALL(MPI_Wait(&dtReduce, MPI_STATUS_IGNORE));
   }
 #endif
@@ -363,7 +512,9 @@ void TimeIntegrator::Cycle(DataBlock &data) {
     data.EvolveRKLStage();
   }
 
-  // Update planet position
+  // Update planet position. Whatever the number of stages, the planets are advanced once per
+  // cycle by their own integrator over the full time step, the fluid stages seeing them at their
+  // position of the beginning of the cycle.
   if(data.haveplanetarySystem) {
     data.planetarySystem->EvolveSystem(data, data.dt);
   }
@@ -379,7 +530,7 @@ void TimeIntegrator::Cycle(DataBlock &data) {
   // Update current time (should have already been done, but this gets rid of roundoff errors)
   data.t=t0+data.dt;
 
-  if(haveRKL) {
+  if(haveRKL && !data.hydro->rkl->isImplicit) {
     // update next time step
     real tt = newdt/data.hydro->rkl->dt;
     newdt *= std::fmin(ONE_F, data.hydro->rkl->rmax_par/(tt));
@@ -417,6 +568,14 @@ int64_t TimeIntegrator::GetNCycles() {
   return(ncycles);
 }
 
+bool TimeIntegrator::RebalanceRequested() {
+  return(ncycles == rebalanceCycles);
+}
+
+double TimeIntegrator::GetRebalanceTime() {
+  return(computeRebalance);
+}
+
 // Check whether our maximumruntime has been reached. Reduce the results on all of the cores
 // to make sure they stop simultaneously even if running time are not perfectly in sync
 bool TimeIntegrator::CheckForMaxRuntime() {
@@ -446,14 +605,16 @@ bool TimeIntegrator::CheckForMaxRuntime() {
 }
 
 void TimeIntegrator::ShowConfig() {
-  if(nstages==1) {
+  if(scheme.compare("euler") == 0) {
     idfx::cout << "TimeIntegrator: using 1st Order (EULER) integrator." << std::endl;
-  } else if(nstages==2) {
+  } else if(scheme.compare("rk2") == 0) {
     idfx::cout << "TimeIntegrator: using 2nd Order (RK2) integrator." << std::endl;
-  } else if(nstages==3) {
+  } else if(scheme.compare("rk3") == 0) {
     idfx::cout << "TimeIntegrator: using 3rd Order (RK3) integrator." << std::endl;
   } else {
-    IDEFIX_ERROR("Unknown time integrator");
+    idfx::cout << "TimeIntegrator: using low-storage " << scheme << " integrator with "
+               << nstages << " stages. The time step is " << sspCoefficient << " times the "
+               << "Euler time step." << std::endl;
   }
   if(haveFixedDt) {
     idfx::cout << "TimeIntegrator: Using fixed dt=" << fixedDt << ". Ignoring CFL and first_dt."
@@ -464,4 +625,8 @@ void TimeIntegrator::ShowConfig() {
   if(maxRuntime>0) {
     idfx::cout << "TimeIntegrator: will stop after " << maxRuntime/3600 << " hours." << std::endl;
   }
+  if(rebalanceCycles>0) {
+    idfx::cout << "TimeIntegrator: will rebalance the domain decomposition after "
+               << rebalanceCycles << " cycles." << std::endl;
+  }
 }
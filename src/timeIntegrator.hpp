@@ -8,6 +8,8 @@
 #ifndef TIMEINTEGRATOR_HPP_
 #define TIMEINTEGRATOR_HPP_
 
+#include <string>
+#include <vector>
 #include "idefix.hpp"
 #include "dataBlock.hpp"
 #include "rkl.hpp"
@@ -27,6 +29,11 @@ class TimeIntegrator {
   // check whether we have reached the maximum runtime
   bool CheckForMaxRuntime();
 
+  // Whether the domain decomposition should be rebalanced after this cycle
+  bool RebalanceRequested();
+  double GetRebalanceTime();    // Compute time measured for the rebalance
+  void AttachDataBlock(DataBlock &); // Prepare a (new) datablock to be integrated
+
   void ShowLog(DataBlock &);    //<  Display progress log
   void ShowConfig();            //< Show configuration of time integrator
 
@@ -34,14 +41,31 @@ class TimeIntegrator {
 
  private:
   double ComputeBalance(); // Compute the compute balance between MPI processes
+  void MakeScheme();       // Build the stages of the time integration scheme
 
   // Whether we have RKL
   bool haveRKL{false};
 
+  // One stage of a strong stability preserving Runge-Kutta scheme, written in Shu-Osher form
+  // with two registers, "current" and "begin" (a copy of the state at the beginning of the cycle):
+  // current = current + dtFactor*dt*L(current)
+  // begin = wb[0]*begin + wb[1]*current    (when updateBegin)
+  // current = wc*current + w0*begin        (when combine)
+  // The weights are in the precision of the state, so that they sum up to one exactly
+  struct RKStage {
+    real dtFactor{1};
+    bool updateBegin{false};
+    accum wb[2]{0, 0};
+    bool combine{false};
+    accum wc{0};
+    accum w0{0};
+  };
+
   int nstages;
-  // Weights of time integrator
-  real w0[2];
-  real wc[2];
+  std::vector<RKStage> stages;
+  std::string scheme;
+  real sspCoefficient{1};   // Largest time step of the scheme, in units of the Euler time step
+  bool haveBeginState{false};
 
   int checkNanPeriodicity{1};
 
@@ -54,6 +78,9 @@ class TimeIntegrator {
   int64_t ncycles;        // # of cycles
 
   double computeLastLog;  // Timer for actual computeTime
+  double predictedImbalance{0}; // Imbalance (%) expected from the domain decomposition
+  int64_t rebalanceCycles{-1};  // # of cycles measured before rebalancing (disabled when <0)
+  double computeRebalance{0};   // compute time measured for the rebalance (excluding MPI)
 
   double lastLog;         // time for the last log (s)
   double lastMpiLog;      // time for the last MPI log (s)
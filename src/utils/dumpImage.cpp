@@ -69,9 +69,10 @@ DumpImage::DumpImage(std::string filename, DataBlock *data, bool enableDomainDec
     dump.ReadSerial(fileHdl, ndim, nx, type, reinterpret_cast<void*>( this->xr[dir].data()) );
   }
 
+  GridBox gridBox;   // Part of the domain loaded when the domain decomposition is enabled
   if(enableDomainDecomposition) {
     #ifdef WITH_MPI
-      GridBox gridBox = GetBox(data);
+      gridBox = GetBox(data);
       // Create sub-x domains
       for(int dir = 0 ; dir < 3 ; dir ++) {
         IdefixHostArray1D<real> xLoc("DumpImageX",gridBox.size[dir]);
@@ -141,7 +142,14 @@ DumpImage::DumpImage(std::string filename, DataBlock *data, bool enableDomainDec
                                     ("DumpImage"+fieldName,nxloc[2],nxloc[1],nxloc[0] );
 
         // load the data
-        if(nType==0) {
+        if(type == CompressedType) {
+          GridBox box = gridBox;
+          for(int dir = 0 ; dir < 3; dir++) {
+            box.size[dir] = nxloc[dir];
+            box.sizeGlob[dir] = nx[dir];
+          }
+          dump.ReadCompressed(fileHdl, box, this->arrays[fieldName].data());
+        } else if(nType==0) {
           dump.ReadDistributed(fileHdl, ndim, nxloc, nx, dump.descCR,
                               reinterpret_cast<void*>(this->arrays[fieldName].data()) );
         } else if(nType==1) {
@@ -155,8 +163,18 @@ DumpImage::DumpImage(std::string filename, DataBlock *data, bool enableDomainDec
       } else {
         this->arrays[fieldName] = IdefixHostArray3D<real>("DumpImage"+fieldName,nx[2],nx[1],nx[0]);
         // Load it
-        dump.ReadSerial(fileHdl,ndim,nx,type,
-                        reinterpret_cast<void*>(this->arrays[fieldName].data()));
+        if(type == CompressedType) {
+          GridBox box;
+          for(int dir = 0 ; dir < 3; dir++) {
+            box.start[dir] = 0;
+            box.size[dir] = nx[dir];
+            box.sizeGlob[dir] = nx[dir];
+          }
+          dump.ReadCompressed(fileHdl, box, this->arrays[fieldName].data());
+        } else {
+          dump.ReadSerial(fileHdl,ndim,nx,type,
+                          reinterpret_cast<void*>(this->arrays[fieldName].data()));
+        }
       }
     } else if(fieldName.compare("time") == 0) {
       dump.ReadSerial(fileHdl, ndim, nx, type, &this->time);
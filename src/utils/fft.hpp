@@ -0,0 +1,97 @@
+// ***********************************************************************************
+// Idefix MHD astrophysical code
+// Copyright(C) Geoffroy R. J. Lesur <geoffroy.lesur@univ-grenoble-alpes.fr>
+// and other code contributors
+// Licensed under CeCILL 2.1 License, see COPYING for more information
+// ***********************************************************************************
+
+#ifndef UTILS_FFT_HPP_
+#define UTILS_FFT_HPP_
+
+#include <cmath>
+#include <string>
+#include "idefix.hpp"
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+/// Building blocks of a self-contained mixed-radix Stockham FFT, computing the transform of a
+/// single line from within a kernel (one line per thread). The lines may be strided, so that
+/// they can be interleaved in team scratch memory.
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
+using FftComplex = Kokkos::complex<real>;
+
+// Factorisation of a line length in the radices of the FFT stages
+struct FftRadices {
+  int n{0};
+  int r[32];
+};
+
+inline FftRadices FftFactorise(int n) {
+  FftRadices radix;
+  auto add = [&](int r) {
+    while(n % r == 0) {
+      radix.r[radix.n++] = r;
+      n /= r;
+    }
+  };
+  add(4);
+  add(2);
+  add(3);
+  add(5);
+  for(int r = 7 ; n > 1 ; r += 2) add(r);
+  return(radix);
+}
+
+// Twiddle factors exp(-2 i pi j/n)
+inline IdefixArray1D<FftComplex> FftTwiddle(const std::string &name, int n) {
+  IdefixArray1D<FftComplex> twiddle(name, n);
+  auto twiddleH = Kokkos::create_mirror_view(twiddle);
+  for(int j = 0 ; j < n ; j++) {
+    const double phi = -2.0*M_PI*j/n;
+    twiddleH(j) = FftComplex(std::cos(phi), std::sin(phi));
+  }
+  Kokkos::deep_copy(twiddle, twiddleH);
+  return(twiddle);
+}
+
+// Unnormalised transform of the line x (element e being x[e*stride]), using the line y of the
+// same shape as work space. sign<0 is the forward transform, sign>0 the backward one.
+// Stockham autosort FFT: each stage of radix r splits the sub-transforms of length len in r
+// sub-transforms of length len/r, reading and writing alternately x and y.
+KOKKOS_INLINE_FUNCTION void FftTransform(FftComplex *x, FftComplex *y, int stride, int n,
+                                         const FftRadices &radix,
+                                         const IdefixArray1D<FftComplex> &twiddle, int sign) {
+  FftComplex *in = x;
+  FftComplex *out = y;
+  int len = n;
+  int s = 1;
+  for(int f = 0 ; f < radix.n ; f++) {
+    const int r = radix.r[f];
+    const int m = len/r;
+    for(int p = 0 ; p < m ; p++) {
+      for(int q = 0 ; q < s ; q++) {
+        for(int v = 0 ; v < r ; v++) {
+          FftComplex acc(ZERO_F, ZERO_F);
+          for(int t = 0 ; t < r ; t++) {
+            FftComplex w = twiddle(((t*v)%r)*(n/r));
+            if(sign > 0) w = Kokkos::conj(w);
+            acc += in[(q + s*(p + t*m))*stride]*w;
+          }
+          FftComplex w = twiddle(p*v*s);
+          if(sign > 0) w = Kokkos::conj(w);
+          out[(q + s*(r*p + v))*stride] = acc*w;
+        }
+      }
+    }
+    FftComplex *tmp = in;
+    in = out;
+    out = tmp;
+    len = m;
+    s *= r;
+  }
+  if(in != x) {
+    for(int e = 0 ; e < n ; e++) x[e*stride] = in[e*stride];
+  }
+}
+
+#endif // UTILS_FFT_HPP_
@@ -36,6 +36,7 @@ class Bicgstab : public IterativeSolver<T> {
   IdefixArray3D<real> work1; // work array
   IdefixArray3D<real> work2; // work array
   IdefixArray3D<real> work3; // work array
+  IdefixArray3D<real> work4; // preconditioned direction (when a preconditioner is set)
 };
 
 template <class T>
@@ -115,7 +116,17 @@ void Bicgstab<T>::InitSolver() {
 
   Kokkos::deep_copy(this->res0, this->res); // (Re)setting reference residual
   Kokkos::deep_copy(this->dir, this->res); // (Re)setting initial searching direction
-  this->linearOperator(this->dir, this->work1); // (Re)setting associated laplacian
+  if(this->preconditioner) {
+    if(this->work4.size() == 0) {
+      this->work4 = IdefixArray3D<real> ("WorkingArray4", this->ntot[KDIR],
+                                                          this->ntot[JDIR],
+                                                          this->ntot[IDIR]);
+    }
+    this->preconditioner(this->dir, this->work4);
+    this->linearOperator(this->work4, this->work1); // (Re)setting associated laplacian
+  } else {
+    this->linearOperator(this->dir, this->work1); // (Re)setting associated laplacian
+  }
 
   // // Resetting parameters
   // this->rho = 1.0;
@@ -139,6 +150,9 @@ void Bicgstab<T>::PerformIter() {
   IdefixArray3D<real> v = this->work1; // Working array, for laplacian dir calculation
   IdefixArray3D<real> s = this->work2; // Working array, for intermediate dir calculation
   IdefixArray3D<real> t = this->work3; // Working array, for laplacian intermediate dir calculation
+  // Right preconditioning: the solution is updated with the preconditioned directions
+  IdefixArray3D<real> dirHat = this->preconditioner ? this->work4 : dir;
+  IdefixArray3D<real> sHat = this->preconditioner ? this->work4 : s;
   real omega;
   real &alpha = this->alpha;
   real &rhoOld = this->rho;
@@ -191,7 +205,8 @@ void Bicgstab<T>::PerformIter() {
   // From now dir is updated
 
   // ***** Step 4.
-  this->linearOperator(dir, v);
+  if(this->preconditioner) this->preconditioner(dir, dirHat);
+  this->linearOperator(dirHat, v);
 
   // from now v is updated (laplacian of dir)
 
@@ -215,7 +230,7 @@ void Bicgstab<T>::PerformIter() {
   // Assumes solution = x_i-1
   idefix_for("FirstUpdatePot", kbeg, kend, jbeg, jend, ibeg, iend,
     KOKKOS_LAMBDA (int k, int j, int i) {
-      solution(k,j,i) = solution(k,j,i) + alpha * dir(k,j,i);
+      solution(k,j,i) = solution(k,j,i) + alpha * dirHat(k,j,i);
     });
 
   // From here solution = h_i
@@ -241,7 +256,8 @@ void Bicgstab<T>::PerformIter() {
     // From here s is updated
 
     // ************** Step 9.
-    this->linearOperator(s, t);
+    if(this->preconditioner) this->preconditioner(s, sHat);
+    this->linearOperator(sHat, t);
 
     // From here t is updated
 
@@ -265,7 +281,7 @@ void Bicgstab<T>::PerformIter() {
     // solution is h_i from step 6.
     idefix_for("SecondUpdatePot", kbeg, kend, jbeg, jend, ibeg, iend,
       KOKKOS_LAMBDA (int k, int j, int i) {
-        solution(k,j,i) = solution(k,j,i) + omega * s(k,j,i);
+        solution(k,j,i) = solution(k,j,i) + omega * sHat(k,j,i);
       });
 
     // From here, solution = x_i
@@ -28,6 +28,7 @@ class Cg : public IterativeSolver<T> {
  private:
   IdefixArray3D<real> p1; // Search direction for gradient descent
   IdefixArray3D<real> s1; // Search direction for gradient descent
+  IdefixArray3D<real> z1; // Preconditioned residual (when a preconditioner is set)
 };
 
 template <class T>
@@ -80,7 +81,17 @@ void Cg<T>::InitSolver() {
   // Residual initialisation
   this->SetRes();
 
-  Kokkos::deep_copy(this->p1, this->res); // (Re)setting reference residual
+  if(this->preconditioner) {
+    if(this->z1.size() == 0) {
+      this->z1 = IdefixArray3D<real> ("z1", this->ntot[KDIR],
+                                            this->ntot[JDIR],
+                                            this->ntot[IDIR]);
+    }
+    this->preconditioner(this->res, this->z1);
+    Kokkos::deep_copy(this->p1, this->z1);
+  } else {
+    Kokkos::deep_copy(this->p1, this->res); // (Re)setting reference residual
+  }
 
   idfx::popRegion();
 }
@@ -94,6 +105,8 @@ void Cg<T>::PerformIter() {
   auto r = this->res;
   auto p1 = this->p1;
   auto s1 = this->s1;
+  // Without preconditioner, the preconditioned residual is the residual itself
+  auto z = this->preconditioner ? this->z1 : this->res;
 
   int ibeg, iend, jbeg, jend, kbeg, kend;
   ibeg = this->beg[IDIR];
@@ -106,7 +119,7 @@ void Cg<T>::PerformIter() {
   // ***** Step 1.
   this->linearOperator(p1, s1);
 
-  real rr = this->ComputeDotProduct(r,r);
+  real rr = this->ComputeDotProduct(r,z);
   //idfx::cout << "rr=" << rr << std::endl;
   real alpha = rr / (this->ComputeDotProduct(p1,s1));
 
@@ -128,7 +141,8 @@ void Cg<T>::PerformIter() {
 
   this->TestErrorL2();
 
-  real beta = this->ComputeDotProduct(r,r) / rr;
+  if(this->preconditioner) this->preconditioner(r, z);
+  real beta = this->ComputeDotProduct(r,z) / rr;
 
   // Checking for Nans
   if(std::isnan(beta)) {
@@ -140,7 +154,7 @@ void Cg<T>::PerformIter() {
 
   idefix_for("UpdateDir", kbeg, kend, jbeg, jend, ibeg, iend,
     KOKKOS_LAMBDA (int k, int j, int i) {
-      p1(k,j,i) = r(k,j,i) + beta * p1(k,j,i);
+      p1(k,j,i) = z(k,j,i) + beta * p1(k,j,i);
     });
 
   idfx::popRegion();
@@ -8,6 +8,7 @@
 #ifndef UTILS_ITERATIVESOLVER_ITERATIVESOLVER_HPP_
 #define UTILS_ITERATIVESOLVER_ITERATIVESOLVER_HPP_
 
+#include <functional>
 #include <vector>
 #include "idefix.hpp"
 #include "vector.hpp"
@@ -20,6 +21,10 @@ class IterativeSolver {
 
   real GetError();  // return the current error of the solver
 
+  // Preconditioner z=M^-1 r applied to the residuals by the Krylov solvers which support it
+  using Preconditioner = std::function<void(IdefixArray3D<real> &r, IdefixArray3D<real> &z)>;
+  void SetPreconditioner(Preconditioner);
+
   virtual int Solve(IdefixArray3D<real> &guess, IdefixArray3D<real> &rhs) = 0;
   virtual void ShowConfig() = 0;
 
@@ -37,6 +42,7 @@ class IterativeSolver {
   int maxiter;        // Maximum iteration allowed to achieve convergence
   bool convStatus;    // Convergence status
   bool restart{false};
+  Preconditioner preconditioner;  // empty when the solver is not preconditioned
   static constexpr bool isVerbose{false}; // Whether the solver should be verbose while iterating
 
   std::array<int,3> beg;
@@ -97,7 +103,7 @@ void IterativeSolver<T>::TestErrorL1() {
 
   // Reduction on the whole grid
   #ifdef WITH_MPI
-  MPI_Allreduce(MPI_IN_PLACE, &normL1Vector.v, 2, realMPI, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, &normL1Vector.v, 2, accumMPI, MPI_SUM, MPI_COMM_WORLD);
   #endif
 
   // Squared error
@@ -155,7 +161,7 @@ void IterativeSolver<T>::TestErrorL2() {
 
   // Reduction on the whole grid
   #ifdef WITH_MPI
-  MPI_Allreduce(MPI_IN_PLACE, &normL2Vector.v, 2, realMPI, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, &normL2Vector.v, 2, accumMPI, MPI_SUM, MPI_COMM_WORLD);
   #endif
 
   // Squared error
@@ -196,7 +202,8 @@ void IterativeSolver<T>::TestErrorLINF() {
   kbeg = this->beg[KDIR];
   kend = this->end[KDIR];
 
-  real maxRes2, rho2;
+  real maxRes2;
+  accum rho2;
 
   // Searching for the maximum residual over the grid
   idefix_reduce("MaxRes2",
@@ -213,15 +220,15 @@ void IterativeSolver<T>::TestErrorLINF() {
                 kbeg, kend,
                 jbeg, jend,
                 ibeg, iend,
-                KOKKOS_LAMBDA (int k, int j, int i, real &localSum) {
+                KOKKOS_LAMBDA (int k, int j, int i, accum &localSum) {
                   localSum += rhs(k,j,i) * rhs(k,j,i);
                 },
-                Kokkos::Sum<real>(rho2));
+                Kokkos::Sum<accum>(rho2));
 
   // Reduction on the whole grid
   #ifdef WITH_MPI
   MPI_Allreduce(MPI_IN_PLACE, &maxRes2, 1, realMPI, MPI_MAX, MPI_COMM_WORLD);
-  MPI_Allreduce(MPI_IN_PLACE, &rho2, 1, realMPI, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, &rho2, 1, accumMPI, MPI_SUM, MPI_COMM_WORLD);
   #endif
 
   // Squared error
@@ -286,20 +293,20 @@ real IterativeSolver<T>::ComputeDotProduct(IdefixArray3D<real> mat1, IdefixArray
   kbeg = this->beg[KDIR];
   kend = this->end[KDIR];
 
-  real sum;
+  accum sum;
 
   idefix_reduce("DotProduct",
                 kbeg, kend,
                 jbeg, jend,
                 ibeg, iend,
-                KOKKOS_LAMBDA (int k, int j, int i, real &localSum) {
+                KOKKOS_LAMBDA (int k, int j, int i, accum &localSum) {
                   localSum += mat1(k,j,i) * mat2(k,j,i);
                 },
-                Kokkos::Sum<real>(sum));
+                Kokkos::Sum<accum>(sum));
 
   // Reduction on the whole grid
   #ifdef WITH_MPI
-  MPI_Allreduce(MPI_IN_PLACE, &sum, 1, realMPI, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce(MPI_IN_PLACE, &sum, 1, accumMPI, MPI_SUM, MPI_COMM_WORLD);
   #endif
 
   idfx::popRegion();
@@ -308,6 +315,11 @@ real IterativeSolver<T>::ComputeDotProduct(IdefixArray3D<real> mat1, IdefixArray
 }
 
 
+template <class T>
+void IterativeSolver<T>::SetPreconditioner(Preconditioner p) {
+  this->preconditioner = p;
+}
+
 template <class T>
 real IterativeSolver<T>::GetError() {
   return(currentError);
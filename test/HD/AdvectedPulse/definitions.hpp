@@ -0,0 +1,4 @@
+#define     COMPONENTS      1
+#define     DIMENSIONS      1
+
+#define     GEOMETRY        CARTESIAN
@@ -0,0 +1,38 @@
+#include "idefix.hpp"
+#include "setup.hpp"
+
+// Initialisation routine. Can be used to allocate
+// Arrays or variables which are used later on
+Setup::Setup(Input &input, Grid &grid, DataBlock &data, Output &output) {
+}
+
+// This routine initialize the flow
+// Note that data is on the device.
+// One can therefore define locally
+// a datahost and sync it, if needed
+void Setup::InitFlow(DataBlock &data) {
+  // Create a host copy
+  DataBlockHost d(data);
+
+  // A density pulse in pressure equilibrium, advected at a uniform velocity
+  const real x0 = 0.125;
+  const real width = 0.03;
+
+  for(int k = 0; k < d.np_tot[KDIR] ; k++) {
+    for(int j = 0; j < d.np_tot[JDIR] ; j++) {
+      for(int i = 0; i < d.np_tot[IDIR] ; i++) {
+        real x = d.x[IDIR](i)-x0;
+        d.Vc(RHO,k,j,i) = ONE_F + HALF_F*exp(-x*x/(2*width*width));
+        d.Vc(VX1,k,j,i) = ONE_F;
+        d.Vc(PRS,k,j,i) = ONE_F;
+      }
+    }
+  }
+
+  // Send it all, if needed
+  d.SyncToDevice();
+}
+
+// Analyse data to produce an output
+void MakeAnalysis(DataBlock & data) {
+}
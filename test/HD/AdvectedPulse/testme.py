@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+
+"""
+
+@author: glesur
+"""
+import os
+import sys
+sys.path.append(os.getenv("IDEFIX_DIR"))
+
+import numpy as np
+import pytools.idfx_test as tst
+from pytools.dump_io import readDump
+
+name="dump.0001.dmp"
+
+def getError(fileName, initialFile, tol):
+  # The pulse is advected at unit velocity in a periodic domain of unit length
+  D0=readDump(initialFile)
+  D=readDump(fileName)
+  dx=D.x1r-D.x1l
+  rho0=np.squeeze(D0.data["Vc-RHO"])
+  rho=np.squeeze(D.data["Vc-RHO"])
+  mass0=np.sum(rho0*dx)
+  mass=np.sum(rho*dx)
+  print("Mass error: %e"%(abs(mass-mass0)/mass0))
+  assert abs(mass-mass0) < tol*mass0, "Mass is not conserved"
+
+  x=D.x1-0.125-0.75
+  x=x-np.round(x)
+  exact=1.0+0.5*np.exp(-x**2/(2*0.03**2))
+  return np.sum(np.abs(rho-exact)*dx)
+
+def testMe(test):
+  test.configure()
+  test.compile()
+  tol=1e-12
+  if test.single:
+    tol=1e-5
+
+  test.run(inputFile="idefix.ini")
+  errRef=getError(name,"dump.0000.dmp",tol)
+  test.run(inputFile="idefix-lts.ini")
+  errLts=getError(name,"dump.0000.dmp",tol)
+  print("L1 error without local time stepping: %e, with local time stepping: %e"%(errRef,errLts))
+  # The coarse bands are advanced with a larger time step, but the interfaces between levels
+  # should not degrade the solution
+  assert errLts < 1.5*errRef, "Local time stepping is not accurate at the level interfaces"
+
+
+test=tst.idfxTest()
+
+if not test.all:
+  testMe(test)
+else:
+  test.noplot = True
+  for rec in range(2,4):
+    test.single=False
+    test.reconstruction=rec
+    test.mpi=False
+    testMe(test)
+
+  # test in single precision
+  test.reconstruction=2
+  test.single=True
+  testMe(test)
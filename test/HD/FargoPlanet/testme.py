@@ -13,9 +13,15 @@ tolerance=1e-13
 def testMe(test):
   test.configure()
   test.compile()
-  inifiles=["idefix.ini","idefix-rkl.ini"]
+  inifiles=["idefix.ini","idefix-rkl.ini","idefix-spectral.ini"]
   mytol=tolerance
+  dec=test.dec
   for ini in inifiles:
+    # the spectral remap can't be split along phi, keep the same number of processes along R
+    if ini == "idefix-spectral.ini":
+      test.dec=[str(int(dec[0])*int(dec[1])),'1']
+    else:
+      test.dec=dec
     test.run(inputFile=ini)
     if test.init and not test.mpi:
       test.makeReference(filename="dump.0001.dmp")
@@ -25,6 +31,7 @@ def testMe(test):
       mytol = tolerance
     test.standardTest()
     test.nonRegressionTest(filename="dump.0001.dmp",tolerance=mytol)
+  test.dec=dec
 
 
 test=tst.idfxTest()
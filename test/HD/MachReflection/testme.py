@@ -22,6 +22,17 @@ def testMe(test):
     test.standardTest()
     test.nonRegressionTest(filename="dump.0001.dmp")
 
+  # the fused sweeps, with or without overlap of the MPI exchanges, should give the same
+  # results as the default ones
+  fusedfiles=[("idefix.ini","idefix-fused.ini"),
+              ("idefix-hllc.ini","idefix-fused-hllc.ini"),
+              ("idefix.ini","idefix-overlap.ini")]
+  for ini,fused in fusedfiles:
+    test.run(inputFile=ini)
+    os.replace("dump.0001.dmp","dump.unfused.dmp")
+    test.run(inputFile=fused)
+    test.compareDump("dump.unfused.dmp","dump.0001.dmp")
+
 
 test=tst.idfxTest()
 if not test.dec:
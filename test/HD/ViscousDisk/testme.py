@@ -13,7 +13,7 @@ tolerance=3e-15
 def testMe(test):
   test.configure()
   test.compile()
-  inifiles=["idefix.ini","idefix-rkl.ini"]
+  inifiles=["idefix.ini","idefix-rkl.ini","idefix-lts.ini"]
   for ini in inifiles:
     mytol=tolerance
 
@@ -15,9 +15,12 @@ name="dump.0001.dmp"
 def testMe(test):
   test.configure()
   test.compile()
-  inifiles=["idefix.ini","idefix-hll.ini","idefix-hllc.ini","idefix-tvdlf.ini"]
+  inifiles=["idefix.ini","idefix-hll.ini","idefix-hllc.ini","idefix-tvdlf.ini",
+            "idefix-ssprk43.ini","idefix-ssprk104.ini"]
   if test.reconstruction==4:
     inifiles=["idefix-rk3.ini","idefix-hllc-rk3.ini"]
+  if test.reconstruction==5:
+    inifiles=["idefix-rk3.ini","idefix-hllc-rk3.ini","idefix-characteristic-rk3.ini"]
 
   # loop on all the ini files for this test
   for ini in inifiles:
@@ -27,6 +30,16 @@ def testMe(test):
     test.standardTest()
     test.nonRegressionTest(filename=name)
 
+  # the fused sweeps should give the same results as the default ones
+  fusedfiles={"idefix-hll.ini":"idefix-fused-hll.ini",
+              "idefix-hllc.ini":"idefix-fused-hllc.ini",
+              "idefix-tvdlf.ini":"idefix-fused-tvdlf.ini"}
+  for ini in fusedfiles:
+    test.run(inputFile=ini)
+    os.replace(name,"dump.unfused.dmp")
+    test.run(inputFile=fusedfiles[ini])
+    test.compareDump("dump.unfused.dmp",name)
+
 
 test=tst.idfxTest()
 
@@ -37,7 +50,7 @@ if not test.all:
     testMe(test)
 else:
   test.noplot = True
-  for rec in range(2,5):
+  for rec in range(2,6):
     test.vectPot=False
     test.single=False
     test.reconstruction=rec
@@ -13,7 +13,7 @@ import pytools.idfx_test as tst
 def testMe(test):
   test.configure()
   test.compile()
-  inifiles=["idefix.ini","idefix-rkl.ini"]
+  inifiles=["idefix.ini","idefix-rkl.ini","idefix-implicit.ini"]
 
   for ini in inifiles:
     test.run(inputFile=ini)
@@ -28,7 +28,7 @@ void UserdefBoundary(Hydro *hydro, int dir, BoundarySide side, real t) {
     auto *data = hydro->data;
     if( (dir==IDIR) && (side == left)) {
         IdefixArray4D<real> Vc = hydro->Vc;
-        IdefixArray4D<real> Vs = hydro->Vs;
+        IdefixArray4D<accum> Vs = hydro->Vs;
 
         int ighost = data->nghost[IDIR];
         idefix_for("UserDefBoundary",
@@ -54,7 +54,7 @@ void UserdefBoundary(Hydro *hydro, int dir, BoundarySide side, real t) {
     }
     if( (dir==IDIR) && (side == right)) {
             IdefixArray4D<real> Vc = hydro->Vc;
-            IdefixArray4D<real> Vs = hydro->Vs;
+            IdefixArray4D<accum> Vs = hydro->Vs;
 
             int ighost = data->end[IDIR]-1;
         idefix_for("UserDefBoundary",
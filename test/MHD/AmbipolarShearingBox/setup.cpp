@@ -11,7 +11,7 @@ static real shear;
 void UserStep(Hydro *hydro, const real t, const real dt) {
     auto *data = hydro->data;
     Kokkos::Profiling::pushRegion("Setup::UserStep");
-    IdefixArray4D<real> Uc = hydro->Uc;
+    IdefixArray4D<accum> Uc = hydro->Uc;
     IdefixArray4D<real> Vc = hydro->Vc;
     IdefixArray1D<real> x = data->x[IDIR];
     IdefixArray1D<real> z = data->x[KDIR];
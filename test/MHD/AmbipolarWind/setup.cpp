@@ -98,7 +98,7 @@ void Resistivity(DataBlock& data, real t, IdefixArray3D<real> &etain) {
 void MySourceTerm(Hydro *hydro, const real t, const real dtin) {
   auto *data = hydro->data;
   IdefixArray4D<real> Vc = hydro->Vc;
-  IdefixArray4D<real> Uc = hydro->Uc;
+  IdefixArray4D<accum> Uc = hydro->Uc;
   IdefixArray1D<real> x1=data->x[IDIR];
   IdefixArray1D<real> x2=data->x[JDIR];
   real epsilonTop = epsilonTopGlob;
@@ -169,7 +169,7 @@ void MySourceTerm(Hydro *hydro, const real t, const real dtin) {
 void InternalBoundary(Hydro *hydro, const real t) {
   auto *data = hydro->data;
   IdefixArray4D<real> Vc = hydro->Vc;
-  IdefixArray4D<real> Vs = hydro->Vs;
+  IdefixArray4D<accum> Vs = hydro->Vs;
   IdefixArray1D<real> x1=data->x[IDIR];
   IdefixArray1D<real> x2=data->x[JDIR];
 
@@ -218,7 +218,7 @@ void UserdefBoundary(Hydro *hydro, int dir, BoundarySide side, real t) {
     auto *data = hydro->data;
     if( (dir==IDIR) && (side == left)) {
         IdefixArray4D<real> Vc = hydro->Vc;
-        IdefixArray4D<real> Vs = hydro->Vs;
+        IdefixArray4D<accum> Vs = hydro->Vs;
         IdefixArray1D<real> x1 = data->x[IDIR];
         IdefixArray1D<real> x2 = data->x[JDIR];
 
@@ -264,7 +264,7 @@ void UserdefBoundary(Hydro *hydro, int dir, BoundarySide side, real t) {
 
     if( (dir==IDIR) && (side == right)) {
         IdefixArray4D<real> Vc = hydro->Vc;
-        IdefixArray4D<real> Vs = hydro->Vs;
+        IdefixArray4D<accum> Vs = hydro->Vs;
         IdefixArray1D<real> x1 = data->x[IDIR];
         IdefixArray1D<real> x2 = data->x[JDIR];
 
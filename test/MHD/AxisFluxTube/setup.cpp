@@ -18,7 +18,7 @@ void ComputeUserVars(DataBlock & data, UserDefVariablesContainer &variables) {
   // Note that the labels should match the variable names in the input file
   IdefixHostArray3D<real> divB  = variables["divB"];
   IdefixHostArray3D<real> Er  = variables["Er"];
-  IdefixHostArray4D<real> Vs = d.Vs;
+  IdefixHostArray4D<accum> Vs = d.Vs;
   IdefixHostArray3D<real> Ax1 = d.A[IDIR];
   IdefixHostArray3D<real> Ax2 = d.A[JDIR];
   IdefixHostArray3D<real> Ax3 = d.A[KDIR];
@@ -43,7 +43,7 @@ void UserdefBoundary(Hydro *hydro, int dir, BoundarySide side, real t) {
     auto *data = hydro->data;
     if( (dir==IDIR) && (side == right)) {
         IdefixArray4D<real> Vc = hydro->Vc;
-        IdefixArray4D<real> Vs = hydro->Vs;
+        IdefixArray4D<accum> Vs = hydro->Vs;
         IdefixArray1D<real> x1Arr = data->x[IDIR];
         IdefixArray1D<real> x2Arr = data->x[JDIR];
         IdefixArray1D<real> x3Arr = data->x[KDIR];
@@ -7,7 +7,7 @@ void UserdefBoundary(Hydro *hydro, int dir, BoundarySide side, real t) {
     auto *data = hydro->data;
     if( (dir==IDIR) && (side == left)) {
         IdefixArray4D<real> Vc = hydro->Vc;
-        IdefixArray4D<real> Vs = hydro->Vs;
+        IdefixArray4D<accum> Vs = hydro->Vs;
         IdefixArray1D<real> x1 = data->x[IDIR];
 
         int ighost = data->nghost[IDIR];
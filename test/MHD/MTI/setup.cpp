@@ -71,7 +71,7 @@ void UserDefBoundary(Hydro *hydro, int dir, BoundarySide side, real t) {
   real rho0 = 1.; //initial density
   real P0 = rho0*T0; //initial pressure
   IdefixArray4D<real> Vc = hydro->Vc;
-  IdefixArray4D<real> Vs = hydro->Vs;
+  IdefixArray4D<accum> Vs = hydro->Vs;
   IdefixArray1D<real> x1 = data->x[IDIR];
   IdefixArray1D<real> x2 = data->x[JDIR];
   int jbeg = (side == left) ? 0 : data->end[JDIR];
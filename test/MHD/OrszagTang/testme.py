@@ -8,8 +8,37 @@ import os
 import sys
 sys.path.append(os.getenv("IDEFIX_DIR"))
 
+import numpy as np
 import pytools.idfx_test as tst
+from pytools.vtk_io import readVTK
 tolerance=1e-12
+
+def checkQuantizedVtk(fullFile, quantizedFile):
+  # The strided outputs hold one cell out of two of the full outputs. The quantized fields
+  # should be within half a quantization step of the full precision ones.
+  full=readVTK(fullFile)
+  quantized=readVTK(quantizedFile)
+  for var,bits in [("RHO",8),("VX1",16)]:
+    ref=full.data[var][::2,::2,:]
+    step=(np.amax(full.data[var])-np.amin(full.data[var]))/(2**bits-1)
+    error=np.amax(np.abs(quantized.data[var]-ref))
+    print("Quantization error of %s on %d bits: %e (step=%e)"%(var,bits,error,step))
+    assert error <= 0.5*step*(1+1e-5)+1e-6*np.amax(np.abs(ref)), "Quantization error too large"
+  assert np.array_equal(quantized.data["PRS"],full.data["PRS"][::2,::2,:]), \
+         "Strided field does not match the full output"
+
+def checkTimeSeries(fileName, tol):
+  # The domain is periodic, so the mass is conserved. The initial pressure is uniform and the
+  # initial velocity averages to zero.
+  series=np.loadtxt(fileName)
+  t=series[:,0]
+  assert np.all(np.diff(t) > 0), "Time series lines are not ordered in time"
+  mass=25.0/(36.0*np.pi)
+  print("Time series mass error: %e"%np.amax(np.abs(series[:,1]-mass)/mass))
+  assert np.allclose(series[:,1], mass, rtol=tol, atol=0), "Mass integral is wrong"
+  assert np.isclose(series[0,2], 5.0/(12.0*np.pi), rtol=tol, atol=0), "Mean pressure is wrong"
+  assert abs(series[0,3]) < tol, "Mean velocity is wrong"
+
 def testMe(test):
   test.configure()
   test.compile()
@@ -32,6 +61,37 @@ def testMe(test):
 
     test.nonRegressionTest(filename="dump.0001.dmp",tolerance=mytol)
 
+  # The fused constrained transport update should match the unfused one
+  if not test.vectPot:
+    fusedfiles={"idefix.ini":"idefix-fusedct.ini",
+                "idefix-hlld-arithmetic.ini":"idefix-hlld-arithmetic-fusedct.ini",
+                "idefix-hlld-uct0.ini":"idefix-hlld-uct0-fusedct.ini"}
+    for ini in fusedfiles:
+      test.run(inputFile=fusedfiles[ini])
+      #force override the inputfile since the result should be identical
+      test.inifile=ini
+      test.nonRegressionTest(filename="dump.0001.dmp",tolerance=mytol)
+
+  # Strided and quantized vtk outputs
+  test.run(inputFile="idefix.ini")
+  os.replace("data.0001.vtk","data.full.vtk")
+  test.run(inputFile="idefix-quantize.ini")
+  checkQuantizedVtk("data.full.vtk","data.0001.vtk")
+
+  # Time series of reductions, continued by a restart from the middle of the run
+  mytol=1e-5 if test.single else 1e-10
+  if os.path.exists("timeseries.dat"):
+    os.remove("timeseries.dat")
+  test.run(inputFile="idefix-tseries.ini")
+  checkTimeSeries("timeseries.dat",mytol)
+  reference=np.loadtxt("timeseries.dat")
+  test.run(inputFile="idefix-tseries.ini",restart=1)
+  checkTimeSeries("timeseries.dat",mytol)
+  restarted=np.loadtxt("timeseries.dat")
+  assert restarted.shape == reference.shape, "Time series lines are lost or duplicated on restart"
+  assert np.allclose(restarted,reference,rtol=tolerance,atol=0), \
+         "Time series differs after a restart"
+
 
 test=tst.idfxTest()
 if not test.dec:
@@ -1,3 +1,5 @@
+#include <chrono>
+#include <thread>
 #include "idefix.hpp"
 #include "setup.hpp"
 
@@ -11,6 +13,16 @@ generators on different architectures.
 
 Output* myOutput;
 int outnum;
+real slowdown;
+
+// Slow down the first process, so that the rebalance of the domain decomposition moves the
+// boundaries between processes. This does not change the flow.
+void SlowDown(Hydro *hydro, const real t, const real dtin) {
+  if(idfx::prank == 0) {
+    std::this_thread::sleep_for(std::chrono::duration<double>(slowdown));
+  }
+}
+
 // Analysis function
 // This analysis checks that the restart routines are performing as they should
 void Analysis(DataBlock& data) {
@@ -31,7 +43,7 @@ void Analysis(DataBlock& data) {
   IdefixHostArray4D<real> myVc = IdefixHostArray4D<real>("myVc", d.Vc.extent(0), data.np_tot[KDIR], data.np_tot[JDIR],data.np_tot[IDIR]);
   IdefixHostArray4D<real> myVs = IdefixHostArray4D<real>("myVs", DIMENSIONS, data.np_tot[KDIR]+KOFFSET, data.np_tot[JDIR]+JOFFSET,data.np_tot[IDIR]+IOFFSET);
   #ifdef EVOLVE_VECTOR_POTENTIAL
-  IdefixHostArray4D<real> myVe = IdefixHostArray4D<real>("myVe", AX3e+1, data.np_tot[KDIR]+KOFFSET, data.np_tot[JDIR]+JOFFSET,data.np_tot[IDIR]+IOFFSET);
+  IdefixHostArray4D<accum> myVe = IdefixHostArray4D<accum>("myVe", AX3e+1, data.np_tot[KDIR]+KOFFSET, data.np_tot[JDIR]+JOFFSET,data.np_tot[IDIR]+IOFFSET);
   #endif
   // Transfer the datablock to myVc and myVs
   for(int n = 0; n < d.Vc.extent(0) ; n++) {
@@ -204,6 +216,10 @@ Setup::Setup(Input &input, Grid &grid, DataBlock &data, Output &output) {
      myOutput = &output;
      outnum=0;
    }
+   slowdown = input.GetOrSet<real>("Setup","slowdown",0,0.0);
+   if(slowdown > 0) {
+     data.hydro->EnrollUserSourceTerm(&SlowDown);
+   }
 }
 
 // This routine initialize the flow
@@ -214,10 +230,10 @@ void Setup::InitFlow(DataBlock &data) {
     // Create a host copy
     DataBlockHost d(data);
     real x,y,z;
-    IdefixHostArray4D<real> Ve;
+    IdefixHostArray4D<accum> Ve;
 
     #ifndef EVOLVE_VECTOR_POTENTIAL
-    Ve = IdefixHostArray4D<real>("Potential vector",3, d.np_tot[KDIR]+1, d.np_tot[JDIR]+1, d.np_tot[IDIR]+1);
+    Ve = IdefixHostArray4D<accum>("Potential vector",3, d.np_tot[KDIR]+1, d.np_tot[JDIR]+1, d.np_tot[IDIR]+1);
     #else
     Ve = d.Ve;
     #endif
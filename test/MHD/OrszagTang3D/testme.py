@@ -12,6 +12,8 @@ import pytools.idfx_test as tst
 # Whether we should reset our reference run (only do that on purpose!)
 
 tolerance=1e-13
+# Maximum error of the mixed precision run with respect to the double precision reference
+mixedTolerance=1e-5
 
 def testMe(test):
   test.configure()
@@ -33,6 +35,86 @@ def testMe(test):
   test.inifile="idefix.ini"
   test.nonRegressionTest(filename="dump.0002.dmp",tolerance=tol)
 
+  # Check restarts from dumps written asynchronously
+  test.run("idefix-checkrestart-async.ini")
+  test.inifile="idefix.ini"
+  test.nonRegressionTest(filename="dump.0002.dmp",tolerance=tol)
+
+  # Check restarts from compressed dumps, which should be read back identically by pytools
+  os.replace("dump.0002.dmp","dump.uncompressed.dmp")
+  test.run("idefix-checkrestart-compressed.ini")
+  test.inifile="idefix.ini"
+  test.nonRegressionTest(filename="dump.0002.dmp",tolerance=tol)
+  test.compareDump("dump.uncompressed.dmp","dump.0002.dmp")
+
+  # The fused constrained transport update should match the unfused one
+  if not test.vectPot:
+    test.run("idefix-fusedct.ini")
+    #force override the inputfile since the result should be identical
+    test.inifile="idefix.ini"
+    test.nonRegressionTest(filename="dump.0001.dmp",tolerance=tol)
+
+  # Single phase exchange with all of the neighbours, including the corners and edges
+  test.run("idefix-exchangeall.ini")
+  #force override the inputfile since the result should be identical
+  test.inifile="idefix.ini"
+  test.nonRegressionTest(filename="dump.0001.dmp",tolerance=tol)
+
+  # Halo buffers staged in host memory instead of being handed to MPI in place
+  if test.mpi:
+    test.run(args=["-mpitransport","host"])
+    test.nonRegressionTest(filename="dump.0001.dmp",tolerance=tol)
+
+  # Rebalance of the domain decomposition after a few cycles, the first process being slowed
+  # down so that the boundaries between processes move
+  if test.mpi:
+    test.run("idefix-rebalance.ini")
+    with open("idefix.0.log","r") as file:
+      assert "Rebalancing the domain decomposition" in file.read(), "No rebalance was performed"
+    #force override the inputfile since the result should be identical
+    test.inifile="idefix.ini"
+    test.nonRegressionTest(filename="dump.0001.dmp",tolerance=tol)
+
+def testMixed(test):
+  # In mixed precision, the evolved state is kept in double precision while Vc, the fluxes and
+  # the MPI buffers are rounded to single precision. Restarts start from the rounded state, so
+  # they are not checked here.
+  test.configure()
+  test.compile()
+  test.run()
+  if test.init:
+    if not test.mpi:
+      test.makeReference(filename="dump.0001.dmp")
+  test.nonRegressionTest(filename="dump.0001.dmp",tolerance=1e-6)
+
+  # The solution should stay close to the double precision one
+  test.mixed=False
+  test.nonRegressionTest(filename="dump.0001.dmp",tolerance=mixedTolerance)
+  test.mixed=True
+
+def testLoopPatterns(test,patterns):
+  # the loop patterns should give the same results as the default one, including on a grid
+  # which is not a multiple of the tiles. Each ini file is run twice to read back the tuning.
+  inifiles=["idefix.ini","idefix-tiles.ini"]
+  cmake=test.cmake
+  test.cmake=cmake+["Idefix_LOOP_PATTERN=Default"]
+  test.configure()
+  test.compile()
+  for ini in inifiles:
+    test.run(inputFile=ini)
+    os.replace("dump.0001.dmp","dump.default."+ini[:-4]+".dmp")
+
+  for pattern in patterns:
+    if os.path.exists("idefix.tuning"):
+      os.remove("idefix.tuning")
+    test.cmake=cmake+["Idefix_LOOP_PATTERN="+pattern]
+    test.configure()
+    test.compile()
+    for ini in inifiles+inifiles:
+      test.run(inputFile=ini)
+      test.compareDump("dump.default."+ini[:-4]+".dmp","dump.0001.dmp")
+  test.cmake=cmake
+
 
 test=tst.idfxTest()
 
@@ -43,6 +125,8 @@ if not test.dec:
 if not test.all:
   if(test.check):
       test.checkOnly(filename="dump.0001.dmp",tolerance=tolerance)
+  elif test.mixed:
+    testMixed(test)
   else:
     testMe(test)
 else:
@@ -73,3 +157,21 @@ else:
   # test in MPI mode
   test.mpi=True
   testMe(test)
+
+  # test in mixed precision
+  test.single=False
+  test.mixed=True
+  test.mpi=False
+  testMixed(test)
+  test.mpi=True
+  testMixed(test)
+
+  # test the loop patterns which tune the loops of each kernel
+  test.mixed=False
+  test.vectPot=False
+  test.mpi=False
+  # the Tiled pattern is only available on CPUs
+  patterns=["Auto"]
+  if not (test.cuda or test.hip):
+    patterns.append("Tiled")
+  testLoopPatterns(test,patterns)
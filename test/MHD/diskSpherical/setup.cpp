@@ -13,7 +13,7 @@ real densityFloorGlob;
 void MySourceTerm(Hydro *hydro, const real t, const real dtin) {
   auto *data = hydro->data;
   IdefixArray4D<real> Vc = hydro->Vc;
-  IdefixArray4D<real> Uc = hydro->Uc;
+  IdefixArray4D<accum> Uc = hydro->Uc;
   IdefixArray1D<real> x1=data->x[IDIR];
   IdefixArray1D<real> x2=data->x[JDIR];
   real epsilon = epsilonGlob;
@@ -65,7 +65,7 @@ void FargoVelocity(DataBlock &data, IdefixArray2D<real> &Vphi) {
 void InternalBoundary(Hydro *hydro, const real t) {
   auto *data = hydro->data;
   IdefixArray4D<real> Vc = hydro->Vc;
-  IdefixArray4D<real> Vs = hydro->Vs;
+  IdefixArray4D<accum> Vs = hydro->Vs;
   IdefixArray1D<real> x1=data->x[IDIR];
   IdefixArray1D<real> x2=data->x[JDIR];
 
@@ -105,7 +105,7 @@ void UserdefBoundary(Hydro *hydro, int dir, BoundarySide side, real t) {
     auto *data = hydro->data;
     if( (dir==IDIR) && (side == left)) {
         IdefixArray4D<real> Vc = hydro->Vc;
-        IdefixArray4D<real> Vs = hydro->Vs;
+        IdefixArray4D<accum> Vs = hydro->Vs;
         IdefixArray1D<real> x1 = data->x[IDIR];
         IdefixArray1D<real> x2 = data->x[JDIR];
 
@@ -151,7 +151,7 @@ void UserdefBoundary(Hydro *hydro, int dir, BoundarySide side, real t) {
 
     if( dir==JDIR) {
         IdefixArray4D<real> Vc = hydro->Vc;
-        IdefixArray4D<real> Vs = hydro->Vs;
+        IdefixArray4D<accum> Vs = hydro->Vs;
         int jghost;
         int jbeg,jend;
         if(side == left) {
@@ -19,7 +19,7 @@ void UserDefBoundary(Hydro *hydro, int dir, BoundarySide side, real t) {
   auto *data = hydro->data;
   real B0 = 0.01;
   IdefixArray4D<real> Vc = data->hydro->Vc;
-  IdefixArray4D<real> Vs = data->hydro->Vs;
+  IdefixArray4D<accum> Vs = data->hydro->Vs;
   IdefixArray1D<real> x1 = data->x[IDIR];
   IdefixArray1D<real> x2 = data->x[JDIR];
   IdefixArray1D<real> x3 = data->x[KDIR];
@@ -132,7 +132,7 @@ void BragViscosity::EnrollBragViscousDiffusivity(DiffusivityFunc myFunc) {
 void BragViscosity::AddBragViscousFlux(int dir, const real t, const IdefixArray4D<real> &Flux) {
   idfx::pushRegion("BragViscosity::AddBragViscousFlux");
   IdefixArray4D<real> Vc = this->Vc;
-  IdefixArray4D<real> Vs = this->Vs;
+  IdefixArray4D<accum> Vs = this->Vs;
   IdefixArray4D<real> bragViscSrc = this->bragViscSrc;
   IdefixArray3D<real> dMax = this->dMax;
   IdefixArray3D<real> etaBragArr = this->etaBragArr;
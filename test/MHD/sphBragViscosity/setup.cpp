@@ -6,7 +6,7 @@ real amplitude;
 void UserDefBoundary(Hydro *hydro, int dir, BoundarySide side, real t) {
   auto *data = hydro->data;
   IdefixArray4D<real> Vc = data->hydro->Vc;
-  IdefixArray4D<real> Vs = data->hydro->Vs;
+  IdefixArray4D<accum> Vs = data->hydro->Vs;
   IdefixArray1D<real> x1 = data->x[IDIR];
   IdefixArray1D<real> x2 = data->x[JDIR];
   IdefixArray1D<real> x3 = data->x[KDIR];
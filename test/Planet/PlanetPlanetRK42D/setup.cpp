@@ -30,7 +30,7 @@ void MySoundSpeed(DataBlock &data, const real t, IdefixArray3D<real> &cs) {
 void Damping(Hydro *hydro, const real t, const real dtin) {
   auto *data = hydro->data;
   IdefixArray4D<real> Vc = hydro->Vc;
-  IdefixArray4D<real> Uc = hydro->Uc;
+  IdefixArray4D<accum> Uc = hydro->Uc;
   IdefixArray1D<real> x1 = data->x[IDIR];
   IdefixArray1D<real> x2 = data->x[JDIR];
 
@@ -8,13 +8,24 @@ import os
 import sys
 sys.path.append(os.getenv("IDEFIX_DIR"))
 
+import numpy as np
 import pytools.idfx_test as tst
+from pytools.dump_io import readDump
 
 name="dump.0001.dmp"
 
 
 tolerance=1e-12
 
+def comparePerturbation(refFile, testFile, tol):
+  # The perturbation grows by orders of magnitude, so the error is measured relative to it
+  rhoRef=np.squeeze(readDump(refFile).data["Vc-RHO"])
+  rho=np.squeeze(readDump(testFile).data["Vc-RHO"])
+  drhoRef=rhoRef-np.mean(rhoRef)
+  error=np.amax(np.abs(rho-rhoRef))/np.amax(np.abs(drhoRef))
+  print("Relative error of the density perturbation: %e"%error)
+  assert error < tol, "Density perturbation differs from the reference"
+
 def testMe(test):
   test.configure()
   test.compile()
@@ -24,6 +35,20 @@ def testMe(test):
   for ini in inifiles:
     test.run(inputFile=ini)
     test.standardTest()
+    if ini=="idefix.ini":
+      os.replace(name,"dump.ref.dmp")
+
+  # The extrapolated initial guess only changes the solution within the solver tolerance
+  test.run(inputFile="idefix-extrapolation.ini")
+  test.standardTest()
+  comparePerturbation("dump.ref.dmp",name,1e-4)
+
+  # Skipping the solver is only accurate with small time steps, for which the density changes
+  # by less than skipTolerance during a cycle
+  test.run(inputFile="idefix-cfl005.ini")
+  os.replace(name,"dump.ref.dmp")
+  test.run(inputFile="idefix-skip.ini")
+  comparePerturbation("dump.ref.dmp",name,5e-2)
 
 
 test=tst.idfxTest()